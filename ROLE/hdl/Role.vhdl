@@ -319,6 +319,19 @@ architecture BringUp of Role_Kale is
   signal ssTARS_TAF_DatLen_tvalid   : std_ulogic;
   signal ssTARS_TAF_DatLen_tready   : std_ulogic;  
   
+  --------------------------------------------------------
+  -- SIGNAL DECLARATIONS : MMIO --> CFGB --> USIF|TSIF
+  --------------------------------------------------------
+  signal sCFGB_WrReg                : std_ulogic_vector( 15 downto 0);  -- Sampled APP_WRROL
+  signal sCFGB_Toggle               : std_ulogic;  -- Toggle bit of the last word taken
+  signal sCFGB_WrIdx                : unsigned(  1 downto 0);  -- Index of the next word (0=none)
+  signal sCFGB_CfgCmd               : std_ulogic_vector( 55 downto 0);
+  signal ssCFGB_CfgCmd_tdata        : std_ulogic_vector( 55 downto 0);
+  signal ssCFGB_USIF_CfgCmd_tvalid  : std_ulogic;
+  signal ssCFGB_USIF_CfgCmd_tready  : std_ulogic;
+  signal ssCFGB_TSIF_CfgCmd_tvalid  : std_ulogic;
+  signal ssCFGB_TSIF_CfgCmd_tready  : std_ulogic;
+
   --------------------------------------------------------
   -- SIGNAL DECLARATIONS : TSIF --> ARS --> DEBUG
   --------------------------------------------------------
@@ -859,6 +872,10 @@ architecture BringUp of Role_Kale is
         -- SHELL / Mmio Interface
         --------------------------------------------------------
         piSHL_Mmio_En_V         : in  std_logic;
+        ---- Configuration Command Stream
+        siSHL_Mmio_CfgCmd_V_tdata  : in  std_logic_vector(55 downto 0);
+        siSHL_Mmio_CfgCmd_V_tvalid : in  std_logic;
+        siSHL_Mmio_CfgCmd_V_tready : out std_logic;
         --------------------------------------------------------
         -- SHELL / UDP Control Port Interfaces
         --------------------------------------------------------
@@ -1167,6 +1184,14 @@ architecture BringUp of Role_Kale is
        -- From SHELL / Mmio Interfaces
        --------------------------------------------------------       
        piSHL_Mmio_En_V        : in  std_ulogic;
+       ---- Configuration Command Stream
+       siSHL_Mmio_CfgCmd_V_tdata  : in  std_ulogic_vector( 55 downto 0);
+       siSHL_Mmio_CfgCmd_V_tvalid : in  std_ulogic;
+       siSHL_Mmio_CfgCmd_V_tready : out std_ulogic;
+       ---- Sink Statistics Stream
+       soSHL_Mmio_SinkStats_V_tdata  : out std_ulogic_vector(175 downto 0);
+       soSHL_Mmio_SinkStats_V_tvalid : out std_ulogic;
+       soSHL_Mmio_SinkStats_V_tready : in  std_ulogic;
       ------------------------------------------------------
       -- TAF / TxP Data Flow Interfaces
       ------------------------------------------------------
@@ -1185,6 +1210,27 @@ architecture BringUp of Role_Kale is
       siTAF_DatLen_V_V_tdata  : in  std_ulogic_vector( 15 downto 0);
       siTAF_DatLen_V_V_tvalid : in  std_ulogic;
       siTAF_DatLen_V_V_tready : out std_ulogic; 
+      ------------------------------------------------------
+      -- TAF / TxP Socket Interfaces
+      ------------------------------------------------------
+      ---- TCP Data Stream 
+      siTAF_SockData_tdata    : in  std_ulogic_vector( 63 downto 0);
+      siTAF_SockData_tkeep    : in  std_ulogic_vector(  7 downto 0);
+      siTAF_SockData_tlast    : in  std_ulogic;
+      siTAF_SockData_tvalid   : in  std_ulogic;
+      siTAF_SockData_tready   : out std_ulogic;
+      ---- TCP Destination Socket
+      siTAF_SockAddr_V_tdata  : in  std_ulogic_vector( 47 downto 0);
+      siTAF_SockAddr_V_tvalid : in  std_ulogic;
+      siTAF_SockAddr_V_tready : out std_ulogic;
+      ---- TCP Data-Length 
+      siTAF_SockLen_V_V_tdata : in  std_ulogic_vector( 15 downto 0);
+      siTAF_SockLen_V_V_tvalid: in  std_ulogic;
+      siTAF_SockLen_V_V_tready: out std_ulogic;
+      ---- TCP Socket Send Reply
+      soTAF_SockRep_V_tdata   : out std_ulogic_vector( 23 downto 0);
+      soTAF_SockRep_V_tvalid  : out std_ulogic;
+      soTAF_SockRep_V_tready  : in  std_ulogic;
       ------------------------------------------------------               
       -- TAF / RxP Data Flow Interfaces                      
       ------------------------------------------------------               
@@ -1279,7 +1325,15 @@ architecture BringUp of Role_Kale is
       ---- Input Buffer Space
       soDBG_InpBufSpace_V_V_tdata : out std_ulogic_vector( 15 downto 0);
       soDBG_InpBufSpace_V_V_tvalid: out std_ulogic;
-      soDBG_InpBufSpace_V_V_tready: in  std_ulogic
+      soDBG_InpBufSpace_V_V_tready: in  std_ulogic;
+      ---- Open Connection Event Stream
+      soDBG_OpnEvent_V_tdata      : out std_ulogic_vector( 79 downto 0);
+      soDBG_OpnEvent_V_tvalid     : out std_ulogic;
+      soDBG_OpnEvent_V_tready     : in  std_ulogic;
+      ---- Iperf Report Stream
+      soDBG_IpfReport_V_tdata     : out std_ulogic_vector(127 downto 0);
+      soDBG_IpfReport_V_tvalid    : out std_ulogic;
+      soDBG_IpfReport_V_tready    : in  std_ulogic
     );
   end component TcpShellInterface;
   
@@ -1596,6 +1650,9 @@ begin
         -- SHELL / Mmio Interface
         --------------------------------------------------------
         piSHL_Mmio_En_V         => piSHL_Mmio_Ly7En,
+        siSHL_Mmio_CfgCmd_V_tdata  => std_logic_vector(ssCFGB_CfgCmd_tdata),
+        siSHL_Mmio_CfgCmd_V_tvalid => ssCFGB_USIF_CfgCmd_tvalid,
+        siSHL_Mmio_CfgCmd_V_tready => ssCFGB_USIF_CfgCmd_tready,
         --------------------------------------------------------
         -- SHELL / UDP Control Port Interfaces
         --------------------------------------------------------
@@ -2097,6 +2154,12 @@ begin
         -- From SHELL / Mmio Interfaces
         --------------------------------------------------------
         piSHL_Mmio_En_V           => piSHL_Mmio_Ly7En,
+        siSHL_Mmio_CfgCmd_V_tdata => ssCFGB_CfgCmd_tdata,
+        siSHL_Mmio_CfgCmd_V_tvalid=> ssCFGB_TSIF_CfgCmd_tvalid,
+        siSHL_Mmio_CfgCmd_V_tready=> ssCFGB_TSIF_CfgCmd_tready,
+        soSHL_Mmio_SinkStats_V_tdata => open,
+        soSHL_Mmio_SinkStats_V_tvalid=> open,
+        soSHL_Mmio_SinkStats_V_tready=> '1',
         ------------------------------------------------------
         -- TAF (via TARS) / TxP Data Flow Interfaces (APP-->SHELL)
         ------------------------------------------------------
@@ -2114,6 +2177,26 @@ begin
         siTAF_DatLen_V_V_tvalid   => ssTARS_TSIF_DatLen_tvalid,
         siTAF_DatLen_V_V_tready   => ssTARS_TSIF_DatLen_tready,
         ------------------------------------------------------
+        -- TAF / TxP Socket Interfaces (not used by this TAF)
+        ------------------------------------------------------
+        siTAF_SockData_tdata      => (others => '0'),
+        siTAF_SockData_tkeep      => (others => '0'),
+        siTAF_SockData_tlast      => '0',
+        siTAF_SockData_tvalid     => '0',
+        siTAF_SockData_tready     => open,
+        --
+        siTAF_SockAddr_V_tdata    => (others => '0'),
+        siTAF_SockAddr_V_tvalid   => '0',
+        siTAF_SockAddr_V_tready   => open,
+        --
+        siTAF_SockLen_V_V_tdata   => (others => '0'),
+        siTAF_SockLen_V_V_tvalid  => '0',
+        siTAF_SockLen_V_V_tready  => open,
+        --
+        soTAF_SockRep_V_tdata     => open,
+        soTAF_SockRep_V_tvalid    => open,
+        soTAF_SockRep_V_tready    => '1',
+        ------------------------------------------------------
         -- TAF (via TARS) / RxP Data Flow Interfaces (SHELL-->APP)
         ------------------------------------------------------  
         soTAF_Data_tdata          => ssTSIF_TARS_Data_tdata,
@@ -2205,7 +2288,15 @@ begin
         ---- Input Buffer Space Stream
         soDBG_InpBufSpace_V_V_tdata  => sTSIF_DBG_InpBufSpace,
         soDBG_InpBufSpace_V_V_tvalid => open,
-        soDBG_InpBufSpace_V_V_tready => '1'
+        soDBG_InpBufSpace_V_V_tready => '1',
+        ---- Open Connection Event Stream
+        soDBG_OpnEvent_V_tdata       => open,
+        soDBG_OpnEvent_V_tvalid      => open,
+        soDBG_OpnEvent_V_tready      => '1',
+        ---- Iperf Report Stream
+        soDBG_IpfReport_V_tdata      => open,
+        soDBG_IpfReport_V_tvalid     => open,
+        soDBG_IpfReport_V_tready     => '1'
       ); -- End of: TcpShellInterface
   end generate;
   
@@ -2431,6 +2522,67 @@ begin
       );
   end generate;
 
+  -- ========================================================================
+  -- == Configuration Bridge (CFGB)
+  -- ==  Assembles the configuration commands of [USIF] and [TSIF] out of the
+  -- ==  APP_WRROL register of [SHELL/MMIO]. A command {value,index,tblId} is
+  -- ==  written as 4 words of 14 bits, least significant word first:
+  -- ==    [15]   : Toggled by every write. A word is taken upon each change.
+  -- ==    [14]   : Set in the first word of a command.
+  -- ==    [13:0] : The next 14 bits of the command.
+  -- ==  Bit #7 of 'tblId' selects [USIF] (1) or [TSIF] (0), and is cleared
+  -- ==  before the command is forwarded. A word is only taken once the
+  -- ==  previous command was accepted, which takes a few cycles only.
+  -- ========================================================================
+  pCfgBridge : process(piSHL_156_25Clk)
+  begin
+    if rising_edge(piSHL_156_25Clk) then
+      if piSHL_Mmio_Ly7Rst = '1' then
+        sCFGB_WrReg               <= (others => '0');
+        sCFGB_Toggle              <= '0';
+        sCFGB_WrIdx               <= (others => '0');
+        sCFGB_CfgCmd              <= (others => '0');
+        ssCFGB_USIF_CfgCmd_tvalid <= '0';
+        ssCFGB_TSIF_CfgCmd_tvalid <= '0';
+      else
+        sCFGB_WrReg <= piSHL_Mmio_WrReg;
+        if ssCFGB_USIF_CfgCmd_tready = '1' then
+          ssCFGB_USIF_CfgCmd_tvalid <= '0';
+        end if;
+        if ssCFGB_TSIF_CfgCmd_tready = '1' then
+          ssCFGB_TSIF_CfgCmd_tvalid <= '0';
+        end if;
+        if (sCFGB_WrReg(15) /= sCFGB_Toggle) and
+           (ssCFGB_USIF_CfgCmd_tvalid = '0') and (ssCFGB_TSIF_CfgCmd_tvalid = '0') then
+          sCFGB_Toggle <= sCFGB_WrReg(15);
+          if sCFGB_WrReg(14) = '1' then
+            sCFGB_CfgCmd(13 downto  0) <= sCFGB_WrReg(13 downto 0);
+            sCFGB_WrIdx <= to_unsigned(1, 2);
+          else
+            -- A word which does not follow a first word is ignored
+            case sCFGB_WrIdx is
+              when "01" =>
+                sCFGB_CfgCmd(27 downto 14) <= sCFGB_WrReg(13 downto 0);
+                sCFGB_WrIdx <= to_unsigned(2, 2);
+              when "10" =>
+                sCFGB_CfgCmd(41 downto 28) <= sCFGB_WrReg(13 downto 0);
+                sCFGB_WrIdx <= to_unsigned(3, 2);
+              when "11" =>
+                sCFGB_CfgCmd(55 downto 42) <= sCFGB_WrReg(13 downto 0);
+                sCFGB_WrIdx <= to_unsigned(0, 2);
+                ssCFGB_USIF_CfgCmd_tvalid <= sCFGB_CfgCmd(7);
+                ssCFGB_TSIF_CfgCmd_tvalid <= not sCFGB_CfgCmd(7);
+              when others =>
+                null;
+            end case;
+          end if;
+        end if;
+      end if;
+    end if;
+  end process pCfgBridge;
+  
+  ssCFGB_CfgCmd_tdata <= sCFGB_CfgCmd(55 downto 8) & '0' & sCFGB_CfgCmd(6 downto 0);
+
   -- ========================================================================
   -- == Generation of a delayed reset for the MemTest core
   -- ==  [TODO: Can we get ret rid of this reset]
@@ -17,12 +17,15 @@
 # *****************************************************************************
 # * 
 # * Description : A Tcl script to simulate, synthesize and package the current
-# *   HLS core as an IP. This script handles two projects:
-# *     1) 'ip_core' which is used to csim, csynth and cosim, 
-# *     2) 'ip_top'  which is used to export and package the IP. 
+# *   HLS core as an IP. This script handles four projects:
+# *     1) 'ip_core'  which is used to csim, csynth and cosim, 
+# *     2) 'ip_top'   which is used to export and package the IP. 
+# *     3) 'ip_bench' which is used to csim the performance benchmark.
+# *     4) 'ip_sched' which is used to csim the benchmark with the Rx scheduling
+# *                   policy passed by ENV variable 'hlsRxPolicy' (see TSIF_RX_POLICY).
 # * 
 # * Synopsis: 
-# *    vivado_hls -f <this_file> [ip_core|ip_top]
+# *    vivado_hls -f <this_file> [ip_core|ip_top|ip_bench|ip_sched]
 # *
 # * Reference documents:
 # *  - UG902 / Ch.4 / High-Level Synthesis Reference Guide.
@@ -49,10 +52,10 @@ if { $argc == 2 } {
     set ipProjectName "ip_core"
 } elseif { $argc == 3 } {
     set ipProjectName [lindex $argv 2]
-    if { ![string equal ${ipProjectName} ip_core] && ![string equal ${ipProjectName} ip_top] } {
+    if { ![string equal ${ipProjectName} ip_core] && ![string equal ${ipProjectName} ip_top] && ![string equal ${ipProjectName} ip_bench] && ![string equal ${ipProjectName} ip_sched] } {
         puts "####"
         puts "####  ERROR: Unknown project name passed as 3rd argument."
-        puts "####    Expected: -f run_hls.tcl [ip_core|ip_top]"
+        puts "####    Expected: -f run_hls.tcl [ip_core|ip_top|ip_bench|ip_sched]"
         puts "####    Received: $argv"
         puts "####"
         exit 2  
@@ -77,6 +80,11 @@ set hlsCSim      $::env(hlsCSim)
 set hlsCSynth    $::env(hlsCSynth)
 set hlsCoSim     $::env(hlsCoSim)
 set hlsRtl       $::env(hlsRtl)
+if { [info exists ::env(hlsRxPolicy)] } {
+    set hlsRxPolicy $::env(hlsRxPolicy)
+} else {
+    set hlsRxPolicy 1
+}
 
 # Set Project Environment Variables  
 #-------------------------------------------------
@@ -101,7 +109,11 @@ open_project     ${ipProjectName}_prj
 
 # Add files
 #-------------------------------------------------
-add_files        ${currDir}/src/${ipName}.cpp
+if { [string equal ${ipProjectName} ip_sched] } {
+    add_files    ${currDir}/src/${ipName}.cpp -cflags "-DTSIF_RX_POLICY=${hlsRxPolicy}"
+} else {
+    add_files    ${currDir}/src/${ipName}.cpp
+}
 add_files        ${currDir}/../../../cFDK/SRA/LIB/SHELL/LIB/hls/NTS/nts_utils.cpp
 
 # Set toplevel
@@ -113,6 +125,12 @@ if { [string equal ${ipProjectName} ip_core] } {
     set_top       ${ipName}_top
     add_files     ${srcDir}/${ipName}_top.cpp       -cflags "-DHLS_VERSION=${HLS_VERSION}"
     add_files -tb ${testDir}/test_${ipName}_top.cpp -cflags "-DHLS_VERSION=${HLS_VERSION}"
+} elseif { [string equal ${ipProjectName} ip_bench] } {
+    set_top       ${ipName}
+    add_files -tb ${testDir}/bench_${ipName}.cpp
+} elseif { [string equal ${ipProjectName} ip_sched] } {
+    set_top       ${ipName}
+    add_files -tb ${testDir}/bench_${ipName}.cpp -cflags "-DTSIF_RX_POLICY=${hlsRxPolicy}"
 }
 add_files -tb ${testDir}/simu_${ipName}_env.cpp
 add_files -tb ${currDir}/../../../cFDK/SRA/LIB/SHELL/LIB/hls/NTS/SimNtsUtils.cpp
@@ -185,6 +203,81 @@ if { $hlsCSim} {
     puts "####          SUCCESSFUL END OF COMPILATION              ####"
     puts "####                                                     ####"
     puts "#############################################################"
+    if { [string equal ${ipProjectName} ip_bench] } {
+        #-- Usage: <nrSess> <nrNotifs> <segLen> [dstPort] [dReqLatency] | arb  (segLen=0: mixed sizes)
+        #--        drr <nrShort> <nrBulk> <quantum> [msgLen] [dReqLatency]
+        #--        ooo <nrSess> <nrNotifs> <segLen> [dstPort] [dReqLatency]  (out-of-order TOE)
+        #--        coa <bytes> <timeout> <nrSess> <nrNotifs> <segLen> [dstPort] [dReqLatency]  (Rx coalescing)
+        #--        gen <nrSess> <nrBytes> [pattern] [rate] [stamp] [repeat] [segLen]
+        #--        iperf <nrStreams> <nrBytes>
+        #--        cli <nrSocks> <nrMsgs> [msgLen] [opnLat] [nrFail] [lossy]  (socket-addressed Tx)
+        #--        txb <nrSess> <nrMsgs> [msgLen] [bufLen] [drain] [nrStall] [nrLost] [segLen]  (Tx buffer back-pressure)
+        csim_design -argv "arb"
+        csim_design -argv "  1 1024   64"
+        csim_design -argv "  2 1024   64"
+        csim_design -argv "  4 1024   64"
+        csim_design -argv "  8 1024   64"
+        csim_design -argv " 16 1024   64"
+        csim_design -argv " 32 2048   64"
+        csim_design -argv "  8 1024  128"
+        csim_design -argv " 32 2048  128"
+        csim_design -argv " 32 2048    8"
+        csim_design -argv " 32  512    1"
+        csim_design -argv "  4   64 2048"
+        csim_design -argv "  2  100 1460 8803 40"
+        csim_design -argv " 32 2048    0 8803 400"
+        csim_design -argv "drr 4 2  256"
+        csim_design -argv "drr 8 4  512"
+        csim_design -argv "drr 2 8  256 64 40"
+        csim_design -argv "pat 8 1024   64 9000"
+        csim_design -argv "ooo 8 1024    0"
+        csim_design -argv "ooo 4  512   64 8803 40"
+        csim_design -argv "coa  256  64 1  512    1"
+        csim_design -argv "coa  512  64 1 1024    8"
+        csim_design -argv "coa 2048 200 4 1000  100 8803 40"
+        csim_design -argv "gen 1 60000 1"
+        csim_design -argv "gen 4 60000 2 0 1"
+        csim_design -argv "gen 4 30000 3 1024"
+        csim_design -argv "gen 2 200000 2 0 1 3"
+        csim_design -argv "gen 1 60000 1 0 0 0    8"
+        csim_design -argv "gen 4 30000 3 0 0 0   64"
+        csim_design -argv "iperf 1 60000"
+        csim_design -argv "iperf 4 30000"
+        csim_design -argv "cli  4 1024   64"
+        csim_design -argv "cli 16 2048    8"
+        csim_design -argv "cli 16 2048  256 200"
+        csim_design -argv "cli  2  600   24   0"
+        csim_design -argv "cli  4   64   64 100 1"
+        csim_design -argv "cli  4 1024   64 100 2"
+        csim_design -argv "cli  4   64   64 100 0 1"
+        csim_design -argv "txb 8 256 1000 1024 16"
+        csim_design -argv "txb 8 128 1500 1024 16"
+        csim_design -argv "txb 4  64 1000  512  8 1"
+        csim_design -argv "txb 4  64 1000  256  8 1"
+        csim_design -argv "txb 4  64 2000  256  8 1"
+        csim_design -argv "txb 4  64 2000  256  8 0 1"
+        csim_design -argv "txb 8 128 1500 1024 16 1 1"
+        puts "#############################################################"
+        puts "####                                                     ####"
+        puts "####          SUCCESSFUL END OF BENCHMARK                ####"
+        puts "####                                                     ####"
+        puts "#############################################################"
+        exit
+    }
+    if { [string equal ${ipProjectName} ip_sched] } {
+        #-- Same traffic for every policy: equal sessions, mixed sizes, many sessions
+        csim_design -argv "  8 1024   64"
+        csim_design -argv " 32 2048   64"
+        csim_design -argv " 16 2048    0 8803 40"
+        csim_design -argv "  8  256 1460"
+        puts "#############################################################"
+        puts "####                                                     ####"
+        puts "####          SUCCESSFUL END OF BENCHMARK                ####"
+        set line "####            (TSIF_RX_POLICY = ${hlsRxPolicy})"; while { [ string length $line ] <= 56 } { append line " " }; puts "${line} ####"
+        puts "####                                                     ####"
+        puts "#############################################################"
+        exit
+    }
     csim_design
     csim_design -argv "   1 10.11.12.13 32768    1"
     csim_design -argv "   2 10.11.12.13 32768    2"
@@ -51,12 +51,16 @@ using namespace std;
 
 /************************************************
  * ARCHITECTURE DIRECTIVE
- *  The ReadRequestHandler (RRh) of TSIF can be
+ *  The ReadRequestHandler (RRh) of TSIF is
  *  implemented with an interrupt handler and
- *  scheduler approach by setting the following
- *  pre-processor directive.
+ *  scheduler approach, unless the Rx scheduling
+ *  policy is 'FIFO' in which case it falls back
+ *  onto the former notification FIFO-based
+ *  implementation (see 'TSIF_RX_POLICY').
  ************************************************/
-#undef USE_INTERRUPTS
+#if TSIF_RX_POLICY != RX_POLICY_FIFO
+  #define USE_INTERRUPTS
+#endif
 
 /************************************************
  * HELPERS FOR THE DEBUGGING TRACES
@@ -77,6 +81,13 @@ using namespace std;
 #define TRACE_RNH     1 <<  6
 #define TRACE_RRH     1 <<  7
 #define TRACE_RRM     1 <<  8
+#define TRACE_MCH     1 <<  9
+#define TRACE_RBP     1 << 10
+#define TRACE_IPS     1 << 11
+#define TRACE_TMX     1 << 12
+#define TRACE_SLC     1 << 13
+#define TRACE_RCO     1 << 14
+#define TRACE_TSH     1 << 15
 #define TRACE_ALL      0xFFFF
 #define DEBUG_LEVEL (TRACE_OFF)
 
@@ -104,35 +115,88 @@ void pStreamDataMover(
  *
  * @param[in]  piSHL_Enable     Enable signal from [SHELL].
  * @param[in]  siRDp_OpnSockReq The remote socket to connect from ReadPath(RDp).
- * @param[in]  siRDp_TxCountReq The #bytes to be transmitted after connection is opened.
- * @param[out] soWRp_TxBytesReq The #bytes to be transmitted to WritePath (WRp).
+ * @param[in]  siRDp_TxCountReq The Tx test request to be served after connection is opened.
+ * @param[in]  siTSh_SockReq    The tagged remote socket of a message from TxSocketHandler (TSh).
+ * @param[out] soTSh_SockRep    The session to send that message on (same tag), to [TSh].
+ * @param[out] soWRp_TxBytesReq The Tx test request to be served by WritePath (WRp).
  * @param[out] soWRp_TxSessId   The session id of the active opened connection to [WRp].
  * @param[out] soSHL_OpnReq     Open connection request to [SHELL].
  * @param[in]  siSHL_OpnRep     Open connection reply from [SHELL].
- * @param[out] soSHL_ClsReq     Close connection request to [SHELL].
+ * @param[out] soSLc_ClsReq     Close connection request to SessionLifecycle (SLc).
+ * @param[in]  siSLc_ClsSig     The session closed by [SLc].
+ * @param[out] soDBG_OpnEvent   The outcome of the open connection attempts (for debug).
  *
  * @details
- *  This process connects the FPGA in client mode to a remote server which
- *   socket address is specified by 'siRDp_OpnSockReq'.
+ *  This process connects the FPGA in client mode to remote servers which
+ *   socket addresses are specified by 'siRDp_OpnSockReq'.
  *  Alternatively, the process is also used to trigger the TxPath (TXp) to
- *   transmit a segment to the newly opened connection.
+ *   transmit a segment to an opened connection.
  *  The switch between opening a connection and sending traffic a remote host is
- *   defined by the value of the 'siRDp_TxCountReq' input:
- *     1) If 'siRDp_TxCountReq' == 0, the process opens a new connection with
- *        the remote host specified by 'siRDp_OpnSockReq'.
- *     2) If 'siRDp_TxCountReq' != 0, the process triggers the TxPath (TXp) to
- *        transmit a segment to the *LAST* opened connection.
- *        The number of bytes to transmit is specified by 'siRDp_TxCountReq'.
+ *   defined by the length of the 'siRDp_TxCountReq' input:
+ *     1) If its length == 0, the process opens a new connection with the remote
+ *        host specified by 'siRDp_OpnSockReq'.
+ *     2) If its length != 0, the process triggers the TxPath (TXp) to transmit
+ *        to the connection of 'siRDp_OpnSockReq'. The number of bytes to
+ *        transmit and the number of times to repeat them are specified by
+ *        'siRDp_TxCountReq' (see 'TxTestReq').
+ *  The connections are kept in a fully associative table of 'cConTblEntries'
+ *   entries which is looked up by socket address. A request for a socket which
+ *   is not in the table allocates a new entry in the 'CONN_WAITING' state, and
+ *   a segment requested while its connection is not yet established is
+ *   deferred until it is (the #bytes of consecutive requests are accumulated,
+ *   unless one of them is repeated). Therefore, a request is not held back by
+ *   a connection being opened, except when it cannot be merged with the
+ *   request already deferred for that connection.
+ *  The same table serves as a connection cache for the socket-addressed
+ *   messages of [TAF]. A socket requested by [TSh] is answered with the session
+ *   of its entry as soon as that connection is established, and an entry is
+ *   allocated and opened on the fly for a socket which is not in the table. The
+ *   requests of [TSh] are looked up ahead of those of [RDp]. They are tagged
+ *   and answered out of order: a request which waits for its connection is
+ *   parked in one of 'cTShLookups' slots, such that the next ones are looked
+ *   up (and their connections opened) right away.
+ *  The open requests are issued to [SHELL] by a non-blocking engine which
+ *   keeps up to 'cConMaxOpnReqs' of them in flight, each with its own deadline.
+ *   An attempt which times out or is refused is retried after an exponential
+ *   backoff, up to 'cConMaxTries' attempts per connection. The outcome of every
+ *   attempt is reported on 'soDBG_OpnEvent'. An entry which is given up is kept
+ *   in the 'CONN_FAILED' state for 'cOpnHoldOff' cycles, during which a request
+ *   to its socket fails right away instead of restarting the attempts.
+ *
+ * @warning
+ *  The open replies of [SHELL] carry no socket address. They are matched with
+ *   the open requests in the order these requests were issued. An attempt that
+ *   timed out therefore keeps its slot until its late reply is received. Such a
+ *   late connection is adopted if its entry is still waiting for a new attempt,
+ *   and closed otherwise.
+ *  An attempt which is still not answered 'cOpnExpiry' cycles after it timed
+ *   out is considered lost and its slot is freed, such that unanswered attempts
+ *   cannot exhaust the slots. No new attempt is issued while a timed out one
+ *   keeps its slot, such that the reply to a later attempt cannot be matched
+ *   with one that [SHELL] has lost. A reply which arrives when no attempt is in
+ *   flight is closed.
+ *  The close requests are forwarded to [SHELL] by [SLc], which in turn signals
+ *   the sessions it reclaims upon idle timeout. The entry of such a session is
+ *   freed, such that a later request to the same socket opens a new connection.
+ *   A connection that is in use by [TSh] is kept warm by its own traffic.
+ *  A request of [TSh] is answered with a failure if the table is full, if all
+ *   the attempts to open its connection fail, or if its socket is held off.
+ *   The entries which are held off are also counted as used.
+ *  De-asserting 'piSHL_Enable' flushes the connection table.
  *******************************************************************************/
 void pConnect(
         CmdBit                *piSHL_Enable,
         stream<SockAddr>      &siRDp_OpnSockReq,
-        stream<Ly4Len>        &siRDp_TxCountReq,
-        stream<Ly4Len>        &soWRp_TxBytesReq,
+        stream<TxTestReq>     &siRDp_TxCountReq,
+        stream<SockLkpReq>    &siTSh_SockReq,
+        stream<SockLkpRep>    &soTSh_SockRep,
+        stream<TxTestReq>     &soWRp_TxBytesReq,
         stream<SessionId>     &soWRp_TxSessId,
         stream<TcpAppOpnReq>  &soSHL_OpnReq,
         stream<TcpAppOpnRep>  &siSHL_OpnRep,
-        stream<TcpAppClsReq>  &soSHL_ClsReq)
+        stream<TcpAppClsReq>  &soSLc_ClsReq,
+        stream<SessionId>     &siSLc_ClsSig,
+        stream<ConnEvent>     &soDBG_OpnEvent)
 {
     //-- DIRECTIVES FOR THIS PROCESS -------------------------------------------
     #pragma HLS INLINE off
@@ -140,108 +204,411 @@ void pConnect(
 
     const char *myName  = concat3(THIS_NAME, "/", "COn");
 
+  #ifndef __SYNTHESIS__
+    const ConnTime cOpnTimeout =    250;  // Deadline of an open request (in cycles)
+    const ConnTime cOpnBackoff =     50;  // Backoff before the 2nd attempt (in cycles)
+    const ConnTime cOpnHoldOff =   5000;  // Hold-off of a socket which failed to open (in cycles)
+  #else
+    const ConnTime cOpnTimeout =  10000;
+    const ConnTime cOpnBackoff =   1000;
+    const ConnTime cOpnHoldOff = 1000000;
+  #endif
+    const ConnTime cOpnExpiry  = 4 * cOpnTimeout;  // Lifetime of a timed out attempt
+
+    //-- STATIC ARRAYS (Connection table) --------------------------------------
+    static ConnState           CON_STATE[cConTblEntries];
+    #pragma HLS ARRAY_PARTITION variable=CON_STATE complete dim=1
+    #pragma HLS reset           variable=CON_STATE
+    static SockAddr            CON_SOCK[cConTblEntries];
+    #pragma HLS ARRAY_PARTITION variable=CON_SOCK  complete dim=1
+    static SessionId           CON_SESS[cConTblEntries];
+    #pragma HLS ARRAY_PARTITION variable=CON_SESS  complete dim=1
+    static TxTestLen           CON_TXREQ[cConTblEntries];
+    #pragma HLS ARRAY_PARTITION variable=CON_TXREQ complete dim=1
+    static ap_uint<16>         CON_TXRPT[cConTblEntries];
+    #pragma HLS ARRAY_PARTITION variable=CON_TXRPT complete dim=1
+    static ap_uint<8>          CON_TRIES[cConTblEntries];
+    #pragma HLS ARRAY_PARTITION variable=CON_TRIES complete dim=1
+    static ConnTime            CON_TIME[cConTblEntries];   // Earliest time of the next attempt (or end of hold-off)
+    #pragma HLS ARRAY_PARTITION variable=CON_TIME  complete dim=1
+
+    //-- STATIC ARRAYS (Requests of [TSh] waiting for their connection) --------
+    static bool                SND_WAIT[cTShLookups];
+    #pragma HLS ARRAY_PARTITION variable=SND_WAIT  complete dim=1
+    #pragma HLS reset           variable=SND_WAIT
+    static ConnIdx             SND_IDX[cTShLookups];
+    #pragma HLS ARRAY_PARTITION variable=SND_IDX   complete dim=1
+    static SockAddr            SND_SOCK[cTShLookups];
+    #pragma HLS ARRAY_PARTITION variable=SND_SOCK  complete dim=1
+
+    //-- STATIC ARRAYS (Open requests in flight - Entry [0] is the oldest) -----
+    static ConnIdx             OPN_IDX[cConMaxOpnReqs];
+    #pragma HLS ARRAY_PARTITION variable=OPN_IDX   complete dim=1
+    static SockAddr            OPN_SOCK[cConMaxOpnReqs];
+    #pragma HLS ARRAY_PARTITION variable=OPN_SOCK  complete dim=1
+    static ConnTime            OPN_DEADLINE[cConMaxOpnReqs];
+    #pragma HLS ARRAY_PARTITION variable=OPN_DEADLINE complete dim=1
+    static bool                OPN_STALE[cConMaxOpnReqs];  // The attempt has timed out (deadline is its expiry)
+    #pragma HLS ARRAY_PARTITION variable=OPN_STALE complete dim=1
+
     //-- STATIC CONTROL VARIABLES (with RESET) --------------------------------
-    static enum FsmStates{ CON_IDLE, CON_RD_RDp,  CON_WR_WRp,    \
-                                     CON_OPN_REQ, CON_OPN_REP } \
-                               con_fsmState=CON_IDLE;
-    #pragma HLS reset variable=con_fsmState
-    static SockAddr            con_testSockAddr;
-    #pragma HLS reset variable=con_testSockAddr
+    static ap_uint<log2Ceil<cConMaxOpnReqs>::val+1> con_nrOpnReqs=0;
+    #pragma HLS reset                      variable=con_nrOpnReqs
+    static bool                con_reqVal=false;
+    #pragma HLS reset variable=con_reqVal
+    static bool                con_sndVal=false;   // A request of [TSh] is pending
+    #pragma HLS reset variable=con_sndVal
+    static ConnTime            con_clock=0;
+    #pragma HLS reset variable=con_clock
 
     //-- STATIC DATAFLOW VARIABLES --------------------------------------------
-    static TcpAppOpnRep  con_opnRep;
-    static Ly4Len        con_txBytesReq;
-    static ap_uint< 12>  con_watchDogTimer;
+    static SockAddr            con_reqSock;
+    static TxTestReq           con_txReq;
+    static SockLkpReq          con_sndReq;
+
+    //-- DYNAMIC VARIABLES -----------------------------------------------------
+    TcpAppOpnRep    opnRep;
+    bool            hit       = false;
+    bool            avail     = false;
+    bool            due       = false;
+    bool            expired   = false;
+    bool            lost      = false;
+    bool            held      = false;
+    bool            release   = false;
+    bool            failed    = false;
+    ConnIdx         hitIdx    = 0;
+    ConnIdx         availIdx  = 0;
+    ConnIdx         dueIdx    = 0;
+    ConnIdx         failIdx   = 0;
+    SockLkpTag      relTag    = 0;
+    ap_uint<log2Ceil<cConMaxOpnReqs>::val> expIdx = 0;
+
+    if (*piSHL_Enable != 1) {
+        if (!siSHL_OpnRep.empty()) {
+            // Drain any potential status data
+            siSHL_OpnRep.read(opnRep);
+            printWarn(myName, "Draining unexpected residue from the \'OpnRep\' stream. As a result, request to close sessionId=%d.\n", opnRep.sessId.to_uint());
+            soSLc_ClsReq.write(opnRep.sessId);
+        }
+        for (int i=0; i<cConTblEntries; i++) {
+            #pragma HLS UNROLL
+            CON_STATE[i] = CONN_FREE;
+        }
+        for (int t=0; t<cTShLookups; t++) {
+            #pragma HLS UNROLL
+            SND_WAIT[t] = false;
+        }
+        con_nrOpnReqs = 0;
+        con_reqVal    = false;
+        con_sndVal    = false;
+        return;
+    }
+
+    con_clock++;
+
+    //-- Free the entries whose hold-off is over
+    for (int i=0; i<cConTblEntries; i++) {
+        #pragma HLS UNROLL
+        if ((CON_STATE[i] == CONN_FAILED) and ((ap_int<24>)(CON_TIME[i] - con_clock) <= 0)) {
+            CON_STATE[i] = CONN_FREE;
+        }
+    }
+
+    //-- Fetch a new request from [RDp]
+    if (!con_reqVal and !siRDp_OpnSockReq.empty() and !siRDp_TxCountReq.empty()) {
+        siRDp_OpnSockReq.read(con_reqSock);
+        siRDp_TxCountReq.read(con_txReq);
+        con_reqVal = true;
+    }
+    //-- Fetch a new request from [TSh]
+    if (!con_sndVal and !siTSh_SockReq.empty()) {
+        siTSh_SockReq.read(con_sndReq);
+        con_sndVal = true;
+    }
+
+    //-- Look for the oldest attempt which timed out
+    for (int i=cConMaxOpnReqs-1; i>=0; i--) {
+        #pragma HLS UNROLL
+        if ((i < con_nrOpnReqs) and !OPN_STALE[i] and
+            ((ap_int<24>)(OPN_DEADLINE[i] - con_clock) <= 0)) {
+            expired = true;
+            expIdx  = i;
+        }
+        if ((i < con_nrOpnReqs) and OPN_STALE[i]) {
+            held = true;
+        }
+    }
+    //-- Check if the oldest attempt is lost (the slots expire in order)
+    if ((con_nrOpnReqs != 0) and OPN_STALE[0] and
+        ((ap_int<24>)(OPN_DEADLINE[0] - con_clock) <= 0)) {
+        lost = true;
+    }
+    //-- Look for a request of [TSh] whose connection is established or given up
+    for (int t=cTShLookups-1; t>=0; t--) {
+        #pragma HLS UNROLL
+        if (SND_WAIT[t] and ((CON_STATE[SND_IDX[t]] == CONN_OPENED) or
+                             (CON_STATE[SND_IDX[t]] == CONN_FAILED) or
+                             (CON_STATE[SND_IDX[t]] == CONN_FREE)   or
+                             (CON_SOCK[SND_IDX[t]]  != SND_SOCK[t]))) {
+            release = true;
+            relTag  = t;
+        }
+    }
+    //-- Look for a connection which is due for an attempt
+    for (int i=0; i<cConTblEntries; i++) {
+        #pragma HLS UNROLL
+        if ((CON_STATE[i] == CONN_WAITING) and ((ap_int<24>)(CON_TIME[i] - con_clock) <= 0)) {
+            due    = true;
+            dueIdx = i;
+        }
+    }
 
-    switch (con_fsmState) {
-    case CON_IDLE:
-        if (*piSHL_Enable != 1) {
-            if (!siSHL_OpnRep.empty()) {
-                // Drain any potential status data
-                siSHL_OpnRep.read(con_opnRep);
-                printWarn(myName, "Draining unexpected residue from the \'OpnRep\' stream. As a result, request to close sessionId=%d.\n", con_opnRep.sessId.to_uint());
-                soSHL_ClsReq.write(con_opnRep.sessId);
+    if (!siSHL_OpnRep.empty() and (con_nrOpnReqs == 0)) {
+        //-- A reply without a request in flight
+        siSHL_OpnRep.read(opnRep);
+        printWarn(myName, "Received an unexpected open reply. As a result, request to close sessionId=%d.\n", opnRep.sessId.to_uint());
+        soSLc_ClsReq.write(opnRep.sessId);
+    }
+    else if (!siSHL_OpnRep.empty() and !soWRp_TxBytesReq.full() and !soWRp_TxSessId.full() and
+             !soDBG_OpnEvent.full() and !soSLc_ClsReq.full()) {
+        //-- Match the reply with the oldest open request in flight
+        siSHL_OpnRep.read(opnRep);
+        ConnIdx  idx   = OPN_IDX[0];
+        SockAddr sock  = OPN_SOCK[0];
+        bool     stale = OPN_STALE[0];
+        for (int i=0; i<cConMaxOpnReqs-1; i++) {
+            #pragma HLS UNROLL
+            OPN_IDX[i]      = OPN_IDX[i+1];
+            OPN_SOCK[i]     = OPN_SOCK[i+1];
+            OPN_DEADLINE[i] = OPN_DEADLINE[i+1];
+            OPN_STALE[i]    = OPN_STALE[i+1];
+        }
+        con_nrOpnReqs -= 1;
+        bool adopt = stale and (CON_STATE[idx] == CONN_WAITING) and (CON_SOCK[idx] == sock);
+        if ((opnRep.tcpState == ESTABLISHED) and (!stale or adopt)) {
+            CON_STATE[idx] = CONN_OPENED;
+            CON_SESS[idx]  = opnRep.sessId;
+            soDBG_OpnEvent.write(ConnEvent(sock, opnRep.sessId, CONN_EVT_OPENED, CON_TRIES[idx]));
+            if (DEBUG_LEVEL & TRACE_CON) {
+                printInfo(myName, "Client successfully established connection (SessId=%d) with remote socket:\n",
+                          opnRep.sessId.to_uint());
+                printSockAddr(myName, sock);
+            }
+            if (CON_TXREQ[idx] != 0) {
+                //-- Request [WRp] to start the deferred xmit test
+                soWRp_TxBytesReq.write(TxTestReq(CON_TXREQ[idx], CON_TXRPT[idx]));
+                soWRp_TxSessId.write(opnRep.sessId);
+                CON_TXREQ[idx] = 0;
             }
         }
-        else {
-            con_fsmState = CON_RD_RDp;
+        else if (opnRep.tcpState == ESTABLISHED) {
+            //-- A late connection which is not wanted anymore
+            soSLc_ClsReq.write(opnRep.sessId);
+            if (DEBUG_LEVEL & TRACE_CON) {
+                printInfo(myName, "Closing the late connection (SessId=%d) of a timed out attempt.\n",
+                          opnRep.sessId.to_uint());
+            }
         }
-        break;
-    case CON_RD_RDp:
-        if (!siRDp_OpnSockReq.empty() and !siRDp_TxCountReq.empty()) {
-            siRDp_TxCountReq.read(con_txBytesReq);
-            SockAddr currSockAddr = siRDp_OpnSockReq.read();
-            if (con_txBytesReq == 0) {
-                con_fsmState = CON_OPN_REQ;
-                con_testSockAddr = currSockAddr;
+        else if (!stale) {
+            failed  = true;
+            failIdx = idx;
+            if (DEBUG_LEVEL & TRACE_CON) {
+                printInfo(myName, "Client failed to establish connection with remote socket (TCP state is '%s'):\n",
+                          getTcpStateName(opnRep.tcpState));
+                printSockAddr(myName, sock);
+            }
+        }
+    }
+    else if (expired and !soDBG_OpnEvent.full()) {
+        //-- Give up waiting for this attempt, but keep its slot until its reply
+        OPN_STALE[expIdx]    = true;
+        OPN_DEADLINE[expIdx] = con_clock + cOpnExpiry;
+        failed  = true;
+        failIdx = OPN_IDX[expIdx];
+        if (DEBUG_LEVEL & TRACE_CON) {
+            printInfo(myName, "Timeout: Failed to establish connection with remote socket:\n");
+            printSockAddr(myName, OPN_SOCK[expIdx]);
+        }
+    }
+    else if (lost) {
+        //-- Free the slot of an attempt which was never answered
+        SockAddr sock = OPN_SOCK[0];
+        for (int i=0; i<cConMaxOpnReqs-1; i++) {
+            #pragma HLS UNROLL
+            OPN_IDX[i]      = OPN_IDX[i+1];
+            OPN_SOCK[i]     = OPN_SOCK[i+1];
+            OPN_DEADLINE[i] = OPN_DEADLINE[i+1];
+            OPN_STALE[i]    = OPN_STALE[i+1];
+        }
+        con_nrOpnReqs -= 1;
+        printWarn(myName, "The open request to the following remote socket was never answered:\n");
+        printSockAddr(myName, sock);
+    }
+    else if (!siSLc_ClsSig.empty()) {
+        //-- Free the entry of a session reclaimed by [SLc]
+        SessionId clsSess = siSLc_ClsSig.read();
+        for (int i=0; i<cConTblEntries; i++) {
+            #pragma HLS UNROLL
+            if ((CON_STATE[i] == CONN_OPENED) and (CON_SESS[i] == clsSess)) {
+                CON_STATE[i] = CONN_FREE;
                 if (DEBUG_LEVEL & TRACE_CON) {
-                    printInfo(myName, "Client is requesting to connect to new remote socket:\n");
-                              printSockAddr(myName, con_testSockAddr);
+                    printInfo(myName, "Freeing the entry of the closed session #%d.\n", clsSess.to_uint());
                 }
             }
-            else if (currSockAddr == con_testSockAddr) {
-                con_fsmState = CON_WR_WRp;
-                if (DEBUG_LEVEL & TRACE_CON) {
-                    printInfo(myName, "Client is requesting the FPGA to send %d bytes to the last opened socket:\n", con_txBytesReq.to_uint());
-                              printSockAddr(myName, currSockAddr);
+        }
+    }
+    else if (release and !soTSh_SockRep.full()) {
+        //-- Release a request of [TSh] which waited for its connection
+        ConnIdx idx  = SND_IDX[relTag];
+        bool    sent = (CON_STATE[idx] == CONN_OPENED) and (CON_SOCK[idx] == SND_SOCK[relTag]);
+        soTSh_SockRep.write(SockLkpRep(relTag, CON_SESS[idx], sent));
+        SND_WAIT[relTag] = false;
+    }
+    else if (due and !held and (con_nrOpnReqs < cConMaxOpnReqs) and !soSHL_OpnReq.full()) {
+        //-- Issue a new attempt
+        soSHL_OpnReq.write(CON_SOCK[dueIdx]);
+        CON_STATE[dueIdx]             = CONN_OPENING;
+        CON_TRIES[dueIdx]            += 1;
+        OPN_IDX[con_nrOpnReqs]        = dueIdx;
+        OPN_SOCK[con_nrOpnReqs]       = CON_SOCK[dueIdx];
+        OPN_DEADLINE[con_nrOpnReqs]   = con_clock + cOpnTimeout;
+        OPN_STALE[con_nrOpnReqs]      = false;
+        con_nrOpnReqs += 1;
+        if (DEBUG_LEVEL & TRACE_CON) {
+            printInfo(myName, "Client is requesting to connect to remote socket (attempt #%d):\n",
+                      CON_TRIES[dueIdx].to_uint());
+            printSockAddr(myName, CON_SOCK[dueIdx]);
+        }
+    }
+    else if (con_reqVal or con_sndVal) {
+        //-- Look up the connection table (the request of [TSh] first)
+        bool     isSnd   = con_sndVal;
+        SockAddr lkpSock = (isSnd) ? con_sndReq.sockAddr : con_reqSock;
+        for (int i=0; i<cConTblEntries; i++) {
+            #pragma HLS UNROLL
+            if ((CON_STATE[i] != CONN_FREE) and (CON_SOCK[i] == lkpSock)) {
+                hit    = true;
+                hitIdx = i;
+            }
+            if (CON_STATE[i] == CONN_FREE) {
+                avail    = true;
+                availIdx = i;
+            }
+        }
+        ap_uint<49> txSum = CON_TXREQ[hitIdx] + con_txReq.length;
+        if (isSnd) {
+            if (hit and (CON_STATE[hitIdx] == CONN_OPENED)) {
+                if (!soTSh_SockRep.full()) {
+                    soTSh_SockRep.write(SockLkpRep(con_sndReq.tag, CON_SESS[hitIdx], true));
+                    con_sndVal = false;
+                }
+            }
+            else if (hit and (CON_STATE[hitIdx] == CONN_FAILED)) {
+                //-- Fail right away during the hold-off of this socket
+                if (!soTSh_SockRep.full()) {
+                    soTSh_SockRep.write(SockLkpRep(con_sndReq.tag, 0, false));
+                    con_sndVal = false;
+                }
+            }
+            else if (hit) {
+                //-- Park the request until its connection is opened
+                SND_WAIT[con_sndReq.tag] = true;
+                SND_IDX[con_sndReq.tag]  = hitIdx;
+                SND_SOCK[con_sndReq.tag] = con_sndReq.sockAddr;
+                con_sndVal = false;
+            }
+            else if (!avail) {
+                if (!soTSh_SockRep.full()) {
+                    soTSh_SockRep.write(SockLkpRep(con_sndReq.tag, 0, false));
+                    con_sndVal = false;
+                    printError(myName, "Connection table is full. Cannot send to remote socket:\n");
+                    printSockAddr(myName, con_sndReq.sockAddr);
                 }
             }
             else {
-                con_fsmState = CON_RD_RDp;
-                printInfo(myName, "Client is requesting the FPGA to send traffic to a none opened connection:\n");
-                printSockAddr(myName, currSockAddr);
-                printFatal(myName, "Error.\n");
+                //-- Open a new connection and park the request until it is opened
+                CON_STATE[availIdx] = CONN_WAITING;
+                CON_SOCK[availIdx]  = con_sndReq.sockAddr;
+                CON_TXREQ[availIdx] = 0;
+                CON_TXRPT[availIdx] = 0;
+                CON_TRIES[availIdx] = 0;
+                CON_TIME[availIdx]  = con_clock;
+                SND_WAIT[con_sndReq.tag] = true;
+                SND_IDX[con_sndReq.tag]  = availIdx;
+                SND_SOCK[con_sndReq.tag] = con_sndReq.sockAddr;
+                con_sndVal = false;
             }
         }
-        break;
-    case CON_OPN_REQ:
-        if (!soSHL_OpnReq.full()) {
-            soSHL_OpnReq.write(con_testSockAddr);
-            #ifndef __SYNTHESIS__
-                con_watchDogTimer = 250;
-            #else
-                con_watchDogTimer = 10000;
-            #endif
-            con_fsmState = CON_OPN_REP;
+        else if (hit and (CON_STATE[hitIdx] == CONN_FAILED)) {
+            con_reqVal = false;
+            printWarn(myName, "Cannot connect to a remote socket which failed to open. Retry later:\n");
+            printSockAddr(myName, con_reqSock);
         }
-        break;
-    case CON_OPN_REP:
-        con_watchDogTimer--;
-        if (!siSHL_OpnRep.empty()) {
-            // Read the reply stream
-            siSHL_OpnRep.read(con_opnRep);
-            if (con_opnRep.tcpState == ESTABLISHED) {
+        else if (hit and (con_txReq.length == 0)) {
+            con_reqVal = false;
+            if (DEBUG_LEVEL & TRACE_CON) {
+                printInfo(myName, "Client is requesting to connect to an already known remote socket:\n");
+                printSockAddr(myName, con_reqSock);
+            }
+        }
+        else if (hit and (CON_STATE[hitIdx] == CONN_OPENED)) {
+            if (!soWRp_TxBytesReq.full() and !soWRp_TxSessId.full()) {
+                //-- Request [WRp] to start the xmit test
+                soWRp_TxBytesReq.write(con_txReq);
+                soWRp_TxSessId.write(CON_SESS[hitIdx]);
+                con_reqVal = false;
                 if (DEBUG_LEVEL & TRACE_CON) {
-                    printInfo(myName, "Client successfully established connection.\n");
+                    printInfo(myName, "Client is requesting the FPGA to send %d times %ld bytes to the opened socket:\n",
+                              con_txReq.repeat.to_uint(), (unsigned long)con_txReq.length.to_uint64());
+                    printSockAddr(myName, con_reqSock);
                 }
             }
-            else {
-                 printError(myName, "Client failed to establish connection with remote socket (TCP state is '%s'):\n",
-                            getTcpStateName(con_opnRep.tcpState));
+        }
+        else if (hit) {
+            //-- The connection is not yet established. Defer the xmit test.
+            if (CON_TXREQ[hitIdx] == 0) {
+                CON_TXREQ[hitIdx] = con_txReq.length;
+                CON_TXRPT[hitIdx] = con_txReq.repeat;
+                con_reqVal = false;
             }
-            con_fsmState = CON_IDLE;
+            else if ((CON_TXRPT[hitIdx] == 1) and (con_txReq.repeat == 1) and !txSum[48]) {
+                CON_TXREQ[hitIdx] = txSum;
+                con_reqVal = false;
+            }
+        }
+        else if (!avail) {
+            con_reqVal = false;
+            printError(myName, "Connection table is full. Cannot connect to remote socket:\n");
+            printSockAddr(myName, con_reqSock);
         }
         else {
-            if (con_watchDogTimer == 0) {
-                if (DEBUG_LEVEL & TRACE_CON) {
-                    printError(myName, "Timeout: Failed to establish connection.\n");
-                }
-                #ifndef __SYNTHESIS__
-                  con_watchDogTimer = 250;
-                #else
-                  con_watchDogTimer = 10000;
-                #endif
-            }
+            CON_STATE[availIdx] = CONN_WAITING;
+            CON_SOCK[availIdx]  = con_reqSock;
+            CON_TXREQ[availIdx] = con_txReq.length;
+            CON_TXRPT[availIdx] = con_txReq.repeat;
+            CON_TRIES[availIdx] = 0;
+            CON_TIME[availIdx]  = con_clock;
+            con_reqVal = false;
         }
-        break;
-    case CON_WR_WRp:
-        if(!soWRp_TxBytesReq.full() and !soWRp_TxSessId.full()) {
-            //-- Request [WRp] to start the xmit test
-            soWRp_TxBytesReq.write(con_txBytesReq);
-            soWRp_TxSessId.write(con_opnRep.sessId);
-            con_fsmState = CON_IDLE;
+    }
+
+    //-- Schedule a new attempt with an exponential backoff, or give up
+    if (failed) {
+        if (CON_TRIES[failIdx] < cConMaxTries) {
+            CON_STATE[failIdx] = CONN_WAITING;
+            CON_TIME[failIdx]  = con_clock + (cOpnBackoff << (CON_TRIES[failIdx] - 1));
+            soDBG_OpnEvent.write(ConnEvent(CON_SOCK[failIdx], 0, CONN_EVT_RETRY, CON_TRIES[failIdx]));
+        }
+        else {
+            //-- Hold off this socket (the requests of [TSh] which wait for it are failed)
+            CON_STATE[failIdx] = CONN_FAILED;
+            CON_TIME[failIdx]  = con_clock + cOpnHoldOff;
+            CON_TXREQ[failIdx] = 0;
+            soDBG_OpnEvent.write(ConnEvent(CON_SOCK[failIdx], 0, CONN_EVT_FAILED, CON_TRIES[failIdx]));
+            printError(myName, "Client gave up connecting to remote socket after %d attempts:\n",
+                       CON_TRIES[failIdx].to_uint());
+            printSockAddr(myName, CON_SOCK[failIdx]);
         }
-        break;
     }
 }
 
@@ -249,15 +616,26 @@ void pConnect(
  * @brief Listen(LSn)
  *
  * @param[in]  piSHL_Enable  Enable signal from [SHELL].
+ * @param[in]  siMCh_PortCfg An entry of the listen port table from MmioConfigHandler (MCh).
  * @param[out] soSHL_LsnReq  Listen port request to [SHELL].
  * @param[in]  siSHL_LsnRep  Listen port reply from [SHELL].
  *
- * @warning
+ * @details
  *  This process requests the SHELL/NTS/TOE to start listening for incoming
- *   connections on a specific port (.i.e, open connection in server mode).
- *  By default, the port numbers 5001, 5201, 8800 to 8803 will always be opened
- *   in listen mode at startup. Later on, we should be able to open more ports
- *   if we provide some configuration register for the user to specify new ones.
+ *   connections on the ports of a run-time programmable listen port table
+ *   (.i.e, open connections in server mode). By default, the entries [0:5] of
+ *   the table hold the port numbers 8800 to 8803, 5001 and 5201, and will be
+ *   opened in listen mode at startup.
+ *  The table can be updated via MMIO (see 'CFG_LSN_PORT') while traffic is
+ *   running. Every enabled entry which is not yet listening is opened, one
+ *   request at a time and in round-robin order, such that a port which is
+ *   denied by the TOE does not prevent the other entries from being opened.
+ *
+ * @warning
+ *  The TOE does not support to stop listening on a port. Disabling an entry
+ *   only removes the port from the table, the TOE keeps accepting connections
+ *   on that port until it is reset. Use the port action table to sink the
+ *   traffic of a retired port (see 'CFG_PORT_ACTION').
  *  FYI - The PortTable (PRt) of the SHELL/NTS/TOE supports two port ranges; one
  *   for static ports (0 to 32,767) which are used for listening ports, and one
  *   for dynamically assigned or ephemeral ports (32,768 to 65,535) which are
@@ -266,6 +644,7 @@ void pConnect(
  *******************************************************************************/
 void pListen(
         CmdBit                *piSHL_Enable,
+        stream<LsnPortCfg>    &siMCh_PortCfg,
         stream<TcpAppLsnReq>  &soSHL_LsnReq,
         stream<TcpAppLsnRep>  &siSHL_LsnRep)
 {
@@ -275,62 +654,72 @@ void pListen(
 
     const char *myName = concat3(THIS_NAME, "/", "LSn");
 
+    //-- STATIC ARRAYS (Listen port table) -------------------------------------
+    static TcpPort             LSN_PORT[cLsnPortEntries] = {
+        RECV_MODE_LSN_PORT, XMIT_MODE_LSN_PORT, ECHO_MOD2_LSN_PORT,
+        ECHO_MODE_LSN_PORT, IPERF_LSN_PORT,     IPREF3_LSN_PORT };
+    #pragma HLS ARRAY_PARTITION variable=LSN_PORT complete dim=1
+    #pragma HLS reset           variable=LSN_PORT
+    static bool                LSN_ENA[cLsnPortEntries] = {
+        true, true, true, true, true, true };
+    #pragma HLS ARRAY_PARTITION variable=LSN_ENA  complete dim=1
+    #pragma HLS reset           variable=LSN_ENA
+    static bool                LSN_OPEN[cLsnPortEntries];  // The TOE listens on this entry
+    #pragma HLS ARRAY_PARTITION variable=LSN_OPEN complete dim=1
+    #pragma HLS reset           variable=LSN_OPEN
+
     //-- STATIC CONTROL VARIABLES (with RESET) ---------------------------------
-    static enum FsmStates { LSN_IDLE, LSN_SEND_REQ, LSN_WAIT_REP, LSN_DONE } \
+    static enum FsmStates { LSN_IDLE, LSN_SEND_REQ, LSN_WAIT_REP } \
                                lsn_fsmState=LSN_IDLE;
     #pragma HLS reset variable=lsn_fsmState
-    static ap_uint<3>          lsn_i = 0;
+    static LsnPortIdx          lsn_i = cLsnPortEntries-1;  // The last entry served
     #pragma HLS reset variable=lsn_i
 
-    //-- STATIC ARRAYS --------------------------------------------------------
-    static const TcpPort LSN_PORT_TABLE[6] = { RECV_MODE_LSN_PORT, XMIT_MODE_LSN_PORT,
-                                               ECHO_MOD2_LSN_PORT, ECHO_MODE_LSN_PORT,
-                                               IPERF_LSN_PORT,     IPREF3_LSN_PORT };
-    #pragma HLS RESOURCE variable=LSN_PORT_TABLE core=ROM_1P
-
     //-- STATIC DATAFLOW VARIABLES ---------------------------------------------
+    static TcpPort     lsn_port;  // The port of the pending listen request
     static ap_uint<8>  lsn_watchDogTimer;
 
+    //-- DYNAMIC VARIABLES -----------------------------------------------------
+    bool        found = false;
+    bool        isListening = false;
+    LsnPortIdx  nextIdx = 0;
+
     switch (lsn_fsmState) {
     case LSN_IDLE:
-        if (*piSHL_Enable != 1) {
-            return;
-        }
-        else {
-            if (lsn_i == 0) {
-                lsn_fsmState = LSN_SEND_REQ;
+        if (*piSHL_Enable == 1) {
+            //-- Search the next enabled entry which is not listening yet
+            for (int k=1; k<=cLsnPortEntries; ++k) {
+                #pragma HLS UNROLL
+                LsnPortIdx idx = lsn_i + k;
+                if (!found and LSN_ENA[idx] and !LSN_OPEN[idx]) {
+                    found   = true;
+                    nextIdx = idx;
+                }
             }
-            else {
-                //-- Port are already opened
-                lsn_fsmState = LSN_DONE;
+            if (found) {
+                lsn_i    = nextIdx;
+                lsn_port = LSN_PORT[nextIdx];
+                lsn_fsmState = LSN_SEND_REQ;
             }
         }
         break;
     case LSN_SEND_REQ:
-        if (!soSHL_LsnReq.full()) {
-            switch (lsn_i) {
-            case 0:
-                soSHL_LsnReq.write(RECV_MODE_LSN_PORT);
-                break;
-            case 1:
-                soSHL_LsnReq.write(XMIT_MODE_LSN_PORT);
-                break;
-            case 2:
-                soSHL_LsnReq.write(ECHO_MOD2_LSN_PORT);
-                break;
-            case 3:
-                soSHL_LsnReq.write(ECHO_MODE_LSN_PORT);
-                break;
-            case 4:
-                soSHL_LsnReq.write(IPERF_LSN_PORT);
-                break;
-            case 5:
-                soSHL_LsnReq.write(IPREF3_LSN_PORT);
-                break;
+        //-- Do not request a port which is already listening via another entry
+        for (int k=0; k<cLsnPortEntries; ++k) {
+            #pragma HLS UNROLL
+            if (LSN_OPEN[k] and (LSN_PORT[k] == lsn_port)) {
+                isListening = true;
             }
+        }
+        if (isListening) {
+            LSN_OPEN[lsn_i] = true;
+            lsn_fsmState = LSN_IDLE;
+        }
+        else if (!soSHL_LsnReq.full()) {
+            soSHL_LsnReq.write(lsn_port);
             if (DEBUG_LEVEL & TRACE_LSN) {
                 printInfo(myName, "Server is requested to listen on port #%d (0x%4.4X).\n",
-                          LSN_PORT_TABLE[lsn_i].to_uint(), LSN_PORT_TABLE[lsn_i].to_uint());
+                          lsn_port.to_uint(), lsn_port.to_uint());
             }
             #ifndef __SYNTHESIS__
                 lsn_watchDogTimer = 10;
@@ -350,36 +739,380 @@ void pListen(
             siSHL_LsnRep.read(listenDone);
             if (listenDone) {
                 if (DEBUG_LEVEL & TRACE_LSN) {
-                    printInfo(myName, "Received OK listen reply from [TOE] for port %d.\n", LSN_PORT_TABLE[lsn_i].to_uint());
+                    printInfo(myName, "Received OK listen reply from [TOE] for port %d.\n", lsn_port.to_uint());
                 }
-                if (lsn_i == sizeof(LSN_PORT_TABLE)/sizeof(LSN_PORT_TABLE[0])-1) {
-                    lsn_fsmState = LSN_DONE;
-                }
-                else {
-                    //-- Set next listen port number
-                    lsn_i += 1;
-                    lsn_fsmState = LSN_SEND_REQ;
+                //-- The entry may have been reprogrammed in the mean time
+                if (LSN_ENA[lsn_i] and (LSN_PORT[lsn_i] == lsn_port)) {
+                    LSN_OPEN[lsn_i] = true;
                 }
             }
             else {
                 printWarn(myName, "TOE denied listening on port %d (0x%4.4X).\n",
-                          LSN_PORT_TABLE[lsn_i].to_uint(), LSN_PORT_TABLE[lsn_i].to_uint());
-                lsn_fsmState = LSN_SEND_REQ;
+                          lsn_port.to_uint(), lsn_port.to_uint());
             }
+            lsn_fsmState = LSN_IDLE;
         }
         else {
             if (lsn_watchDogTimer == 0) {
                 printError(myName, "Timeout: Server failed to listen on port %d (0x%4.4X).\n",
-                        LSN_PORT_TABLE[lsn_i].to_uint(), LSN_PORT_TABLE[lsn_i].to_uint());
-                lsn_fsmState = LSN_SEND_REQ;
+                           lsn_port.to_uint(), lsn_port.to_uint());
+                lsn_fsmState = LSN_IDLE;
             }
         }
         break;
-    case LSN_DONE:
-        break;
     }  // End-of: switch()
+
+    //-- Update the listen port table (takes precedence over the FSM)
+    if (!siMCh_PortCfg.empty()) {
+        LsnPortCfg portCfg = siMCh_PortCfg.read();
+        if ((portCfg.enable != LSN_ENA[portCfg.index]) or (portCfg.port != LSN_PORT[portCfg.index])) {
+            LSN_OPEN[portCfg.index] = false;
+        }
+        LSN_ENA[portCfg.index]  = portCfg.enable;
+        LSN_PORT[portCfg.index] = portCfg.port;
+        if (DEBUG_LEVEL & TRACE_LSN) {
+            printInfo(myName, "%s listen port entry #%d (Port=%d).\n",
+                      (portCfg.enable ? "Enabling" : "Disabling"),
+                      portCfg.index.to_uint(), portCfg.port.to_uint());
+        }
+    }
 }  // End-of: pListen()
 
+/*******************************************************************************
+ * @brief Session Lifecycle (SLc)
+ *
+ * @param[in]  piSHL_Enable  Enable signal from [SHELL].
+ * @param[in]  siMCh_IdleTmo The idle timeout of the sessions from MmioConfigHandler (MCh).
+ * @param[in]  siSHL_Notif   A new Rx data notification from [SHELL].
+ * @param[out] soRRh_Notif   The Rx data notification to ReadRequestHandler (RRh).
+ * @param[in]  siWRp_TxAct   The session of a send reply from WritePath (WRp).
+ * @param[in]  siCOn_ClsReq  A close connection request from Connect (COn).
+ * @param[out] soRRh_ClrReq  Request to clear the interrupt table entry of a session to [RRh].
+ * @param[out] soCOn_ClsSig  Signals the close of a session to [COn].
+ * @param[out] soSHL_ClsReq  Close connection request to [SHELL].
+ *
+ * @details
+ *  This process keeps track of the last Rx and Tx activity of every session
+ *   and reclaims the sessions which remain idle. The Rx notifications of
+ *   [SHELL] are passed through this process on their way to [RRh], and the
+ *   [WRp] reports the session of every send reply it receives. Every such
+ *   event marks its session as active and stamps it with the current time
+ *   (see 'SlcTime'). The Rx notifications have priority and a Tx event is
+ *   only taken in a cycle without notification.
+ *  The table of timestamps is swept at a rate of one session per cycle. An
+ *   active session which has been idle for more than the timeout programmed
+ *   via 'CFG_IDLE_TIMEOUT' is closed, its entry of the interrupt table is
+ *   cleared by [RRh] and its entry of the connection table (if any) is freed
+ *   by [COn]. A timeout of zero disables the reclamation (default).
+ *  This process is the only issuer of close requests to [SHELL]. The close
+ *   requests of [COn] are forwarded first, and even while the interface is
+ *   disabled.
+ *
+ * @warning
+ *  The TOE does not report the sessions closed by the remote end. Such a
+ *   session is also reclaimed by the idle timeout, at the expense of a close
+ *   request for a session which is already closed.
+ *******************************************************************************/
+void pSessionLifecycle(
+        CmdBit                *piSHL_Enable,
+        stream<SlcTime>       &siMCh_IdleTmo,
+        stream<TcpAppNotif>   &siSHL_Notif,
+        stream<TcpAppNotif>   &soRRh_Notif,
+        stream<SessionId>     &siWRp_TxAct,
+        stream<TcpAppClsReq>  &siCOn_ClsReq,
+        stream<SessionId>     &soRRh_ClrReq,
+        stream<SessionId>     &soCOn_ClsSig,
+        stream<TcpAppClsReq>  &soSHL_ClsReq)
+{
+    //-- DIRECTIVES FOR THIS PROCESS -------------------------------------------
+    #pragma HLS INLINE off
+    #pragma HLS PIPELINE II=1 enable_flush
+
+    const char *myName  = concat3(THIS_NAME, "/", "SLc");
+
+  #ifndef __SYNTHESIS__
+    const ap_uint<18> cSlcTickCycles =     16;  // Length of a tick (in cycles)
+  #else
+    const ap_uint<18> cSlcTickCycles = 156250;  // 1 ms at 156.25 MHz
+  #endif
+
+    //-- STATIC ARRAYS ---------------------------------------------------------
+    static SlcTime                            LAST_ACT[cMaxSessions];
+    #pragma HLS RESOURCE             variable=LAST_ACT core=RAM_2P
+    #pragma HLS DEPENDENCE           variable=LAST_ACT inter false
+
+    //-- STATIC CONTROL VARIABLES (with RESET) ---------------------------------
+    static ap_uint<cMaxSessions> slc_active=0;   // The session has seen some activity
+    #pragma HLS reset variable=slc_active
+    static SlcTime             slc_idleTmo=0;    // 0 = disabled
+    #pragma HLS reset variable=slc_idleTmo
+    static SlcTime             slc_now=0;
+    #pragma HLS reset variable=slc_now
+    static ap_uint<18>         slc_tickCnt=0;
+    #pragma HLS reset variable=slc_tickCnt
+    static ap_uint<log2Ceil<cMaxSessions>::val> slc_sweep=0;
+    #pragma HLS reset                  variable=slc_sweep
+    static bool                slc_fwdVal=false;
+    #pragma HLS reset variable=slc_fwdVal
+
+    //-- STATIC DATAFLOW VARIABLES (Write-Forwarding Register) -----------------
+    static SessionId           slc_fwdSess;
+
+    //-- DYNAMIC VARIABLES -----------------------------------------------------
+    bool        actVal  = false;
+    SessionId   actSess = 0;
+    bool        clsFwd  = false;
+
+    //-- Forward the close requests of [COn]
+    if (!siCOn_ClsReq.empty() and !soSHL_ClsReq.full()) {
+        soSHL_ClsReq.write(siCOn_ClsReq.read());
+        clsFwd = true;
+    }
+
+    //-- Pass the Rx notifications through (and stamp their session)
+    if (!siSHL_Notif.empty() and !soRRh_Notif.full()) {
+        TcpAppNotif notif = siSHL_Notif.read();
+        soRRh_Notif.write(notif);
+        actVal  = true;
+        actSess = notif.sessionID;
+    }
+    else if (!siWRp_TxAct.empty()) {
+        actSess = siWRp_TxAct.read();
+        actVal  = true;
+    }
+
+    if (*piSHL_Enable != 1) {
+        slc_active = 0;
+        slc_fwdVal = false;
+        return;
+    }
+
+    if (!siMCh_IdleTmo.empty()) {
+        siMCh_IdleTmo.read(slc_idleTmo);
+    }
+
+    //-- Sweep the sessions and close the one which timed out (if any)
+    SessionId sessId = slc_sweep;
+    bool      recent = (actVal and (actSess == sessId)) or (slc_fwdVal and (slc_fwdSess == sessId));
+    SlcTime   idle   = slc_now - LAST_ACT[sessId];
+    if ((slc_idleTmo != 0) and slc_active[sessId] and !recent and (idle >= slc_idleTmo)) {
+        if (!clsFwd and !soSHL_ClsReq.full() and !soRRh_ClrReq.full() and !soCOn_ClsSig.full()) {
+            soSHL_ClsReq.write(sessId);
+            soRRh_ClrReq.write(sessId);
+            soCOn_ClsSig.write(sessId);
+            slc_active[sessId] = 0;
+            slc_sweep += 1;
+            if (DEBUG_LEVEL & TRACE_SLC) {
+                printInfo(myName, "Closing session #%d after %d ticks of inactivity.\n",
+                          sessId.to_uint(), idle.to_uint());
+            }
+        }
+    }
+    else {
+        slc_sweep += 1;
+    }
+
+    //-- Stamp the session of the current activity
+    if (actVal) {
+        LAST_ACT[actSess] = slc_now;
+        slc_active[actSess] = 1;
+    }
+    slc_fwdVal  = actVal;
+    slc_fwdSess = actSess;
+
+    //-- Advance the coarse time
+    if (slc_tickCnt == cSlcTickCycles-1) {
+        slc_tickCnt = 0;
+        slc_now    += 1;
+    }
+    else {
+        slc_tickCnt += 1;
+    }
+}
+
+/*******************************************************************************
+ * @brief MMIO Configuration Handler (MCh)
+ *
+ * @param[in]  siSHL_CfgCmd  A configuration command from [SHELL/MMIO].
+ * @param[out] soRRh_Quantum The DRR quantum of a session to ReadRequestHandler (RRh).
+ * @param[out] soRRh_PortAct An entry of the port action table to [RRh].
+ * @param[out] soLSn_PortCfg An entry of the listen port table to Listen (LSn).
+ * @param[out] soWRp_SegLen  The length of the Tx segments to WritePath (WRp).
+ * @param[out] soWRp_GenCfg  A setting of the Tx traffic generator to [WRp].
+ * @param[out] soRDp_StatReq A read-out request of the sink statistics to ReadPath (RDp).
+ * @param[out] soSLc_IdleTmo The idle timeout of the sessions to SessionLifecycle (SLc).
+ * @param[out] soRCo_CoaCfg  A setting of the Rx coalescing to RxCoalescer (RCo).
+ *
+ * @details
+ *  This process decodes the configuration commands written by the MMIO
+ *   register path and dispatches them to the process which owns the targeted
+ *   table. Commands with an unknown table-id, an out-of-range index or an
+ *   invalid value are dropped. A read-out of the sink statistics is passed on
+ *   to [RDp] which answers it on the MMIO statistics interface.
+ *  An entry of the port action table is programmed in two steps, by setting
+ *   its port range first ('CFG_PORT_RANGE') and its action next
+ *   ('CFG_PORT_ACTION'). The action of an entry must be set to 'PA_NONE'
+ *   before its port range is modified.
+ *******************************************************************************/
+void pMmioConfigHandler(
+        stream<MmioCfgCmd>    &siSHL_CfgCmd,
+        stream<RxQuantumCfg>  &soRRh_Quantum,
+        stream<PortActCfg>    &soRRh_PortAct,
+        stream<LsnPortCfg>    &soLSn_PortCfg,
+        stream<TcpDatLen>     &soWRp_SegLen,
+        stream<TxGenCfg>      &soWRp_GenCfg,
+        stream<ap_uint<16> >  &soRDp_StatReq,
+        stream<SlcTime>       &soSLc_IdleTmo,
+        stream<RxCoaCfg>      &soRCo_CoaCfg)
+{
+    //-- DIRECTIVES FOR THIS PROCESS -------------------------------------------
+    #pragma HLS INLINE off
+    #pragma HLS PIPELINE II=1 enable_flush
+
+    const char *myName = concat3(THIS_NAME, "/", "MCh");
+
+    if (!siSHL_CfgCmd.empty() and !soRRh_Quantum.full() and !soRRh_PortAct.full() and
+        !soLSn_PortCfg.full() and !soWRp_SegLen.full() and !soWRp_GenCfg.full() and
+        !soRDp_StatReq.full() and !soSLc_IdleTmo.full() and !soRCo_CoaCfg.full()) {
+        MmioCfgCmd cfgCmd = siSHL_CfgCmd.read();
+        PortAction action = (PortAction)cfgCmd.value(7,0).to_uint();
+        ap_uint<8> pipeId = cfgCmd.value(15,8);
+        switch (cfgCmd.tblId) {
+        case CFG_RX_QUANTUM:
+            if (cfgCmd.index >= cMaxSessions) {
+                printWarn(myName, "Session #%d is out of range. Rx quantum is ignored.\n",
+                          cfgCmd.index.to_uint());
+            }
+            else if (cfgCmd.value > 0xFFFF) {
+                printWarn(myName, "Invalid Rx quantum (%d bytes) for session #%d. Rx quantum is ignored.\n",
+                          cfgCmd.value.to_uint(), cfgCmd.index.to_uint());
+            }
+            else {
+                soRRh_Quantum.write(RxQuantumCfg(cfgCmd.index, cfgCmd.value(15,0)));
+                if (DEBUG_LEVEL & TRACE_MCH) {
+                    printInfo(myName, "Setting the Rx quantum of session #%d to %d bytes.\n",
+                              cfgCmd.index.to_uint(), cfgCmd.value.to_uint());
+                }
+            }
+            break;
+        case CFG_PORT_RANGE:
+            if (cfgCmd.index < cPortActEntries) {
+                soRRh_PortAct.write(PortActCfg(cfgCmd.index, true,
+                                    PortActEntry(cfgCmd.value(15,0), cfgCmd.value(31,16), PA_NONE, 0)));
+                if (DEBUG_LEVEL & TRACE_MCH) {
+                    printInfo(myName, "Setting the port range of action entry #%d to [%d:%d].\n",
+                              cfgCmd.index.to_uint(), cfgCmd.value(15,0).to_uint(), cfgCmd.value(31,16).to_uint());
+                }
+            }
+            else {
+                printWarn(myName, "Port action entry #%d is out of range. Port range is ignored.\n",
+                          cfgCmd.index.to_uint());
+            }
+            break;
+        case CFG_PORT_ACTION:
+            if (cfgCmd.index >= cPortActEntries) {
+                printWarn(myName, "Port action entry #%d is out of range. Action is ignored.\n",
+                          cfgCmd.index.to_uint());
+            }
+            else if ((cfgCmd.value(7,0) > PA_IPERF3) or ((action == PA_FWD) and (pipeId >= cNrFwdPipes))) {
+                printWarn(myName, "Invalid action (Action=%d, PipeId=%d) for port action entry #%d. Action is ignored.\n",
+                          cfgCmd.value(7,0).to_uint(), pipeId.to_uint(), cfgCmd.index.to_uint());
+            }
+            else {
+                soRRh_PortAct.write(PortActCfg(cfgCmd.index, false,
+                                    PortActEntry(0, 0, action, pipeId)));
+                if (DEBUG_LEVEL & TRACE_MCH) {
+                    printInfo(myName, "Setting the action of port action entry #%d to %d (PipeId=%d).\n",
+                              cfgCmd.index.to_uint(), action, pipeId.to_uint());
+                }
+            }
+            break;
+        case CFG_LSN_PORT:
+            if (cfgCmd.index >= cLsnPortEntries) {
+                printWarn(myName, "Listen port entry #%d is out of range. Listen port is ignored.\n",
+                          cfgCmd.index.to_uint());
+            }
+            else if (cfgCmd.value[16] and cfgCmd.value[15]) {
+                printWarn(myName, "Listen port %d is not a static port. Listen port entry #%d is ignored.\n",
+                          cfgCmd.value(15,0).to_uint(), cfgCmd.index.to_uint());
+            }
+            else {
+                soLSn_PortCfg.write(LsnPortCfg(cfgCmd.index, cfgCmd.value[16], cfgCmd.value(15,0)));
+                if (DEBUG_LEVEL & TRACE_MCH) {
+                    printInfo(myName, "Setting listen port entry #%d to port %d (Enable=%d).\n",
+                              cfgCmd.index.to_uint(), cfgCmd.value(15,0).to_uint(), cfgCmd.value(16,16).to_uint());
+                }
+            }
+            break;
+        case CFG_TX_SEG_LEN:
+            if ((cfgCmd.value == 0) or (cfgCmd.value > cRtySlotChunks*(ARW/8)) or
+                (cfgCmd.value % (ARW/8) != 0)) {
+                printWarn(myName, "Invalid Tx segment length (%d bytes). Tx segment length is ignored.\n",
+                          cfgCmd.value.to_uint());
+            }
+            else {
+                soWRp_SegLen.write(cfgCmd.value(15,0));
+                if (DEBUG_LEVEL & TRACE_MCH) {
+                    printInfo(myName, "Setting the Tx segment length to %d bytes.\n", cfgCmd.value.to_uint());
+                }
+            }
+            break;
+        case CFG_TX_GEN:
+            if ((cfgCmd.index > GEN_CFG_RATE) or
+                ((cfgCmd.index == GEN_CFG_RATE) and (cfgCmd.value > ((ARW/8) << 8)))) {
+                printWarn(myName, "Invalid Tx generator setting #%d (Value=0x%8.8X). Setting is ignored.\n",
+                          cfgCmd.index.to_uint(), cfgCmd.value.to_uint());
+            }
+            else {
+                soWRp_GenCfg.write(TxGenCfg((GenCfgField)cfgCmd.index.to_uint(), cfgCmd.value));
+                if (DEBUG_LEVEL & TRACE_MCH) {
+                    printInfo(myName, "Setting the Tx generator setting #%d to 0x%8.8X.\n",
+                              cfgCmd.index.to_uint(), cfgCmd.value.to_uint());
+                }
+            }
+            break;
+        case CFG_SINK_STATS:
+            if ((cfgCmd.index < cMaxSessions) or (cfgCmd.index == cSinkStatsAll)) {
+                soRDp_StatReq.write(cfgCmd.index);
+                if (DEBUG_LEVEL & TRACE_MCH) {
+                    printInfo(myName, "Reading out the sink statistics of entry #%d.\n",
+                              cfgCmd.index.to_uint());
+                }
+            }
+            else {
+                printWarn(myName, "Session #%d is out of range. Read-out of the sink statistics is ignored.\n",
+                          cfgCmd.index.to_uint());
+            }
+            break;
+        case CFG_IDLE_TIMEOUT:
+            soSLc_IdleTmo.write(cfgCmd.value);
+            if (DEBUG_LEVEL & TRACE_MCH) {
+                printInfo(myName, "Setting the idle timeout of the sessions to %d ticks.\n",
+                          cfgCmd.value.to_uint());
+            }
+            break;
+        case CFG_RX_COALESCE:
+            if ((cfgCmd.index > COA_CFG_TIMEOUT) or (cfgCmd.value > 0xFFFF) or
+                ((cfgCmd.index == COA_CFG_BYTES) and (cfgCmd.value > cRcoMaxBytes))) {
+                printWarn(myName, "Invalid Rx coalescing setting #%d (Value=%d). Setting is ignored.\n",
+                          cfgCmd.index.to_uint(), cfgCmd.value.to_uint());
+            }
+            else {
+                soRCo_CoaCfg.write(RxCoaCfg((CoaCfgField)cfgCmd.index.to_uint(), cfgCmd.value(15,0)));
+                if (DEBUG_LEVEL & TRACE_MCH) {
+                    printInfo(myName, "Setting the Rx coalescing setting #%d to %d.\n",
+                              cfgCmd.index.to_uint(), cfgCmd.value.to_uint());
+                }
+            }
+            break;
+        default:
+            printWarn(myName, "Unknown configuration table #%d. Command is ignored.\n",
+                      cfgCmd.tblId.to_uint());
+            break;
+        }
+    }
+}
+
 #if defined USE_INTERRUPTS
 /*******************************************************************************
  * @brief Input Read Buffer (IRb)
@@ -387,25 +1120,25 @@ void pListen(
  * @param[in]  piSHL_Enable  Enable signal from [SHELL].
  * @param[in]  siSHL_Data    Data stream from [SHELL].
  * @param[in]  siSHL_Meta    Session Id from [SHELL].
- * @param[out] soRRh_EnquSig Signals the enqueue of a new chunk to ReadRequestHandler (RRh).
- * @param[out] soRDp_Data    Data stream to ReadPath (RDp).
- * @param[out] soRDp_Meta    Metadata stream [RDp].
+ * @param[out] soRRh_EnquSig Signals the byte count of an enqueued chunk to ReadRequestHandler (RRh).
+ * @param[out] soRbp_Data    Data stream to RxBufferPool (Rbp).
+ * @param[out] soRbp_Meta    Metadata stream [Rbp].
  *
  * @details
- *  This process counts and enqueues the incoming data segments and their meta-
- *  data into two FIFOs. The goal is to provision a buffer to store all the
- *  bytes that were requested from the TCP Rx buffer by the ReadRequestHandler
- *  (RRh) process. If this process does not absorb the incoming data stream fast
- *  enough, the [TOE] will start dropping segments on his side to avoid any
- *  blocking situation.
+ *  This process counts the incoming data chunks and passes them on, together
+ *  with the metadata of their segment, to the RxBufferPool (Rbp). The goal is
+ *  to provision a buffer to store all the bytes that were requested from the
+ *  TCP Rx buffer by the ReadRequestHandler (RRh) process. If this process does
+ *  not absorb the incoming data stream fast enough, the [TOE] will start
+ *  dropping segments on his side to avoid any blocking situation.
  *******************************************************************************/
 void pInputReadBuffer(
         CmdBit              *piSHL_Enable,
         stream<TcpAppData>  &siSHL_Data,
         stream<TcpAppMeta>  &siSHL_Meta,
-        stream<SigBit>      &soRRh_EnquSig,
-        stream<TcpAppData>  &soRDp_Data,
-        stream<TcpAppMeta>  &soRDp_Meta)
+        stream<ChunkBytes>  &soRRh_EnquSig,
+        stream<TcpAppData>  &soRbp_Data,
+        stream<TcpAppMeta>  &soRbp_Meta)
 {
     //-- DIRECTIVES FOR THIS PROCESS -------------------------------------------
     #pragma HLS INLINE off
@@ -424,16 +1157,16 @@ void pInputReadBuffer(
 
     switch (irb_fsmState ) {
     case IRB_IDLE:
-        if (!siSHL_Meta.empty() and !soRDp_Meta.full()) {
-            soRDp_Meta.write(siSHL_Meta.read());
+        if (!siSHL_Meta.empty() and !soRbp_Meta.full()) {
+            soRbp_Meta.write(siSHL_Meta.read());
             irb_fsmState = IRB_STREAM;
         }
         break;
     case IRB_STREAM:
-        if (!siSHL_Data.empty() and !soRDp_Data.full() and !soRRh_EnquSig.full()) {
+        if (!siSHL_Data.empty() and !soRbp_Data.full() and !soRRh_EnquSig.full()) {
             TcpAppData currChunk = siSHL_Data.read();
-            soRDp_Data.write(currChunk);
-            soRRh_EnquSig.write(1);
+            soRbp_Data.write(currChunk);
+            soRRh_EnquSig.write(currChunk.getLen());
             if (currChunk.getTLast()) {
                 irb_fsmState = IRB_IDLE;
             }
@@ -446,14 +1179,26 @@ void pInputReadBuffer(
  * @brief Rx Buffer Occupancy (Rxb) -
  *   Keeps track of the occupancy of the input read buffer.
  *
- * @param[in]  siEnqueueSig Signals the enqueue of a chunk in the buffer.
- * @param[in]  siEnqueueSig Signals the dequeue of a chunk from the buffer.
- * @param[out] soFreeSpace  The available space in the input buffer (in bytes).
+ * @param[in]  siEnqueueSig    Signals the byte count of a chunk enqueued in the buffer.
+ * @param[in]  siDequeueSig    Signals the dequeue of a chunk from the buffer.
+ * @param[out] soRit_Release   Releases the bytes of a dequeued chunk to the RxInterruptTable (Rit).
+ * @param[out] soRxs_Release   Releases the chunk of a session to the RxScheduler (Rxs).
+ * @param[out] soDBG_FreeSpace The available space in the input buffer (for debug).
+ *
+ * @details
+ *  The space of the input buffer is reserved by [Rit] upon the grant of a data
+ *   request, and this process gives it back every time a chunk is dequeued.
+ *   Both the reservation and the release are accounted in bytes, as given by
+ *   the 'tkeep' field of the chunk. An enqueue and a dequeue can occur in the
+ *   same cycle. The occupancy maintained here reflects the number of bytes
+ *   which are physically stored in the buffer and is only used for debugging.
  *******************************************************************************/
 void pRxBufferOccupancy(
-        stream<SigBit>                                 &siEnqueueSig,
-        stream<SigBit>                                 &siDequeueSig,
-        stream<ap_uint<log2Ceil<cIBuffBytes>::val+1> > &soFreeSpace)
+        stream<ChunkBytes>                             &siEnqueueSig,
+        stream<RxDequSig>                              &siDequeueSig,
+        stream<ChunkBytes>                             &soRit_Release,
+        stream<RxDequSig>                              &soRxs_Release,
+        stream<ap_uint<16> >                           &soDBG_FreeSpace)
 {
     //-- DIRECTIVES FOR THIS PROCESS -------------------------------------------
     #pragma HLS INLINE off
@@ -464,27 +1209,29 @@ void pRxBufferOccupancy(
     static ap_uint<log2Ceil<cIBuffBytes>::val+1>  rrh_freeSpace=cIBuffBytes;
     #pragma HLS reset                    variable=rrh_freeSpace
 
-    bool traceInc = false;
-    bool traceDec = false;
+    bool       traceInc = false;
+    bool       traceDec = false;
+    ChunkBytes incBytes = 0;
+    ChunkBytes decBytes = 0;
 
-    if (!siEnqueueSig.empty() and siDequeueSig.empty()) {
-        siEnqueueSig.read();
-        rrh_freeSpace -= (ARW/8);
-        traceInc = true;
-    } else if (siEnqueueSig.empty() and !siDequeueSig.empty()) {
-        siDequeueSig.read();
-        rrh_freeSpace += (ARW/8);
-        traceDec = true;
-    } else if (!siEnqueueSig.empty() and !siDequeueSig.empty()) {
-        siEnqueueSig.read();
-        siDequeueSig.read();
+    if (!siEnqueueSig.empty()) {
+        incBytes = siEnqueueSig.read();
         traceInc = true;
+    }
+    if (!siDequeueSig.empty() and !soRit_Release.full() and !soRxs_Release.full()) {
+        RxDequSig dequSig = siDequeueSig.read();
+        soRxs_Release.write(dequSig);
+        soRit_Release.write(dequSig.byteCnt);
+        decBytes = dequSig.byteCnt;
         traceDec = true;
     }
+    rrh_freeSpace = rrh_freeSpace + decBytes - incBytes;
     //-- Always
-    soFreeSpace.write(rrh_freeSpace);
+    if (!soDBG_FreeSpace.full()) {
+        soDBG_FreeSpace.write(rrh_freeSpace);
+    }
 
-    if (DEBUG_LEVEL & TRACE_RRH_IBO) {
+    if (DEBUG_LEVEL & TRACE_RRH) {
         if (traceInc or traceDec) {
             printInfo(myName, "Input buffer occupancy = %d bytes (%c|%c)\n",
                      (cIBuffBytes - rrh_freeSpace.to_uint()),
@@ -494,20 +1241,23 @@ void pRxBufferOccupancy(
 }
 
 /*******************************************************************************
- * @brief Post a new notification into the Rx interrupt table.
+ * @brief Post a new notification into the Rx interrupt table (Rpn).
  *
- * @param[in]  siSHL_Notif    A new Rx data notification from [SHELL].
- * @param[out] soRit_InterruptQry  Interrupt query to RxInterruptTable(Rit).
- * @param[in]  siRit_InterruptRep  Interrupt reply from [Rit].
- * @param[out] soRst_SessId   Session Id to RxSchedulerRequest(Rsr).
+ * @param[in]  siSHL_Notif         A new Rx data notification from [SHELL].
+ * @param[out] soRit_InterruptQry  Interrupt query to RxInterruptTable (Rit).
  *
  * @details
- *  This 'POST' process reads the incoming notification from the shell and
- *   updates the Rx interrupt table accordingly. The interrupt table is used
- *   to keep track of the TCP destination port and the total amount of pending
- *   bytes for a given session.
- *  After that, the session Id of the incoming notification is forwarded to the
- *   RxSchedulerRequest (Rsr).
+ *  This process reads the incoming notifications from the shell and forwards
+ *   them as 'POST' queries to the Rx interrupt table. The read-modify-write of
+ *   the table entry is performed by [Rit] itself, which allows this process to
+ *   accept one notification per clock cycle.
+ *  The notifications are first collected into a small content-addressable
+ *   coalescing queue of 'cRpnCamEntries' entries. A notification whose session
+ *   already has an entry in that queue is merged into it, while the others are
+ *   appended at its tail. The head entry is posted to [Rit] whenever the table
+ *   can accept a query. Therefore, back-to-back notifications for the same
+ *   session end up in a single update of the table, and a burst of
+ *   notifications which targets a few sessions is absorbed while [Rit] is busy.
  *
  * @warning
  *  The incoming notification is only added to the interrupt table when the TCP
@@ -515,80 +1265,144 @@ void pRxBufferOccupancy(
  *******************************************************************************/
 void pRxPostNotification(
         stream<TcpAppNotif>     &siSHL_Notif,
-        stream<InterruptQuery>  &soRit_InterruptQry,
-        stream<InterruptEntry>  &siRit_InterruptRep,
-        stream<SessionId>       &soRsr_SessId)
+        stream<InterruptQuery>  &soRit_InterruptQry)
 {
     //-- DIRECTIVES FOR THIS PROCESS -------------------------------------------
     #pragma HLS INLINE off
     #pragma HLS PIPELINE II=1 enable_flush
 
-    const char *myName  = concat3(THIS_NAME, "/", "RRh/Rxp");
+    const char *myName  = concat3(THIS_NAME, "/", "RRh/Rpn");
+
+    //-- STATIC ARRAYS (Coalescing CAM - Entry [0] is the head) ----------------
+    static SessionId                 CAM_SESS[cRpnCamEntries];
+    #pragma HLS ARRAY_PARTITION variable=CAM_SESS  complete dim=1
+    static TcpDatLen                 CAM_BYTES[cRpnCamEntries];
+    #pragma HLS ARRAY_PARTITION variable=CAM_BYTES complete dim=1
+    static TcpPort                   CAM_PORT[cRpnCamEntries];
+    #pragma HLS ARRAY_PARTITION variable=CAM_PORT  complete dim=1
 
     //-- STATIC VARIABLES W/ RESET ---------------------------------------------
-    static enum PostFsmStates { RPN_IDLE, RPN_INC, RPN_POST } \
-                                  rpn_fsmState=RPN_IDLE;
-    #pragma HLS reset    variable=rpn_fsmState
+    static ap_uint<log2Ceil<cRpnCamEntries>::val+1> rpn_nrEntries=0;
+    #pragma HLS reset                      variable=rpn_nrEntries
 
-    //-- STATIC DATAFLOW VARIABLES ---------------------------------------------
-    static TcpAppNotif     rpn_notif;
-    static TcpDatLen       rpn_newPendingByteCnt;
+    //-- DYNAMIC VARIABLES -----------------------------------------------------
+    TcpAppNotif notif;
+    bool        notifVal = false;
+    bool        hit      = false;
+    ap_uint<log2Ceil<cRpnCamEntries>::val>   hitIdx = 0;
 
     //-- PROCESS FUNCTION ------------------------------------------------------
+    bool popVal = (rpn_nrEntries != 0) and !soRit_InterruptQry.full();
 
-    switch (rpn_fsmState) {
-    case RPN_IDLE:
-        if (!siSHL_Notif.empty() and !soRit_InterruptQry.full()) {
-            rpn_notif = siSHL_Notif.read();
-            if (rpn_notif.tcpDatLen != 0) {
-                InterruptQuery getQuery(rpn_notif.sessionID, GET);
-                soRit_InterruptQry.write(getQuery);
-                rpn_fsmState = RPN_INC;
+    //-- Accept a new notification if an entry is (or is about to become) free
+    if (!siSHL_Notif.empty() and ((rpn_nrEntries < cRpnCamEntries) or popVal)) {
+        siSHL_Notif.read(notif);
+        notifVal = (notif.tcpDatLen != 0);
+    }
+
+    //-- Merge it into the entry of its session (unless the byte count wraps)
+    if (notifVal) {
+        for (int i=0; i<cRpnCamEntries; i++) {
+            #pragma HLS UNROLL
+            ap_uint<17> sum = CAM_BYTES[i] + notif.tcpDatLen;
+            if ((i < rpn_nrEntries) and (CAM_SESS[i] == notif.sessionID) and !sum[16]) {
+                hit    = true;
+                hitIdx = i;
             }
         }
-        break;
-    case RPN_INC:
-        if (!siRit_InterruptRep.empty()) {
-            InterruptEntry currEntry = siRit_InterruptRep.read();
-            rpn_newPendingByteCnt = currEntry.byteCnt + rpn_notif.tcpDatLen;
-            rpn_fsmState = RPN_POST;
+        if (hit) {
+            CAM_BYTES[hitIdx] += notif.tcpDatLen;
+            CAM_PORT[hitIdx]   = notif.tcpDstPort;
+            if (DEBUG_LEVEL & TRACE_RRH) {
+                printInfo(myName, "Coalescing notif (SessId=%2d, DatLen=%4d) into entry #%d.\n",
+                          notif.sessionID.to_uint(), notif.tcpDatLen.to_uint(), hitIdx.to_uint());
+            }
         }
-        break;
-    case RPN_POST:
-        if (!soRit_InterruptQry.full() and !soRsr_SessId.full()) {
-            InterruptEntry currEntry(rpn_newPendingByteCnt, rpn_notif.tcpDstPort);
-            InterruptQuery postQuery(rpn_notif.sessionID, currEntry);
-            soRit_InterruptQry.write(postQuery);
-            soRsr_SessId.write(rpn_notif.sessionID);
-            rpn_fsmState = RPN_IDLE;
+    }
+
+    //-- Post the head entry and shift the queue
+    if (popVal) {
+        soRit_InterruptQry.write(InterruptQuery(CAM_SESS[0],
+                                 InterruptEntry(CAM_BYTES[0], CAM_PORT[0])));
+        if (DEBUG_LEVEL & TRACE_RRH) {
+            printInfo(myName, "Posting notif (SessId=%2d, DatLen=%4d, DstPort=%4d).\n",
+                      CAM_SESS[0].to_uint(), CAM_BYTES[0].to_uint(), CAM_PORT[0].to_uint());
         }
-        break;
+        for (int i=0; i<cRpnCamEntries-1; i++) {
+            #pragma HLS UNROLL
+            CAM_SESS[i]  = CAM_SESS[i+1];
+            CAM_BYTES[i] = CAM_BYTES[i+1];
+            CAM_PORT[i]  = CAM_PORT[i+1];
+        }
+        rpn_nrEntries -= 1;
+    }
+
+    //-- Append a notification which did not hit at the tail of the queue
+    if (notifVal and !hit) {
+        CAM_SESS[rpn_nrEntries]  = notif.sessionID;
+        CAM_BYTES[rpn_nrEntries] = notif.tcpDatLen;
+        CAM_PORT[rpn_nrEntries]  = notif.tcpDstPort;
+        rpn_nrEntries += 1;
     }
 }
 
 /*******************************************************************************
- * @brief Receive Interrupt Table (Rit).
+ * @brief Rx Interrupt Table (Rit).
  *
  * @param[in]  siRpn_InterruptQry  Interrupt query from RxPostNotification (Rpn).
- * @param[out] soRpn_InterruptRep  Interrupt reply to [Rpn].
- * @param[in]  siRsr_InterruptQry  Interrupt query from RxSchedulerRequest (Rsr).
- * @param[out] soRsr_InterruptRep  Interrupt reply to [Rsr].
+ * @param[in]  siRxs_InterruptQry  Interrupt query from RxScheduler (Rxs).
+ * @param[out] soRxs_InterruptRep  Interrupt reply to [Rxs].
+ * @param[in]  siRxb_Release       Releases the bytes of a chunk dequeued from the RxBuffer (Rxb).
+ * @param[out] soRxh_SetInt        Request to set an interrupt to RxHandler (Rxh).
+ * @param[out] soRxh_ClrInt        Request to clear (or update) an interrupt to [Rxh].
+ * @param[in]  siSLc_ClrReq        Request to clear the entry of a session from SessionLifecycle (SLc).
  *
  * @details
- *  This process implements the interrupt table which keeps track on the number
- *   of pending bytes per session as well as the TCP destination port.
- *  The table is a dual-port RAM with 'POST' writing on one port while 'SCHED'
- *   reads from the other one.
- *  Upon reception of a 'POST' or 'PUT' query, the process also maintains a
- *   bitmap encoded vector that represents the sessions that have pending bytes.
- *   For example, if bitmap[0] is set, it indicates that session #0 has pending
- *   bytes.
+ *  This process implements the interrupt table which keeps track of the number
+ *   of pending bytes per session as well as the TCP destination port. It runs
+ *   with II=1 and serves one 'POST' query from [Rpn] and one 'PUT' query from
+ *   [Rxs] per clock cycle.
+ *  To avoid two writes into the same RAM location, the pending byte count is
+ *   not stored as such but as the difference of two free-running counters:
+ *     - NOTIF_BYTES_A/B[s] : the total number of bytes notified for session 's'
+ *                            (written by 'POST' only, [B] is a replica of [A]
+ *                            which is read by the 'PUT' side).
+ *     - SCHED_BYTES[s]     : the total number of bytes requested for session
+ *                            's' (written by 'PUT' only).
+ *   Every array therefore has a single writer and is mapped onto a simple
+ *   dual-port RAM. The read-after-write hazards between two consecutive
+ *   iterations are resolved with a pair of write-forwarding registers, and a
+ *   'POST' and a 'PUT' that target the same session during the same iteration
+ *   are resolved by bypassing the freshly computed 'POST' value.
+ *  The table also owns the credits of the input read buffer. A 'PUT' is granted
+ *   no more bytes than the buffer can accommodate (or none at all when less
+ *   than 'cMinDataReqLen' bytes are available), and the bytes of the grant are
+ *   reserved right away. They are released chunk by chunk by the RxBuffer (Rxb)
+ *   as they get dequeued by the RxBufferPool (Rbp). The credits are accounted in
+ *   bytes rather than in chunks, such that short and unaligned segments do
+ *   not waste the budget of the buffer. The first session which is refused for
+ *   lack of space is remembered and 'cMinDataReqLen' bytes are held back for it
+ *   until its next query, otherwise the session whose query happens to coincide
+ *   with the release of the buffer space would always win it. Because the 'PUT' queries are
+ *   served in order, the scheduler can keep several of them in flight without
+ *   ever overcommitting the input read buffer.
+ *  Finally, the table signals the RxHandler (Rxh) to set the interrupt of a
+ *   session upon every 'POST', and to clear it when a 'PUT' drains all the
+ *   pending bytes of that session. Both signals carry the number of bytes that
+ *   were added or withdrawn, such that [Rxh] can track the pending bytes.
+ *  The entry of a session reclaimed by [SLc] is cleared by a 'CLR' which is
+ *   served in the iterations without 'PUT'. It discards the pending bytes of
+ *   that session by aligning SCHED_BYTES with NOTIF_BYTES, such that every
+ *   array keeps a single writer.
  *******************************************************************************/
 void pRxInterruptTable(
         stream<InterruptQuery>  &siRpn_InterruptQry,
-        stream<InterruptEntry>  &soRpn_InterruptRep,
-        stream<InterruptQuery>  &siRsr_InterruptQry,
-        stream<InterruptEntry>  &soRsr_InterruptRep)
+        stream<InterruptQuery>  &siRxs_InterruptQry,
+        stream<RxGrant>         &soRxs_InterruptRep,
+        stream<ChunkBytes>      &siRxb_Release,
+        stream<RxIntSig>        &soRxh_SetInt,
+        stream<RxIntSig>        &soRxh_ClrInt,
+        stream<SessionId>       &siSLc_ClrReq)
 {
     //-- DIRECTIVES FOR THIS PROCESS -------------------------------------------
     #pragma HLS INLINE off
@@ -597,29 +1411,55 @@ void pRxInterruptTable(
     const char *myName = concat3(THIS_NAME, "/", "RRh/Rit");
 
     //-- STATIC ARRAYS ---------------------------------------------------------
-    static InterruptEntry                     INTERRUPT_TABLE[cMaxSessions];
-    #pragma HLS RESOURCE             variable=INTERRUPT_TABLE core=RAM_2P
-    #pragma HLS DEPENDENCE           variable=INTERRUPT_TABLE inter false
+    static TcpDatLen                          NOTIF_BYTES_A[cMaxSessions];
+    #pragma HLS RESOURCE             variable=NOTIF_BYTES_A core=RAM_2P
+    #pragma HLS DEPENDENCE           variable=NOTIF_BYTES_A inter false
+    static TcpDatLen                          NOTIF_BYTES_B[cMaxSessions];
+    #pragma HLS RESOURCE             variable=NOTIF_BYTES_B core=RAM_2P
+    #pragma HLS DEPENDENCE           variable=NOTIF_BYTES_B inter false
+    static TcpPort                            DST_PORT[cMaxSessions];
+    #pragma HLS RESOURCE             variable=DST_PORT      core=RAM_2P
+    #pragma HLS DEPENDENCE           variable=DST_PORT      inter false
+    static TcpDatLen                          SCHED_BYTES[cMaxSessions];
+    #pragma HLS RESOURCE             variable=SCHED_BYTES   core=RAM_2P
+    #pragma HLS DEPENDENCE           variable=SCHED_BYTES   inter false
 
     //-- STATIC VARIABLES W/ RESET ---------------------------------------------
     static bool                                 rit_isInit=false;
     #pragma HLS reset                  variable=rit_isInit
     static ap_uint<log2Ceil<cMaxSessions>::val> rit_initEntry=0;
     #pragma HLS reset                  variable=rit_initEntry
+    static bool                                 rit_fwdPostVal=false;
+    #pragma HLS reset                  variable=rit_fwdPostVal
+    static bool                                 rit_fwdPutVal=false;
+    #pragma HLS reset                  variable=rit_fwdPutVal
+    static ap_uint<log2Ceil<cIBuffBytes>::val+1> rit_freeSpace=cIBuffBytes;
+    #pragma HLS reset                  variable=rit_freeSpace
+    static bool                                 rit_waitVal=false;
+    #pragma HLS reset                  variable=rit_waitVal
+
+    //-- STATIC DATAFLOW VARIABLES (Write-Forwarding Registers) ----------------
+    static SessionId       rit_waitSess;  // Session which was refused for lack of space
+    static SessionId       rit_fwdPostSess;
+    static TcpDatLen       rit_fwdPostBytes;
+    static TcpPort         rit_fwdPostPort;
+    static SessionId       rit_fwdPutSess;
+    static TcpDatLen       rit_fwdPutBytes;
 
-    static enum FsmStates { RIT_IDLE, RIT_NOTIF_REQ, RIT_NOTIF_REP, RIT_NOTIF_UPDATE, \
-                                      RIT_SCHED_REQ, RIT_SCHED_REP, RIT_SCHED_UPDATE } rit_fsmState=RIT_IDLE;
-
-    //-- STATIC DATAFLOW VARIABLES ---------------------------------------------
-    static InterruptEntry  rit_notifEntry;
-    static InterruptEntry  rit_schedEntry;
-    static InterruptQuery  rit_notifQuery;
-    static InterruptQuery  rit_schedQuery;
+    //-- DYNAMIC VARIABLES -----------------------------------------------------
+    InterruptQuery  postQry;
+    TcpDatLen       postBytes;
+    bool            postVal = false;
+    bool            putVal  = false;
+    bool            putDrainedPost = false;
 
     //-- PROCESS FUNCTION ------------------------------------------------------
     if (!rit_isInit) {
-        //-- This the table must be cleared upon reset
-        INTERRUPT_TABLE[rit_initEntry] = InterruptEntry(0, 0);
+        //-- The table must be cleared upon reset
+        NOTIF_BYTES_A[rit_initEntry] = 0;
+        NOTIF_BYTES_B[rit_initEntry] = 0;
+        DST_PORT[rit_initEntry]      = 0;
+        SCHED_BYTES[rit_initEntry]   = 0;
         if (rit_initEntry == (cMaxSessions-1)) {
             rit_isInit = true;
             if (DEBUG_LEVEL & TRACE_RRH) {
@@ -628,89 +1468,157 @@ void pRxInterruptTable(
         } else {
             rit_initEntry += 1;
         }
+        return;
     }
-    else {
-        switch (rit_fsmState) {
-            case RIT_IDLE:
-                if (!siRpn_InterruptQry.empty()) {
-                    rit_notifQuery = siRpn_InterruptQry.read();
-                    if (rit_notifQuery.action != GET) {
-                        printFatal(myName, "Expecting a query 'GET' request!\n");
-                    }
-                    rit_fsmState = RIT_NOTIF_REQ;
-                }
-                else if (!siRsr_InterruptQry.empty()) {
-                    rit_schedQuery = siRsr_InterruptQry.read();
-                    if (rit_schedQuery.action != GET) {
-                        printFatal(myName, "Expecting a query 'GET' request!\n");
-                    }
-                    rit_fsmState = RIT_SCHED_REQ;
-                }
-                break;
-            case RIT_NOTIF_REQ:
-                rit_notifEntry = INTERRUPT_TABLE[rit_notifQuery.sessId];
-                rit_fsmState = RIT_NOTIF_REP;
-                break;
-            case RIT_NOTIF_REP:
-                if (!soRpn_InterruptRep.full()) {
-                    soRpn_InterruptRep.write(rit_notifEntry);
-                    rit_fsmState = RIT_NOTIF_UPDATE;
-                }
-                break;
-            case RIT_SCHED_REQ:
-                rit_schedEntry = INTERRUPT_TABLE[rit_schedQuery.sessId];
-                rit_fsmState = RIT_SCHED_REP;
-                break;
-            case RIT_SCHED_REP:
-                if (!soRsr_InterruptRep.full()) {
-                    soRsr_InterruptRep.write(rit_schedEntry);
-                    rit_fsmState = RIT_SCHED_UPDATE;
-                }
-                break;
-            case RIT_NOTIF_UPDATE:
-                if (!siRpn_InterruptQry.empty()) {
-                    InterruptQuery notifQry = siRpn_InterruptQry.read();
-                    if (notifQry.action == POST) {
-                        INTERRUPT_TABLE[notifQry.sessId] = InterruptEntry(notifQry.entry);
-                    }
-                    else if (notifQry.action == PUT) {
-                        INTERRUPT_TABLE[notifQry.sessId].byteCnt = notifQry.entry.byteCnt;
-                    }
-                    else {
-                        printFatal(myName, "Expecting a query 'PUT' or 'PUSH' request!\n");
-                    }
-                    rit_fsmState = RIT_IDLE;
-                }
-                break;
-            case RIT_SCHED_UPDATE:
-                if (!siRsr_InterruptQry.empty()) {
-                    InterruptQuery schedQry = siRsr_InterruptQry.read();
-                    if (schedQry.action == POST) {
-                        INTERRUPT_TABLE[schedQry.sessId] = InterruptEntry(schedQry.entry);
-                    }
-                    else if (schedQry.action == PUT) {
-                        INTERRUPT_TABLE[schedQry.sessId].byteCnt = schedQry.entry.byteCnt;
-                    }
-                    else {
-                        printFatal(myName, "Expecting a query 'PUT' or 'PUSH' request!\n");
-                    }
-                    rit_fsmState = RIT_IDLE;
-                }
-                break;
+
+    //-- Release the bytes of a dequeued chunk
+    if (!siRxb_Release.empty()) {
+        rit_freeSpace += siRxb_Release.read();
+    }
+
+    //-- POST (read-modify-write of NOTIF_BYTES) -------------------------------
+    if (!siRpn_InterruptQry.empty() and !soRxh_SetInt.full()) {
+        siRpn_InterruptQry.read(postQry);
+        TcpDatLen currBytes = (rit_fwdPostVal and (rit_fwdPostSess == postQry.sessId)) ?
+                              rit_fwdPostBytes : NOTIF_BYTES_A[postQry.sessId];
+        postBytes = currBytes + postQry.entry.byteCnt;
+        NOTIF_BYTES_A[postQry.sessId] = postBytes;
+        NOTIF_BYTES_B[postQry.sessId] = postBytes;
+        DST_PORT[postQry.sessId]      = postQry.entry.dstPort;
+        postVal = true;
+    }
+
+    //-- PUT (read-modify-write of SCHED_BYTES) --------------------------------
+    if (!siRxs_InterruptQry.empty() and !soRxs_InterruptRep.full() and !soRxh_ClrInt.full()) {
+        InterruptQuery putQry = siRxs_InterruptQry.read();
+        TcpDatLen notifTot;
+        TcpPort   dstPort;
+        if (postVal and (postQry.sessId == putQry.sessId)) {
+            notifTot = postBytes;
+            dstPort  = postQry.entry.dstPort;
+        }
+        else if (rit_fwdPostVal and (rit_fwdPostSess == putQry.sessId)) {
+            notifTot = rit_fwdPostBytes;
+            dstPort  = rit_fwdPostPort;
+        }
+        else {
+            notifTot = NOTIF_BYTES_B[putQry.sessId];
+            dstPort  = DST_PORT[putQry.sessId];
+        }
+        TcpDatLen schedTot = (rit_fwdPutVal and (rit_fwdPutSess == putQry.sessId)) ?
+                             rit_fwdPutBytes : SCHED_BYTES[putQry.sessId];
+        TcpDatLen pending  = notifTot - schedTot;
+        //-- Keep 'cMinDataReqLen' bytes aside for a session which is waiting for space
+        bool      isWaiter = rit_waitVal and (rit_waitSess == putQry.sessId);
+        TcpDatLen held     = (rit_waitVal and !isWaiter) ? cMinDataReqLen : 0;
+        TcpDatLen avail    = (rit_freeSpace < held) ? 0 : (rit_freeSpace.to_uint() - held);
+        TcpDatLen maxLen   = (avail < cMinDataReqLen) ? (TcpDatLen)0 : avail;
+        if (rit_waitVal and (maxLen > cIBuffBytes/cMaxRxsDataReqs)) {
+            //-- The buffer is contended. Do not let a single session take it all.
+            maxLen = cIBuffBytes/cMaxRxsDataReqs;
+        }
+        if (putQry.entry.byteCnt < maxLen) {
+            maxLen = putQry.entry.byteCnt;
+        }
+        TcpDatLen granted  = (maxLen < pending) ? maxLen : pending;
+        if (!rit_waitVal and (granted == 0) and (pending != 0)) {
+            rit_waitVal  = true;
+            rit_waitSess = putQry.sessId;
+        }
+        else if (isWaiter and (granted != 0)) {
+            rit_waitVal  = false;
+        }
+        SCHED_BYTES[putQry.sessId] = schedTot + granted;
+        //-- Reserve the bytes of the grant in the input buffer
+        rit_freeSpace -= granted;
+        soRxs_InterruptRep.write(RxGrant(granted, dstPort, (granted == pending)));
+        if ((granted != 0) or (granted == pending)) {
+            soRxh_ClrInt.write(RxIntSig(putQry.sessId, granted, (granted == pending)));
+            putDrainedPost = postVal and (postQry.sessId == putQry.sessId) and (granted == pending);
+        }
+        if (DEBUG_LEVEL & TRACE_RRH) {
+            printInfo(myName, "PUT(SessId=%2d) - Pending=%4d - Granted=%4d.\n",
+                      putQry.sessId.to_uint(), pending.to_uint(), granted.to_uint());
+        }
+        rit_fwdPutSess  = putQry.sessId;
+        rit_fwdPutBytes = schedTot + granted;
+        putVal = true;
+    }
+    //-- CLR (write of SCHED_BYTES) --------------------------------------------
+    else if (!siSLc_ClrReq.empty() and !soRxh_ClrInt.full()) {
+        SessionId clrSess = siSLc_ClrReq.read();
+        TcpDatLen notifTot;
+        if (postVal and (postQry.sessId == clrSess)) {
+            notifTot = postBytes;
+        }
+        else if (rit_fwdPostVal and (rit_fwdPostSess == clrSess)) {
+            notifTot = rit_fwdPostBytes;
+        }
+        else {
+            notifTot = NOTIF_BYTES_B[clrSess];
         }
+        TcpDatLen schedTot = (rit_fwdPutVal and (rit_fwdPutSess == clrSess)) ?
+                             rit_fwdPutBytes : SCHED_BYTES[clrSess];
+        TcpDatLen pending  = notifTot - schedTot;
+        SCHED_BYTES[clrSess] = notifTot;
+        if (pending != 0) {
+            soRxh_ClrInt.write(RxIntSig(clrSess, pending, true));
+            putDrainedPost = postVal and (postQry.sessId == clrSess);
+        }
+        if (rit_waitVal and (rit_waitSess == clrSess)) {
+            rit_waitVal = false;
+        }
+        if (DEBUG_LEVEL & TRACE_RRH) {
+            printInfo(myName, "CLR(SessId=%2d) - Pending=%4d.\n",
+                      clrSess.to_uint(), pending.to_uint());
+        }
+        rit_fwdPutSess  = clrSess;
+        rit_fwdPutBytes = notifTot;
+        putVal = true;
+    }
+
+    //-- Raise the interrupt unless the same iteration already drained it
+    if (postVal and !putDrainedPost) {
+        soRxh_SetInt.write(RxIntSig(postQry.sessId, postQry.entry.byteCnt, false));
+    }
+
+    //-- Update the write-forwarding registers
+    rit_fwdPostVal = postVal;
+    if (postVal) {
+        rit_fwdPostSess  = postQry.sessId;
+        rit_fwdPostBytes = postBytes;
+        rit_fwdPostPort  = postQry.entry.dstPort;
     }
+    rit_fwdPutVal = putVal;
 }
 
 /*******************************************************************************
- * @brief Rx Handler (Rxs)
- *  Reads the incoming session Id (w/ II=1) and updates the vector of pending
- *  interrupts.
+ * @brief Rx Handler (Rxh)
+ *
+ * @tparam     Policy           The Rx scheduling policy (see 'TSIF_RX_POLICY').
+ * @param[in]  siRit_SetInt     Request to set an interrupt from RxInterruptTable (Rit).
+ * @param[in]  siRit_ClrInt     Request to clear (or update) an interrupt from [Rit].
+ * @param[in]  siRxs_SessIdReq  Request for a session id from RxScheduler (Rxs).
+ * @param[out] soRxs_SessIdRep  The session id granted to [Rxs].
+ *
+ * @details
+ *  Reads the set/clear interrupt requests (w/ II=1) and updates the vector of
+ *   pending interrupts. Upon request, the next session with a pending
+ *   interrupt is selected as follows:
+ *   - RR/DRR: a round-robin arbiter starts right after the session that was
+ *      granted last (see 'rrArbiter()').
+ *   - SPF: the session with the fewest pending bytes is selected (see
+ *      'minArbiter()'). The pending bytes of every session are maintained
+ *      here from the byte counts carried by the set/clear requests. The
+ *      session granted last is skipped unless it is the only candidate,
+ *      because its query is most likely still in flight.
  *******************************************************************************/
+template<int Policy>
 void pRxHandler(
-        stream<SessionId>              &siRpn_SessId,
+        stream<RxIntSig>               &siRit_SetInt,
+        stream<RxIntSig>               &siRit_ClrInt,
         stream<ReqBit>                 &siRxs_SessIdReq,
-        stream<SessionId>              &soRxs_SessIdRep,
-        stream<SessionId>              &siRxs_ClearInt)
+        stream<SessionId>              &soRxs_SessIdRep)
 {
     //-- DIRECTIVES FOR THIS PROCESS -------------------------------------------
     #pragma HLS INLINE off
@@ -721,50 +1629,80 @@ void pRxHandler(
     //-- STATIC VARIABLES W/ RESET ---------------------------------------------
     static ap_uint<cMaxSessions>    rsr_pendingInterrupts=0;
     #pragma HLS reset      variable=rsr_pendingInterrupts
-    static SessionId                rsr_currSess=0;
-    #pragma HLS reset      variable=rsr_currSess
+    static ap_uint<log2Ceil<cMaxSessions>::val> rsr_currSess=0;
+    #pragma HLS reset                   variable=rsr_currSess
+    static TcpDatLen                rsr_pendingBytes[cMaxSessions];
+    #pragma HLS reset      variable=rsr_pendingBytes
+    #pragma HLS ARRAY_PARTITION variable=rsr_pendingBytes complete
 
     //-- DYNAMIC VARIABLES -----------------------------------------------------
-    ap_uint<log2Ceil<cMaxSessions>::val> nextSess=0;
     ap_uint<cMaxSessions>   setVec=0;
     ap_uint<cMaxSessions>   clrVec=0;
+    RxIntSig                setSig;
+    RxIntSig                clrSig;
+    bool                    setVal=false;
+    bool                    clrVal=false;
 
     //-- Set interrupt ----------------
-    if (!siRpn_SessId.empty()) {
-        SessionId sessId = siRpn_SessId.read();
-        setVec[sessId] = 1;
+    if (!siRit_SetInt.empty()) {
+        setSig = siRit_SetInt.read();
+        setVec[setSig.sessId] = 1;
+        setVal = true;
         if (DEBUG_LEVEL & TRACE_RRH) {
-            printInfo(myName, "Set   interrupt for session #%d.\n", sessId.to_uint());
+            printInfo(myName, "Set   interrupt for session #%d.\n", setSig.sessId.to_uint());
         }
     }
     //-- Clear interrupt --------------
-    if (!siRxs_ClearInt.empty()) {
-        SessionId sessId = siRxs_ClearInt.read();
-        clrVec[sessId] = 1;
+    if (!siRit_ClrInt.empty()) {
+        clrSig = siRit_ClrInt.read();
+        clrVec[clrSig.sessId] = clrSig.clear;
+        clrVal = true;
         if (DEBUG_LEVEL & TRACE_RRH) {
-            printInfo(myName, "Clear interrupt for session #%d.\n", sessId.to_uint());
+            printInfo(myName, "%s interrupt for session #%d.\n",
+                      (clrSig.clear ? "Clear" : "Updt "), clrSig.sessId.to_uint());
         }
     }
     //-- Update interrupt vector ------
-    rsr_pendingInterrupts = (rsr_pendingInterrupts xor clrVec) | setVec;
+    rsr_pendingInterrupts = (rsr_pendingInterrupts & ~clrVec) | setVec;
+
+    if (Policy == RX_POLICY_SPF) {
+        //-- Update the pending bytes (a set wins over a clear, as above)
+        for (int s=0; s<cMaxSessions; s++) {
+            #pragma HLS UNROLL
+            TcpDatLen bytes = rsr_pendingBytes[s];
+            if (clrVal and (clrSig.sessId == s)) {
+                bytes = (clrSig.clear) ? (TcpDatLen)0 : (TcpDatLen)(bytes - clrSig.byteCnt);
+            }
+            if (setVal and (setSig.sessId == s)) {
+                bytes += setSig.byteCnt;
+            }
+            rsr_pendingBytes[s] = bytes;
+        }
+    }
 
     //-- Forward interrupt
-    bool currSessValid = false;
     if (!siRxs_SessIdReq.empty() and !soRxs_SessIdRep.full()) {
-        //-- Round-robin scheduler
-        for (uint8_t i=0; i<cMaxSessions; ++i) {
-            #pragma HLS UNROLL
-            nextSess = rsr_currSess + i + 1;
-            if (rsr_pendingInterrupts[nextSess] == 1) {
-                rsr_currSess = nextSess;
-                currSessValid = true;
+        ap_uint<log2Ceil<cMaxSessions>::val> nextSess;
+        bool granted;
+        if (Policy == RX_POLICY_SPF) {
+            //-- Shortest-pending-first arbiter
+            ap_uint<cMaxSessions> reqVec = rsr_pendingInterrupts;
+            reqVec[rsr_currSess] = 0;
+            if (reqVec == 0) {
+                reqVec = rsr_pendingInterrupts;
             }
+            granted = minArbiter<cMaxSessions>(reqVec, rsr_pendingBytes, nextSess);
+        }
+        else {
+            //-- Round-robin arbiter
+            granted = rrArbiter<cMaxSessions>(rsr_pendingInterrupts, rsr_currSess, nextSess);
         }
-        if (currSessValid == true) {
+        if (granted) {
+            rsr_currSess = nextSess;
             siRxs_SessIdReq.read();
             soRxs_SessIdRep.write(nextSess);
             if (DEBUG_LEVEL & TRACE_RRH) {
-                printInfo(myName, "RR-Arbiter has scheduled session #%d.\n", nextSess.to_uint());
+                printInfo(myName, "Arbiter has scheduled session #%d.\n", nextSess.to_uint());
             }
         }
     }
@@ -773,34 +1711,63 @@ void pRxHandler(
 /*******************************************************************************
  * @brief Rx Scheduler (Rxs)
  *
+ * @tparam     Policy              The Rx scheduling policy (see 'TSIF_RX_POLICY').
+ * @param[in]  siMCh_Quantum       The DRR quantum of a session from MmioConfigHandler (MCh).
+ * @param[in]  siMCh_PortAct       An entry of the port action table from [MCh].
  * @param[out] soRxh_SessIdReq     Request a session id from the RxHandler (Rxh).
  * @param[in]  siRxh_SessIdRep     A session id reply from [Rxh].
- * @param[in]  siRxb_FreeSpace     The available space (in bytes) from the RxBuffer (Rxb).
+ * @param[in]  siRxb_Release       Releases the chunk of a session from the RxBuffer (Rxb).
  * @param[out] soRit_InterruptQry  Interrupt query to RxInterruptTable(Rit).
  * @param[in]  siRit_InterruptRep  Interrupt reply from [Rit].
- * @param[out] soRxh_ClearInt      A request to clear an interrupt to [Rxh].
  * @param[out] soSHL_DReq          An Rx data request to [SHELL].
- * @param[out] soRDp_FwdCmd        A command telling the ReadPath (RDp) to keep/drop a stream.
+ * @param[out] soRbp_FwdCmd        A command telling the RxBufferPool (Rbp) to keep/drop a stream.
  *
  * @detail
- *  This process implements a round-robin scheduler that generates data requests
- *   to TOE based on a bitmap encoded vector that represents the sessions that
- *   have pending bytes to be read. For example, if 'rit_pendingInterrupts[0]'
- *   is set, it indicates that session #0 has pending bytes.
- *  After sending the request to TOE, the pending byte count of the interrupt
- *   table is decreased accordingly.
+ *  This process requests a session with pending bytes from the RxHandler (Rxh)
+ *   and withdraws as many bytes as the input read buffer can accommodate from
+ *   the interrupt table by issuing a 'PUT' query to [Rit].
  *  Next, the scheduler sends a data request to [SHELL] indicating the number of
- *   bytes that it is willing to receive for a given session.
+ *   bytes that were granted by [Rit] for that session.
+ *  The scheduler is implemented as a 3-stage pipeline which runs with II=1 and
+ *   can issue a new data request every clock cycle:
+ *   1) REQ   - Up to 'cMaxRxsQueries' session id requests are kept in flight
+ *              towards [Rxh].
+ *   2) QUERY - A session id reply from [Rxh] is turned into a 'PUT' query to
+ *              [Rit]. The context of the query is pushed into a small ring of
+ *              contexts until its reply comes back. A session which already
+ *              has a query in flight is skipped because its context is not up
+ *              to date yet.
+ *   3) GRANT - A reply from [Rit] is popped together with its context and
+ *              turned into a data request to [SHELL] and a forward command to
+ *              the RxBufferPool (Rbp). Up to 'cMaxRxsDataReqs' data requests
+ *              are kept in flight, such that the bytes notified in the meantime
+ *              are aggregated into larger requests when the Rx path lags behind.
+ *  The space of the input read buffer is reserved by [Rit] when it grants the
+ *   bytes of a query. The reserved and released bytes are also accounted per
+ *   session by this process, which gives the number of bytes every session
+ *   holds in the input read buffer.
+ *  When a session is assigned a non-zero quantum, the scheduler operates in
+ *   deficit round-robin (DRR) mode for that session: the deficit counter of the
+ *   session is credited with its quantum once all the bytes of its previous
+ *   requests have left the input read buffer, and the number of bytes requested
+ *   from [Rit] is capped by that deficit. The deficit is then decreased by the
+ *   number of bytes that were effectively granted, or reset when the session
+ *   has no more pending bytes. This prevents a bulk session from monopolizing
+ *   the input read buffer at the expense of the latency of the short-message
+ *   sessions. With the 'DRR' policy, every session starts with a quantum of
+ *   'cRxDefQuantum' bytes.
  *******************************************************************************/
+template<int Policy>
 void pRxScheduler(
+        stream<RxQuantumCfg>           &siMCh_Quantum,
+        stream<PortActCfg>             &siMCh_PortAct,
         stream<ReqBit>                 &soRxh_SessIdReq,
         stream<SessionId>              &siRxh_SessIdRep,
-        stream<ap_uint<log2Ceil<cIBuffBytes>::val + 1> > &siRxb_FreeSpace,
+        stream<RxDequSig>              &siRxb_Release,
         stream<InterruptQuery>         &soRit_InterruptQry,
-        stream<InterruptEntry>         &siRit_InterruptRep,
-        stream<SessionId>              &soRxh_ClearReq,
+        stream<RxGrant>                &siRit_InterruptRep,
         stream<TcpAppRdReq>            &soSHL_DReq,
-        stream<ForwardCmd>             &soRDp_FwdCmd)
+        stream<ForwardCmd>             &soRbp_FwdCmd)
 {
     //-- DIRECTIVES FOR THIS PROCESS -------------------------------------------
     #pragma HLS INLINE off
@@ -808,119 +1775,230 @@ void pRxScheduler(
 
     const char *myName = concat3(THIS_NAME, "/", "RRh/Rxs");
 
+    //-- STATIC ARRAYS ---------------------------------------------------------
+    static TcpDatLen                             QUANTUM[cMaxSessions];
+    #pragma HLS RESOURCE                variable=QUANTUM core=RAM_2P
+    #pragma HLS DEPENDENCE              variable=QUANTUM inter false
+    static TcpDatLen                             DEFICIT[cMaxSessions];
+    #pragma HLS RESOURCE                variable=DEFICIT core=RAM_2P
+    #pragma HLS DEPENDENCE              variable=DEFICIT inter false
+    //-- Running sums of the bytes reserved and released by every session.
+    //--  The released sums are duplicated to provide one read port to the
+    //--  release logic (A) and one read port to the QUERY stage (B).
+    static TcpDatLen                             RSRV_BYTES[cMaxSessions];
+    #pragma HLS RESOURCE                variable=RSRV_BYTES core=RAM_2P
+    #pragma HLS DEPENDENCE              variable=RSRV_BYTES inter false
+    static TcpDatLen                             RLSD_BYTES_A[cMaxSessions];
+    #pragma HLS RESOURCE                variable=RLSD_BYTES_A core=RAM_2P
+    #pragma HLS DEPENDENCE              variable=RLSD_BYTES_A inter false
+    static TcpDatLen                             RLSD_BYTES_B[cMaxSessions];
+    #pragma HLS RESOURCE                variable=RLSD_BYTES_B core=RAM_2P
+    #pragma HLS DEPENDENCE              variable=RLSD_BYTES_B inter false
+    //-- Ring of the contexts of the queries in flight
+    static RxSchedCtx                            CONTEXT[cMaxRxsQueries];
+    #pragma HLS RESOURCE                variable=CONTEXT core=RAM_2P
+    #pragma HLS DEPENDENCE              variable=CONTEXT inter false
+    #pragma HLS DATA_PACK               variable=CONTEXT
+
     //-- STATIC VARIABLES W/ RESET ---------------------------------------------
-    static enum FsmStates { RSR_SREQ, RSR_SREP, RSR_DEC, RSR_PUT, RSR_FWD } \
-                                                 rsr_fsmState=RSR_SREQ;
-    #pragma HLS reset                   variable=rsr_fsmState
-    static TcpDatLen                             rsr_freeSpace;
-    #pragma HLS reset                   variable=rsr_freeSpace
+    static PortActEntry                          PORT_ACTION[cPortActEntries] = {
+        PortActEntry(RECV_MODE_LSN_PORT, RECV_MODE_LSN_PORT, PA_SINK, 0),
+        PortActEntry(XMIT_MODE_LSN_PORT, XMIT_MODE_LSN_PORT, PA_GEN,  0),
+        PortActEntry(IPERF_LSN_PORT,     IPERF_LSN_PORT,     PA_IPERF2, 0),
+        PortActEntry(IPREF3_LSN_PORT,    IPREF3_LSN_PORT,    PA_IPERF3, 0) };
+    #pragma HLS ARRAY_PARTITION         variable=PORT_ACTION complete dim=1
+    #pragma HLS reset                   variable=PORT_ACTION
+    static bool                                  rsr_isInit=false;
+    #pragma HLS reset                   variable=rsr_isInit
+    static ap_uint<log2Ceil<cMaxSessions>::val>  rsr_initEntry=0;
+    #pragma HLS reset                   variable=rsr_initEntry
+    static bool                                  rsr_relValid=false;
+    #pragma HLS reset                   variable=rsr_relValid
+    static ap_uint<log2Ceil<cMaxRxsQueries>::val+1>  rsr_nrTokens=0;
+    #pragma HLS reset                   variable=rsr_nrTokens
+    static ap_uint<log2Ceil<cMaxRxsQueries>::val>    rsr_ctxWrPtr=0;
+    #pragma HLS reset                   variable=rsr_ctxWrPtr
+    static ap_uint<log2Ceil<cMaxRxsQueries>::val>    rsr_ctxRdPtr=0;
+    #pragma HLS reset                   variable=rsr_ctxRdPtr
+    static ap_uint<log2Ceil<cMaxRxsDataReqs>::val+1> rsr_nrDataReqs=0;
+    #pragma HLS reset                   variable=rsr_nrDataReqs
+    static ap_uint<cMaxSessions>                 rsr_busyVec=0;
+    #pragma HLS reset                   variable=rsr_busyVec
 
     //-- STATIC VARIABLES ------------------------------------------------------
-    static SessionId              rsr_currSess;
-    static InterruptEntry         rsr_intEntry;
-    static TcpDatLen              rsr_datLenReq;
-    static ap_uint<cMaxSessions>  rsr_pendingInterrupts;
+    static SessionId              rsr_relSess;   // Session of the last released chunk
+    static TcpDatLen              rsr_relBytes;  // Released sum of that session
+
+    //-- DYNAMIC VARIABLES -----------------------------------------------------
+    ap_uint<cMaxSessions>         busySet=0;
+    ap_uint<cMaxSessions>         busyClr=0;
+    bool                          tokenTaken=false;
+    ap_uint<2>                    tokensBack=0;
+    bool                          dataReqTaken=false;
+    bool                          dataReqBack=false;
+
+    if (!rsr_isInit) {
+        //-- The quanta, deficits and byte counts must be cleared upon reset
+        QUANTUM[rsr_initEntry]      = (Policy == RX_POLICY_DRR) ? cRxDefQuantum : 0;
+        DEFICIT[rsr_initEntry]      = 0;
+        RSRV_BYTES[rsr_initEntry]   = 0;
+        RLSD_BYTES_A[rsr_initEntry] = 0;
+        RLSD_BYTES_B[rsr_initEntry] = 0;
+        if (rsr_initEntry == (cMaxSessions-1)) {
+            rsr_isInit = true;
+        } else {
+            rsr_initEntry += 1;
+        }
+        return;
+    }
 
-    TcpDatLen                     newByteCnt;
+    //-- Account the release of a dequeued chunk
+    if (!siRxb_Release.empty()) {
+        RxDequSig release = siRxb_Release.read();
+        //-- Forward the last released sum when a session releases back-to-back chunks
+        TcpDatLen relBytes = (rsr_relValid and (release.sessId == rsr_relSess)) ?
+                             rsr_relBytes : RLSD_BYTES_A[release.sessId];
+        relBytes += release.byteCnt;
+        RLSD_BYTES_A[release.sessId] = relBytes;
+        RLSD_BYTES_B[release.sessId] = relBytes;
+        rsr_relSess  = release.sessId;
+        rsr_relBytes = relBytes;
+        rsr_relValid = true;
+        dataReqBack  = release.last;
+    }
 
-    if (!siRxb_FreeSpace.empty()) {
-        rsr_freeSpace = siRxb_FreeSpace.read();
+    if (!siMCh_Quantum.empty()) {
+        RxQuantumCfg quantumCfg = siMCh_Quantum.read();
+        QUANTUM[quantumCfg.sessId] = quantumCfg.quantum;
+        if (DEBUG_LEVEL & TRACE_RRH) {
+            printInfo(myName, "Quantum of session #%d is set to %d bytes.\n",
+                      quantumCfg.sessId.to_uint(), quantumCfg.quantum.to_uint());
+        }
+    }
+    if (!siMCh_PortAct.empty()) {
+        updatePortAction(PORT_ACTION, siMCh_PortAct.read());
     }
 
-    switch(rsr_fsmState) {
-        case RSR_SREQ:
-            if (!soRxh_SessIdReq.full()) {
-                soRxh_SessIdReq.write(1);
-                rsr_fsmState = RSR_SREP;
+    //-- STAGE-3: GRANT --------------------------------------------------------
+    if (!siRit_InterruptRep.empty() and !soSHL_DReq.full() and !soRbp_FwdCmd.full() and
+        (rsr_nrDataReqs < cMaxRxsDataReqs)) {
+        RxGrant    grant = siRit_InterruptRep.read();
+        RxSchedCtx ctx   = CONTEXT[rsr_ctxRdPtr];
+        rsr_ctxRdPtr += 1;
+        if (ctx.quantum != 0) {
+            if (grant.drained) {
+                //-- The session has been drained. Its deficit is not carried over.
+                DEFICIT[ctx.sessId] = 0;
             }
-            break;
-        case RSR_SREP:
-            if (!siRxh_SessIdRep.empty() and !soRit_InterruptQry.full()) {
-                rsr_currSess = siRxh_SessIdRep.read();
-                soRit_InterruptQry.write(rsr_currSess);
-                if (DEBUG_LEVEL & TRACE_RRH) {
-                    printInfo(myName, "Querying [Rit] for session #%d.\n", rsr_currSess.to_uint());
-                }
-                rsr_fsmState = RSR_DEC;
+            else {
+                //-- Carry over the residual credit but not more than one quantum
+                TcpDatLen residual = ctx.credit - grant.byteCnt;
+                DEFICIT[ctx.sessId] = (residual > ctx.quantum) ? ctx.quantum : residual;
             }
-            break;
-        case RSR_DEC:
-            if (!siRit_InterruptRep.empty()) {
-                // Decrement counter and put it back in the table
-                rsr_intEntry  = siRit_InterruptRep.read();
-                // Request to TOE = max(rit_schedEntry.byteCnt, rit_freeSSpace)
-                rsr_datLenReq = (rsr_freeSpace < rsr_intEntry.byteCnt) ? (rsr_freeSpace) : (rsr_intEntry.byteCnt);
-                if (DEBUG_LEVEL & TRACE_RRH) {
-                    printInfo(myName, "NotifBytes=%d - FreeSpace=%d \n",
-                            rsr_intEntry.byteCnt.to_uint(), rsr_freeSpace.to_uint());
-                }
-                rsr_fsmState = RSR_PUT;
+        }
+        if (grant.byteCnt != 0) {
+            RSRV_BYTES[ctx.sessId] = ctx.rsrvBytes + grant.byteCnt;
+            soSHL_DReq.write(TcpAppRdReq(ctx.sessId, grant.byteCnt));
+            soRbp_FwdCmd.write(lookupPortAction(PORT_ACTION, ctx.sessId, grant.byteCnt, grant.dstPort));
+            dataReqTaken = true;
+            if (DEBUG_LEVEL & TRACE_RRH) {
+                printInfo(myName, "Sending DReq(SessId=%2d, DatLen=%4d) to RDp (expected TcpDstPort=%4d).\n",
+                          ctx.sessId.to_uint(), grant.byteCnt.to_uint(), grant.dstPort.to_uint());
             }
-            break;
-        case RSR_PUT:
-            if (!soRit_InterruptQry.full() and !soRxh_ClearReq.full()) {
-                newByteCnt = rsr_intEntry.byteCnt - rsr_datLenReq;
-                soRit_InterruptQry.write(InterruptQuery(rsr_currSess, newByteCnt));
-                if (newByteCnt == 0) {
-                    soRxh_ClearReq.write(rsr_currSess);
-                    if (DEBUG_LEVEL & TRACE_RRH) {
-                        printInfo(myName, "Request to clear interrupt #%d.\n", rsr_currSess.to_uint());
-                    }
-                }
-                rsr_fsmState = RSR_FWD;
+        }
+        busyClr[ctx.sessId] = 1;
+        tokensBack += 1;
+    }
+
+    //-- STAGE-2: QUERY --------------------------------------------------------
+    if (!siRxh_SessIdRep.empty() and !soRit_InterruptQry.full()) {
+        SessionId currSess = siRxh_SessIdRep.read();
+        TcpDatLen quantum  = QUANTUM[currSess];
+        TcpDatLen rsrvTot  = RSRV_BYTES[currSess];
+        TcpDatLen credit   = 0xFFFF;
+        if (quantum != 0) {
+            ap_uint<17> sum = DEFICIT[currSess];
+            if (rsrvTot == RLSD_BYTES_B[currSess]) {
+                //-- The session holds no more bytes in the input buffer.
+                //--  Credit it with its quantum (saturating).
+                sum += quantum;
             }
-            break;
-        case RSR_FWD:
-            if (!soSHL_DReq.full() and !soRDp_FwdCmd.full()) {
-                soSHL_DReq.write(TcpAppRdReq(rsr_currSess, rsr_datLenReq));
-                switch (rsr_intEntry.dstPort) {
-                    case RECV_MODE_LSN_PORT: // 8800
-                        soRDp_FwdCmd.write(ForwardCmd(rsr_currSess, rsr_datLenReq, CMD_DROP, NOP));
-                        break;
-                    case XMIT_MODE_LSN_PORT: // 8801
-                        soRDp_FwdCmd.write(ForwardCmd(rsr_currSess, rsr_datLenReq, CMD_DROP, GEN));
-                        break;
-                    default:
-                        soRDp_FwdCmd.write(ForwardCmd(rsr_currSess, rsr_datLenReq, CMD_KEEP, NOP));
-                        break;
-                }
-                if (DEBUG_LEVEL & TRACE_RRH) {
-                    printInfo(myName, "Sending DReq(SessId=%2d, DatLen=%4d) to RDp (expected TcpDstPort=%4d).\n",
-                              rsr_currSess.to_uint(), rsr_datLenReq.to_uint(), rsr_intEntry.dstPort.to_uint());
-                }
+            credit = (sum[16]) ? (TcpDatLen)0xFFFF : (TcpDatLen)sum(15,0);
+        }
+        if (rsr_busyVec[currSess] or (credit == 0)) {
+            //-- Skip this session for now. It remains pending in [Rxh].
+            tokensBack += 1;
+        }
+        else {
+            CONTEXT[rsr_ctxWrPtr] = RxSchedCtx(currSess, credit, quantum, rsrvTot);
+            rsr_ctxWrPtr += 1;
+            soRit_InterruptQry.write(InterruptQuery(currSess, credit));
+            busySet[currSess] = 1;
+            if (DEBUG_LEVEL & TRACE_RRH) {
+                printInfo(myName, "Querying [Rit] for session #%d (MaxLen=%d).\n",
+                          currSess.to_uint(), credit.to_uint());
             }
-            rsr_fsmState = RSR_SREQ;
-            break;
+        }
+    }
+
+    //-- STAGE-1: REQ ----------------------------------------------------------
+    if ((rsr_nrTokens < cMaxRxsQueries) and !soRxh_SessIdReq.full()) {
+        soRxh_SessIdReq.write(1);
+        tokenTaken = true;
     }
+
+    //-- Update the busy vector and the number of requests in flight
+    rsr_busyVec    = (rsr_busyVec & ~busyClr) | busySet;
+    rsr_nrTokens   = rsr_nrTokens   + (tokenTaken   ? 1 : 0) - tokensBack;
+    rsr_nrDataReqs = rsr_nrDataReqs + (dataReqTaken ? 1 : 0) - (dataReqBack ? 1 : 0);
 }
 
 /*******************************************************************************
  * @brief Read Request Handler (RRh)
  *
- * @param[in]  siSHL_Notif   A new Rx data notification from [SHELL].
- * @param[in]  siIRb_EnquSig Signals the enqueue of a chunk from InputReadBuffer (IRb).
- * @param[in]  siRDp_EnquSig Signals the dequeue of a chunk from ReadPath (RDp).
- * @param[out] soSHL_DReq    An Rx data request to [SHELL].
- * @param[out] soRDp_FwdCmd  A command telling the ReadPath (RDp) to keep/drop a stream.
+ * @tparam     Policy          The Rx scheduling policy (see 'TSIF_RX_POLICY').
+ * @param[in]  siMCh_Quantum   The DRR quantum of a session from MmioConfigHandler (MCh).
+ * @param[in]  siMCh_PortAct   An entry of the port action table from [MCh].
+ * @param[in]  siSLc_Notif     A new Rx data notification from SessionLifecycle (SLc).
+ * @param[in]  siSLc_ClrReq    Request to clear the interrupt table entry of a session from [SLc].
+ * @param[in]  siIRb_EnquSig   Signals the enqueue of a chunk from InputReadBuffer (IRb).
+ * @param[in]  siRbp_DequSig   Signals the dequeue of a chunk from RxBufferPool (Rbp).
+ * @param[out] soSHL_DReq      An Rx data request to [SHELL].
+ * @param[out] soRbp_FwdCmd    A command telling the RxBufferPool (Rbp) to keep/drop a stream.
+ * @param[out] soDBG_FreeSpace Debug probe reporting the free space of the input buffer.
  *
  * @details
- *  The [RRh] consists of 4 sub-processes:
+ *  The [RRh] consists of 5 sub-processes:
  *   1) pRxBufferOccupancy (Rxb) keeps tracks of the input read buffer occupancy.
- *   2) pRxInterruptTable (Rit) keeps track of the received notifications.
- *   3) pRxPostNotification (Rxp) handles the incoming notifications and post them into the interrupt table.
- *   4) pRxScheduler (Rxs) schedules new data requests among the pending interrupts.
+ *   2) pRxPostNotification (Rpn) coalesces the incoming notifications and post them into the interrupt table.
+ *   3) pRxInterruptTable (Rit) keeps track of the received notifications.
+ *   4) pRxHandler (Rxh) maintains the vector of pending interrupts and arbitrates among them.
+ *   5) pRxScheduler (Rxs) schedules new data requests among the pending interrupts.
  *
  *  The [RRh] waits for a notification from [TOE] indicating the availability
  *   of new data for the TcpApplication Flash (TAF) process of the [ROLE]. If
  *   the TCP segment length of the notification message is greater than 0, the
  *   data segment is valid and the notification is accepted. The #bytes and TCP
  *   destination port specified by the notification are added to the interrupt
- *   table by the [Rxp] process.
- *  The [Rxh] implement a round-robin that schedules among the pending requests
- *   and generates data requests to [TOE] accordingly. Upon, request, the number
- *   of pending bytes in [Rit] is decreased.
- *   For testing purposes, the TCP destination port is evaluated here and one of
- *   the following actions is taken upon its value:
+ *   table by the [Rpn] process at a rate of one notification per clock cycle,
+ *   after consecutive notifications of a same session have been coalesced.
+ *  The [Rxh] arbitrates among the pending requests according to the 'Policy'
+ *   selected at compile time (see 'TSIF_RX_POLICY') and [Rxs] generates data
+ *   requests to [TOE] accordingly:
+ *     - RR  : a plain round-robin among the pending sessions.
+ *     - DRR : a round-robin where every session starts with a deficit quantum
+ *             of 'cRxDefQuantum' bytes.
+ *     - SPF : the session with the fewest pending bytes is served first. The
+ *             current session is only re-elected if it is the last candidate.
+ *   Upon request, the number of pending bytes in [Rit] is decreased. The size
+ *   of a data request can further be capped on a per-session basis by
+ *   programming a deficit round-robin quantum via the MMIO configuration path
+ *   (see 'CFG_RX_QUANTUM'). The FIFO policy does not use this process but the
+ *   legacy in-order handler which requests the notifications as they arrive.
+ *   The TCP destination port is also looked up here in a port action table,
+ *    which is programmed at run time via the MMIO configuration path (see
+ *    'CFG_PORT_RANGE' and 'CFG_PORT_ACTION'). By default, the table specifies
+ *    the following actions:
  *     - 8800 : The RxPath (RXp) process is requested to dump/sink this segment.
  *              This is an indirect way for a remote client to run iPerf on that
  *              FPGA port used here as a server.
@@ -932,17 +2010,24 @@ void pRxScheduler(
  *              these data to the Connect (COn) process. The [COn] will then
  *              open an active connection before triggering the WritePath (WRp)
  *              to send the requested amount of bytes on the new connection.
- *     - 5001 : [TBD]
- *     - 5201 : [TBD]
+ *     - 5001 : The IperfServer (IPs) sinks and accounts for this segment as an
+ *              iperf2 server.
+ *     - 5201 : The [IPs] runs the iperf3 protocol on this segment (see
+ *              'pIperfServer').
  *     - Others: The RXp process is requested to forward these data and metadata
  *              streams to the TcpApplicationFlash (TAF).
  *******************************************************************************/
+template<int Policy>
 void pReadRequestHandler(
-        stream<TcpAppNotif>    &siSHL_Notif,
-        stream<SigBit>         &siIRb_EnquSig,
-        stream<SigBit>         &siRDp_DequSig,
+        stream<RxQuantumCfg>   &siMCh_Quantum,
+        stream<PortActCfg>     &siMCh_PortAct,
+        stream<TcpAppNotif>    &siSLc_Notif,
+        stream<SessionId>      &siSLc_ClrReq,
+        stream<ChunkBytes>     &siIRb_EnquSig,
+        stream<RxDequSig>      &siRbp_DequSig,
         stream<TcpAppRdReq>    &soSHL_DReq,
-        stream<ForwardCmd>     &soRDp_FwdCmd)
+        stream<ForwardCmd>     &soRbp_FwdCmd,
+        stream<ap_uint<16> >   &soDBG_FreeSpace)
 {
     //-- DIRECTIVES FOR THIS PROCESS -------------------------------------------
     #pragma HLS DATAFLOW
@@ -953,62 +2038,71 @@ void pReadRequestHandler(
 
     //-- LOCAL STREAM ----------------------------------------------------------
     static stream<InterruptQuery>   ssRpnToRit_InterruptQry ("ssRpnToRit_InterruptQry");
-    #pragma HLS stream     variable=ssRpnToRit_InterruptQry depth=2
-    static stream<SessionId>        ssRpnToRxh_SessId       ("ssRpnToRxh_SessId");
-    #pragma HLS stream     variable=ssRpnToRxh_SessId       depth=4
-
-    static stream<InterruptEntry>   ssRitToRsr_InterruptRep ("ssRitToRsr_InterruptRep");
-    #pragma HLS stream     variable=ssRitToRsr_InterruptRep depth=2
-    static stream<InterruptEntry>   ssRitToRpn_InterruptRep ("ssRitToRpn_InterruptRep");
-    #pragma HLS stream     variable=ssRitToRpn_InterruptRep depth=2
+    #pragma HLS stream     variable=ssRpnToRit_InterruptQry depth=4
+    #pragma HLS DATA_PACK  variable=ssRpnToRit_InterruptQry
+
+    static stream<RxGrant>          ssRitToRxs_InterruptRep ("ssRitToRxs_InterruptRep");
+    #pragma HLS stream     variable=ssRitToRxs_InterruptRep depth=2
+    #pragma HLS DATA_PACK  variable=ssRitToRxs_InterruptRep
+    static stream<RxIntSig>         ssRitToRxh_SetInt       ("ssRitToRxh_SetInt");
+    #pragma HLS stream     variable=ssRitToRxh_SetInt       depth=4
+    #pragma HLS DATA_PACK  variable=ssRitToRxh_SetInt
+    static stream<RxIntSig>         ssRitToRxh_ClrInt       ("ssRitToRxh_ClrInt");
+    #pragma HLS stream     variable=ssRitToRxh_ClrInt       depth=4
+    #pragma HLS DATA_PACK  variable=ssRitToRxh_ClrInt
 
     static stream<InterruptQuery>   ssRxsToRit_InterruptQry ("ssRxsToRit_InterruptQry");
     #pragma HLS stream     variable=ssRxsToRit_InterruptQry depth=2
-
+    #pragma HLS DATA_PACK  variable=ssRxsToRit_InterruptQry
     static stream<ReqBit>           ssRxsToRxh_SessIdReq    ("ssRxsToRxh_SessIdReq");
     #pragma HLS stream     variable=ssRxsToRxh_SessIdReq    depth=2
-    static stream<SessionId>        ssRxsToRxh_ClearInt     ("ssRxsToRxh_ClearInt");
-    #pragma HLS stream     variable=ssRxsToRxh_ClearInt     depth=2
 
     static stream<SessionId>        ssRxhToRxs_SessIdRep    ("ssRxhToRxs_SessIdRep");
     #pragma HLS stream     variable=ssRxhToRxs_SessIdRep    depth=2
 
-    static stream<ap_uint<log2Ceil<cIBuffBytes>::val+1> >  ssRxbToRxs_FreeSpace  ("ssRxbToRxs_FreeSpace");
-    #pragma HLS stream                            variable=ssRxbToRxs_FreeSpace  depth=4
+    static stream<ChunkBytes>       ssRxbToRit_Release      ("ssRxbToRit_Release");
+    #pragma HLS stream     variable=ssRxbToRit_Release      depth=4
+    static stream<RxDequSig>        ssRxbToRxs_Release      ("ssRxbToRxs_Release");
+    #pragma HLS stream     variable=ssRxbToRxs_Release      depth=4
+    #pragma HLS DATA_PACK  variable=ssRxbToRxs_Release
 
     //-- PROCESS FUNCTIONS -----------------------------------------------------
     pRxBufferOccupancy(
             siIRb_EnquSig,
-            siRDp_DequSig,
-            ssRxbToRxs_FreeSpace);
+            siRbp_DequSig,
+            ssRxbToRit_Release,
+            ssRxbToRxs_Release,
+            soDBG_FreeSpace);
 
     pRxPostNotification(
-            siSHL_Notif,
-            ssRpnToRit_InterruptQry,
-            ssRitToRpn_InterruptRep,
-            ssRpnToRxh_SessId);
+            siSLc_Notif,
+            ssRpnToRit_InterruptQry);
 
-    pRxHandler(
-            ssRpnToRxh_SessId,
+    pRxHandler<Policy>(
+            ssRitToRxh_SetInt,
+            ssRitToRxh_ClrInt,
             ssRxsToRxh_SessIdReq,
-            ssRxhToRxs_SessIdRep,
-            ssRxsToRxh_ClearInt);
+            ssRxhToRxs_SessIdRep);
 
-    pRxScheduler(
+    pRxScheduler<Policy>(
+            siMCh_Quantum,
+            siMCh_PortAct,
             ssRxsToRxh_SessIdReq,
             ssRxhToRxs_SessIdRep,
-            ssRxbToRxs_FreeSpace,
+            ssRxbToRxs_Release,
             ssRxsToRit_InterruptQry,
-            ssRitToRsr_InterruptRep,
-            ssRxsToRxh_ClearInt,
+            ssRitToRxs_InterruptRep,
             soSHL_DReq,
-            soRDp_FwdCmd);
+            soRbp_FwdCmd);
 
     pRxInterruptTable(
             ssRpnToRit_InterruptQry,
-            ssRitToRpn_InterruptRep,
             ssRxsToRit_InterruptQry,
-            ssRitToRsr_InterruptRep);
+            ssRitToRxs_InterruptRep,
+            ssRxbToRit_Release,
+            ssRitToRxh_SetInt,
+            ssRitToRxh_ClrInt,
+            siSLc_ClrReq);
 }
 
 #else
@@ -1019,13 +2113,13 @@ void pReadRequestHandler(
  * @param[in]  piSHL_Enable  Enable signal from [SHELL].
  * @param[in]  siSHL_Data    Data stream from [SHELL].
  * @param[in]  siSHL_Meta    Session Id from [SHELL].
- * @param[out] soRDp_Data    Data stream to ReadPath (RDp).
- * @param[out] soRDp_Meta    Metadata stream [RDp].
+ * @param[out] soRbp_Data    Data stream to RxBufferPool (Rbp).
+ * @param[out] soRbp_Meta    Metadata stream [Rbp].
  *
  * @details
- *  This process implements an input FIFO buffer as a stream. The goal is to
- *   provision a buffer to store all the bytes that were requested by the
- *   ReadRequestHandler (RRh) process.
+ *  This process passes the incoming data and metadata streams on to the
+ *   RxBufferPool (Rbp) which provisions a buffer to store all the bytes that
+ *   were requested by the ReadRequestHandler (RRh) process.
  *  FYI, if this user process does not absorb the incoming data stream fast
  *   enough, the [TOE] will start dropping segments on his side to avoid any
  *   blocking situation.
@@ -1034,8 +2128,8 @@ void pInputReadBuffer(
         CmdBit              *piSHL_Enable,
         stream<TcpAppData>  &siSHL_Data,
         stream<TcpAppMeta>  &siSHL_Meta,
-        stream<TcpAppData>  &soRDp_Data,
-        stream<TcpAppMeta>  &soRDp_Meta)
+        stream<TcpAppData>  &soRbp_Data,
+        stream<TcpAppMeta>  &soRbp_Meta)
 {
     //-- DIRECTIVES FOR THIS PROCESS -------------------------------------------
     #pragma HLS INLINE off
@@ -1047,11 +2141,11 @@ void pInputReadBuffer(
         return;
     }
 
-    if (!siSHL_Meta.empty() and !soRDp_Meta.full()) {
-        soRDp_Meta.write(siSHL_Meta.read());
+    if (!siSHL_Meta.empty() and !soRbp_Meta.full()) {
+        soRbp_Meta.write(siSHL_Meta.read());
     }
-    if (!siSHL_Data.empty() and !soRDp_Data.full()) {
-        soRDp_Data.write(siSHL_Data.read());
+    if (!siSHL_Data.empty() and !soRbp_Data.full()) {
+        soRbp_Data.write(siSHL_Data.read());
     }
 
 }
@@ -1060,7 +2154,7 @@ void pInputReadBuffer(
  * @brief Read Notification Handler (RNh)
  *
  * @param[in]  piSHL_Enable  Enable signal from [SHELL].
- * @param[in]  siSHL_Notif   A new Rx data notification from [SHELL].
+ * @param[in]  siSLc_Notif   A new Rx data notification from SessionLifecycle (SLc).
  * @param[out] soRRh_Notif   The notification forwarded to ReadRequestHandler (RRh).
  *
  * @details
@@ -1069,11 +2163,13 @@ void pInputReadBuffer(
  *   the TCP segment length of the notification message is greater than 0, the
  *   data segment is valid and the notification is accepted. The notification
  *   is then pushed into a FIFO for later processing by the [RRh].
- *  This process runs with II=1 in order to never miss an incoming notification.
+ *  This process runs with II=1 and stops reading from [SHELL] while that FIFO
+ *   is full, such that a burst of notifications back-pressures the [TOE]
+ *   instead of being lost.
  *******************************************************************************/
 void pReadNotificationHandler(
         CmdBit                *piSHL_Enable,
-        stream<TcpAppNotif>    &siSHL_Notif,
+        stream<TcpAppNotif>    &siSLc_Notif,
         stream<TcpAppNotif>    &soRRh_Notif)
 {
     //-- DIRECTIVES FOR THIS PROCESS -------------------------------------------
@@ -1086,18 +2182,13 @@ void pReadNotificationHandler(
         return;
     }
 
-    if (!siSHL_Notif.empty()) {
+    if (!siSLc_Notif.empty() and !soRRh_Notif.full()) {
         TcpAppNotif notif;
-        siSHL_Notif.read(notif);
+        siSLc_Notif.read(notif);
         if (notif.tcpDatLen == 0) {
             printFatal(myName, "Received a notification for a TCP segment of length 'zero'. Don't know what to do with it!\n");
         }
-        if (!soRRh_Notif.full()) {
-            soRRh_Notif.write(notif);
-        }
-        else {
-            printFatal(myName, "The Rx Notif FiFo is full. Consider increasing the depth of this FiFo.\n");
-        }
+        soRRh_Notif.write(notif);
     }
 }
 
@@ -1105,10 +2196,13 @@ void pReadNotificationHandler(
  * @brief Read Request Handler (RRh)
  *
  * @param[in]  piSHL_Enable  Enable signal from [SHELL].
+ * @param[in]  siMCh_Quantum The DRR quantum of a session from MmioConfigHandler (MCh).
+ * @param[in]  siMCh_PortAct An entry of the port action table from [MCh].
  * @param[in]  siRNh_Notif   A new Rx data notification from ReadNotifHandler (RNh).
- * @param[in]  siRDp_DequSig Signals the dequeue of a chunk from ReadPath (RDp).
+ * @param[in]  siRbp_DequSig Signals the dequeue of a chunk from RxBufferPool (Rbp).
+ * @param[in]  siSLc_ClrReq  Request to clear the pending bytes of a session from SessionLifecycle (SLc).
  * @param[out] soRRm_DReq    A data read request to ReadRequestMover (RRm).
- * @param[out] soRDp_FwdCmd  A command telling the ReadPath (RDp) to keep/drop a stream.
+ * @param[out] soRbp_FwdCmd  A command telling the RxBufferPool (Rbp) to keep/drop a stream.
  *
  * @details
  *  The [RRh] consists of 2 sub-processes:
@@ -1118,9 +2212,16 @@ void pReadNotificationHandler(
  *       read requests from the [SHELL] accordingly.
  *      The rule is as follows:
  *       #RequestedBytes = min(NotifDatLen, max(AvailableSpace, cMinDataReqLen).
+ *   This implementation keeps no per-session state and therefore ignores the
+ *    clear requests of [SLc].
+ *   At most 'cMaxRxsDataReqs' data requests are kept in flight, such that the
+ *    RxBufferPool (Rbp) can always hold their forward commands until their
+ *    segments arrive, in whatever order the [TOE] serves them.
  *
- *   For testing purposes, the TCP destination port is also evaluated here and
- *    one of the following actions is taken upon its value:
+ *   The TCP destination port is also looked up here in a port action table,
+ *    which is programmed at run time via the MMIO configuration path (see
+ *    'CFG_PORT_RANGE' and 'CFG_PORT_ACTION'). By default, the table specifies
+ *    the following actions:
  *     - 8800 : The RxPath (RXp) process is requested to dump/sink this segment.
  *              This is an indirect way for a remote client to run iPerf on that
  *              FPGA port used here as a server.
@@ -1132,17 +2233,22 @@ void pReadNotificationHandler(
  *              these data to the Connect (COn) process. The [COn] will then
  *              open an active connection before triggering the WritePath (WRp)
  *              to send the requested amount of bytes on the new connection.
- *     - 5001 : [TBD]
- *     - 5201 : [TBD]
+ *     - 5001 : The IperfServer (IPs) sinks and accounts for this segment as an
+ *              iperf2 server.
+ *     - 5201 : The [IPs] runs the iperf3 protocol on this segment (see
+ *              'pIperfServer').
  *     - Others: The RXp process is requested to forward these data and metadata
  *              streams to the TcpApplicationFlash (TAF).
  *******************************************************************************/
 void pReadRequestHandler(
         CmdBit                *piSHL_Enable,
+        stream<RxQuantumCfg>   &siMCh_Quantum,
+        stream<PortActCfg>     &siMCh_PortAct,
         stream<TcpAppNotif>    &siRNh_Notif,
-        stream<SigBit>         &siRDp_DequSig,
+        stream<RxDequSig>      &siRbp_DequSig,
+        stream<SessionId>      &siSLc_ClrReq,
         stream<TcpAppRdReq>    &soRRm_DReq,
-        stream<ForwardCmd>     &soRDp_FwdCmd,
+        stream<ForwardCmd>     &soRbp_FwdCmd,
         stream<ap_uint<16> >   &soDBG_freeSpace)
 {
     //-- DIRECTIVES FOR THIS PROCESS -------------------------------------------
@@ -1156,26 +2262,54 @@ void pReadRequestHandler(
     #pragma HLS reset                    variable=rrh_fsmState
     static ap_uint<log2Ceil<cIBuffBytes>::val+1>  rrh_freeSpace=cIBuffBytes;
     #pragma HLS reset                    variable=rrh_freeSpace
+    static ap_uint<log2Ceil<cMaxRxsDataReqs>::val+1> rrh_nrDataReqs=0;
+    #pragma HLS reset                    variable=rrh_nrDataReqs
+    static PortActEntry                           PORT_ACTION[cPortActEntries] = {
+        PortActEntry(RECV_MODE_LSN_PORT, RECV_MODE_LSN_PORT, PA_SINK, 0),
+        PortActEntry(XMIT_MODE_LSN_PORT, XMIT_MODE_LSN_PORT, PA_GEN,  0),
+        PortActEntry(IPERF_LSN_PORT,     IPERF_LSN_PORT,     PA_IPERF2, 0),
+        PortActEntry(IPREF3_LSN_PORT,    IPREF3_LSN_PORT,    PA_IPERF3, 0) };
+    #pragma HLS ARRAY_PARTITION          variable=PORT_ACTION complete dim=1
+    #pragma HLS reset                    variable=PORT_ACTION
 
     //-- STATIC VARIABLES ------------------------------------------------------
     static  TcpAppNotif rrh_notif;
     static  TcpDatLen   rrh_datLenReq;
 
+    //-- DYNAMIC VARIABLES -----------------------------------------------------
+    bool    dataReqTaken = false;
+    bool    dataReqBack  = false;
+
     if (*piSHL_Enable != 1) {
         return;
     }
 
+    //-- This implementation does not support the deficit round-robin mode
+    if (!siMCh_Quantum.empty()) {
+        siMCh_Quantum.read();
+        printWarn(myName, "Rx quantum is not supported by this implementation and is ignored.\n");
+    }
+    //-- The pending notifications are not tracked per session (see above)
+    if (!siSLc_ClrReq.empty()) {
+        siSLc_ClrReq.read();
+    }
+    if (!siMCh_PortAct.empty()) {
+        updatePortAction(PORT_ACTION, siMCh_PortAct.read());
+    }
+
+    //-- Always handle dequeue signal (release the bytes of the dequeued chunk)
+    if (!siRbp_DequSig.empty()) {
+        RxDequSig dequSig = siRbp_DequSig.read();
+        rrh_freeSpace += dequSig.byteCnt;
+        dataReqBack    = dequSig.last;
+        if (DEBUG_LEVEL & TRACE_RRH) {
+            printInfo(myName, "FreeSpace=%4d bytes\n", rrh_freeSpace.to_uint());
+        }
+    }
+
     //-- MAIN PROCESS ----------------------------------------------------------
     switch(rrh_fsmState) {
         case RRH_IDLE:
-            //-- Always handle dequeue signal
-            if (!siRDp_DequSig.empty()) {
-                siRDp_DequSig.read();
-                rrh_freeSpace += (ARW/8);
-                if (DEBUG_LEVEL & TRACE_RRH) {
-                    printInfo(myName, "FreeSpace=%4d bytes\n", rrh_freeSpace.to_uint());
-                }
-            }
             if (!siRNh_Notif.empty()) {
                 siRNh_Notif.read(rrh_notif);
                 rrh_fsmState = RRH_GEN_DLEN;
@@ -1192,31 +2326,14 @@ void pReadRequestHandler(
                     //-- Requested bytes = rrh_freeSpace
                     rrh_datLenReq        = rrh_freeSpace;
                     rrh_notif.tcpDatLen -= rrh_freeSpace;
-                    //-- Handle dequeue signal
-                    if (!siRDp_DequSig.empty()) {
-                        siRDp_DequSig.read();
-                        rrh_freeSpace += (ARW/8);
-                    }
-                    else {
-                        rrh_freeSpace = 0;
-                    }
                 }
                 else {
                     //-- Requested bytes = rdr_notif.byteCnt
                     rrh_datLenReq        = rrh_notif.tcpDatLen;
-                    rrh_freeSpace       -= (rrh_notif.tcpDatLen) & ~((TcpDatLen)(ARW/8-1));
-                    if (rrh_notif.tcpDatLen & (TcpDatLen)((ARW/8)-1)) {
-                        // The requested length is not aligned w/ the input buffer
-                        // width and this will consume another input buffer chunk.
-                        rrh_freeSpace -= (ARW/8);
-                        //-- Handle dequeue signal
-                        if (!siRDp_DequSig.empty()) {
-                            siRDp_DequSig.read();
-                            rrh_freeSpace += (ARW/8);
-                        }
-                    }
                     rrh_notif.tcpDatLen  = 0;
                 }
+                //-- Reserve the requested bytes in the input buffer
+                rrh_freeSpace -= rrh_datLenReq;
                 rrh_fsmState = RRH_SEND_DREQ;
             }
             else {
@@ -1224,11 +2341,6 @@ void pReadRequestHandler(
                     printInfo(myName, "FreeSpace=%4d is too low. Waiting for buffer to drain. \n",
                               rrh_freeSpace.to_uint());
                }
-               //-- Handle dequeue signal
-               if (!siRDp_DequSig.empty()) {
-                   siRDp_DequSig.read();
-                   rrh_freeSpace += (ARW/8);
-               }
             }
             // Debug Trace
             if (DEBUG_LEVEL & TRACE_RRH) {
@@ -1237,27 +2349,11 @@ void pReadRequestHandler(
             }
             break;
         case RRH_SEND_DREQ:
-            //-- Always handle dequeue signal
-            if (!siRDp_DequSig.empty()) {
-                siRDp_DequSig.read();
-                rrh_freeSpace += (ARW/8);
-                if (DEBUG_LEVEL & TRACE_RRH) {
-                    printInfo(myName, "FreeSpace=%4d bytes\n", rrh_freeSpace.to_uint());
-                }
-            }
-            if (!soRRm_DReq.full() and !soRDp_FwdCmd.full()) {
+            if (!soRRm_DReq.full() and !soRbp_FwdCmd.full() and (rrh_nrDataReqs < cMaxRxsDataReqs)) {
                 soRRm_DReq.write(TcpAppRdReq(rrh_notif.sessionID, rrh_datLenReq));
-                switch (rrh_notif.tcpDstPort) {
-                    case RECV_MODE_LSN_PORT: // 8800
-                        soRDp_FwdCmd.write(ForwardCmd(rrh_notif.sessionID, rrh_datLenReq, CMD_DROP, NOP));
-                        break;
-                    case XMIT_MODE_LSN_PORT: // 8801
-                        soRDp_FwdCmd.write(ForwardCmd(rrh_notif.sessionID, rrh_datLenReq, CMD_DROP, GEN));
-                        break;
-                    default:
-                        soRDp_FwdCmd.write(ForwardCmd(rrh_notif.sessionID, rrh_datLenReq, CMD_KEEP, NOP));
-                        break;
-                }
+                dataReqTaken = true;
+                soRbp_FwdCmd.write(lookupPortAction(PORT_ACTION, rrh_notif.sessionID,
+                                                    rrh_datLenReq, rrh_notif.tcpDstPort));
                 if (rrh_notif.tcpDatLen == 0) {
                     rrh_fsmState = RRH_IDLE;
                     if (DEBUG_LEVEL & TRACE_RRH) {
@@ -1276,6 +2372,9 @@ void pReadRequestHandler(
         break;
     }
 
+    //-- Account the data requests in flight
+    rrh_nrDataReqs = rrh_nrDataReqs + (dataReqTaken ? 1 : 0) - (dataReqBack ? 1 : 0);
+
     //-- ALWAYS -------------------------------------------
      if (!soDBG_freeSpace.full()) {
         soDBG_freeSpace.write(rrh_freeSpace);
@@ -1315,194 +2414,1968 @@ void pReadRequestMover(
 
 #endif
 
+/*******************************************************************************
+ * @brief Rx Buffer Pool (Rbp)
+ *
+ * @param[in]  piSHL_Enable  Enable signal from [SHELL].
+ * @param[in]  siIRb_Data    Data stream from InputReadBuffer (IRb).
+ * @param[in]  siIRb_Meta    Session Id from [IRb].
+ * @param[in]  siRRh_FwdCmd  A command to keep/drop a stream from ReadRequestHandler (RRh).
+ * @param[out] soRRh_DequSig Signals the dequeue of a chunk to [RRh].
+ * @param[out] soRDp_TafCmd  The forward command of a segment of the TAF lane to ReadPath (RDp).
+ * @param[out] soRDp_TafData Data stream of the TAF  lane to [RDp].
+ * @param[out] soRDp_SnkCmd  The forward command of a segment of the SINK lane to [RDp].
+ * @param[out] soRDp_SnkData Data stream of the SINK lane to [RDp].
+ * @param[out] soRDp_GenData Data stream of the GEN  lane to [RDp].
+ * @param[out] soIPs_IpfCmd  The forward command of a segment of the IPERF lane to IperfServer (IPs).
+ * @param[out] soIPs_IpfData Data stream of the IPERF lane to [IPs].
+ *
+ * @details
+ *  This process implements the storage of the input read buffer as a pool of
+ *   'cIBuffChunks' chunks which is shared by the downstream lanes of the
+ *   ReadPath (RDp) and of the IperfServer (IPs) (see 'RxLane'). Every lane is a linked list of chunks
+ *   (DATA + NEXT) with its own head and tail pointers, and the free chunks are
+ *   kept in a ring of pointers (FREE). The tail of a lane always points to a
+ *   free chunk which was allocated beforehand, such that the link to the next
+ *   chunk can be written together with the data.
+ *  Enqueue - The forward commands from [RRh] are kept in a queue of
+ *   'cRbpCmdSlots' pending commands (PND_CMD). At the beginning of a segment,
+ *   the metadata from [IRb] is paired with the oldest pending command of the
+ *   same session, which selects the lane of the segment. The segments of a
+ *   session are therefore matched in order, but the [TOE] is free to serve the
+ *   data requests of different sessions out of order. The command is stored
+ *   along with the first chunk (CMD) and every chunk of the segment is appended
+ *   to that lane.
+ *  Dequeue - Every cycle, a round-robin arbiter picks one lane which holds a
+ *   chunk and whose output stream is not full. As a result, a lane which is
+ *   back-pressured by its consumer (e.g. [TAF]) no longer blocks the segments
+ *   that were queued behind it for the other lanes. The dequeue of a chunk is
+ *   signaled to [RRh] which releases its space.
+ *  Both sides run with II=1 and the read-after-write hazards between two
+ *   consecutive iterations are resolved with write-forwarding registers.
+ *
+ * @warning
+ *  A segment waits for its command to enter the queue. However, a segment for
+ *   which no command is pending while the queue is full was not requested by
+ *   [RRh]. It is discarded upon enqueue, such that it does not consume any
+ *   buffer space.
+ *******************************************************************************/
+void pRxBufferPool(
+        CmdBit               *piSHL_Enable,
+        stream<TcpAppData>   &siIRb_Data,
+        stream<TcpAppMeta>   &siIRb_Meta,
+        stream<ForwardCmd>   &siRRh_FwdCmd,
+        stream<RxDequSig>    &soRRh_DequSig,
+        stream<ForwardCmd>   &soRDp_TafCmd,
+        stream<TcpAppData>   &soRDp_TafData,
+        stream<ForwardCmd>   &soRDp_SnkCmd,
+        stream<TcpAppData>   &soRDp_SnkData,
+        stream<TcpAppData>   &soRDp_GenData,
+        stream<ForwardCmd>   &soIPs_IpfCmd,
+        stream<TcpAppData>   &soIPs_IpfData)
+{
+    //-- DIRECTIVES FOR THIS PROCESS -------------------------------------------
+    #pragma HLS INLINE off
+    #pragma HLS PIPELINE II=1 enable_flush
+
+    const char *myName  = concat3(THIS_NAME, "/", "Rbp");
+
+    //-- STATIC ARRAYS ---------------------------------------------------------
+    static TcpAppData                         DATA[cIBuffChunks];
+    #pragma HLS RESOURCE             variable=DATA core=RAM_2P
+    #pragma HLS DEPENDENCE           variable=DATA inter false
+    static ChunkPtr                           NEXT[cIBuffChunks];
+    #pragma HLS RESOURCE             variable=NEXT core=RAM_2P
+    #pragma HLS DEPENDENCE           variable=NEXT inter false
+    static ForwardCmd                         CMD[cIBuffChunks];
+    #pragma HLS RESOURCE             variable=CMD  core=RAM_2P
+    #pragma HLS DEPENDENCE           variable=CMD  inter false
+    #pragma HLS DATA_PACK            variable=CMD
+    static ChunkPtr                           FREE[cIBuffChunks];
+    #pragma HLS RESOURCE             variable=FREE core=RAM_2P
+    #pragma HLS DEPENDENCE           variable=FREE inter false
+
+    //-- STATIC ARRAYS (Pending forward commands - Entry [0] is the oldest) ----
+    static ForwardCmd                         PND_CMD[cRbpCmdSlots];
+    #pragma HLS ARRAY_PARTITION      variable=PND_CMD complete dim=1
+
+    //-- STATIC VARIABLES W/ RESET ---------------------------------------------
+    static ChunkPtr                           rbp_head[cRxLanes]={LANE_TAF, LANE_SINK, LANE_GEN, LANE_IPERF};
+    #pragma HLS reset                variable=rbp_head
+    #pragma HLS ARRAY_PARTITION      variable=rbp_head  complete
+    static ChunkPtr                           rbp_tail[cRxLanes]={LANE_TAF, LANE_SINK, LANE_GEN, LANE_IPERF};
+    #pragma HLS reset                variable=rbp_tail
+    #pragma HLS ARRAY_PARTITION      variable=rbp_tail  complete
+    static ap_uint<log2Ceil<cIBuffChunks+1>::val> rbp_avail[cRxLanes]={0,0,0,0};
+    #pragma HLS reset                variable=rbp_avail
+    #pragma HLS ARRAY_PARTITION      variable=rbp_avail complete
+    static bool                               rbp_inSeg[cRxLanes]={false,false,false,false};
+    #pragma HLS reset                variable=rbp_inSeg
+    #pragma HLS ARRAY_PARTITION      variable=rbp_inSeg complete
+    static ap_uint<log2Ceil<cIBuffChunks+1>::val> rbp_freshPtr=cRxLanes;
+    #pragma HLS reset                variable=rbp_freshPtr
+    static ChunkPtr                           rbp_freeWrPtr=0;
+    #pragma HLS reset                variable=rbp_freeWrPtr
+    static ChunkPtr                           rbp_freeRdPtr=0;
+    #pragma HLS reset                variable=rbp_freeRdPtr
+    static bool                               rbp_enqInSeg=false;
+    #pragma HLS reset                variable=rbp_enqInSeg
+    static bool                               rbp_enqDrop=false;  // The segment was not requested
+    #pragma HLS reset                variable=rbp_enqDrop
+    static bool                               rbp_metaVal=false;
+    #pragma HLS reset                variable=rbp_metaVal
+    static ap_uint<log2Ceil<cRbpCmdSlots>::val+1> rbp_nrCmds=0;
+    #pragma HLS reset                variable=rbp_nrCmds
+    static RxLaneId                           rbp_lastLane=0;
+    #pragma HLS reset                variable=rbp_lastLane
+    static bool                               rbp_fwdChunkVal=false;
+    #pragma HLS reset                variable=rbp_fwdChunkVal
+    static bool                               rbp_fwdFreeVal=false;
+    #pragma HLS reset                variable=rbp_fwdFreeVal
+
+    //-- STATIC VARIABLES ------------------------------------------------------
+    static SessionId   rbp_deqSess[cRxLanes];
+    #pragma HLS ARRAY_PARTITION variable=rbp_deqSess complete
+    static RxLaneId    rbp_enqLane;
+    static ForwardCmd  rbp_enqCmd;
+    static bool        rbp_enqFirst;
+    static TcpSessId   rbp_enqMeta;
+
+    //-- STATIC DATAFLOW VARIABLES (Write-Forwarding Registers) ----------------
+    static ChunkPtr    rbp_fwdChunkPtr;
+    static TcpAppData  rbp_fwdChunkData;
+    static ChunkPtr    rbp_fwdChunkNext;
+    static ForwardCmd  rbp_fwdChunkCmd;
+    static ChunkPtr    rbp_fwdFreeIdx;
+    static ChunkPtr    rbp_fwdFreePtr;
+
+    //-- DYNAMIC VARIABLES -----------------------------------------------------
+    ap_uint<cRxLanes>  deqReqVec;
+    RxLaneId           deqLane;
+    ChunkPtr           deqPtr;
+    bool               deqVal = false;
+    ChunkPtr           enqPtr;
+    bool               enqVal = false;
+    bool               cmdHit = false;
+    ap_uint<log2Ceil<cRbpCmdSlots>::val> cmdIdx = 0;
+
+    if (*piSHL_Enable != 1) {
+        return;
+    }
+
+    //-- DEQUEUE ---------------------------------------------------------------
+    ChunkPtr freeWrPtr = rbp_freeWrPtr;
+    deqReqVec[LANE_TAF]  = (rbp_avail[LANE_TAF]  != 0) and !soRDp_TafData.full() and
+                           (rbp_inSeg[LANE_TAF] or !soRDp_TafCmd.full());
+    deqReqVec[LANE_SINK] = (rbp_avail[LANE_SINK] != 0) and !soRDp_SnkData.full() and
+                           (rbp_inSeg[LANE_SINK] or !soRDp_SnkCmd.full());
+    deqReqVec[LANE_GEN]  = (rbp_avail[LANE_GEN]  != 0) and !soRDp_GenData.full();
+    deqReqVec[LANE_IPERF]= (rbp_avail[LANE_IPERF]!= 0) and !soIPs_IpfData.full() and
+                           (rbp_inSeg[LANE_IPERF] or !soIPs_IpfCmd.full());
+    if (!soRRh_DequSig.full() and rrArbiter<cRxLanes>(deqReqVec, rbp_lastLane, deqLane)) {
+        deqPtr = rbp_head[deqLane];
+        bool       isFwd = rbp_fwdChunkVal and (rbp_fwdChunkPtr == deqPtr);
+        TcpAppData chunk = (isFwd) ? rbp_fwdChunkData : DATA[deqPtr];
+        ChunkPtr   next  = (isFwd) ? rbp_fwdChunkNext : NEXT[deqPtr];
+        if (!rbp_inSeg[deqLane]) {
+            //-- First chunk of a segment
+            ForwardCmd cmd = (isFwd) ? rbp_fwdChunkCmd : CMD[deqPtr];
+            rbp_deqSess[deqLane] = cmd.sessId;
+            if (deqLane == LANE_TAF) {
+                soRDp_TafCmd.write(cmd);
+            }
+            else if (deqLane == LANE_SINK) {
+                soRDp_SnkCmd.write(cmd);
+            }
+            else if (deqLane == LANE_IPERF) {
+                soIPs_IpfCmd.write(cmd);
+            }
+        }
+        switch (deqLane) {
+        case LANE_TAF:  soRDp_TafData.write(chunk); break;
+        case LANE_SINK: soRDp_SnkData.write(chunk); break;
+        case LANE_GEN:  soRDp_GenData.write(chunk); break;
+        default:        soIPs_IpfData.write(chunk); break;
+        }
+        soRRh_DequSig.write(RxDequSig(rbp_deqSess[deqLane], chunk.getLen(), chunk.getTLast()));
+        if (DEBUG_LEVEL & TRACE_RBP) {
+            printInfo(myName, "Dequeue chunk #%3d from lane #%d (SessId=%d).\n",
+                      deqPtr.to_uint(), deqLane.to_uint(), rbp_deqSess[deqLane].to_uint());
+        }
+        rbp_inSeg[deqLane] = !chunk.getTLast();
+        rbp_head[deqLane]  = next;
+        rbp_lastLane       = deqLane;
+        //-- Give the chunk back to the free ring
+        FREE[rbp_freeWrPtr] = deqPtr;
+        rbp_fwdFreeIdx = rbp_freeWrPtr;
+        rbp_fwdFreePtr = deqPtr;
+        rbp_freeWrPtr  = (rbp_freeWrPtr == (cIBuffChunks-1)) ? (ChunkPtr)0 : (ChunkPtr)(rbp_freeWrPtr+1);
+        deqVal = true;
+    }
+
+    //-- ENQUEUE ---------------------------------------------------------------
+    if (!rbp_enqInSeg) {
+        if (!rbp_metaVal and !siIRb_Meta.empty()) {
+            siIRb_Meta.read(rbp_enqMeta);
+            rbp_metaVal = true;
+        }
+        //-- Look up the oldest pending command of the session
+        for (int i=cRbpCmdSlots-1; i>=0; i--) {
+            #pragma HLS UNROLL
+            if ((i < rbp_nrCmds) and (PND_CMD[i].sessId == rbp_enqMeta)) {
+                cmdHit = true;
+                cmdIdx = i;
+            }
+        }
+        if (rbp_metaVal and cmdHit) {
+            rbp_enqCmd = PND_CMD[cmdIdx];
+            for (int i=0; i<cRbpCmdSlots-1; i++) {
+                #pragma HLS UNROLL
+                if (i >= cmdIdx) {
+                    PND_CMD[i] = PND_CMD[i+1];
+                }
+            }
+            rbp_nrCmds -= 1;
+            if (rbp_enqCmd.action == CMD_KEEP) {
+                rbp_enqLane = LANE_TAF;
+            }
+            else if (rbp_enqCmd.dropCode == GEN) {
+                rbp_enqLane = LANE_GEN;
+            }
+            else if ((rbp_enqCmd.dropCode == IPF2) or (rbp_enqCmd.dropCode == IPF3)) {
+                rbp_enqLane = LANE_IPERF;
+            }
+            else {
+                rbp_enqLane = LANE_SINK;
+            }
+            rbp_enqFirst = true;
+            rbp_enqInSeg = true;
+            rbp_metaVal  = false;
+        }
+        else if (rbp_metaVal and (rbp_nrCmds == cRbpCmdSlots)) {
+            printWarn(myName, "Received a segment which was not requested (SessId=%d). It is discarded.\n",
+                      rbp_enqMeta.to_uint());
+            rbp_enqDrop  = true;
+            rbp_enqInSeg = true;
+            rbp_metaVal  = false;
+        }
+    }
+    else if (rbp_enqDrop) {
+        if (!siIRb_Data.empty()) {
+            TcpAppData chunk = siIRb_Data.read();
+            if (chunk.getTLast()) {
+                rbp_enqDrop  = false;
+                rbp_enqInSeg = false;
+            }
+        }
+    }
+    else {
+        bool freshAvail = (rbp_freshPtr != cIBuffChunks);
+        bool freeAvail  = (rbp_freeRdPtr != freeWrPtr);
+        if (!siIRb_Data.empty() and (freshAvail or freeAvail)) {
+            TcpAppData chunk = siIRb_Data.read();
+            //-- Allocate the next tail of the lane
+            ChunkPtr newPtr;
+            if (freshAvail) {
+                newPtr = rbp_freshPtr;
+                rbp_freshPtr += 1;
+            }
+            else {
+                newPtr = (rbp_fwdFreeVal and (rbp_fwdFreeIdx == rbp_freeRdPtr)) ?
+                         rbp_fwdFreePtr : FREE[rbp_freeRdPtr];
+                rbp_freeRdPtr = (rbp_freeRdPtr == (cIBuffChunks-1)) ? (ChunkPtr)0 : (ChunkPtr)(rbp_freeRdPtr+1);
+            }
+            //-- Write the chunk into the current tail
+            enqPtr = rbp_tail[rbp_enqLane];
+            DATA[enqPtr] = chunk;
+            NEXT[enqPtr] = newPtr;
+            if (rbp_enqFirst) {
+                CMD[enqPtr] = rbp_enqCmd;
+            }
+            rbp_tail[rbp_enqLane] = newPtr;
+            rbp_fwdChunkPtr  = enqPtr;
+            rbp_fwdChunkData = chunk;
+            rbp_fwdChunkNext = newPtr;
+            rbp_fwdChunkCmd  = rbp_enqCmd;
+            if (DEBUG_LEVEL & TRACE_RBP) {
+                printInfo(myName, "Enqueue chunk #%3d into lane #%d (SessId=%d).\n",
+                          enqPtr.to_uint(), rbp_enqLane.to_uint(), rbp_enqCmd.sessId.to_uint());
+            }
+            rbp_enqFirst = false;
+            if (chunk.getTLast()) {
+                rbp_enqInSeg = false;
+            }
+            enqVal = true;
+        }
+    }
+
+    //-- Append a new command at the tail of the pending queue
+    if (!siRRh_FwdCmd.empty() and (rbp_nrCmds < cRbpCmdSlots)) {
+        PND_CMD[rbp_nrCmds] = siRRh_FwdCmd.read();
+        rbp_nrCmds += 1;
+    }
+
+    //-- Update the occupancy of the lanes
+    for (int l=0; l<cRxLanes; l++) {
+        #pragma HLS UNROLL
+        bool inc = enqVal and (rbp_enqLane == l);
+        bool dec = deqVal and (deqLane == l);
+        if (inc and !dec) {
+            rbp_avail[l] += 1;
+        }
+        else if (dec and !inc) {
+            rbp_avail[l] -= 1;
+        }
+    }
+
+    //-- Update the write-forwarding registers
+    rbp_fwdChunkVal = enqVal;
+    rbp_fwdFreeVal  = deqVal;
+}
+
 /*******************************************************************************
  * @brief Read Path (RDp)
  *
  * @param[in]  piSHL_Enable     Enable signal from [SHELL].
- * @param[in]  siSHL_Data       Data stream from [SHELL].
- * @param[in]  siSHL_Meta       Session Id from [SHELL].
- * @param[in]  siRRh_FwdCmd     A command to keep/drop a stream from ReadRequestHandler (RRh).
+ * @param[in]  siRbp_TafCmd     The forward command of a segment of the TAF lane from RxBufferPool (Rbp).
+ * @param[in]  siRbp_TafData    Data stream of the TAF  lane from [Rbp].
+ * @param[in]  siRbp_SnkCmd     The forward command of a segment of the SINK lane from [Rbp].
+ * @param[in]  siRbp_SnkData    Data stream of the SINK lane from [Rbp].
+ * @param[in]  siRbp_GenData    Data stream of the GEN  lane from [Rbp].
+ * @param[in]  siMCh_StatReq    A read-out request of the sink statistics from MmioConfigHandler (MCh).
  * @param[out] soCOn_OpnSockReq The remote socket to open to Connect (COn).
- * @param[out] soCOn_TxCountReq The #bytes to be transmitted once connection is opened by [COn].
- * @param[out] soRRh_DequSig    Signals the dequeue of a chunk to ReadRequestHandler (RRh).
- * @param[out] soTAF_Data       Data stream to [TAF].
- * @param[out] soTAF_SessId     The session-id to [TAF].
- * @param[out] soTAF_DatLen     The data-length to [TAF].
- * @param[out] soDBG_SinkCount  Counts the number of sinked bytes (for debug).
+ * @param[out] soCOn_TxCountReq The Tx test request to be served once connection is opened by [COn].
+ * @param[out] soRCo_Data       Data stream to [TAF] (via RxCoalescer (RCo)).
+ * @param[out] soRCo_SessId     The session-id to [TAF] (via [RCo]).
+ * @param[out] soRCo_DatLen     The data-length to [TAF] (via [RCo]).
+ * @param[out] soSHL_SinkStats  The sink statistics read out by [SHELL/MMIO].
+ * @param[out] soDBG_SinkCnt    The number of bytes sunk by all sessions (for debug).
+ *
+ * @details
+ *  This process drains the lanes of the RxBufferPool (Rbp) which already sorted
+ *   the incoming segments according to the forward command issued for them by
+ *   the ReadRequestHandler (RRh). Every lane is served by its own state machine
+ *   such that the lanes progress independently of each other.
+ *   - The TAF lane is forwarded to the next layer together with its metadata.
+ *     As such, [RDp] implements a pipe for the TCP traffic from [SHELL] to [TAF].
+ *     The metadata of a segment are forwarded in the same cycle as its first
+ *     chunk, such that back-to-back segments stream at one chunk per cycle.
+ *   - The SINK lane is dropped and accounted per session (see 'SinkStats').
+ *     The bytes of a segment are summed up while it is sunk at a rate of one
+ *     chunk per cycle, and the statistics table of its session is updated
+ *     once with the whole segment upon its last chunk. The bytes-per-interval
+ *     rate is rolled over lazily: every entry is tagged with the interval it
+ *     was last updated in, such that the table does not have to be swept at
+ *     the end of an interval. A read-out request is served in a cycle without
+ *     update, and the read-after-write hazard between two consecutive
+ *     iterations is resolved with write-forwarding registers. The aggregate
+ *     byte count is also mirrored on 'soDBG_SinkCnt' for an ILA probe.
+ *   - The GEN lane carries the segments of the transmit test mode. The remote
+ *     socket to connect to as well as the number of bytes to transmit are
+ *     extracted out of the 64 first incoming bits of every segment and are
+ *     forwarded to the Connect (COn) process. If the 16-bit length is null and
+ *     the segment carries a second chunk, the latter holds a 48-bit length and
+ *     a repeat count (see 'TxTestReq'). The rest of the segment is dropped.
+ *******************************************************************************/
+void pReadPath(
+        CmdBit               *piSHL_Enable,
+        stream<ForwardCmd>   &siRbp_TafCmd,
+        stream<TcpAppData>   &siRbp_TafData,
+        stream<ForwardCmd>   &siRbp_SnkCmd,
+        stream<TcpAppData>   &siRbp_SnkData,
+        stream<TcpAppData>   &siRbp_GenData,
+        stream<ap_uint<16> > &siMCh_StatReq,
+        stream<SockAddr>     &soCOn_OpnSockReq,
+        stream<TxTestReq>    &soCOn_TxCountReq,
+        stream<TcpAppData>   &soRCo_Data,
+        stream<TcpSessId>    &soRCo_SessId,
+        stream<TcpDatLen>    &soRCo_DatLen,
+        stream<SinkStats>    &soSHL_SinkStats,
+        stream<ap_uint<32> > &soDBG_SinkCnt)
+{
+    //-- DIRECTIVES FOR THIS PROCESS -------------------------------------------
+    #pragma HLS INLINE off
+    #pragma HLS PIPELINE II=1 enable_flush
+
+    const char *myName  = concat3(THIS_NAME, "/", "RDp");
+
+  #ifndef __SYNTHESIS__
+    const ap_uint<28> cSnkInterval = 4096;       // Rate interval (in cycles)
+  #else
+    const ap_uint<28> cSnkInterval = 156250000;  // 1 second at 156.25 MHz
+  #endif
+
+    //-- STATIC ARRAYS (Sink statistics) ---------------------------------------
+    static ap_uint<64>                        SNK_BYTES[cMaxSessions];
+    #pragma HLS RESOURCE             variable=SNK_BYTES core=RAM_2P
+    #pragma HLS DEPENDENCE           variable=SNK_BYTES inter false
+    static ap_uint<64>                        SNK_SEGS[cMaxSessions];
+    #pragma HLS RESOURCE             variable=SNK_SEGS  core=RAM_2P
+    #pragma HLS DEPENDENCE           variable=SNK_SEGS  inter false
+    static ap_uint<32>                        SNK_IVAL[cMaxSessions];   // #Bytes sunk during interval 'SNK_EPOCH'
+    #pragma HLS RESOURCE             variable=SNK_IVAL  core=RAM_2P
+    #pragma HLS DEPENDENCE           variable=SNK_IVAL  inter false
+    static ap_uint<32>                        SNK_RATE[cMaxSessions];   // #Bytes sunk during interval 'SNK_EPOCH'-1
+    #pragma HLS RESOURCE             variable=SNK_RATE  core=RAM_2P
+    #pragma HLS DEPENDENCE           variable=SNK_RATE  inter false
+    static SnkEpoch                           SNK_EPOCH[cMaxSessions];  // Interval of the last update
+    #pragma HLS RESOURCE             variable=SNK_EPOCH core=RAM_2P
+    #pragma HLS DEPENDENCE           variable=SNK_EPOCH inter false
+
+    //-- STATIC CONTROL VARIABLES (with RESET) ---------------------------------
+    static enum GenStates { RDP_8801=0,     RDP_8801_EXT, RDP_GEN_SINK } \
+                               rdp_genState=RDP_8801;
+    #pragma HLS reset variable=rdp_genState
+    static bool                rdp_isInit=false;
+    #pragma HLS reset variable=rdp_isInit
+    static ap_uint<log2Ceil<cMaxSessions>::val> rdp_initEntry=0;
+    #pragma HLS reset variable=rdp_initEntry
+    static bool                rdp_tafInSeg=false;
+    #pragma HLS reset variable=rdp_tafInSeg
+    static bool                rdp_snkInSeg=false;
+    #pragma HLS reset variable=rdp_snkInSeg
+    static bool                rdp_fwdVal=false;
+    #pragma HLS reset variable=rdp_fwdVal
+    static ap_uint<28>         rdp_timer=0;
+    #pragma HLS reset variable=rdp_timer
+    static SnkEpoch            rdp_epoch=0;
+    #pragma HLS reset variable=rdp_epoch
+    static ap_uint<64>         rdp_totBytes=0;
+    #pragma HLS reset variable=rdp_totBytes
+    static ap_uint<64>         rdp_totSegs=0;
+    #pragma HLS reset variable=rdp_totSegs
+    static ap_uint<32>         rdp_totIval=0;
+    #pragma HLS reset variable=rdp_totIval
+    static ap_uint<32>         rdp_totRate=0;
+    #pragma HLS reset variable=rdp_totRate
+
+    //-- STATIC DATAFLOW VARIABLES ---------------------------------------------
+    static SessionId           rdp_snkSess;
+    static SockAddr            rdp_genSock;   // The socket of an extended Tx test command
+    static ap_uint<32>         rdp_snkBytes;  // #Bytes of the current sink segment
+
+    //-- STATIC DATAFLOW VARIABLES (Write-Forwarding Registers) ----------------
+    static SessionId           rdp_fwdSess;
+    static ap_uint<64>         rdp_fwdBytes;
+    static ap_uint<64>         rdp_fwdSegs;
+    static ap_uint<32>         rdp_fwdIval;
+    static ap_uint<32>         rdp_fwdRate;
+    static SnkEpoch            rdp_fwdEpoch;
+
+    //-- DYNAMIC VARIABLES -----------------------------------------------------
+    TcpAppData  appData;
+    bool        commit = false;  // The statistics of 'rdp_snkSess' are updated
+
+    if (*piSHL_Enable != 1) {
+        return;
+    }
+
+    if (!rdp_isInit) {
+        //-- Clear the statistics table, one entry per cycle
+        SNK_BYTES[rdp_initEntry] = 0;
+        SNK_SEGS[rdp_initEntry]  = 0;
+        SNK_IVAL[rdp_initEntry]  = 0;
+        SNK_RATE[rdp_initEntry]  = 0;
+        SNK_EPOCH[rdp_initEntry] = 0;
+        if (rdp_initEntry == cMaxSessions-1) {
+            rdp_isInit = true;
+        }
+        rdp_initEntry += 1;
+    }
+
+    //-- TAF LANE --------------------------------------------------------------
+    if (!siRbp_TafData.empty() and !soRCo_Data.full() and
+        (rdp_tafInSeg or (!siRbp_TafCmd.empty() and !soRCo_SessId.full() and !soRCo_DatLen.full()))) {
+        if (!rdp_tafInSeg) {
+            //-- The metadata are forwarded along with the first chunk of the segment
+            ForwardCmd fwdCmd = siRbp_TafCmd.read();
+            soRCo_SessId.write(fwdCmd.sessId);
+            soRCo_DatLen.write(fwdCmd.datLen);
+            if (DEBUG_LEVEL & TRACE_RDP) {
+                printInfo(myName, "soRCo_SessId = %d \n", fwdCmd.sessId.to_uint());
+                printInfo(myName, "soRCo_DatLen = %d \n", fwdCmd.datLen.to_uint());
+            }
+        }
+        siRbp_TafData.read(appData);
+        soRCo_Data.write(appData);
+        if (DEBUG_LEVEL & TRACE_RDP) { printAxisRaw(myName, "soRCo_Data =", appData); }
+        rdp_tafInSeg = !appData.getTLast();
+    }
+
+    //-- SINK LANE -------------------------------------------------------------
+    if (rdp_isInit and !siRbp_SnkData.empty() and (rdp_snkInSeg or !siRbp_SnkCmd.empty())) {
+        if (!rdp_snkInSeg) {
+            //-- The command comes along with the first chunk of the segment
+            ForwardCmd fwdCmd = siRbp_SnkCmd.read();
+            rdp_snkSess  = fwdCmd.sessId;
+            rdp_snkBytes = 0;
+        }
+        siRbp_SnkData.read(appData);
+        if (DEBUG_LEVEL & TRACE_RDP) { printAxisRaw(myName, "Sink Data =", appData); }
+        rdp_snkBytes += appData.getLen();
+        rdp_snkInSeg  = !appData.getTLast();
+        commit        = appData.getTLast();
+    }
+
+    //-- GEN LANE --------------------------------------------------------------
+    switch (rdp_genState) {
+    case RDP_8801:
+        if (!siRbp_GenData.empty() and !soCOn_OpnSockReq.full() and !soCOn_TxCountReq.full()) {
+            // Extract the remote socket address and the requested #bytes to transmit
+            siRbp_GenData.read(appData);
+            SockAddr sockToOpen(byteSwap32(appData.getLE_TData(31,  0)),   // IP4 address
+                                byteSwap16(appData.getLE_TData(47, 32)));  // TCP port
+            TcpDatLen bytesToSend = byteSwap16(appData.getLE_TData(63, 48));
+            if ((bytesToSend == 0) and !appData.getTLast()) {
+                //-- An extended command. The length comes with the next chunk.
+                rdp_genSock  = sockToOpen;
+                rdp_genState = RDP_8801_EXT;
+            }
+            else {
+                soCOn_OpnSockReq.write(sockToOpen);
+                soCOn_TxCountReq.write(TxTestReq(bytesToSend, 1));
+                if (DEBUG_LEVEL & TRACE_RDP) {
+                    printInfo(myName, "Received request for Tx test mode to generate a segment of length=%d and to send it to socket:\n",
+                              bytesToSend.to_int());
+                    printSockAddr(myName, sockToOpen);
+                }
+                if (!appData.getTLast()) {
+                    rdp_genState = RDP_GEN_SINK;
+                }
+            }
+        }
+        break;
+    case RDP_8801_EXT:
+        if (!siRbp_GenData.empty() and !soCOn_OpnSockReq.full() and !soCOn_TxCountReq.full()) {
+            // Extract the 48-bit #bytes to transmit and the repeat count
+            siRbp_GenData.read(appData);
+            TxTestLen   bytesToSend;
+            bytesToSend(47,16) = byteSwap32(appData.getLE_TData(31,  0));
+            bytesToSend(15, 0) = byteSwap16(appData.getLE_TData(47, 32));
+            ap_uint<16> repeat = byteSwap16(appData.getLE_TData(63, 48));
+            if (repeat == 0) {
+                repeat = 1;
+            }
+            soCOn_OpnSockReq.write(rdp_genSock);
+            soCOn_TxCountReq.write(TxTestReq(bytesToSend, repeat));
+            if (DEBUG_LEVEL & TRACE_RDP) {
+                printInfo(myName, "Received request for Tx test mode to generate %d times a transfer of length=%ld and to send it to socket:\n",
+                          repeat.to_uint(), (unsigned long)bytesToSend.to_uint64());
+                printSockAddr(myName, rdp_genSock);
+            }
+            rdp_genState = (appData.getTLast()) ? RDP_8801 : RDP_GEN_SINK;
+        }
+        break;
+    case RDP_GEN_SINK:
+        if (!siRbp_GenData.empty()) {
+            siRbp_GenData.read(appData);
+            if (DEBUG_LEVEL & TRACE_RDP) { printAxisRaw(myName, "Sink Data =", appData); }
+            if (appData.getTLast()) {
+                rdp_genState = RDP_8801;
+            }
+        }
+        break;
+    }
+
+    //-- SINK STATISTICS -------------------------------------------------------
+    SnkEpoch prevEpoch = rdp_epoch - 1;
+    if (commit) {
+        SessionId   sessId = rdp_snkSess;
+        bool        isFwd  = rdp_fwdVal and (rdp_fwdSess == sessId);
+        ap_uint<64> bytes  = (isFwd) ? rdp_fwdBytes : SNK_BYTES[sessId];
+        ap_uint<64> segs   = (isFwd) ? rdp_fwdSegs  : SNK_SEGS[sessId];
+        ap_uint<32> ival   = (isFwd) ? rdp_fwdIval  : SNK_IVAL[sessId];
+        ap_uint<32> rate   = (isFwd) ? rdp_fwdRate  : SNK_RATE[sessId];
+        SnkEpoch    epoch  = (isFwd) ? rdp_fwdEpoch : SNK_EPOCH[sessId];
+        if (epoch != rdp_epoch) {
+            //-- First update of the session during the current interval
+            rate = (epoch == prevEpoch) ? ival : (ap_uint<32>)0;
+            ival = 0;
+        }
+        bytes += rdp_snkBytes;
+        segs  += 1;
+        ival  += rdp_snkBytes;
+        SNK_BYTES[sessId] = bytes;
+        SNK_SEGS[sessId]  = segs;
+        SNK_IVAL[sessId]  = ival;
+        SNK_RATE[sessId]  = rate;
+        SNK_EPOCH[sessId] = rdp_epoch;
+        rdp_fwdSess  = sessId;
+        rdp_fwdBytes = bytes;
+        rdp_fwdSegs  = segs;
+        rdp_fwdIval  = ival;
+        rdp_fwdRate  = rate;
+        rdp_fwdEpoch = rdp_epoch;
+        rdp_totBytes += rdp_snkBytes;
+        rdp_totSegs  += 1;
+        rdp_totIval  += rdp_snkBytes;
+        if (!soDBG_SinkCnt.full()) {
+            soDBG_SinkCnt.write(rdp_totBytes(31, 0));
+        }
+        if (DEBUG_LEVEL & TRACE_RDP) {
+            printInfo(myName, "Session #%d sunk a segment of %d bytes (%ld bytes in total).\n",
+                      sessId.to_uint(), rdp_snkBytes.to_uint(), (unsigned long)bytes.to_uint64());
+        }
+    }
+    else if (rdp_isInit and !siMCh_StatReq.empty() and !soSHL_SinkStats.full()) {
+        //-- Read-out of the statistics of a session, or of their aggregate
+        ap_uint<16> index = siMCh_StatReq.read();
+        SinkStats   stats(index, rdp_totBytes, rdp_totSegs, rdp_totRate);
+        if (index != cSinkStatsAll) {
+            SessionId   sessId = index;
+            bool        isFwd  = rdp_fwdVal and (rdp_fwdSess == sessId);
+            ap_uint<32> ival   = (isFwd) ? rdp_fwdIval  : SNK_IVAL[sessId];
+            ap_uint<32> rate   = (isFwd) ? rdp_fwdRate  : SNK_RATE[sessId];
+            SnkEpoch    epoch  = (isFwd) ? rdp_fwdEpoch : SNK_EPOCH[sessId];
+            stats.bytes = (isFwd) ? rdp_fwdBytes : SNK_BYTES[sessId];
+            stats.segs  = (isFwd) ? rdp_fwdSegs  : SNK_SEGS[sessId];
+            stats.rate  = (epoch == rdp_epoch) ? rate :
+                          (epoch == prevEpoch) ? ival : (ap_uint<32>)0;
+        }
+        soSHL_SinkStats.write(stats);
+        if (DEBUG_LEVEL & TRACE_RDP) {
+            printInfo(myName, "Sink statistics of entry #%d: %ld bytes, %ld segments, %d bytes/interval.\n",
+                      index.to_uint(), (unsigned long)stats.bytes.to_uint64(),
+                      (unsigned long)stats.segs.to_uint64(), stats.rate.to_uint());
+        }
+    }
+    rdp_fwdVal = commit;
+
+    //-- INTERVAL TIMER (after the update, which is accounted in the closing interval)
+    if (rdp_timer == cSnkInterval-1) {
+        rdp_timer   = 0;
+        rdp_epoch  += 1;
+        rdp_totRate = rdp_totIval;
+        rdp_totIval = 0;
+    }
+    else {
+        rdp_timer += 1;
+    }
+}
+
+/*******************************************************************************
+ * @brief Rx Coalescer (RCo)
+ *
+ * @param[in]  piSHL_Enable  Enable signal from [SHELL].
+ * @param[in]  siMCh_CoaCfg  A setting of the Rx coalescing from MmioConfigHandler (MCh).
+ * @param[in]  siRDp_Data    Data stream of the TAF lane from ReadPath (RDp).
+ * @param[in]  siRDp_SessId  The session-id from [RDp].
+ * @param[in]  siRDp_DatLen  The data-length from [RDp].
+ * @param[out] soTAF_Data    Data stream to [TAF].
+ * @param[out] soTAF_SessId  The session-id to [TAF].
+ * @param[out] soTAF_DatLen  The data-length to [TAF].
+ *
+ * @details
+ *  This process merges consecutive segments of the same session into a single
+ *   message to [TAF], such that a peer which sends many tiny writes does not
+ *   cost one [TAF] message per segment. Coalescing is disabled by default
+ *   ('COA_CFG_BYTES'=0), in which case the segments are cut through with their
+ *   metadata along with their first chunk.
+ *  Otherwise, the length of a message must be known before its first chunk is
+ *   forwarded, and the segments are therefore stored into a buffer of
+ *   'cRcoBufChunks' chunks while their message is accumulated. A segment is
+ *   appended right behind the last byte of its message. The bytes which do
+ *   not fill up a whole chunk yet are held in a tail register, which is queued
+ *   along with the message once it is closed. A message is closed as soon as:
+ *   - it holds 'COA_CFG_BYTES' bytes or more, or the next segment does not
+ *     fit within that threshold,
+ *   - the next segment belongs to another session, or
+ *   - 'COA_CFG_TIMEOUT' cycles have elapsed since its first segment.
+ *  The queued messages are forwarded out of the same buffer at one chunk per
+ *   cycle while the next message is accumulated. A segment longer than
+ *   'cRcoMaxBytes' is cut through once all the queued messages are forwarded.
+ *******************************************************************************/
+void pRxCoalescer(
+        CmdBit               *piSHL_Enable,
+        stream<RxCoaCfg>     &siMCh_CoaCfg,
+        stream<TcpAppData>   &siRDp_Data,
+        stream<TcpSessId>    &siRDp_SessId,
+        stream<TcpDatLen>    &siRDp_DatLen,
+        stream<TcpAppData>   &soTAF_Data,
+        stream<TcpSessId>    &soTAF_SessId,
+        stream<TcpDatLen>    &soTAF_DatLen)
+{
+    //-- DIRECTIVES FOR THIS PROCESS -------------------------------------------
+    #pragma HLS INLINE off
+    #pragma HLS PIPELINE II=1 enable_flush
+
+    const char *myName  = concat3(THIS_NAME, "/", "RCo");
+
+    //-- STATIC ARRAYS ---------------------------------------------------------
+    static ap_uint<64>         RCO_BUF[cRcoBufChunks];   // The full chunks of the messages
+    #pragma HLS RESOURCE        variable=RCO_BUF  core=RAM_2P
+    #pragma HLS DEPENDENCE      variable=RCO_BUF  inter false
+    static TcpSessId           MSG_SESS[cRcoMsgSlots];
+    #pragma HLS ARRAY_PARTITION variable=MSG_SESS complete dim=1
+    static TcpDatLen           MSG_LEN[cRcoMsgSlots];
+    #pragma HLS ARRAY_PARTITION variable=MSG_LEN  complete dim=1
+    static ap_uint<64>         MSG_TAIL[cRcoMsgSlots];   // The last partial chunk of the message
+    #pragma HLS ARRAY_PARTITION variable=MSG_TAIL complete dim=1
+
+    //-- STATIC CONTROL VARIABLES (with RESET) ---------------------------------
+    static ap_uint<16>         rco_thres=0;    // Flush threshold (in bytes, 0=disabled)
+    #pragma HLS reset variable=rco_thres
+    static ap_uint<16>         rco_tmo=cRcoDefTimeout;
+    #pragma HLS reset variable=rco_tmo
+    static ap_uint<16>         rco_timer=0;    // #Cycles since the first segment of the open message
+    #pragma HLS reset variable=rco_timer
+    static bool                rco_open=false; // A message is being accumulated
+    #pragma HLS reset variable=rco_open
+    static bool                rco_inSeg=false;
+    #pragma HLS reset variable=rco_inSeg
+    static bool                rco_cut=false;  // The current segment is cut through
+    #pragma HLS reset variable=rco_cut
+    static bool                rco_nxtVal=false;
+    #pragma HLS reset variable=rco_nxtVal
+    static bool                rco_outMsg=false;
+    #pragma HLS reset variable=rco_outMsg
+    static ap_uint<log2Ceil<cRcoBufChunks>::val>   rco_wrPtr=0;
+    #pragma HLS reset variable=rco_wrPtr
+    static ap_uint<log2Ceil<cRcoBufChunks>::val>   rco_rdPtr=0;
+    #pragma HLS reset variable=rco_rdPtr
+    static ap_uint<log2Ceil<cRcoBufChunks+1>::val> rco_used=0;  // #Chunks held in the buffer
+    #pragma HLS reset variable=rco_used
+    static ap_uint<log2Ceil<cRcoMsgSlots>::val>    rco_msgWr=0;
+    #pragma HLS reset variable=rco_msgWr
+    static ap_uint<log2Ceil<cRcoMsgSlots>::val>    rco_msgRd=0;
+    #pragma HLS reset variable=rco_msgRd
+    static ap_uint<log2Ceil<cRcoMsgSlots+1>::val>  rco_msgCnt=0;
+    #pragma HLS reset variable=rco_msgCnt
+
+    //-- STATIC DATAFLOW VARIABLES ---------------------------------------------
+    static TcpSessId           rco_sess;     // The session of the open message
+    static ap_uint<17>         rco_len;      // #Bytes of the open message
+    static ap_uint<64>         rco_tail;     // The bytes of the open message which do not fill a chunk yet
+    static TcpSessId           rco_nxtSess;  // The metadata of the next segment
+    static TcpDatLen           rco_nxtLen;
+    static TcpDatLen           rco_outLeft;  // #Bytes left to forward of the current message
+
+    //-- DYNAMIC VARIABLES -----------------------------------------------------
+    TcpAppData  appData;
+    bool        push    = false;  // A message is queued
+    bool        pop     = false;  // A message is forwarded
+    bool        wrChunk = false;
+    bool        rdChunk = false;
+    bool        store   = false;  // A chunk is appended to the open message
+    bool        idle    = (rco_msgCnt == 0) and !rco_outMsg;
+
+    if (*piSHL_Enable != 1) {
+        return;
+    }
+
+    if (!siMCh_CoaCfg.empty()) {
+        RxCoaCfg coaCfg = siMCh_CoaCfg.read();
+        if (coaCfg.field == COA_CFG_BYTES) {
+            rco_thres = coaCfg.value;
+        }
+        else {
+            rco_tmo   = coaCfg.value;
+        }
+    }
+
+    //-- FORWARD THE QUEUED MESSAGES -------------------------------------------
+    if (!soTAF_Data.full() and
+        (rco_outMsg or ((rco_msgCnt != 0) and !soTAF_SessId.full() and !soTAF_DatLen.full()))) {
+        TcpDatLen left = (rco_outMsg) ? rco_outLeft : MSG_LEN[rco_msgRd];
+        if (!rco_outMsg) {
+            //-- The metadata come along with the first chunk of the message
+            soTAF_SessId.write(MSG_SESS[rco_msgRd]);
+            soTAF_DatLen.write(MSG_LEN[rco_msgRd]);
+            if (DEBUG_LEVEL & TRACE_RCO) {
+                printInfo(myName, "Forwarding a message of %d bytes for session #%d.\n",
+                          MSG_LEN[rco_msgRd].to_uint(), MSG_SESS[rco_msgRd].to_uint());
+            }
+        }
+        if (left >= (ARW/8)) {
+            appData = TcpAppData(RCO_BUF[rco_rdPtr], 0xFF, (left == (ARW/8)) ? TLAST : 0);
+            rco_rdPtr += 1;
+            rdChunk = true;
+        }
+        else {
+            appData = TcpAppData(MSG_TAIL[rco_msgRd], lenToLE_tKeep(left), TLAST);
+        }
+        if (left <= (ARW/8)) {
+            rco_outMsg = false;
+            rco_msgRd += 1;
+            pop = true;
+        }
+        else {
+            rco_outMsg = true;
+        }
+        rco_outLeft = left - (ARW/8);
+        soTAF_Data.write(appData);
+    }
+
+    //-- CLOSE THE OPEN MESSAGE ------------------------------------------------
+    if (!rco_nxtVal and !siRDp_SessId.empty() and !siRDp_DatLen.empty()) {
+        siRDp_SessId.read(rco_nxtSess);
+        siRDp_DatLen.read(rco_nxtLen);
+        rco_nxtVal = true;
+    }
+    bool misfit = rco_nxtVal and ((rco_nxtSess != rco_sess) or (rco_len + rco_nxtLen > rco_thres));
+    if (rco_open and !rco_inSeg and (rco_msgCnt != cRcoMsgSlots) and
+        ((rco_len >= rco_thres) or (rco_timer >= rco_tmo) or misfit)) {
+        MSG_SESS[rco_msgWr] = rco_sess;
+        MSG_LEN[rco_msgWr]  = rco_len;
+        MSG_TAIL[rco_msgWr] = rco_tail;
+        rco_msgWr += 1;
+        rco_open = false;
+        push = true;
+    }
+    else if (rco_open and (rco_timer < rco_tmo)) {
+        rco_timer += 1;
+    }
+
+    //-- ACCUMULATE THE INCOMING SEGMENTS --------------------------------------
+    if (!rco_inSeg) {
+        bool large  = (rco_nxtLen > cRcoMaxBytes);
+        bool bypass = ((rco_thres == 0) or large) and !rco_open and !push and idle;
+        bool fits   = (rco_used + (rco_nxtLen + (ARW/8) - 1) / (ARW/8)) <= cRcoBufChunks;
+        if (rco_nxtVal and !siRDp_Data.empty()) {
+            if (bypass and !soTAF_SessId.full() and !soTAF_DatLen.full() and !soTAF_Data.full()) {
+                //-- Cut the segment through, along with its metadata
+                soTAF_SessId.write(rco_nxtSess);
+                soTAF_DatLen.write(rco_nxtLen);
+                siRDp_Data.read(appData);
+                soTAF_Data.write(appData);
+                rco_nxtVal = false;
+                rco_cut    = true;
+                rco_inSeg  = !appData.getTLast();
+            }
+            else if ((rco_thres != 0) and !large and fits and (!rco_open or !misfit)) {
+                //-- Append the segment to the open message (or open a new one)
+                if (!rco_open) {
+                    rco_open  = true;
+                    rco_sess  = rco_nxtSess;
+                    rco_len   = 0;
+                    rco_tail  = 0;
+                    rco_timer = 0;
+                }
+                siRDp_Data.read(appData);
+                rco_nxtVal = false;
+                rco_cut    = false;
+                store      = true;
+            }
+        }
+    }
+    else if (!siRDp_Data.empty()) {
+        if (rco_cut) {
+            if (!soTAF_Data.full()) {
+                siRDp_Data.read(appData);
+                soTAF_Data.write(appData);
+                rco_inSeg = !appData.getTLast();
+            }
+        }
+        else {
+            siRDp_Data.read(appData);
+            store = true;
+        }
+    }
+
+    if (store) {
+        //-- Append the bytes of the chunk behind the tail of the open message
+        appData.clearUnusedBytes();
+        ap_uint<3>  offset = rco_len(2,0);
+        ap_uint<4>  nrBytes = appData.getLen();
+        ap_uint<64> data = appData.getLE_TData();
+        ap_uint<64> word = rco_tail;
+        ap_uint<64> spill = 0;
+        if (offset == 0) {
+            word = data;
+        }
+        else {
+            word  = rco_tail | (data << (8*offset.to_uint()));
+            spill = data >> (ARW - 8*offset.to_uint());
+        }
+        if ((offset + nrBytes) >= (ARW/8)) {
+            RCO_BUF[rco_wrPtr] = word;
+            rco_wrPtr += 1;
+            wrChunk   = true;
+            rco_tail  = spill;
+        }
+        else {
+            rco_tail  = word;
+        }
+        rco_len  += nrBytes;
+        rco_inSeg = !appData.getTLast();
+        if (DEBUG_LEVEL & TRACE_RCO) { printAxisRaw(myName, "Appending siRDp_Data =", appData); }
+    }
+
+    if (wrChunk and !rdChunk) {
+        rco_used += 1;
+    }
+    else if (rdChunk and !wrChunk) {
+        rco_used -= 1;
+    }
+    if (push and !pop) {
+        rco_msgCnt += 1;
+    }
+    else if (pop and !push) {
+        rco_msgCnt -= 1;
+    }
+}
+
+/*******************************************************************************
+ * @brief Iperf Server (IPs)
+ *
+ * @param[in]  piSHL_Enable    Enable signal from [SHELL].
+ * @param[in]  siRbp_IpfCmd    The forward command of a segment of the IPERF lane from RxBufferPool (Rbp).
+ * @param[in]  siRbp_IpfData   Data stream of the IPERF lane from [Rbp].
+ * @param[out] soTMx_Data      Tx data stream to TxMultiplexer (TMx).
+ * @param[out] soTMx_SessId    The session-id of a Tx message to [TMx].
+ * @param[out] soTMx_DatLen    The length of a Tx message to [TMx].
+ * @param[out] soDBG_IpfReport The per-session byte/interval reports (for debug).
+ *
+ * @details
+ *  This process implements the server side of iperf2 (port 5001) and iperf3
+ *   (port 5201), such that a standard iperf client measures the receive
+ *   throughput of the FPGA without any echo loading the link in return.
+ *   Every session is assigned an entry of a session table upon its first
+ *   segment. The entries are looked up in parallel and the bytes of a chunk
+ *   are accounted at a rate of one chunk per cycle.
+ *   - An iperf2 session is a plain sink since the client does not expect any
+ *     answer during a TCP test.
+ *   - The first iperf3 session which shows up while no test is running is the
+ *     control channel of a new test, and the sessions which follow are its
+ *     data streams. The control channel is parsed one byte per cycle and is
+ *     answered with the state codes of the protocol (see 'IperfState'):
+ *     PARAM_EXCHANGE after the cookie, CREATE_STREAMS after the parameters
+ *     (from which the '"parallel"' number of streams is extracted), TEST_START
+ *     and TEST_RUNNING once all the streams are connected, EXCHANGE_RESULTS
+ *     upon TEST_END, and finally the results of the server followed by
+ *     DISPLAY_RESULTS once the results of the client were received. The
+ *     results hold the number of bytes received by every data stream (its
+ *     cookie excluded). The numbers are right-aligned with blanks within
+ *     fixed-width fields, such that the length of the JSON string is known
+ *     before it is sent out.
+ *  Every 'cIpfInterval' cycles, the session table is scanned one entry per
+ *   cycle and a report with the bytes received during the interval and since
+ *   the beginning of the session is issued for every data session. Since the
+ *   end of a connection is not notified, an iperf2 session is released after
+ *   'cIpfIdleIvals' idle intervals. The sessions of an iperf3 test are released
+ *   upon IPERF_DONE or CLIENT_TERMINATE, or once the whole test stayed idle
+ *   for 'cIpfIdleIvals' intervals.
+ *
+ * @warning
+ *  A single iperf3 test runs at a time. A new iperf3 session which shows up
+ *   while a test is running is accounted as a data stream of that test.
+ *******************************************************************************/
+void pIperfServer(
+        CmdBit               *piSHL_Enable,
+        stream<ForwardCmd>   &siRbp_IpfCmd,
+        stream<TcpAppData>   &siRbp_IpfData,
+        stream<TcpAppData>   &soTMx_Data,
+        stream<TcpSessId>    &soTMx_SessId,
+        stream<TcpDatLen>    &soTMx_DatLen,
+        stream<IperfReport>  &soDBG_IpfReport)
+{
+    //-- DIRECTIVES FOR THIS PROCESS -------------------------------------------
+    #pragma HLS INLINE off
+    #pragma HLS PIPELINE II=1 enable_flush
+
+    const char *myName  = concat3(THIS_NAME, "/", "IPs");
+
+  #ifndef __SYNTHESIS__
+    const ap_uint<28> cIpfInterval = 4096;       // Report interval (in cycles)
+  #else
+    const ap_uint<28> cIpfInterval = 156250000;  // 1 second at 156.25 MHz
+  #endif
+
+    //-- The fragments of the JSON results of the server (see 'IPS_JSON')
+    const int cJsonHdrLen = 96;  // '{"cpu_util_total":0,...,"streams":['
+    const int cJsonStrLen = 90;  // ',{"id":' + 3 digits + ',"bytes":' + 20 digits + ',"retransmits":0,...}'
+    const int cJsonTrlLen =  2;  // ']}'
+    const int cJsonStr0   = cJsonHdrLen;
+    const int cJsonStr1   = cJsonStr0 + 7;
+    const int cJsonStr2   = cJsonStr1 + 9;
+    const int cJsonTrl    = cJsonStr2 + 51;
+
+    //-- STATIC ARRAYS (Read-only) ---------------------------------------------
+    static const char          IPS_JSON[] =
+        "{\"cpu_util_total\":0,\"cpu_util_user\":0,\"cpu_util_system\":0,\"sender_has_retransmits\":0,\"streams\":["
+        ",{\"id\":"
+        ",\"bytes\":"
+        ",\"retransmits\":0,\"jitter\":0,\"errors\":0,\"packets\":0}"
+        "]}";
+    static const char          IPS_PARALLEL[] = "\"parallel\":";
+    static const ap_uint<64>   POW10[20] = {
+        1ULL,                    10ULL,                    100ULL,                    1000ULL,
+        10000ULL,                100000ULL,                1000000ULL,                10000000ULL,
+        100000000ULL,            1000000000ULL,            10000000000ULL,            100000000000ULL,
+        1000000000000ULL,        10000000000000ULL,        100000000000000ULL,        1000000000000000ULL,
+        10000000000000000ULL,    100000000000000000ULL,    1000000000000000000ULL,    10000000000000000000ULL };
+
+    //-- STATIC ARRAYS (Session table) -----------------------------------------
+    static bool                IPF_VALID[cIpfSessions];
+    #pragma HLS ARRAY_PARTITION variable=IPF_VALID  complete dim=1
+    #pragma HLS reset           variable=IPF_VALID
+    static SessionId           IPF_SESS[cIpfSessions];
+    #pragma HLS ARRAY_PARTITION variable=IPF_SESS   complete dim=1
+    static bool                IPF_VER3[cIpfSessions];   // iperf3 (or iperf2) session
+    #pragma HLS ARRAY_PARTITION variable=IPF_VER3   complete dim=1
+    static bool                IPF_CTRL[cIpfSessions];   // Control channel of the iperf3 test
+    #pragma HLS ARRAY_PARTITION variable=IPF_CTRL   complete dim=1
+    static bool                IPF_CLOSE[cIpfSessions];  // To be released by the next scan
+    #pragma HLS ARRAY_PARTITION variable=IPF_CLOSE  complete dim=1
+    static ap_uint<8>          IPF_STREAM[cIpfSessions]; // Stream id of an iperf3 data stream
+    #pragma HLS ARRAY_PARTITION variable=IPF_STREAM complete dim=1
+    static ap_uint<64>         IPF_BYTES[cIpfSessions];
+    #pragma HLS ARRAY_PARTITION variable=IPF_BYTES  complete dim=1
+    static ap_uint<32>         IPF_IVAL[cIpfSessions];
+    #pragma HLS ARRAY_PARTITION variable=IPF_IVAL   complete dim=1
+    static ap_uint<6>          IPF_SKIP[cIpfSessions];   // #Cookie bytes left to skip
+    #pragma HLS ARRAY_PARTITION variable=IPF_SKIP   complete dim=1
+    static ap_uint<log2Ceil<cIpfIdleIvals+1>::val> IPF_IDLE[cIpfSessions];
+    #pragma HLS ARRAY_PARTITION variable=IPF_IDLE   complete dim=1
+
+    //-- STATIC CONTROL VARIABLES (with RESET) ---------------------------------
+    static enum CtlStates { CTL_IDLE=0, CTL_COOKIE, CTL_PLEN, CTL_PARAMS, CTL_STREAMS,
+                            CTL_RUNNING, CTL_RLEN, CTL_RESULTS, CTL_DONE } \
+                               ips_ctlState=CTL_IDLE;
+    #pragma HLS reset variable=ips_ctlState
+    static enum TxSteps   { TXS_IDLE=0, TXS_CODE, TXS_LEN, TXS_ROM, TXS_ENTRY, TXS_NUM, TXS_DISP } \
+                               ips_txStep=TXS_IDLE;
+    #pragma HLS reset variable=ips_txStep
+    static bool                ips_inSeg=false;
+    #pragma HLS reset variable=ips_inSeg
+    static bool                ips_chunkVal=false;
+    #pragma HLS reset variable=ips_chunkVal
+    static bool                ips_testOn=false;
+    #pragma HLS reset variable=ips_testOn
+    static bool                ips_txReqVal=false;
+    #pragma HLS reset variable=ips_txReqVal
+    static bool                ips_scanVal=false;
+    #pragma HLS reset variable=ips_scanVal
+    static bool                ips_tick=false;
+    #pragma HLS reset variable=ips_tick
+    static bool                ips_closePend=false;
+    #pragma HLS reset variable=ips_closePend
+    static ap_uint<28>         ips_timer=0;
+    #pragma HLS reset variable=ips_timer
+    static ap_uint<log2Ceil<cIpfIdleIvals+1>::val> ips_testIdle=0;
+    #pragma HLS reset variable=ips_testIdle
+
+    //-- STATIC DATAFLOW VARIABLES ---------------------------------------------
+    static enum TxMsgs    { MSG_PARAM_EXCHANGE=0, MSG_CREATE_STREAMS, MSG_TEST_START,
+                            MSG_EXCHANGE_RESULTS, MSG_RESULTS } \
+                               ips_txReq;
+    static enum TxPhases  { PH_HDR=0, PH_STR0, PH_ID, PH_STR1, PH_BYTES, PH_STR2, PH_TRL } \
+                               ips_txPhase;
+    static bool                ips_segVal;   // The current segment is accounted in 'ips_entry'
+    static IpfIdx              ips_entry;
+    static IpfIdx              ips_ctlEntry;
+    static TcpAppData          ips_chunk;    // The control chunk being parsed
+    static ap_uint<3>          ips_bytePos;
+    static ap_uint<32>         ips_ctlCnt;
+    static ap_uint<32>         ips_ctlLen;
+    static ap_uint<4>          ips_match;    // #Bytes of '"parallel":' matched so far
+    static bool                ips_parVal;   // Parsing the digits of '"parallel"'
+    static ap_uint<8>          ips_parallel;
+    static ap_uint<8>          ips_nrStreams;
+    static ap_uint<8>          ips_nextId;
+    static ap_uint<log2Ceil<cIpfSessions>::val> ips_scanIdx;
+    static bool                ips_scanAll;
+    static TcpDatLen           ips_txLeft;
+    static ap_uint<64>         ips_txWord;
+    static ap_uint<3>          ips_txPos;
+    static ap_uint<8>          ips_txCode;
+    static ap_uint<32>         ips_jsonLen;
+    static ap_uint<2>          ips_lenCnt;
+    static ap_uint<8>          ips_romPtr;
+    static ap_uint<8>          ips_romEnd;
+    static ap_uint<log2Ceil<cIpfSessions+1>::val> ips_txEntry;
+    static bool                ips_txFirst;
+    static ap_uint<8>          ips_txId;
+    static ap_uint<64>         ips_txBytes;
+    static ap_uint<64>         ips_num;
+    static ap_uint<5>          ips_pow;
+    static ap_uint<4>          ips_digit;
+    static bool                ips_lead;
+
+    //-- DYNAMIC VARIABLES -----------------------------------------------------
+    bool        accVal   = false;  // Bytes to account in 'ips_entry'
+    ChunkBytes  accBytes = 0;
+    bool        close    = false;  // Release the current iperf3 test
+    bool        txVal    = false;  // A byte of a Tx message is issued
+    ap_uint<8>  txByte   = 0;
+    bool        fragDone = false;  // The current fragment of the results is issued
+
+    if (*piSHL_Enable != 1) {
+        return;
+    }
+
+    //-- INTERVAL TIMER --------------------------------------------------------
+    if (ips_timer == cIpfInterval-1) {
+        ips_timer = 0;
+        ips_tick  = true;
+        if (ips_testOn) {
+            if (ips_testIdle == cIpfIdleIvals-1) {
+                printWarn(myName, "The iperf3 test stayed idle for %d intervals. It is released.\n",
+                          cIpfIdleIvals);
+                close = true;
+            }
+            ips_testIdle += 1;
+        }
+    }
+    else {
+        ips_timer += 1;
+    }
+
+    //-- SEGMENT AND CHUNK INTAKE ----------------------------------------------
+    if (!ips_inSeg) {
+        //-- A new segment is only accepted outside of a scan of the session table
+        if (!ips_scanVal and !siRbp_IpfCmd.empty()) {
+            ForwardCmd cmd = siRbp_IpfCmd.read();
+            //-- Look up the session and a free entry in parallel
+            bool   hit = false;
+            bool   freeFound = false;
+            IpfIdx hitIdx  = 0;
+            IpfIdx freeIdx = 0;
+            for (int i=cIpfSessions-1; i>=0; i--) {
+                #pragma HLS UNROLL
+                if (IPF_VALID[i] and (IPF_SESS[i] == cmd.sessId)) {
+                    hit    = true;
+                    hitIdx = i;
+                }
+                if (!IPF_VALID[i]) {
+                    freeFound = true;
+                    freeIdx   = i;
+                }
+            }
+            if (hit) {
+                ips_entry  = hitIdx;
+                ips_segVal = true;
+            }
+            else if (freeFound) {
+                bool isVer3 = (cmd.dropCode == IPF3);
+                bool isCtrl = isVer3 and !ips_testOn;
+                IPF_VALID[freeIdx]  = true;
+                IPF_SESS[freeIdx]   = cmd.sessId;
+                IPF_VER3[freeIdx]   = isVer3;
+                IPF_CTRL[freeIdx]   = isCtrl;
+                IPF_CLOSE[freeIdx]  = false;
+                IPF_STREAM[freeIdx] = ips_nextId;
+                IPF_BYTES[freeIdx]  = 0;
+                IPF_IVAL[freeIdx]   = 0;
+                IPF_SKIP[freeIdx]   = (isVer3) ? cIpf3CookieLen : 0;
+                IPF_IDLE[freeIdx]   = 0;
+                if (isCtrl) {
+                    //-- A new iperf3 test starts with its control channel
+                    ips_testOn    = true;
+                    ips_testIdle  = 0;
+                    ips_ctlEntry  = freeIdx;
+                    ips_ctlState  = CTL_COOKIE;
+                    ips_ctlCnt    = cIpf3CookieLen;
+                    ips_nrStreams = 0;
+                    ips_nextId    = 1;
+                }
+                else if (isVer3) {
+                    //-- The data streams are numbered 1, 3, 4, ... as by the iperf3 client
+                    ips_nrStreams += 1;
+                    ips_nextId     = (ips_nextId == 1) ? 3 : ips_nextId.to_uint()+1;
+                }
+                if (DEBUG_LEVEL & TRACE_IPS) {
+                    printInfo(myName, "New iperf%d session #%d (Entry=%d, Ctrl=%d).\n",
+                              (isVer3) ? 3 : 2, cmd.sessId.to_uint(), freeIdx.to_uint(), isCtrl);
+                }
+                ips_entry  = freeIdx;
+                ips_segVal = true;
+            }
+            else {
+                printWarn(myName, "The iperf session table is full. Segment of session #%d is sunk without accounting.\n",
+                          cmd.sessId.to_uint());
+                ips_segVal = false;
+            }
+            ips_inSeg = true;
+        }
+    }
+    else if (!ips_chunkVal and !siRbp_IpfData.empty()) {
+        TcpAppData chunk = siRbp_IpfData.read();
+        if (ips_segVal) {
+            if (IPF_CTRL[ips_entry]) {
+                //-- The control channel is parsed one byte per cycle (see below)
+                ips_chunk    = chunk;
+                ips_chunkVal = true;
+                ips_bytePos  = 0;
+            }
+            else {
+                ChunkBytes len  = chunk.getLen();
+                ChunkBytes skip = (IPF_SKIP[ips_entry] < len) ? (ChunkBytes)IPF_SKIP[ips_entry] : len;
+                IPF_SKIP[ips_entry] -= skip;
+                accBytes = len - skip;
+                accVal   = true;
+            }
+            if (IPF_VER3[ips_entry]) {
+                ips_testIdle = 0;
+            }
+        }
+        if (chunk.getTLast()) {
+            ips_inSeg = false;
+        }
+    }
+
+    //-- CONTROL CHANNEL OF THE IPERF3 TEST ------------------------------------
+    if (ips_chunkVal and !ips_txReqVal) {
+        ap_uint<64> word = ips_chunk.getLE_TData();
+        ap_uint<8>  byte = word(8*ips_bytePos.to_int()+7, 8*ips_bytePos.to_int());
+        ap_uint<32> len  = (ips_ctlLen << 8) | byte;
+        switch (ips_ctlState) {
+        case CTL_COOKIE:
+            if (ips_ctlCnt == 1) {
+                ips_txReq    = MSG_PARAM_EXCHANGE;
+                ips_txReqVal = true;
+                ips_ctlState = CTL_PLEN;
+                ips_ctlCnt   = 4;
+                ips_ctlLen   = 0;
+            }
+            else {
+                ips_ctlCnt -= 1;
+            }
+            break;
+        case CTL_PLEN:
+        case CTL_RLEN:
+            //-- The length of a JSON string (in network order)
+            ips_ctlLen = len;
+            if (ips_ctlCnt != 1) {
+                ips_ctlCnt -= 1;
+            }
+            else if (ips_ctlState == CTL_PLEN) {
+                ips_ctlCnt   = len;
+                ips_match    = 0;
+                ips_parVal   = false;
+                ips_parallel = 1;
+                if (len == 0) {
+                    ips_txReq    = MSG_CREATE_STREAMS;
+                    ips_txReqVal = true;
+                    ips_ctlState = CTL_STREAMS;
+                }
+                else {
+                    ips_ctlState = CTL_PARAMS;
+                }
+            }
+            else {
+                ips_ctlCnt = len;
+                if (len == 0) {
+                    ips_txReq    = MSG_RESULTS;
+                    ips_txReqVal = true;
+                    ips_ctlState = CTL_DONE;
+                }
+                else {
+                    ips_ctlState = CTL_RESULTS;
+                }
+            }
+            break;
+        case CTL_PARAMS:
+            //-- Extract the number of streams out of '"parallel":<n>'
+            if (ips_parVal) {
+                if ((byte >= '0') and (byte <= '9')) {
+                    ips_parallel = ips_parallel * 10 + (byte - '0');
+                }
+                else {
+                    ips_parVal = false;
+                }
+            }
+            else if (byte == (ap_uint<8>)IPS_PARALLEL[ips_match]) {
+                if (ips_match == sizeof(IPS_PARALLEL)-2) {
+                    ips_parVal   = true;
+                    ips_parallel = 0;
+                    ips_match    = 0;
+                }
+                else {
+                    ips_match += 1;
+                }
+            }
+            else {
+                ips_match = (byte == '"') ? 1 : 0;
+            }
+            if (ips_ctlCnt == 1) {
+                if (DEBUG_LEVEL & TRACE_IPS) {
+                    printInfo(myName, "The iperf3 test requests %d stream(s).\n", ips_parallel.to_uint());
+                }
+                ips_txReq    = MSG_CREATE_STREAMS;
+                ips_txReqVal = true;
+                ips_ctlState = CTL_STREAMS;
+            }
+            else {
+                ips_ctlCnt -= 1;
+            }
+            break;
+        case CTL_STREAMS:
+        case CTL_RUNNING:
+            if (byte == IPF_TEST_END) {
+                ips_txReq    = MSG_EXCHANGE_RESULTS;
+                ips_txReqVal = true;
+                ips_ctlState = CTL_RLEN;
+                ips_ctlCnt   = 4;
+                ips_ctlLen   = 0;
+            }
+            else if (byte == IPF_CLIENT_TERMINATE) {
+                close = true;
+            }
+            break;
+        case CTL_RESULTS:
+            //-- The results of the client are skipped
+            if (ips_ctlCnt == 1) {
+                ips_txReq    = MSG_RESULTS;
+                ips_txReqVal = true;
+                ips_ctlState = CTL_DONE;
+            }
+            else {
+                ips_ctlCnt -= 1;
+            }
+            break;
+        case CTL_DONE:
+            if ((byte == IPF_IPERF_DONE) or (byte == IPF_CLIENT_TERMINATE)) {
+                close = true;
+            }
+            break;
+        default:
+            //-- Left-over of a released test
+            break;
+        }
+        if ((ips_bytePos == ips_chunk.getLen()-1) or (ips_bytePos == (ARW/8)-1)) {
+            ips_chunkVal = false;
+        }
+        ips_bytePos += 1;
+    }
+    else if ((ips_ctlState == CTL_STREAMS) and !ips_txReqVal and
+             (ips_nrStreams >= ips_parallel)) {
+        ips_txReq    = MSG_TEST_START;
+        ips_txReqVal = true;
+        ips_ctlState = CTL_RUNNING;
+    }
+
+    if (close) {
+        //-- Release the sessions of the iperf3 test with the next scan
+        for (int i=0; i<cIpfSessions; i++) {
+            #pragma HLS UNROLL
+            if (IPF_VER3[i]) {
+                IPF_CLOSE[i] = true;
+            }
+        }
+        if (DEBUG_LEVEL & TRACE_IPS) {
+            printInfo(myName, "The iperf3 test is done.\n");
+        }
+        ips_testOn    = false;
+        ips_ctlState  = CTL_IDLE;
+        ips_closePend = true;
+    }
+
+    //-- SCAN OF THE SESSION TABLE ---------------------------------------------
+    if (!ips_scanVal and (ips_tick or ips_closePend)) {
+        ips_scanVal   = true;
+        ips_scanAll   = ips_tick;
+        ips_scanIdx   = 0;
+        ips_tick      = false;
+        ips_closePend = false;
+    }
+    else if (ips_scanVal and !soDBG_IpfReport.full()) {
+        IpfIdx i = ips_scanIdx;
+        if (IPF_VALID[i] and (ips_scanAll or IPF_CLOSE[i])) {
+            bool idle    = (IPF_IVAL[i] == 0) and !(accVal and (ips_entry == i));
+            bool release = IPF_CLOSE[i] or
+                           (!IPF_VER3[i] and idle and (IPF_IDLE[i] == cIpfIdleIvals-1));
+            if (!IPF_CTRL[i]) {
+                soDBG_IpfReport.write(IperfReport(IPF_SESS[i], (IPF_VER3[i]) ? 3 : 2,
+                                                  IPF_IVAL[i], IPF_BYTES[i], release));
+                if (DEBUG_LEVEL & TRACE_IPS) {
+                    printInfo(myName, "Report of session #%d: %d bytes in the interval, %ld in total (Last=%d).\n",
+                              IPF_SESS[i].to_uint(), IPF_IVAL[i].to_uint(),
+                              (unsigned long)IPF_BYTES[i].to_uint64(), release);
+                }
+            }
+            IPF_IVAL[i] = 0;
+            IPF_IDLE[i] = (idle) ? (ap_uint<log2Ceil<cIpfIdleIvals+1>::val>)(IPF_IDLE[i]+1) :
+                                   (ap_uint<log2Ceil<cIpfIdleIvals+1>::val>)0;
+            if (release) {
+                IPF_VALID[i] = false;
+            }
+        }
+        if (ips_scanIdx == cIpfSessions-1) {
+            ips_scanVal = false;
+        }
+        ips_scanIdx += 1;
+    }
+
+    //-- ACCOUNTING (after the scan, which reads and clears the interval) ------
+    if (accVal) {
+        IPF_BYTES[ips_entry] += accBytes;
+        IPF_IVAL[ips_entry]  += accBytes;
+    }
+
+    //-- TX MESSAGES OF THE CONTROL CHANNEL ------------------------------------
+    if (!soTMx_Data.full()) {
+        switch (ips_txStep) {
+        case TXS_IDLE:
+            if (ips_txReqVal and !soTMx_SessId.full() and !soTMx_DatLen.full()) {
+                TcpDatLen msgLen = 1;
+                ips_jsonLen = cJsonHdrLen + ips_nrStreams.to_uint() * cJsonStrLen + cJsonTrlLen -
+                              ((ips_nrStreams != 0) ? 1 : 0);
+                ips_txStep  = TXS_CODE;
+                switch (ips_txReq) {
+                case MSG_PARAM_EXCHANGE:   ips_txCode = IPF_PARAM_EXCHANGE;   break;
+                case MSG_CREATE_STREAMS:   ips_txCode = IPF_CREATE_STREAMS;   break;
+                case MSG_EXCHANGE_RESULTS: ips_txCode = IPF_EXCHANGE_RESULTS; break;
+                case MSG_TEST_START:
+                    ips_txCode = IPF_TEST_START;
+                    msgLen     = 2;
+                    break;
+                default:
+                    //-- {Length, JSON results, DISPLAY_RESULTS}
+                    msgLen     = 4 + ips_jsonLen + 1;
+                    ips_txStep = TXS_LEN;
+                    ips_lenCnt = 0;
+                    break;
+                }
+                soTMx_SessId.write(IPF_SESS[ips_ctlEntry]);
+                soTMx_DatLen.write(msgLen);
+                if (DEBUG_LEVEL & TRACE_IPS) {
+                    printInfo(myName, "Sending message #%d (%d bytes) on the iperf3 control channel.\n",
+                              ips_txReq, msgLen.to_uint());
+                }
+                ips_txLeft   = msgLen;
+                ips_txPos    = 0;
+                ips_txWord   = 0;
+                ips_txReqVal = false;
+            }
+            break;
+        case TXS_CODE:
+            txVal  = true;
+            txByte = ips_txCode;
+            if (ips_txLeft == 1) {
+                ips_txStep = TXS_IDLE;
+            }
+            else {
+                ips_txCode = IPF_TEST_RUNNING;
+            }
+            break;
+        case TXS_LEN:
+            txVal  = true;
+            txByte = ips_jsonLen(31, 24);
+            ips_jsonLen = ips_jsonLen << 8;
+            if (ips_lenCnt == 3) {
+                ips_txStep  = TXS_ROM;
+                ips_txPhase = PH_HDR;
+                ips_romPtr  = 0;
+                ips_romEnd  = cJsonHdrLen-1;
+                ips_txEntry = 0;
+                ips_txFirst = true;
+            }
+            ips_lenCnt += 1;
+            break;
+        case TXS_ROM:
+            txVal  = true;
+            txByte = IPS_JSON[ips_romPtr];
+            if (ips_romPtr == ips_romEnd) {
+                fragDone = true;
+            }
+            ips_romPtr += 1;
+            break;
+        case TXS_NUM:
+            //-- Binary to decimal by successive subtractions of the powers of ten
+            if (ips_num >= POW10[ips_pow]) {
+                ips_num   -= POW10[ips_pow];
+                ips_digit += 1;
+            }
+            else {
+                bool blank = ips_lead and (ips_digit == 0) and (ips_pow != 0);
+                txVal     = true;
+                txByte    = (blank) ? (ap_uint<8>)' ' : (ap_uint<8>)('0' + ips_digit.to_uint());
+                ips_lead  = blank;
+                ips_digit = 0;
+                if (ips_pow == 0) {
+                    fragDone = true;
+                }
+                ips_pow -= 1;
+            }
+            break;
+        case TXS_ENTRY:
+            if (ips_txEntry == cIpfSessions) {
+                ips_txStep  = TXS_ROM;
+                ips_txPhase = PH_TRL;
+                ips_romPtr  = cJsonTrl;
+                ips_romEnd  = cJsonTrl + cJsonTrlLen-1;
+            }
+            else {
+                IpfIdx i = ips_txEntry;
+                if (IPF_VALID[i] and IPF_VER3[i] and !IPF_CTRL[i] and !IPF_CLOSE[i]) {
+                    ips_txId    = IPF_STREAM[i];
+                    ips_txBytes = IPF_BYTES[i];
+                    ips_txStep  = TXS_ROM;
+                    ips_txPhase = PH_STR0;
+                    ips_romPtr  = (ips_txFirst) ? cJsonStr0+1 : cJsonStr0;
+                    ips_romEnd  = cJsonStr1-1;
+                    ips_txFirst = false;
+                }
+                ips_txEntry += 1;
+            }
+            break;
+        case TXS_DISP:
+            txVal      = true;
+            txByte     = IPF_DISPLAY_RESULTS;
+            ips_txStep = TXS_IDLE;
+            break;
+        }
+
+        //-- Move on to the next fragment of the results
+        if (fragDone) {
+            switch (ips_txPhase) {
+            case PH_HDR:
+            case PH_STR2:
+                ips_txStep  = TXS_ENTRY;
+                break;
+            case PH_STR0:
+            case PH_STR1:
+                ips_num     = (ips_txPhase == PH_STR0) ? (ap_uint<64>)ips_txId : ips_txBytes;
+                ips_pow     = (ips_txPhase == PH_STR0) ? 2 : 19;
+                ips_digit   = 0;
+                ips_lead    = true;
+                ips_txStep  = TXS_NUM;
+                ips_txPhase = (ips_txPhase == PH_STR0) ? PH_ID : PH_BYTES;
+                break;
+            case PH_ID:
+                ips_txStep  = TXS_ROM;
+                ips_txPhase = PH_STR1;
+                ips_romPtr  = cJsonStr1;
+                ips_romEnd  = cJsonStr2-1;
+                break;
+            case PH_BYTES:
+                ips_txStep  = TXS_ROM;
+                ips_txPhase = PH_STR2;
+                ips_romPtr  = cJsonStr2;
+                ips_romEnd  = cJsonTrl-1;
+                break;
+            default:
+                ips_txStep  = TXS_DISP;
+                break;
+            }
+        }
+
+        //-- Pack the bytes of the message into chunks
+        if (txVal) {
+            ap_uint<64> word = ips_txWord;
+            bool        last = (ips_txLeft == 1);
+            word(8*ips_txPos.to_int()+7, 8*ips_txPos.to_int()) = txByte;
+            if (last or (ips_txPos == (ARW/8)-1)) {
+                TcpAppData chunk(word, lenToLE_tKeep(ips_txPos.to_uint()+1), last);
+                soTMx_Data.write(chunk);
+                if (DEBUG_LEVEL & TRACE_IPS) { printAxisRaw(myName, "soTMx_Data =", chunk); }
+                ips_txWord = 0;
+            }
+            else {
+                ips_txWord = word;
+            }
+            ips_txPos  += 1;
+            ips_txLeft -= 1;
+        }
+    }
+}
+
+/*******************************************************************************
+ * @brief Tx Socket Handler (TSh)
+ *
+ * @param[in]  piSHL_Enable   Enable signal from [SHELL].
+ * @param[in]  siTAF_SockData Tx data stream of a socket-addressed message from [ROLE/TAF].
+ * @param[in]  siTAF_SockAddr The remote socket of the message from [ROLE/TAF].
+ * @param[in]  siTAF_SockLen  The length of the message from [ROLE/TAF].
+ * @param[out] soTAF_SockRep  The session the message was sent on, to [ROLE/TAF].
+ * @param[out] soCOn_SockReq  The tagged remote socket to look up, to Connect (COn).
+ * @param[in]  siCOn_SockRep  The session of that socket (same tag) from [COn].
+ * @param[out] soTMx_Data     Tx data stream to TxMultiplexer (TMx).
+ * @param[out] soTMx_SessId   The session Id to [TMx].
+ * @param[out] soTMx_DatLen   The data length to [TMx].
+ *
+ * @details
+ *  This process lets [TAF] send a message to a remote socket instead of a
+ *   session. The socket of every message is looked up in the connection table
+ *   of [COn], which opens a connection for a socket it does not know yet and
+ *   keeps it for the next messages. Therefore, only the first message to a
+ *   socket pays the latency of opening its connection.
+ *  Once its session is known, a message is forwarded to [TMx] like a regular
+ *   [TAF] message (i.e. it is segmented and retried by [WRp]), and the session
+ *   is reported to [TAF] on 'soTAF_SockRep'. [TAF] can then match the data it
+ *   receives from that socket, or keep sending on that session directly.
+ *  Up to 'cTShLookups' sockets are looked up ahead of the message being
+ *   streamed, such that consecutive messages are forwarded back-to-back, down
+ *   to single-chunk messages. Every lookup is tagged with its slot, and [COn]
+ *   answers it as soon as its connection is known. The connections of the
+ *   messages looked up ahead are therefore opened in parallel.
+ *  A message for which no connection could be opened is dropped and reported
+ *   as not sent. A message to a socket which recently failed to open is
+ *   dropped right away (see the hold-off of [COn]).
+ *
+ * @warning
+ *  The messages are still forwarded in order, since their data share a single
+ *   stream. A message to a socket which is being opened therefore holds back
+ *   the next messages, whatever their socket.
+ *  [TAF] must consume the replies on 'soTAF_SockRep'.
+ *******************************************************************************/
+void pTxSocketHandler(
+        CmdBit               *piSHL_Enable,
+        stream<TcpAppData>   &siTAF_SockData,
+        stream<SockAddr>     &siTAF_SockAddr,
+        stream<TcpDatLen>    &siTAF_SockLen,
+        stream<SockSndRep>   &soTAF_SockRep,
+        stream<SockLkpReq>   &soCOn_SockReq,
+        stream<SockLkpRep>   &siCOn_SockRep,
+        stream<TcpAppData>   &soTMx_Data,
+        stream<TcpSessId>    &soTMx_SessId,
+        stream<TcpDatLen>    &soTMx_DatLen)
+{
+    //-- DIRECTIVES FOR THIS PROCESS -------------------------------------------
+    #pragma HLS INLINE off
+    #pragma HLS PIPELINE II=1 enable_flush
+
+    const char *myName  = concat3(THIS_NAME, "/", "TSh");
+
+    //-- STATIC ARRAYS (Messages being looked up) ------------------------------
+    static SockAddr            LKP_SOCK[cTShLookups];
+    #pragma HLS ARRAY_PARTITION variable=LKP_SOCK complete dim=1
+    static TcpDatLen           LKP_LEN[cTShLookups];
+    #pragma HLS ARRAY_PARTITION variable=LKP_LEN  complete dim=1
+    static bool                REP_VAL[cTShLookups];   // The lookup is answered
+    #pragma HLS ARRAY_PARTITION variable=REP_VAL  complete dim=1
+    #pragma HLS reset           variable=REP_VAL
+    static SessionId           REP_SESS[cTShLookups];
+    #pragma HLS ARRAY_PARTITION variable=REP_SESS complete dim=1
+    static bool                REP_SENT[cTShLookups];
+    #pragma HLS ARRAY_PARTITION variable=REP_SENT complete dim=1
+
+    //-- STATIC CONTROL VARIABLES (with RESET) ---------------------------------
+    static ap_uint<log2Ceil<cTShLookups>::val>   tsh_wrPtr=0;
+    #pragma HLS reset variable=tsh_wrPtr
+    static ap_uint<log2Ceil<cTShLookups>::val>   tsh_rdPtr=0;
+    #pragma HLS reset variable=tsh_rdPtr
+    static ap_uint<log2Ceil<cTShLookups+1>::val> tsh_nrLkps=0;
+    #pragma HLS reset variable=tsh_nrLkps
+    static bool                tsh_repVal=false;   // The session of the next message is known
+    #pragma HLS reset variable=tsh_repVal
+    static bool                tsh_inMsg=false;    // A message is being streamed
+    #pragma HLS reset variable=tsh_inMsg
+    static bool                tsh_drop=false;     // The current message is dropped
+    #pragma HLS reset variable=tsh_drop
+
+    //-- STATIC DATAFLOW VARIABLES ---------------------------------------------
+    static SockAddr            tsh_sock;
+    static TcpDatLen           tsh_len;
+    static SockSndRep          tsh_rep;
+
+    //-- DYNAMIC VARIABLES -----------------------------------------------------
+    TcpAppData  appData;
+    SockLkpRep  lkpRep;
+    bool        push = false;
+    bool        pop  = false;
+
+    if (*piSHL_Enable != 1) {
+        return;
+    }
+
+    //-- STREAM OR DROP THE CURRENT MESSAGE ------------------------------------
+    if (tsh_inMsg and !siTAF_SockData.empty() and (tsh_drop or !soTMx_Data.full())) {
+        siTAF_SockData.read(appData);
+        if (!tsh_drop) {
+            soTMx_Data.write(appData);
+        }
+        if (appData.getTLast()) {
+            tsh_inMsg = false;
+        }
+    }
+
+    //-- LOOK UP THE SOCKETS OF THE NEXT MESSAGES ------------------------------
+    if ((tsh_nrLkps != cTShLookups) and !siTAF_SockAddr.empty() and !siTAF_SockLen.empty() and
+        !soCOn_SockReq.full()) {
+        SockAddr sockAddr = siTAF_SockAddr.read();
+        LKP_SOCK[tsh_wrPtr] = sockAddr;
+        LKP_LEN[tsh_wrPtr]  = siTAF_SockLen.read();
+        soCOn_SockReq.write(SockLkpReq(sockAddr, tsh_wrPtr));
+        tsh_wrPtr += 1;
+        push = true;
+    }
+    if (!siCOn_SockRep.empty()) {
+        //-- The lookups are answered out of order
+        siCOn_SockRep.read(lkpRep);
+        REP_SESS[lkpRep.tag] = lkpRep.sessId;
+        REP_SENT[lkpRep.tag] = lkpRep.sent;
+        REP_VAL[lkpRep.tag]  = true;
+    }
+    if ((tsh_nrLkps != 0) and !tsh_repVal and REP_VAL[tsh_rdPtr]) {
+        tsh_rep    = SockSndRep(REP_SESS[tsh_rdPtr], REP_SENT[tsh_rdPtr]);
+        tsh_sock   = LKP_SOCK[tsh_rdPtr];
+        tsh_len    = LKP_LEN[tsh_rdPtr];
+        REP_VAL[tsh_rdPtr] = false;
+        tsh_rdPtr += 1;
+        tsh_repVal = true;
+        pop = true;
+    }
+
+    //-- FORWARD THE NEXT MESSAGE ----------------------------------------------
+    if (tsh_repVal and !tsh_inMsg and !soTAF_SockRep.full() and
+        (!tsh_rep.sent or (!soTMx_SessId.full() and !soTMx_DatLen.full()))) {
+        if (tsh_rep.sent) {
+            soTMx_SessId.write(tsh_rep.sessId);
+            soTMx_DatLen.write(tsh_len);
+            if (DEBUG_LEVEL & TRACE_TSH) {
+                printInfo(myName, "Sending a message of %d bytes on session #%d to remote socket:\n",
+                          tsh_len.to_uint(), tsh_rep.sessId.to_uint());
+                printSockAddr(myName, tsh_sock);
+            }
+        }
+        else {
+            printWarn(myName, "Dropping a message of %d bytes. No connection to remote socket:\n",
+                      tsh_len.to_uint());
+            printSockAddr(myName, tsh_sock);
+        }
+        soTAF_SockRep.write(tsh_rep);
+        tsh_inMsg  = true;
+        tsh_drop   = !tsh_rep.sent;
+        tsh_repVal = false;
+    }
+
+    if (push and !pop) {
+        tsh_nrLkps += 1;
+    }
+    else if (pop and !push) {
+        tsh_nrLkps -= 1;
+    }
+}
+
+/*******************************************************************************
+ * @brief Tx Multiplexer (TMx)
+ *
+ * @param[in]  piSHL_Enable  Enable signal from [SHELL].
+ * @param[in]  siTAF_Data    Tx data stream from [ROLE/TAF].
+ * @param[in]  siTAF_SessId  The session Id from [ROLE/TAF].
+ * @param[in]  siTAF_DatLen  The data length from [ROLE/TAF].
+ * @param[in]  siIPs_Data    Tx data stream from IperfServer (IPs).
+ * @param[in]  siIPs_SessId  The session Id from [IPs].
+ * @param[in]  siIPs_DatLen  The data length from [IPs].
+ * @param[in]  siTSh_Data    Tx data stream from TxSocketHandler (TSh).
+ * @param[in]  siTSh_SessId  The session Id from [TSh].
+ * @param[in]  siTSh_DatLen  The data length from [TSh].
+ * @param[out] soWRp_Data    Tx data stream to WritePath (WRp).
+ * @param[out] soWRp_SessId  The session Id to [WRp].
+ * @param[out] soWRp_DatLen  The data length to [WRp].
  *
  * @details
- *  This process waits for new data to read and either forwards them to the
- *   TcpApplicationFlash (TAF) process or drops them based on the 'action' field
- *   of the 'siRRh_FwdCmd' command.
- *   - If the action is 'CMD_KEEP', the stream is forwarded to the next layer.
- *     As such, [RDp] implements a pipe for the TCP traffic from [SHELL] to [TAF].
- *   - If the action is 'CMD_DROP' the field 'opCOde' becomes meaningful and may
- *     specify additional sub-options:
- *     - If the op-code is 'NOP', simply drop the stream and do nothing more.
- *     - If the op-code is 'GEN', extract the remote socket to connect to as
- *       well as the number of bytes to transmit out of the 64 first incoming
- *       bits of the data stream. Next, drop the rest of that stream and forward
- *       the extracted fields to the Connect (COn) process.
+ *  This process merges the Tx messages of [TAF], [IPs] and [TSh] into the
+ *   message interface of [WRp]. The metadata of a message are forwarded as soon
+ *   as they are available (the rare and short messages of [IPs] first, and the
+ *   messages of [TAF] and [TSh] in turn) and the source
+ *   of every forwarded message is queued into a small ORDER queue. The data
+ *   are then moved from the source at the head of that queue, at a rate of one
+ *   chunk per cycle and without any bubble between two messages.
  *******************************************************************************/
-void pReadPath(
+void pTxMultiplexer(
         CmdBit               *piSHL_Enable,
-        stream<TcpAppData>   &siSHL_Data,
-        stream<TcpAppMeta>   &siSHL_Meta,
-        stream<ForwardCmd>   &siRRh_FwdCmd,
-        stream<SockAddr>     &soCOn_OpnSockReq,
-        stream<TcpDatLen>    &soCOn_TxCountReq,
-        stream<SigBit>       &soRRh_DequSig,
-        stream<TcpAppData>   &soTAF_Data,
-        stream<TcpSessId>    &soTAF_SessId,
-        stream<TcpDatLen>    &soTAF_DatLen,
-        stream<ap_uint<32> > &soDBG_SinkCount)
+        stream<TcpAppData>   &siTAF_Data,
+        stream<TcpSessId>    &siTAF_SessId,
+        stream<TcpDatLen>    &siTAF_DatLen,
+        stream<TcpAppData>   &siIPs_Data,
+        stream<TcpSessId>    &siIPs_SessId,
+        stream<TcpDatLen>    &siIPs_DatLen,
+        stream<TcpAppData>   &siTSh_Data,
+        stream<TcpSessId>    &siTSh_SessId,
+        stream<TcpDatLen>    &siTSh_DatLen,
+        stream<TcpAppData>   &soWRp_Data,
+        stream<TcpSessId>    &soWRp_SessId,
+        stream<TcpDatLen>    &soWRp_DatLen)
 {
     //-- DIRECTIVES FOR THIS PROCESS -------------------------------------------
     #pragma HLS INLINE off
     #pragma HLS PIPELINE II=1 enable_flush
 
-    const char *myName  = concat3(THIS_NAME, "/", "RDp");
+    const char *myName  = concat3(THIS_NAME, "/", "TMx");
 
-    //-- STATIC CONTROL VARIABLES (with RESET) ---------------------------------
-    static enum FsmStates { RDP_IDLE=0,    RDP_8801,
-                            RDP_FWD_META,  RDP_FWD_STREAM,
-                            RDP_SINK_META, RDP_SINK_STREAM } \
-                               rdp_fsmState=RDP_IDLE;
-    #pragma HLS reset variable=rdp_fsmState
-    static ap_uint<32>         rdp_sinkCnt=0;
-    #pragma HLS reset variable=rdp_sinkCnt
+    //-- STATIC ARRAYS ---------------------------------------------------------
+    static TxMsgSrc            ORDER[cTMxOrders];  // The source of the message
+    #pragma HLS ARRAY_PARTITION variable=ORDER complete dim=1
 
-    //-- STATIC VARIABLES ------------------------------------------------------
-    static ForwardCmd  rdp_fwdCmd;
-    static TcpSessId   rdp_sessId;
+    //-- STATIC CONTROL VARIABLES (with RESET) ---------------------------------
+    static ap_uint<log2Ceil<cTMxOrders>::val>   tmx_wrPtr=0;
+    #pragma HLS reset variable=tmx_wrPtr
+    static ap_uint<log2Ceil<cTMxOrders>::val>   tmx_rdPtr=0;
+    #pragma HLS reset variable=tmx_rdPtr
+    static ap_uint<log2Ceil<cTMxOrders+1>::val> tmx_count=0;
+    #pragma HLS reset variable=tmx_count
+    static bool                tmx_lastSck=false;  // The last [TAF] message came from [TSh]
+    #pragma HLS reset variable=tmx_lastSck
 
     //-- DYNAMIC VARIABLES -----------------------------------------------------
     TcpAppData  appData;
+    bool        push = false;
+    bool        pop  = false;
 
     if (*piSHL_Enable != 1) {
         return;
     }
 
-    switch (rdp_fsmState ) {
-    case RDP_IDLE:
-        if (!siRRh_FwdCmd.empty() and !siSHL_Meta.empty()) {
-            siRRh_FwdCmd.read(rdp_fwdCmd);
-            siSHL_Meta.read(rdp_sessId);
-            if ((rdp_fwdCmd.action == CMD_KEEP) and (rdp_fwdCmd.sessId == rdp_sessId)) {
-                rdp_fsmState  = RDP_FWD_META;
-            }
-            else {
-                rdp_fsmState  = RDP_SINK_META;
+    //-- DATA ------------------------------------------------------------------
+    if ((tmx_count != 0) and !soWRp_Data.full()) {
+        bool moved = false;
+        if (ORDER[tmx_rdPtr] == TX_SRC_IPS) {
+            if (!siIPs_Data.empty()) {
+                siIPs_Data.read(appData);
+                moved = true;
             }
         }
-        break;
-    case RDP_FWD_META:
-        if (!soTAF_SessId.full() and !soTAF_DatLen.full()) {
-            soTAF_SessId.write(rdp_sessId);
-            soTAF_DatLen.write(rdp_fwdCmd.datLen);
-            if (DEBUG_LEVEL & TRACE_RDP) {
-                printInfo(myName, "soTAF_SessId = %d \n", rdp_sessId.to_uint());
-                printInfo(myName, "soTAF_DatLen = %d \n", rdp_fwdCmd.datLen.to_uint());
+        else if (ORDER[tmx_rdPtr] == TX_SRC_SCK) {
+            if (!siTSh_Data.empty()) {
+                siTSh_Data.read(appData);
+                moved = true;
             }
-            rdp_fsmState  = RDP_FWD_STREAM;
         }
-        break;
-    case RDP_FWD_STREAM:
-        if (!siSHL_Data.empty() and !soTAF_Data.full()) {
-            siSHL_Data.read(appData);
-            soRRh_DequSig.write(1);
-            soTAF_Data.write(appData);
-            if (DEBUG_LEVEL & TRACE_RDP) { printAxisRaw(myName, "soTAF_Data =", appData); }
+        else if (!siTAF_Data.empty()) {
+            siTAF_Data.read(appData);
+            moved = true;
+        }
+        if (moved) {
+            soWRp_Data.write(appData);
             if (appData.getTLast()) {
-                rdp_fsmState  = RDP_IDLE;
+                tmx_rdPtr += 1;
+                pop = true;
             }
         }
-        break;
-    case RDP_SINK_META:
-        if (rdp_fwdCmd.dropCode == GEN) {
-            rdp_fsmState  = RDP_8801;
+    }
+
+    //-- METADATA --------------------------------------------------------------
+    if ((tmx_count != cTMxOrders) and !soWRp_SessId.full() and !soWRp_DatLen.full()) {
+        bool tafRdy = !siTAF_SessId.empty() and !siTAF_DatLen.empty();
+        bool sckRdy = !siTSh_SessId.empty() and !siTSh_DatLen.empty();
+        if (!siIPs_SessId.empty() and !siIPs_DatLen.empty()) {
+            soWRp_SessId.write(siIPs_SessId.read());
+            soWRp_DatLen.write(siIPs_DatLen.read());
+            ORDER[tmx_wrPtr] = TX_SRC_IPS;
+            push = true;
         }
-        else {
-            rdp_fsmState  = RDP_SINK_STREAM;
+        else if (sckRdy and (!tafRdy or !tmx_lastSck)) {
+            soWRp_SessId.write(siTSh_SessId.read());
+            soWRp_DatLen.write(siTSh_DatLen.read());
+            ORDER[tmx_wrPtr] = TX_SRC_SCK;
+            tmx_lastSck = true;
+            push = true;
         }
-        break;
-    case RDP_SINK_STREAM:
-        if (!siSHL_Data.empty()) {
-            siSHL_Data.read(appData);
-            soRRh_DequSig.write(1);
-            if (DEBUG_LEVEL & TRACE_RDP) { printAxisRaw(myName, "Sink Data =", appData); }
-            rdp_sinkCnt += appData.getLen();
-            soDBG_SinkCount.write(rdp_sinkCnt);
-            if (appData.getTLast()) {
-                rdp_fsmState  = RDP_IDLE;
-            }
+        else if (tafRdy) {
+            soWRp_SessId.write(siTAF_SessId.read());
+            soWRp_DatLen.write(siTAF_DatLen.read());
+            ORDER[tmx_wrPtr] = TX_SRC_TAF;
+            tmx_lastSck = false;
+            push = true;
         }
-        break;
-    case RDP_8801:
-        if (!siSHL_Data.empty() and !soCOn_OpnSockReq.full() and !soCOn_TxCountReq.full()) {
-            // Extract the remote socket address and the requested #bytes to transmit
-            siSHL_Data.read(appData);
-            soRRh_DequSig.write(1);
-            SockAddr sockToOpen(byteSwap32(appData.getLE_TData(31,  0)),   // IP4 address
-                                byteSwap16(appData.getLE_TData(47, 32)));  // TCP port
-            TcpDatLen bytesToSend = byteSwap16(appData.getLE_TData(63, 48));
-            soCOn_OpnSockReq.write(sockToOpen);
-            soCOn_TxCountReq.write(bytesToSend);
-            if (DEBUG_LEVEL & TRACE_RDP) {
-                printInfo(myName, "Received request for Tx test mode to generate a segment of length=%d and to send it to socket:\n",
-                          bytesToSend.to_int());
-                printSockAddr(myName, sockToOpen);
-            }
-            if (appData.getTLast()) {
-                rdp_fsmState  = RDP_IDLE;
-            }
-            else {
-                rdp_fsmState = RDP_SINK_STREAM;
+        if (push) {
+            if (DEBUG_LEVEL & TRACE_TMX) {
+                printInfo(myName, "Forwarding a message from [%s].\n",
+                          (ORDER[tmx_wrPtr] == TX_SRC_IPS) ? "IPs" :
+                          (ORDER[tmx_wrPtr] == TX_SRC_SCK) ? "TSh" : "TAF");
             }
+            tmx_wrPtr += 1;
         }
     }
+
+    if (push and !pop) {
+        tmx_count += 1;
+    }
+    else if (pop and !push) {
+        tmx_count -= 1;
+    }
 }
 
 /*******************************************************************************
  * @brief Write Path (WRp)
  *
  * @param[in]  piSHL_Enable  Enable signal from [SHELL].
- * @param[in]  siTAF_Data   Tx data stream from [ROLE/TAF].
- * @param[in]  siTAF_SessId The session Id from [ROLE/TAF].
- * @param[in]  siTAF_DatLen The data length from [ROLE/TAF].
- * @param[in]  siCOn_TxBytesReq The #bytes to be transmitted on the active opened connection from Connect(COn).
+ * @param[in]  siMCh_SegLen The length of the Tx segments from MmioConfigHandler (MCh).
+ * @param[in]  siMCh_GenCfg A setting of the Tx traffic generator from [MCh].
+ * @param[in]  siTAF_Data   Tx data stream from [ROLE/TAF] (via TxMultiplexer (TMx)).
+ * @param[in]  siTAF_SessId The session Id from [TAF] (via [TMx]).
+ * @param[in]  siTAF_DatLen The data length from [TAF] (via [TMx]).
+ * @param[in]  siCOn_TxBytesReq The Tx test request to serve on the active opened connection from Connect(COn).
  * @param[in]  siCOn_SessId The session id of the active opened connection from [COn].
  * @param[out] soSHL_Data   Tx data to [SHELL].
  * @param[out] soSHL_SndReq Request to send to [SHELL].
  * @param[in]  siSHL_SndRep Send reply from [SHELL].
+ * @param[out] soSLc_TxAct  The session of a granted send request to SessionLifecycle (SLc).
  *
  * @details
  *  This process waits for new data to be forwarded from the TcpAppFlash (TAF)
  *   or for a transmit test command from Connect(COn).
  *  Upon reception of one of these two requests, the process issues a request to
  *   send message and waits for its reply. A request to send consists of a
- *   session-id and a data-length information.
+ *   session-id and a data-length information. A message from [TAF] is split
+ *   into segments of at most 'cTxSegLen' bytes (see also 'CFG_TX_SEG_LEN'),
+ *   and every segment is requested, sent and retried on its own.
  *  A send reply consists of a session-id, a data-length, the amount of space
  *   left in TCP Tx buffer and an error code.
  *   1) If the return code is 'NO_ERROR', the process is allowed to send the
  *      amount of requested bytes.
  *   2) If the return code is 'NO_SPACE', there is not enough space available in
- *      the TCP Tx buffer of the session. The process will retry its request
- *      after a short delay but may give up after a maximum number f trials.
+ *      the TCP Tx buffer of the session. A message from [TAF] is then parked
+ *      into a slot of the send-retry queue, such that the process can keep
+ *      serving the sessions which do have Tx buffer space. A parked message is
+ *      retried after an exponential backoff and is dropped after
+ *      'cRtyMaxTries' attempts, along with the remainder of its message.
  *   3) If the return code is 'NO_CONNECTION', the process will abandon the
  *      transmission because there is no established connection for session-id.
+ *  The messages of a session are sent in order. Once a session has a message
+ *   parked, its next messages are parked behind it, and only the oldest parked
+ *   message of a session is retried.
+ *  Every slot records whether its segment continues a message and whether it
+ *   is the last segment of that message. When a parked segment is dropped, the
+ *   slots chained behind it which continue the same message are released as
+ *   well, and the segments of that message which are still to come from [TAF]
+ *   are drained. The byte stream of a session therefore never has a hole in
+ *   the middle of a message.
+ *  Every send reply refreshes a per-session cache of the Tx buffer space. The
+ *   'spaceLeft' of a reply accounts for all the previously accepted requests,
+ *   and the buffer space of a session only shrinks with the requests of this
+ *   process. Therefore, the cached value is a lower bound of the actual space
+ *   as long as a single request is in flight. The cache is refreshed before it
+ *   is looked up, such that the reply served in a cycle is accounted for by a
+ *   request issued ahead in that same cycle. While a message is streamed, the
+ *   request-to-send of the next [TAF] segment is issued ahead if the cache
+ *   guarantees its admission, such that its data can follow the current
+ *   segment back-to-back. The data of a message are never forwarded before its
+ *   'NO_ERROR' reply is received, but a request-to-send is issued in the cycle
+ *   it is decided, and the first chunk of a segment is streamed in the cycle
+ *   its reply is served. The metadata of the next [TAF] message are prefetched
+ *   as soon as the current message is taken. Back-to-back segments are
+ *   therefore streamed at one chunk per cycle, down to single-chunk segments
+ *   as long as the reply of a request arrives within the following cycle.
+ *  The Tx test requests of [COn] are served by a traffic generator which runs
+ *   up to 'cGenSessions' transfers concurrently. A transfer is split into
+ *   segments like a [TAF] message, but its segments are generated on the fly
+ *   with the pattern programmed via 'CFG_TX_GEN'. Therefore, a segment refused
+ *   with 'NO_SPACE' is simply requested again after an exponential backoff,
+ *   and a transfer is given up after 'cRtyMaxTries' consecutive refusals. The
+ *   generator and the other sources are served in turn, and the segments of
+ *   the generator are requested ahead as well. An optional token bucket limits
+ *   the rate of the generator, whatever the number of its transfers.
+ *  A transfer may be repeated (see 'TxTestReq'). Its entry is then reloaded
+ *   as soon as the last segment of a repetition is granted, such that the
+ *   first segment of the next repetition can be requested ahead and a single
+ *   command drives an arbitrarily long transmit run at line rate.
  *
+ * @warning
+ *  A segment which finds no free slot is retried in place, up to 0x200 times,
+ *   and will therefore block the other sessions while it is retried. A segment
+ *   which is given up or refused with 'NO_CONNECTION' drops the remainder of its
+ *   message, but the segments of that message which were already sent are not
+ *   recalled.
+ *  A Tx test request for a session which already has a transfer running waits
+ *   for that transfer to complete, and holds back the next requests meanwhile.
  *******************************************************************************/
 void pWritePath(
         CmdBit               *piSHL_Enable,
+        stream<TcpDatLen>    &siMCh_SegLen,
+        stream<TxGenCfg>     &siMCh_GenCfg,
         stream<TcpAppData>   &siTAF_Data,
         stream<TcpSessId>    &siTAF_SessId,
         stream<TcpDatLen>    &siTAF_DatLen,
-        stream<TcpDatLen>    &siCOn_TxBytesReq,
+        stream<TxTestReq>    &siCOn_TxBytesReq,
         stream<SessionId>    &siCOn_TxSessId,
         stream<TcpAppData>   &soSHL_Data,
         stream<TcpAppSndReq> &soSHL_SndReq,
-        stream<TcpAppSndRep> &siSHL_SndRep)
+        stream<TcpAppSndRep> &siSHL_SndRep,
+        stream<SessionId>    &soSLc_TxAct)
 {
     //-- DIRECTIVES FOR THIS PROCESS -------------------------------------------
     #pragma HLS INLINE off
@@ -1510,103 +4383,374 @@ void pWritePath(
 
     const char *myName = concat3(THIS_NAME, "/", "WRp");
 
+  #ifndef __SYNTHESIS__
+    const ap_uint<16> cRtyBackoff =  16;  // Backoff before the 2nd attempt (in cycles)
+  #else
+    const ap_uint<16> cRtyBackoff = 256;
+  #endif
+
+    //-- STATIC ARRAYS (Send-retry queue) --------------------------------------
+    static TcpAppData          RTY_BUF[cRtySlots*cRtySlotChunks];
+    #pragma HLS RESOURCE        variable=RTY_BUF core=RAM_2P
+    #pragma HLS DEPENDENCE      variable=RTY_BUF inter false
+    static bool                RTY_BUSY[cRtySlots];
+    #pragma HLS ARRAY_PARTITION variable=RTY_BUSY  complete dim=1
+    #pragma HLS reset           variable=RTY_BUSY
+    static SessionId           RTY_SESS[cRtySlots];
+    #pragma HLS ARRAY_PARTITION variable=RTY_SESS  complete dim=1
+    static TcpDatLen           RTY_LEN[cRtySlots];
+    #pragma HLS ARRAY_PARTITION variable=RTY_LEN   complete dim=1
+    static bool                RTY_HEAD[cRtySlots];  // Oldest parked message of its session
+    #pragma HLS ARRAY_PARTITION variable=RTY_HEAD  complete dim=1
+    static bool                RTY_LINK[cRtySlots];  // A younger message of the session is chained
+    #pragma HLS ARRAY_PARTITION variable=RTY_LINK  complete dim=1
+    static RtySlotIdx          RTY_NEXT[cRtySlots];
+    #pragma HLS ARRAY_PARTITION variable=RTY_NEXT  complete dim=1
+    static bool                RTY_CONT[cRtySlots];  // The segment continues a message
+    #pragma HLS ARRAY_PARTITION variable=RTY_CONT  complete dim=1
+    static bool                RTY_LAST[cRtySlots];  // The segment is the last one of its message
+    #pragma HLS ARRAY_PARTITION variable=RTY_LAST  complete dim=1
+    static ap_uint<4>          RTY_TRIES[cRtySlots];
+    #pragma HLS ARRAY_PARTITION variable=RTY_TRIES complete dim=1
+    static ap_uint<16>         RTY_WAIT[cRtySlots];  // #Cycles before the next attempt
+    #pragma HLS ARRAY_PARTITION variable=RTY_WAIT  complete dim=1
+
+    //-- STATIC ARRAYS (Tx space cache) ----------------------------------------
+    static TcpDatLen           TX_SPACE[cMaxSessions];  // A lower bound of the Tx buffer space
+    #pragma HLS RESOURCE        variable=TX_SPACE core=RAM_2P
+
+    //-- STATIC ARRAYS (Tx traffic generator) ----------------------------------
+    static bool                GEN_BUSY[cGenSessions];
+    #pragma HLS ARRAY_PARTITION variable=GEN_BUSY  complete dim=1
+    #pragma HLS reset           variable=GEN_BUSY
+    static SessionId           GEN_SESS[cGenSessions];
+    #pragma HLS ARRAY_PARTITION variable=GEN_SESS  complete dim=1
+    static GenLen              GEN_LEFT[cGenSessions];   // #Bytes left to request
+    #pragma HLS ARRAY_PARTITION variable=GEN_LEFT  complete dim=1
+    static TxTestLen           GEN_LEN[cGenSessions];    // #Bytes of a repetition of the transfer
+    #pragma HLS ARRAY_PARTITION variable=GEN_LEN   complete dim=1
+    static ap_uint<16>         GEN_RPT[cGenSessions];    // #Repetitions left after the current one
+    #pragma HLS ARRAY_PARTITION variable=GEN_RPT   complete dim=1
+    static ap_uint<64>         GEN_CHUNK[cGenSessions];  // Index of the next chunk of the transfer
+    #pragma HLS ARRAY_PARTITION variable=GEN_CHUNK complete dim=1
+    static ap_uint<64>         GEN_PRBS[cGenSessions];   // State of the pseudo-random sequence
+    #pragma HLS ARRAY_PARTITION variable=GEN_PRBS  complete dim=1
+    static ap_uint<64>         GEN_SEQ[cGenSessions];    // Sequence number of the next segment
+    #pragma HLS ARRAY_PARTITION variable=GEN_SEQ   complete dim=1
+    static ap_uint<4>          GEN_TRIES[cGenSessions];
+    #pragma HLS ARRAY_PARTITION variable=GEN_TRIES complete dim=1
+    static ap_uint<16>         GEN_WAIT[cGenSessions];   // #Cycles before the next attempt
+    #pragma HLS ARRAY_PARTITION variable=GEN_WAIT  complete dim=1
+
     //-- STATIC CONTROL VARIABLES (with RESET) ---------------------------------
-    static enum FsmStates { WRP_IDLE=0, WRP_RTS, WRP_RTS_REP,
-                            WRP_STREAM, WRP_TXGEN, WRP_DRAIN } \
+    static enum FsmStates { WRP_IDLE=0, WRP_RTS, WRP_RTS_REP, WRP_STREAM,
+                            WRP_TXGEN, WRP_DRAIN, WRP_PARK, WRP_UNPARK } \
                                wrp_fsmState=WRP_IDLE;
     #pragma HLS reset variable=wrp_fsmState
-    static enum GenChunks { CHK0=0, CHK1 } \
-                               wrp_genChunk=CHK0;
-    #pragma HLS reset variable=wrp_genChunk
+    static enum SendSources { SRC_GEN=0, SRC_TAF, SRC_RTY } \
+                               wrp_source=SRC_GEN;
+    #pragma HLS reset variable=wrp_source
+    static bool                wrp_tafPending=false;  // A request from [TAF] is waiting to be served
+    #pragma HLS reset variable=wrp_tafPending
+    static RtySlotIdx          wrp_lastSlot=0;        // The last slot retried
+    #pragma HLS reset variable=wrp_lastSlot
+    static ap_uint<cMaxSessions> wrp_spaceValid=0;    // The entry of 'TX_SPACE' is valid
+    #pragma HLS reset variable=wrp_spaceValid
+    static bool                wrp_early=false;       // The request of 'wrp_earlyReq' was issued ahead
+    #pragma HLS reset variable=wrp_early
+    static bool                wrp_earlyRepValid=false;  // The reply of 'wrp_earlyReq' was received
+    #pragma HLS reset variable=wrp_earlyRepValid
+    static bool                wrp_tafMid=false;      // 'wrp_tafReq' is the remainder of a segmented message
+    #pragma HLS reset variable=wrp_tafMid
+    static TcpDatLen           wrp_segLen=cTxSegLen;  // The maximum length of a Tx segment
+    #pragma HLS reset variable=wrp_segLen
+    static bool                wrp_genTurn=true;      // The generator has priority over the other sources
+    #pragma HLS reset variable=wrp_genTurn
+    static GenIdx              wrp_lastGen=0;         // The last transfer served by the generator
+    #pragma HLS reset variable=wrp_lastGen
+    static bool                wrp_genReqVal=false;   // A Tx test request from [COn] is waiting for an entry
+    #pragma HLS reset variable=wrp_genReqVal
+    static ap_uint<2>          wrp_genPattern=GEN_PAT_HELLO;
+    #pragma HLS reset variable=wrp_genPattern
+    static bool                wrp_genStamp=false;    // Stamp the segments of the generator
+    #pragma HLS reset variable=wrp_genStamp
+    static ap_uint<64>         wrp_genConst=0;
+    #pragma HLS reset variable=wrp_genConst
+    static ap_uint<12>         wrp_genRate=0;         // Rate limit (in 1/256 bytes per cycle, 0=unlimited)
+    #pragma HLS reset variable=wrp_genRate
+    static ap_uint<24>         wrp_genTokens=0;       // Token bucket of the rate limiter (in 1/256 bytes)
+    #pragma HLS reset variable=wrp_genTokens
+    static ap_uint<64>         wrp_clock=0;
+    #pragma HLS reset variable=wrp_clock
 
     //-- STATIC DATAFLOW VARIABLES ---------------------------------------------
     static TcpAppSndReq wrp_sendReq;
-    static FlagBool     wrp_testMode;
+    static TcpAppSndReq wrp_tafReq;
     static uint16_t     wrp_retryCnt;
+    static RtySlotIdx   wrp_slot;
+    static RtyChunkIdx  wrp_chunkIdx;
+    static TcpAppSndReq wrp_earlyReq;
+    static TcpAppSndRep wrp_earlyRep;
+    static TcpDatLen    wrp_segLeft;  // #Bytes left in the segment being streamed or parked
+    static bool         wrp_segCont;  // The last [TAF] segment taken continues a message
+    static bool         wrp_segLast;  // The last [TAF] segment taken ends its message
+    static SendSources  wrp_earlySrc;
+    static GenIdx       wrp_earlyGen;
+    static GenIdx       wrp_gen;      // The transfer of the generator being served
+    static ap_uint<2>   wrp_genHdr;   // #Chunks of the current segment generated so far (saturated)
+    static SessionId    wrp_genSess;  // The session of the Tx test request waiting for an entry
+    static TxTestReq    wrp_genReq;
 
     //-- DYNAMIC VARIABLES -----------------------------------------------------
     TcpAppData  appData;
+    RtyBufPtr   bufPtr;
+    bool        dueFound   = false;
+    RtySlotIdx  dueSlot    = 0;
+    bool        freeFound  = false;
+    RtySlotIdx  freeSlot   = 0;
+    bool        tailFound  = false;
+    RtySlotIdx  tailSlot   = 0;
+    bool        doPark     = false;
+    bool        parkAsHead = false;  // Otherwise, the parked message is chained to 'tailSlot'
+    bool        doRelease  = false;
+    bool        doDrop     = false;  // The current slot is released with the remainder of its message
+    bool        isStreaming = false;
+    bool        endOfMsg   = false;
+    bool        repRead    = false;
+    TcpAppSndRep newRep;
+    TcpDatLen   tafSegLen  = (wrp_tafReq.length > wrp_segLen) ? wrp_segLen : wrp_tafReq.length;
+    bool        takeSeg    = false;  // The next segment of 'wrp_tafReq' is taken
+    bool        genDue     = false;
+    GenIdx      genIdx     = 0;
+    bool        genHit     = false;
+    bool        genFree    = false;
+    GenIdx      genFreeIdx = 0;
+    bool        genStart   = false;  // A segment of the generator was granted
 
     if (*piSHL_Enable != 1) {
         return;
     }
 
+    if (!siMCh_SegLen.empty()) {
+        siMCh_SegLen.read(wrp_segLen);
+    }
+    if (!siMCh_GenCfg.empty()) {
+        TxGenCfg genCfg = siMCh_GenCfg.read();
+        switch (genCfg.field) {
+        case GEN_CFG_PATTERN:
+            wrp_genPattern = genCfg.value(1,0);
+            wrp_genStamp   = genCfg.value[8];
+            break;
+        case GEN_CFG_CONST_LO:
+            wrp_genConst(31, 0) = genCfg.value;
+            break;
+        case GEN_CFG_CONST_HI:
+            wrp_genConst(63,32) = genCfg.value;
+            break;
+        case GEN_CFG_RATE:
+            wrp_genRate   = genCfg.value(11,0);
+            wrp_genTokens = 0;
+            break;
+        }
+    }
+
+    wrp_clock++;
+
+    //-- Refill the token bucket of the generator (up to one segment)
+    if ((wrp_genRate != 0) and (wrp_genTokens < ((ap_uint<24>)wrp_segLen << 8))) {
+        wrp_genTokens += wrp_genRate;
+    }
+
+    //-- Count down the backoff of the parked messages
+    for (int s=0; s<cRtySlots; ++s) {
+        #pragma HLS UNROLL
+        if (RTY_WAIT[s] != 0) {
+            RTY_WAIT[s] -= 1;
+        }
+    }
+    for (int g=0; g<cGenSessions; ++g) {
+        #pragma HLS UNROLL
+        if (GEN_WAIT[g] != 0) {
+            GEN_WAIT[g] -= 1;
+        }
+    }
+
+    //-- Look up the send-retry queue
+    for (int k=1; k<=cRtySlots; ++k) {
+        #pragma HLS UNROLL
+        RtySlotIdx s = wrp_lastSlot + k;
+        if (!dueFound and RTY_BUSY[s] and RTY_HEAD[s] and (RTY_WAIT[s] == 0)) {
+            dueFound = true;
+            dueSlot  = s;
+        }
+    }
+    for (int s=0; s<cRtySlots; ++s) {
+        #pragma HLS UNROLL
+        if (!freeFound and !RTY_BUSY[s]) {
+            freeFound = true;
+            freeSlot  = s;
+        }
+        if (RTY_BUSY[s] and !RTY_LINK[s] and (RTY_SESS[s] == wrp_tafReq.sessId)) {
+            tailFound = true;
+            tailSlot  = s;
+        }
+    }
+
+    //-- Look up the transfers of the generator
+    for (int k=1; k<=cGenSessions; ++k) {
+        #pragma HLS UNROLL
+        GenIdx g = wrp_lastGen + k;
+        if (!genDue and GEN_BUSY[g] and (GEN_LEFT[g] != 0) and (GEN_WAIT[g] == 0)) {
+            genDue = true;
+            genIdx = g;
+        }
+    }
+    for (int g=0; g<cGenSessions; ++g) {
+        #pragma HLS UNROLL
+        if (GEN_BUSY[g] and (GEN_SESS[g] == wrp_genSess)) {
+            genHit = true;
+        }
+        if (!genFree and !GEN_BUSY[g]) {
+            genFree    = true;
+            genFreeIdx = g;
+        }
+    }
+    TcpDatLen   genSegLen = (GEN_LEFT[genIdx] > wrp_segLen) ? wrp_segLen : TcpDatLen(GEN_LEFT[genIdx]);
+    bool        genReady  = genDue and ((wrp_genRate == 0) or
+                                        (wrp_genTokens >= ((ap_uint<24>)genSegLen << 8)));
+
     switch (wrp_fsmState) {
     case WRP_IDLE:
-        //-- Always give priority to the Tx test generator (for testing reasons)
-        if (!siCOn_TxSessId.empty() and !siCOn_TxBytesReq.empty()) {
-            siCOn_TxSessId.read(wrp_sendReq.sessId);
-            siCOn_TxBytesReq.read(wrp_sendReq.length);
+        //-- Serve the Tx traffic generator and the other sources in turn
+        if (genReady and (wrp_genTurn or (!dueFound and !wrp_tafPending and siTAF_SessId.empty()))) {
+            wrp_gen      = genIdx;
+            wrp_lastGen  = genIdx;
+            wrp_sendReq  = TcpAppSndReq(GEN_SESS[genIdx], genSegLen);
+            wrp_source   = SRC_GEN;
+            wrp_genTurn  = false;
+            wrp_fsmState = WRP_RTS;
+        }
+        //-- Retry the oldest parked message of a session once its backoff has expired
+        else if (dueFound) {
+            wrp_slot = dueSlot;
+            wrp_lastSlot = dueSlot;
+            wrp_sendReq.sessId = RTY_SESS[dueSlot];
+            wrp_sendReq.length = RTY_LEN[dueSlot];
             if (DEBUG_LEVEL & TRACE_WRP) {
-                printInfo(myName, "Received a Tx test request from [TSIF/COn] for sessId=%d and nrBytes=%d.\n",
-                        wrp_sendReq.sessId.to_uint(), wrp_sendReq.length.to_uint());
-            }
-            if (wrp_sendReq.length != 0) {
-                wrp_testMode = true;
-                wrp_retryCnt = 0x200;
-                wrp_fsmState = WRP_RTS;
-            }
-            else {
-                wrp_fsmState = WRP_IDLE;
+                printInfo(myName, "Retrying to send the %d bytes of session #%d parked in slot #%d (Attempt #%d).\n",
+                          RTY_LEN[dueSlot].to_uint(), RTY_SESS[dueSlot].to_uint(),
+                          dueSlot.to_uint(), RTY_TRIES[dueSlot].to_uint()+1);
             }
+            wrp_source   = SRC_RTY;
+            wrp_genTurn  = true;
+            wrp_fsmState = WRP_RTS;
         }
-        else if (!siTAF_SessId.empty() and !siTAF_DatLen.empty()) {
-            siTAF_SessId.read(wrp_sendReq.sessId);
-            siTAF_DatLen.read(wrp_sendReq.length);
-            if (DEBUG_LEVEL & TRACE_WRP) {
-                printInfo(myName, "Received a data forward request from [ROLE/TAF] for sessId=%d and nrBytes=%d.\n",
-                          wrp_sendReq.sessId.to_uint(), wrp_sendReq.length.to_uint());
+        else if (wrp_tafPending) {
+            if (tailFound) {
+                //-- The session has parked segments. Park this one behind them.
+                if (freeFound) {
+                    doPark      = true;
+                    takeSeg     = true;
+                    wrp_sendReq = TcpAppSndReq(wrp_tafReq.sessId, tafSegLen);
+                    wrp_genTurn = true;
+                }
             }
-            if (wrp_sendReq.length != 0) {
-                wrp_testMode = false;
+            else {
+                takeSeg      = true;
+                wrp_sendReq  = TcpAppSndReq(wrp_tafReq.sessId, tafSegLen);
+                wrp_source   = SRC_TAF;
                 wrp_retryCnt = 0x200;
+                wrp_genTurn  = true;
                 wrp_fsmState = WRP_RTS;
             }
         }
         break;
-    case WRP_RTS:
-        if (!soSHL_SndReq.full()) {
-            soSHL_SndReq.write(wrp_sendReq);
-            wrp_fsmState = WRP_RTS_REP;
-        }
-        break;
     case WRP_RTS_REP:
-        if (!siSHL_SndRep.empty()) {
-            //-- Read the request-to-send reply and continue accordingly
-            TcpAppSndRep appSndRep = siSHL_SndRep.read();
+        if (wrp_earlyRepValid or !siSHL_SndRep.empty()) {
+            //-- Read the request-to-send reply (unless received ahead) and continue accordingly
+            TcpAppSndRep appSndRep;
+            if (wrp_earlyRepValid) {
+                appSndRep = wrp_earlyRep;
+                wrp_earlyRepValid = false;
+            }
+            else {
+                appSndRep = siSHL_SndRep.read();
+                newRep    = appSndRep;
+                repRead   = true;
+            }
             switch (appSndRep.error) {
             case NO_ERROR:
-                if (wrp_testMode) {
-                    wrp_genChunk = CHK0;
+                if (wrp_source == SRC_GEN) {
+                    genStart     = true;
                     wrp_fsmState = WRP_TXGEN;
                 }
+                else if (wrp_source == SRC_RTY) {
+                    wrp_chunkIdx = 0;
+                    wrp_fsmState = WRP_UNPARK;
+                }
                 else {
+                    wrp_segLeft  = wrp_sendReq.length;
                     wrp_fsmState = WRP_STREAM;
                 }
                 break;
             case NO_SPACE:
-                printWarn(myName, "Not enough space for writing %d bytes in the Tx buffer of session #%d. Available space is %d bytes.\n",
-                          appSndRep.length.to_uint(), appSndRep.sessId.to_uint(), appSndRep.spaceLeft.to_uint());
-                if (wrp_retryCnt) {
-                    wrp_retryCnt -= 1;
-                    wrp_fsmState = WRP_RTS;
+                if (DEBUG_LEVEL & TRACE_WRP) {
+                    printInfo(myName, "Not enough space for writing %d bytes in the Tx buffer of session #%d. Available space is %d bytes.\n",
+                              appSndRep.length.to_uint(), appSndRep.sessId.to_uint(), appSndRep.spaceLeft.to_uint());
                 }
-                else {
-                    if (wrp_testMode) {
-                        wrp_fsmState = WRP_IDLE;
+                if (wrp_source == SRC_RTY) {
+                    if (RTY_TRIES[wrp_slot] == cRtyMaxTries-1) {
+                        printWarn(myName, "Giving up sending the %d bytes of session #%d after %d attempts.\n",
+                                  RTY_LEN[wrp_slot].to_uint(), RTY_SESS[wrp_slot].to_uint(), cRtyMaxTries);
+                        doDrop = true;
                     }
                     else {
-                        wrp_fsmState = WRP_DRAIN;
+                        RTY_TRIES[wrp_slot] += 1;
+                        RTY_WAIT[wrp_slot]   = cRtyBackoff << RTY_TRIES[wrp_slot];
                     }
+                    wrp_fsmState = WRP_IDLE;
+                }
+                else if (wrp_source == SRC_GEN) {
+                    if (GEN_TRIES[wrp_gen] == cRtyMaxTries-1) {
+                        printWarn(myName, "Giving up the Tx test transfer of session #%d after %d attempts.\n",
+                                  GEN_SESS[wrp_gen].to_uint(), cRtyMaxTries);
+                        GEN_BUSY[wrp_gen] = false;
+                    }
+                    else {
+                        GEN_TRIES[wrp_gen] += 1;
+                        GEN_WAIT[wrp_gen]   = cRtyBackoff << GEN_TRIES[wrp_gen];
+                    }
+                    wrp_fsmState = WRP_IDLE;
+                }
+                else if ((wrp_source == SRC_TAF) and freeFound) {
+                    doPark     = true;
+                    parkAsHead = true;
+                }
+                else if (wrp_retryCnt) {
+                    wrp_retryCnt -= 1;
+                    wrp_fsmState = WRP_RTS;
+                }
+                else {
+                    printWarn(myName, "Giving up sending %d bytes to session #%d. Available space is %d bytes.\n",
+                              appSndRep.length.to_uint(), appSndRep.sessId.to_uint(), appSndRep.spaceLeft.to_uint());
+                    wrp_tafPending = wrp_tafPending and !wrp_tafMid;
+                    wrp_tafMid   = false;
+                    wrp_fsmState = WRP_DRAIN;
                 }
                 break;
             case NO_CONNECTION:
                 printWarn(myName, "Attempt to write data for a session that is not established.\n");
-                if (wrp_testMode) {
-                    wrp_fsmState = WRP_IDLE;
+                if (wrp_source == SRC_TAF) {
+                    wrp_tafPending = wrp_tafPending and !wrp_tafMid;
+                    wrp_tafMid   = false;
+                    wrp_fsmState = WRP_DRAIN;
                 }
                 else {
-                    wrp_fsmState = WRP_DRAIN;
+                    doDrop = (wrp_source == SRC_RTY);
+                    if (wrp_source == SRC_GEN) {
+                        GEN_BUSY[wrp_gen] = false;
+                    }
+                    wrp_fsmState = WRP_IDLE;
                 }
                 break;
             default:
@@ -1616,62 +4760,340 @@ void pWritePath(
             }
         }
         break;
+    case WRP_DRAIN:
+        if (!siTAF_Data.empty()) {
+            siTAF_Data.read(appData);
+            if (DEBUG_LEVEL & TRACE_WRP) { printAxisRaw(myName, "Draining siTAF_Data =", appData); }
+            if(appData.getTLast()) {
+                wrp_fsmState = WRP_IDLE;
+            }
+        }
+        break;
+    case WRP_PARK:
+        if (!siTAF_Data.empty()) {
+            siTAF_Data.read(appData);
+            if (wrp_segLeft <= (ARW/8)) {
+                appData.setLE_TLast(TLAST);
+            }
+            bufPtr = wrp_slot * cRtySlotChunks + wrp_chunkIdx;
+            RTY_BUF[bufPtr] = appData;
+            wrp_segLeft  -= (ARW/8);
+            wrp_chunkIdx += 1;
+            if(appData.getTLast()) {
+                wrp_fsmState = WRP_IDLE;
+            }
+        }
+        break;
+    default:
+        //-- The request-to-send and the streaming states are served below
+        break;
+    } // End-of: switch
+
+    //-- Issue the request-to-send in the same cycle as it is decided
+    if ((wrp_fsmState == WRP_RTS) and !soSHL_SndReq.full()) {
+        soSHL_SndReq.write(wrp_sendReq);
+        wrp_fsmState = WRP_RTS_REP;
+    }
+
+    //-- Start a segment of the generator
+    if (genStart) {
+        GenLen left = GEN_LEFT[wrp_gen] - wrp_sendReq.length;
+        if ((left == 0) and (GEN_RPT[wrp_gen] != 0)) {
+            //-- Chain the next repetition of the transfer
+            GEN_LEFT[wrp_gen] = GEN_LEN[wrp_gen];
+            GEN_RPT[wrp_gen] -= 1;
+        }
+        else {
+            GEN_LEFT[wrp_gen] = left;
+        }
+        GEN_TRIES[wrp_gen]  = 0;
+        wrp_segLeft = wrp_sendReq.length;
+        wrp_genHdr  = 0;
+        ap_uint<24> cost = (ap_uint<24>)wrp_sendReq.length << 8;
+        wrp_genTokens = (wrp_genTokens > cost) ? ap_uint<24>(wrp_genTokens - cost) : ap_uint<24>(0);
+    }
+
+    //-- Stream the current segment, starting in the same cycle as its reply
+    isStreaming = (wrp_fsmState == WRP_STREAM) or (wrp_fsmState == WRP_UNPARK) or
+                  (wrp_fsmState == WRP_TXGEN);
+    switch (wrp_fsmState) {
     case WRP_STREAM:
         if (!siTAF_Data.empty() and !soSHL_Data.full()) {
             siTAF_Data.read(appData);
+            if (wrp_segLeft <= (ARW/8)) {
+                //-- Terminate the segment
+                appData.setLE_TLast(TLAST);
+            }
             soSHL_Data.write(appData);
+            wrp_segLeft -= (ARW/8);
             if (DEBUG_LEVEL & TRACE_WRP) { printAxisRaw(myName, "soSHL_Data = ", appData); }
             if(appData.getTLast()) {
+                endOfMsg = true;
                 wrp_fsmState = WRP_IDLE;
             }
         }
         break;
     case WRP_TXGEN:
         if (!soSHL_Data.full()) {
-            TcpAppData currChunk(0,0,0);
-            if (wrp_sendReq.length > 8) {
+            TcpAppData  currChunk(0,0,0);
+            ap_uint<64> genWord;
+            switch (wrp_genPattern) {
+            case GEN_PAT_INCR:
+                genWord = GEN_CHUNK[wrp_gen];
+                break;
+            case GEN_PAT_PRBS:
+                genWord = GEN_PRBS[wrp_gen];
+                break;
+            case GEN_PAT_CONST:
+                genWord = wrp_genConst;
+                break;
+            default: // Send 'Hi from ' and 'FMKU60!\n' alternately
+                genWord = (GEN_CHUNK[wrp_gen][0] == 0) ? GEN_CHK0 : GEN_CHK1;
+                break;
+            }
+            if (wrp_genStamp and (wrp_genHdr == 0)) {
+                genWord = GEN_SEQ[wrp_gen];
+            }
+            else if (wrp_genStamp and (wrp_genHdr == 1)) {
+                genWord = wrp_clock;
+            }
+            currChunk.setTData(genWord);
+            if (wrp_segLeft > (ARW/8)) {
                 currChunk.setLE_TKeep(0xFF);
-                wrp_sendReq.length -= 8;
+                wrp_segLeft -= (ARW/8);
             }
             else {
-                currChunk.setLE_TKeep(lenToLE_tKeep(wrp_sendReq.length));
+                currChunk.setLE_TKeep(lenToLE_tKeep(wrp_segLeft));
                 currChunk.setLE_TLast(TLAST);
+                GEN_SEQ[wrp_gen] += 1;
+                if (GEN_LEFT[wrp_gen] == 0) {
+                    //-- End of the transfer
+                    GEN_BUSY[wrp_gen] = false;
+                }
+                endOfMsg = true;
                 wrp_fsmState = WRP_IDLE;
             }
-            switch (wrp_genChunk) {
-            case CHK0: // Send 'Hi from '
-                currChunk.setTData(GEN_CHK0);
-                wrp_genChunk = CHK1;
-                break;
-            case CHK1: // Send 'FMKU60!\n'
-                currChunk.setTData(GEN_CHK1);
-                wrp_genChunk = CHK0;
-                break;
+            if (wrp_genHdr != 2) {
+                wrp_genHdr += 1;
             }
+            GEN_CHUNK[wrp_gen] += 1;
+            GEN_PRBS[wrp_gen]   = prbsNext(GEN_PRBS[wrp_gen]);
             currChunk.clearUnusedBytes();
             soSHL_Data.write(currChunk);
             if (DEBUG_LEVEL & TRACE_WRP) { printAxisRaw(myName, "soSHL_Data =", currChunk); }
         }
         break;
-    case WRP_DRAIN:
-        if (!siTAF_Data.empty()) {
-            siTAF_Data.read(appData);
-            if (DEBUG_LEVEL & TRACE_WRP) { printAxisRaw(myName, "Draining siTAF_Data =", appData); }
+    case WRP_UNPARK:
+        if (!soSHL_Data.full()) {
+            bufPtr  = wrp_slot * cRtySlotChunks + wrp_chunkIdx;
+            appData = RTY_BUF[bufPtr];
+            soSHL_Data.write(appData);
+            if (DEBUG_LEVEL & TRACE_WRP) { printAxisRaw(myName, "soSHL_Data = ", appData); }
+            wrp_chunkIdx += 1;
             if(appData.getTLast()) {
+                doRelease = true;
+                endOfMsg  = true;
                 wrp_fsmState = WRP_IDLE;
             }
         }
         break;
+    default:
+        break;
     } // End-of: switch
 
+    //-- Read the reply of the request issued ahead while the current segment streams
+    if (isStreaming and wrp_early and !wrp_earlyRepValid and !siSHL_SndRep.empty()) {
+        wrp_earlyRep      = siSHL_SndRep.read();
+        wrp_earlyRepValid = true;
+        newRep  = wrp_earlyRep;
+        repRead = true;
+    }
+
+    //-- Refresh the Tx space cache with every send reply (before it is looked up ahead)
+    if (repRead) {
+        if (newRep.error == NO_CONNECTION) {
+            wrp_spaceValid[newRep.sessId] = 0;
+        }
+        else {
+            TcpDatLen space = newRep.spaceLeft;
+            if (newRep.error == NO_ERROR) {
+                space = (newRep.spaceLeft > newRep.length) ? TcpDatLen(newRep.spaceLeft - newRep.length) : TcpDatLen(0);
+            }
+            TX_SPACE[newRep.sessId] = space;
+            wrp_spaceValid[newRep.sessId] = 1;
+        }
+        //-- Report the Tx activity of the session (a lost report is harmless)
+        if ((newRep.error == NO_ERROR) and !soSLc_TxAct.full()) {
+            soSLc_TxAct.write(newRep.sessId);
+        }
+    }
+
+    //-- Look ahead at the next segment while the current segment streams
+    if (isStreaming) {
+        if (!wrp_early) {
+            //-- Re-evaluate the entry of the generator, its current segment may start in this cycle
+            TcpDatLen nextGenLen = (GEN_LEFT[genIdx] > wrp_segLen) ? wrp_segLen : TcpDatLen(GEN_LEFT[genIdx]);
+            bool      nextGenOk  = genDue and GEN_BUSY[genIdx] and (GEN_LEFT[genIdx] != 0) and
+                                   ((wrp_genRate == 0) or (wrp_genTokens >= ((ap_uint<24>)nextGenLen << 8)));
+            bool      preferGen = nextGenOk and (wrp_genTurn or !wrp_tafPending or tailFound);
+            SessionId nextSess  = (preferGen) ? GEN_SESS[genIdx] : wrp_tafReq.sessId;
+            TcpDatLen nextLen   = (preferGen) ? nextGenLen : tafSegLen;
+            bool      admitted  = wrp_spaceValid[nextSess] and (TX_SPACE[nextSess] >= nextLen);
+            if ((preferGen or (wrp_tafPending and !tailFound)) and admitted and !soSHL_SndReq.full()) {
+                //-- Admission is guaranteed. Issue the request ahead.
+                wrp_earlyReq = TcpAppSndReq(nextSess, nextLen);
+                soSHL_SndReq.write(wrp_earlyReq);
+                wrp_early    = true;
+                wrp_earlySrc = (preferGen) ? SRC_GEN : SRC_TAF;
+                wrp_earlyGen = genIdx;
+                wrp_genTurn  = !preferGen;
+                if (preferGen) {
+                    wrp_lastGen = genIdx;
+                }
+                else {
+                    takeSeg = true;
+                }
+            }
+        }
+    }
+
+    //-- Chain the segment requested ahead to the end of the current one
+    if (endOfMsg and wrp_early) {
+        wrp_early    = false;
+        wrp_sendReq  = wrp_earlyReq;
+        wrp_source   = wrp_earlySrc;
+        wrp_gen      = wrp_earlyGen;
+        wrp_retryCnt = 0x200;
+        //-- The reply (if already received ahead) is served along with the first chunk
+        wrp_fsmState = WRP_RTS_REP;
+    }
+
+    //-- Accept a new Tx test request from [COn] into a free entry of the generator
+    if (!wrp_genReqVal) {
+        if (!siCOn_TxSessId.empty() and !siCOn_TxBytesReq.empty()) {
+            siCOn_TxSessId.read(wrp_genSess);
+            siCOn_TxBytesReq.read(wrp_genReq);
+            if (DEBUG_LEVEL & TRACE_WRP) {
+                printInfo(myName, "Received a Tx test request from [TSIF/COn] for sessId=%d and nrBytes=%ld (x%d).\n",
+                          wrp_genSess.to_uint(), (unsigned long)wrp_genReq.length.to_uint64(),
+                          wrp_genReq.repeat.to_uint());
+            }
+            wrp_genReqVal = (wrp_genReq.length != 0);
+        }
+    }
+    else if (!genHit and genFree) {
+        GEN_BUSY[genFreeIdx]  = true;
+        GEN_SESS[genFreeIdx]  = wrp_genSess;
+        GEN_LEFT[genFreeIdx]  = wrp_genReq.length;
+        GEN_LEN[genFreeIdx]   = wrp_genReq.length;
+        GEN_RPT[genFreeIdx]   = (wrp_genReq.repeat != 0) ? ap_uint<16>(wrp_genReq.repeat - 1) : ap_uint<16>(0);
+        GEN_CHUNK[genFreeIdx] = 0;
+        GEN_PRBS[genFreeIdx]  = ap_uint<64>(GEN_PRBS_SEED) ^ wrp_genSess;
+        GEN_SEQ[genFreeIdx]   = 0;
+        GEN_TRIES[genFreeIdx] = 0;
+        GEN_WAIT[genFreeIdx]  = 0;
+        wrp_genReqVal = false;
+    }
+
+    //-- Consume the segment taken from the current [TAF] message
+    if (takeSeg) {
+        wrp_segCont = wrp_tafMid;
+        wrp_segLast = (wrp_tafReq.length == tafSegLen);
+        wrp_tafReq.length -= tafSegLen;
+        wrp_tafPending = (wrp_tafReq.length != 0);
+        wrp_tafMid     = (wrp_tafReq.length != 0);
+    }
+
+    //-- Prefetch the metadata of the next [TAF] message as soon as the current one is taken
+    if (!wrp_tafPending and !siTAF_SessId.empty() and !siTAF_DatLen.empty()) {
+        siTAF_SessId.read(wrp_tafReq.sessId);
+        siTAF_DatLen.read(wrp_tafReq.length);
+        if (DEBUG_LEVEL & TRACE_WRP) {
+            printInfo(myName, "Received a data forward request from [ROLE/TAF] for sessId=%d and nrBytes=%d.\n",
+                      wrp_tafReq.sessId.to_uint(), wrp_tafReq.length.to_uint());
+        }
+        if (wrp_tafReq.length != 0) {
+            wrp_tafPending = true;
+        }
+    }
+
+    //-- Park the current [TAF] message into a free slot of the send-retry queue
+    if (doPark) {
+        RTY_BUSY[freeSlot]  = true;
+        RTY_SESS[freeSlot]  = wrp_sendReq.sessId;
+        RTY_LEN[freeSlot]   = wrp_sendReq.length;
+        RTY_HEAD[freeSlot]  = parkAsHead;
+        RTY_LINK[freeSlot]  = false;
+        RTY_CONT[freeSlot]  = wrp_segCont;
+        RTY_LAST[freeSlot]  = wrp_segLast;
+        RTY_TRIES[freeSlot] = parkAsHead ? 1 : 0;
+        RTY_WAIT[freeSlot]  = parkAsHead ? cRtyBackoff : ap_uint<16>(0);
+        if (!parkAsHead) {
+            RTY_LINK[tailSlot] = true;
+            RTY_NEXT[tailSlot] = freeSlot;
+        }
+        if (DEBUG_LEVEL & TRACE_WRP) {
+            printInfo(myName, "Parking the %d bytes of session #%d into slot #%d.\n",
+                      wrp_sendReq.length.to_uint(), wrp_sendReq.sessId.to_uint(), freeSlot.to_uint());
+        }
+        wrp_slot     = freeSlot;
+        wrp_chunkIdx = 0;
+        wrp_segLeft  = wrp_sendReq.length;
+        wrp_fsmState = WRP_PARK;
+    }
+
+    //-- Release the current slot and promote the next message of its session
+    if (doRelease) {
+        RTY_BUSY[wrp_slot] = false;
+        if (RTY_LINK[wrp_slot]) {
+            RTY_HEAD[RTY_NEXT[wrp_slot]] = true;
+        }
+    }
+
+    //-- Release the current slot with the remainder of its message
+    if (doDrop) {
+        RtySlotIdx lastSlot = wrp_slot;
+        bool       walking  = true;
+        RTY_BUSY[wrp_slot] = false;
+        for (int k=1; k<cRtySlots; ++k) {
+            #pragma HLS UNROLL
+            if (walking and RTY_LINK[lastSlot] and RTY_CONT[RTY_NEXT[lastSlot]]) {
+                lastSlot = RTY_NEXT[lastSlot];
+                RTY_BUSY[lastSlot] = false;
+            }
+            else {
+                walking = false;
+            }
+        }
+        if (RTY_LINK[lastSlot]) {
+            //-- Promote the next message of the session
+            RTY_HEAD[RTY_NEXT[lastSlot]] = true;
+        }
+        else if (!RTY_LAST[lastSlot] and wrp_tafMid and (wrp_tafReq.sessId == RTY_SESS[wrp_slot])) {
+            //-- The remainder of the message is still to come from [TAF]. Drain it.
+            wrp_tafPending = false;
+            wrp_tafMid     = false;
+            wrp_fsmState   = WRP_DRAIN;
+        }
+        if (DEBUG_LEVEL & TRACE_WRP) {
+            printInfo(myName, "Dropping the message of session #%d parked in slot #%d.\n",
+                      RTY_SESS[wrp_slot].to_uint(), wrp_slot.to_uint());
+        }
+    }
 }
 
 /*******************************************************************************
  * @brief TCP Shell Interface (TSIF)
  *
  * @param[in]  piSHL_Mmio_En Enable signal from [SHELL/MMIO].
+ * @param[in]  siSHL_Mmio_CfgCmd Configuration command from [SHELL/MMIO].
+ * @param[out] soSHL_Mmio_SinkStats The sink statistics read out by [SHELL/MMIO].
  * @param[in]  siTAF_Data    TCP data stream from TcpAppFlash (TAF).
  * @param[in]  siTAF_SessId  TCP session Id  from [TAF].
+ * @param[in]  siTAF_SockData TCP data stream of a socket-addressed message from [TAF].
+ * @param[in]  siTAF_SockAddr The remote socket of that message from [TAF].
+ * @param[in]  siTAF_SockLen  The length of that message from [TAF].
+ * @param[out] soTAF_SockRep  The session that message was sent on, to [TAF].
  * @param[out] soTAF_Data    TCP data stream to   [TAF].
  * @param[out] soTAF_SessId  TCP session Id  to   [TAF].
  * @param[in]  siSHL_Notif   TCP data notification from [SHELL].
@@ -1687,6 +5109,9 @@ void pWritePath(
  * @param[in]  siSHL_OpnRep  TCP open connection reply from [SHELL].
  * @param[out] soSHL_ClsReq  TCP close connection request to [SHELL].
  * @param[out] soDBG_SinkCnt Counts the number of sinked bytes (for debug).
+ * @param[out] soDBG_InpBufSpace The available space in the input buffer (for debug).
+ * @param[out] soDBG_OpnEvent The outcome of the open connection attempts (for debug).
+ * @param[out] soDBG_IpfReport The per-session reports of the iperf server (for debug).
  *******************************************************************************/
 void tcp_shell_if(
 
@@ -1694,6 +5119,8 @@ void tcp_shell_if(
         //-- SHELL / Mmio Interface
         //------------------------------------------------------
         CmdBit                *piSHL_Mmio_En,
+        stream<MmioCfgCmd>    &siSHL_Mmio_CfgCmd,
+        stream<SinkStats>     &soSHL_Mmio_SinkStats,
 
         //------------------------------------------------------
         //-- TAF / TxP Data Interface
@@ -1702,6 +5129,14 @@ void tcp_shell_if(
         stream<TcpSessId>     &siTAF_SessId,
         stream<TcpDatLen>     &siTAF_DatLen,
 
+        //------------------------------------------------------
+        //-- TAF / TxP Socket Interface
+        //------------------------------------------------------
+        stream<TcpAppData>    &siTAF_SockData,
+        stream<SockAddr>      &siTAF_SockAddr,
+        stream<TcpDatLen>     &siTAF_SockLen,
+        stream<SockSndRep>    &soTAF_SockRep,
+
         //------------------------------------------------------
         //-- TAF / RxP Data Interface
         //------------------------------------------------------
@@ -1745,7 +5180,9 @@ void tcp_shell_if(
         //-- DEBUG Probes
         //------------------------------------------------------
         stream<ap_uint<32> >  &soDBG_SinkCnt,
-        stream<ap_uint<16> >  &soDBG_InpBufSpace)
+        stream<ap_uint<16> >  &soDBG_InpBufSpace,
+        stream<ConnEvent>     &soDBG_OpnEvent,
+        stream<IperfReport>   &soDBG_IpfReport)
 {
     //-- DIRECTIVES FOR THIS PROCESS -------------------------------------------
     #pragma HLS DATAFLOW
@@ -1756,112 +5193,323 @@ void tcp_shell_if(
     //-- LOCAL STREAMS (Sorted by the name of the modules which generate them)
     //--------------------------------------------------------------------------
 
+    //-- MMIO Configuration Handler (MCh)
+    static stream<RxQuantumCfg>    ssMChToRRh_Quantum    ("ssMChToRRh_Quantum");
+    #pragma HLS stream    variable=ssMChToRRh_Quantum    depth=cDepth_MChToRRh_Quantum
+    #pragma HLS DATA_PACK variable=ssMChToRRh_Quantum
+    static stream<PortActCfg>      ssMChToRRh_PortAct    ("ssMChToRRh_PortAct");
+    #pragma HLS stream    variable=ssMChToRRh_PortAct    depth=cDepth_MChToRRh_PortAct
+    #pragma HLS DATA_PACK variable=ssMChToRRh_PortAct
+    static stream<LsnPortCfg>      ssMChToLSn_PortCfg    ("ssMChToLSn_PortCfg");
+    #pragma HLS stream    variable=ssMChToLSn_PortCfg    depth=cDepth_MChToLSn_PortCfg
+    #pragma HLS DATA_PACK variable=ssMChToLSn_PortCfg
+    static stream<TcpDatLen>       ssMChToWRp_SegLen     ("ssMChToWRp_SegLen");
+    #pragma HLS stream    variable=ssMChToWRp_SegLen     depth=cDepth_MChToWRp_SegLen
+    static stream<TxGenCfg>        ssMChToWRp_GenCfg     ("ssMChToWRp_GenCfg");
+    #pragma HLS stream    variable=ssMChToWRp_GenCfg     depth=cDepth_MChToWRp_GenCfg
+    #pragma HLS DATA_PACK variable=ssMChToWRp_GenCfg
+    static stream<ap_uint<16> >    ssMChToRDp_StatReq    ("ssMChToRDp_StatReq");
+    #pragma HLS stream    variable=ssMChToRDp_StatReq    depth=cDepth_MChToRDp_StatReq
+    static stream<SlcTime>         ssMChToSLc_IdleTmo    ("ssMChToSLc_IdleTmo");
+    #pragma HLS stream    variable=ssMChToSLc_IdleTmo    depth=cDepth_MChToSLc_IdleTmo
+    static stream<RxCoaCfg>        ssMChToRCo_CoaCfg     ("ssMChToRCo_CoaCfg");
+    #pragma HLS stream    variable=ssMChToRCo_CoaCfg     depth=cDepth_MChToRCo_CoaCfg
+    #pragma HLS DATA_PACK variable=ssMChToRCo_CoaCfg
+
+    //-- Session Lifecycle (SLc)
+    static stream<TcpAppNotif>     ssSLcToRRh_Notif      ("ssSLcToRRh_Notif");
+    #pragma HLS stream    variable=ssSLcToRRh_Notif      depth=cDepth_SLcToRRh_Notif
+    #pragma HLS DATA_PACK variable=ssSLcToRRh_Notif
+    static stream<SessionId>       ssSLcToRRh_ClrReq     ("ssSLcToRRh_ClrReq");
+    #pragma HLS stream    variable=ssSLcToRRh_ClrReq     depth=cDepth_SLcToRRh_ClrReq
+    static stream<SessionId>       ssSLcToCOn_ClsSig     ("ssSLcToCOn_ClsSig");
+    #pragma HLS stream    variable=ssSLcToCOn_ClsSig     depth=cDepth_SLcToCOn_ClsSig
+
     //-- Input Read Buffer (IRb)
-    static stream<TcpAppData>      ssIRbToRDp_Data       ("ssIRbToRDp_Data");
-    #pragma HLS stream    variable=ssIRbToRDp_Data       depth=cDepth_IRbToRDp_Data
-    static stream<TcpAppMeta>      ssIRbToRDp_Meta       ("ssIRbToRDp_Meta");
-    #pragma HLS stream    variable=ssIRbToRDp_Meta       depth=cDepth_IRbToRDp_Meta
+    static stream<TcpAppData>      ssIRbToRbp_Data       ("ssIRbToRbp_Data");
+    #pragma HLS stream    variable=ssIRbToRbp_Data       depth=cDepth_IRbToRbp_Data
+    static stream<TcpAppMeta>      ssIRbToRbp_Meta       ("ssIRbToRbp_Meta");
+    #pragma HLS stream    variable=ssIRbToRbp_Meta       depth=cDepth_IRbToRbp_Meta
+  #if defined USE_INTERRUPTS
+    static stream<ChunkBytes>      ssIRbToRRh_Enqueue    ("ssIRbToRRh_Enqueue");
+    #pragma HLS stream    variable=ssIRbToRRh_Enqueue    depth=cDepth_IRbToRRh_Enqueue
+  #else
 
     //-- Read Notification Handler (RNh)
     static stream <TcpAppNotif>    ssRNhToRRh_Notif      ("ssRNhToRRh_Notif");
     #pragma HLS stream    variable=ssRNhToRRh_Notif      depth=cDepth_RNhToRRh_Notif
+  #endif
 
     //-- Read Request Handler (RRh)
-    static stream<ForwardCmd>      ssRRhToRDp_FwdCmd     ("ssRRhToRDp_FwdCmd");
-    #pragma HLS stream    variable=ssRRhToRDp_FwdCmd     depth=cDepth_RRhToRDp_FwdCmd
-    #pragma HLS DATA_PACK variable=ssRRhToRDp_FwdCmd
+    static stream<ForwardCmd>      ssRRhToRbp_FwdCmd     ("ssRRhToRbp_FwdCmd");
+    #pragma HLS stream    variable=ssRRhToRbp_FwdCmd     depth=cDepth_RRhToRbp_FwdCmd
+    #pragma HLS DATA_PACK variable=ssRRhToRbp_FwdCmd
+  #if not defined USE_INTERRUPTS
     static stream<TcpAppRdReq>     ssRRhToRRm_DReq       ("ssRRhToRRm_DReq");
     #pragma HLS stream    variable=ssRRhToRRm_DReq       depth=cDepth_RRhToRRm_DReq
+  #endif
+
+    //-- Rx Buffer Pool (Rbp)
+    static stream<RxDequSig>       ssRbpToRRh_Dequeue    ("ssRbpToRRh_Dequeue");
+    #pragma HLS stream    variable=ssRbpToRRh_Dequeue    depth=cDepth_RbpToRRh_Dequeue
+    #pragma HLS DATA_PACK variable=ssRbpToRRh_Dequeue
+    static stream<ForwardCmd>      ssRbpToRDp_TafCmd     ("ssRbpToRDp_TafCmd");
+    #pragma HLS stream    variable=ssRbpToRDp_TafCmd     depth=cDepth_RbpToRDp_TafCmd
+    #pragma HLS DATA_PACK variable=ssRbpToRDp_TafCmd
+    static stream<TcpAppData>      ssRbpToRDp_TafData    ("ssRbpToRDp_TafData");
+    #pragma HLS stream    variable=ssRbpToRDp_TafData    depth=cDepth_RbpToRDp_LaneData
+    static stream<ForwardCmd>      ssRbpToRDp_SnkCmd     ("ssRbpToRDp_SnkCmd");
+    #pragma HLS stream    variable=ssRbpToRDp_SnkCmd     depth=cDepth_RbpToRDp_SnkCmd
+    #pragma HLS DATA_PACK variable=ssRbpToRDp_SnkCmd
+    static stream<TcpAppData>      ssRbpToRDp_SnkData    ("ssRbpToRDp_SnkData");
+    #pragma HLS stream    variable=ssRbpToRDp_SnkData    depth=cDepth_RbpToRDp_LaneData
+    static stream<TcpAppData>      ssRbpToRDp_GenData    ("ssRbpToRDp_GenData");
+    #pragma HLS stream    variable=ssRbpToRDp_GenData    depth=cDepth_RbpToRDp_LaneData
+    static stream<ForwardCmd>      ssRbpToIPs_IpfCmd     ("ssRbpToIPs_IpfCmd");
+    #pragma HLS stream    variable=ssRbpToIPs_IpfCmd     depth=cDepth_RbpToIPs_IpfCmd
+    #pragma HLS DATA_PACK variable=ssRbpToIPs_IpfCmd
+    static stream<TcpAppData>      ssRbpToIPs_IpfData    ("ssRbpToIPs_IpfData");
+    #pragma HLS stream    variable=ssRbpToIPs_IpfData    depth=cDepth_RbpToRDp_LaneData
 
     //-- Read Path (RDp)
-    static stream<SigBit>          ssRDpToRRh_Dequeue    ("ssRDpToRRh_Dequeue");
-    #pragma HLS stream    variable=ssRDpToRRh_Dequeue    depth=cDepth_RDpToRRh_Dequeue
     static stream<SockAddr>        ssRDpToCOn_OpnSockReq ("ssRDpToCOn_OpnSockReq");
     #pragma HLS stream    variable=ssRDpToCOn_OpnSockReq depth=cDepth_RDpToCOn_OpnSockReq
-    static stream<TcpDatLen>       ssRDpToCOn_TxCountReq ("ssRDpToCOn_TxCountReq");
+    static stream<TxTestReq>       ssRDpToCOn_TxCountReq ("ssRDpToCOn_TxCountReq");
     #pragma HLS stream    variable=ssRDpToCOn_TxCountReq depth=cDepth_RDpToCOn_TxCountReq
+    #pragma HLS DATA_PACK variable=ssRDpToCOn_TxCountReq
+    static stream<TcpAppData>      ssRDpToRCo_Data       ("ssRDpToRCo_Data");
+    #pragma HLS stream    variable=ssRDpToRCo_Data       depth=cDepth_RDpToRCo_Data
+    static stream<TcpSessId>       ssRDpToRCo_SessId     ("ssRDpToRCo_SessId");
+    #pragma HLS stream    variable=ssRDpToRCo_SessId     depth=cDepth_RDpToRCo_Meta
+    static stream<TcpDatLen>       ssRDpToRCo_DatLen     ("ssRDpToRCo_DatLen");
+    #pragma HLS stream    variable=ssRDpToRCo_DatLen     depth=cDepth_RDpToRCo_Meta
+
+    //-- Iperf Server (IPs)
+    static stream<TcpAppData>      ssIPsToTMx_Data       ("ssIPsToTMx_Data");
+    #pragma HLS stream    variable=ssIPsToTMx_Data       depth=cDepth_IPsToTMx_Data
+    static stream<TcpSessId>       ssIPsToTMx_SessId     ("ssIPsToTMx_SessId");
+    #pragma HLS stream    variable=ssIPsToTMx_SessId     depth=cDepth_IPsToTMx_Meta
+    static stream<TcpDatLen>       ssIPsToTMx_DatLen     ("ssIPsToTMx_DatLen");
+    #pragma HLS stream    variable=ssIPsToTMx_DatLen     depth=cDepth_IPsToTMx_Meta
+
+    //-- Tx Socket Handler (TSh)
+    static stream<TcpAppData>      ssTShToTMx_Data       ("ssTShToTMx_Data");
+    #pragma HLS stream    variable=ssTShToTMx_Data       depth=cDepth_TShToTMx_Data
+    static stream<TcpSessId>       ssTShToTMx_SessId     ("ssTShToTMx_SessId");
+    #pragma HLS stream    variable=ssTShToTMx_SessId     depth=cDepth_TShToTMx_Meta
+    static stream<TcpDatLen>       ssTShToTMx_DatLen     ("ssTShToTMx_DatLen");
+    #pragma HLS stream    variable=ssTShToTMx_DatLen     depth=cDepth_TShToTMx_Meta
+    static stream<SockLkpReq>      ssTShToCOn_SockReq    ("ssTShToCOn_SockReq");
+    #pragma HLS stream    variable=ssTShToCOn_SockReq    depth=cDepth_TShToCOn_SockReq
+    #pragma HLS DATA_PACK variable=ssTShToCOn_SockReq
+
+    //-- Tx Multiplexer (TMx)
+    static stream<TcpAppData>      ssTMxToWRp_Data       ("ssTMxToWRp_Data");
+    #pragma HLS stream    variable=ssTMxToWRp_Data       depth=cDepth_TMxToWRp_Data
+    static stream<TcpSessId>       ssTMxToWRp_SessId     ("ssTMxToWRp_SessId");
+    #pragma HLS stream    variable=ssTMxToWRp_SessId     depth=cDepth_TMxToWRp_Meta
+    static stream<TcpDatLen>       ssTMxToWRp_DatLen     ("ssTMxToWRp_DatLen");
+    #pragma HLS stream    variable=ssTMxToWRp_DatLen     depth=cDepth_TMxToWRp_Meta
 
     //-- Connect (COn)
-    static stream<TcpDatLen>       ssCOnToWRp_TxBytesReq ("ssCOnToWRp_TxBytesReq");
+    static stream<TxTestReq>       ssCOnToWRp_TxBytesReq ("ssCOnToWRp_TxBytesReq");
     #pragma HLS stream    variable=ssCOnToWRp_TxBytesReq depth=cDepth_COnToWRp_TxBytesReq
+    #pragma HLS DATA_PACK variable=ssCOnToWRp_TxBytesReq
     static stream<SessionId>       ssCOnToWRp_TxSessId   ("ssCOnToWRp_TxSessId");
     #pragma HLS stream    variable=ssCOnToWRp_TxSessId   depth=cDepth_COnToWRp_TxSessId
+    static stream<TcpAppClsReq>    ssCOnToSLc_ClsReq     ("ssCOnToSLc_ClsReq");
+    #pragma HLS stream    variable=ssCOnToSLc_ClsReq     depth=cDepth_COnToSLc_ClsReq
+    static stream<SockLkpRep>      ssCOnToTSh_SockRep    ("ssCOnToTSh_SockRep");
+    #pragma HLS stream    variable=ssCOnToTSh_SockRep    depth=cDepth_COnToTSh_SockRep
+    #pragma HLS DATA_PACK variable=ssCOnToTSh_SockRep
+
+    //-- Write Path (WRp)
+    static stream<SessionId>       ssWRpToSLc_TxAct      ("ssWRpToSLc_TxAct");
+    #pragma HLS stream    variable=ssWRpToSLc_TxAct      depth=cDepth_WRpToSLc_TxAct
 
     //-- PROCESS FUNCTIONS -----------------------------------------------------
+    pMmioConfigHandler(
+            siSHL_Mmio_CfgCmd,
+            ssMChToRRh_Quantum,
+            ssMChToRRh_PortAct,
+            ssMChToLSn_PortCfg,
+            ssMChToWRp_SegLen,
+            ssMChToWRp_GenCfg,
+            ssMChToRDp_StatReq,
+            ssMChToSLc_IdleTmo,
+            ssMChToRCo_CoaCfg);
+
+    pSessionLifecycle(
+            piSHL_Mmio_En,
+            ssMChToSLc_IdleTmo,
+            siSHL_Notif,
+            ssSLcToRRh_Notif,
+            ssWRpToSLc_TxAct,
+            ssCOnToSLc_ClsReq,
+            ssSLcToRRh_ClrReq,
+            ssSLcToCOn_ClsSig,
+            soSHL_ClsReq);
+
     pConnect(
             piSHL_Mmio_En,
             ssRDpToCOn_OpnSockReq,
             ssRDpToCOn_TxCountReq,
+            ssTShToCOn_SockReq,
+            ssCOnToTSh_SockRep,
             ssCOnToWRp_TxBytesReq,
             ssCOnToWRp_TxSessId,
             soSHL_OpnReq,
             siSHL_OpnRep,
-            soSHL_ClsReq);
+            ssCOnToSLc_ClsReq,
+            ssSLcToCOn_ClsSig,
+            soDBG_OpnEvent);
 
     pListen(
             piSHL_Mmio_En,
+            ssMChToLSn_PortCfg,
             soSHL_LsnReq,
             siSHL_LsnRep);
 
+  #if defined USE_INTERRUPTS
     pInputReadBuffer(
             piSHL_Mmio_En,
             siSHL_Data,
             siSHL_Meta,
-            ssIRbToRDp_Data,
-            ssIRbToRDp_Meta);
+            ssIRbToRRh_Enqueue,
+            ssIRbToRbp_Data,
+            ssIRbToRbp_Meta);
+  #else
+    pInputReadBuffer(
+            piSHL_Mmio_En,
+            siSHL_Data,
+            siSHL_Meta,
+            ssIRbToRbp_Data,
+            ssIRbToRbp_Meta);
+  #endif
+
+    pRxBufferPool(
+            piSHL_Mmio_En,
+            ssIRbToRbp_Data,
+            ssIRbToRbp_Meta,
+            ssRRhToRbp_FwdCmd,
+            ssRbpToRRh_Dequeue,
+            ssRbpToRDp_TafCmd,
+            ssRbpToRDp_TafData,
+            ssRbpToRDp_SnkCmd,
+            ssRbpToRDp_SnkData,
+            ssRbpToRDp_GenData,
+            ssRbpToIPs_IpfCmd,
+            ssRbpToIPs_IpfData);
 
     pReadPath(
             piSHL_Mmio_En,
-            ssIRbToRDp_Data,
-            ssIRbToRDp_Meta,
-            ssRRhToRDp_FwdCmd,
+            ssRbpToRDp_TafCmd,
+            ssRbpToRDp_TafData,
+            ssRbpToRDp_SnkCmd,
+            ssRbpToRDp_SnkData,
+            ssRbpToRDp_GenData,
+            ssMChToRDp_StatReq,
             ssRDpToCOn_OpnSockReq,
             ssRDpToCOn_TxCountReq,
-            ssRDpToRRh_Dequeue,
+            ssRDpToRCo_Data,
+            ssRDpToRCo_SessId,
+            ssRDpToRCo_DatLen,
+            soSHL_Mmio_SinkStats,
+            soDBG_SinkCnt);
+
+    pRxCoalescer(
+            piSHL_Mmio_En,
+            ssMChToRCo_CoaCfg,
+            ssRDpToRCo_Data,
+            ssRDpToRCo_SessId,
+            ssRDpToRCo_DatLen,
             soTAF_Data,
             soTAF_SessId,
-            soTAF_DatLen,
-            soDBG_SinkCnt);
+            soTAF_DatLen);
 
-    pReadNotificationHandler(
+    pIperfServer(
             piSHL_Mmio_En,
-            siSHL_Notif,
-            ssRNhToRRh_Notif);
+            ssRbpToIPs_IpfCmd,
+            ssRbpToIPs_IpfData,
+            ssIPsToTMx_Data,
+            ssIPsToTMx_SessId,
+            ssIPsToTMx_DatLen,
+            soDBG_IpfReport);
 
   #if defined USE_INTERRUPTS
-    pReadRequestHandler(
-            siSHL_Notif,
+    pReadRequestHandler<TSIF_RX_POLICY>(
+            ssMChToRRh_Quantum,
+            ssMChToRRh_PortAct,
+            ssSLcToRRh_Notif,
+            ssSLcToRRh_ClrReq,
             ssIRbToRRh_Enqueue,
-            ssRDpToRRh_Dequeue,
+            ssRbpToRRh_Dequeue,
             soSHL_DReq,
-            ssRRhToRDp_FwdCmd);
-
+            ssRRhToRbp_FwdCmd,
+            soDBG_InpBufSpace);
   #else
+    pReadNotificationHandler(
+            piSHL_Mmio_En,
+            ssSLcToRRh_Notif,
+            ssRNhToRRh_Notif);
+
     pReadRequestHandler(
             piSHL_Mmio_En,
+            ssMChToRRh_Quantum,
+            ssMChToRRh_PortAct,
             ssRNhToRRh_Notif,
-            ssRDpToRRh_Dequeue,
+            ssRbpToRRh_Dequeue,
+            ssSLcToRRh_ClrReq,
             ssRRhToRRm_DReq,
-            ssRRhToRDp_FwdCmd,
+            ssRRhToRbp_FwdCmd,
             soDBG_InpBufSpace);
 
     pReadRequestMover(
             piSHL_Mmio_En,
             ssRRhToRRm_DReq,
             soSHL_DReq);
+  #endif
 
-    pWritePath(
+    pTxSocketHandler(
+            piSHL_Mmio_En,
+            siTAF_SockData,
+            siTAF_SockAddr,
+            siTAF_SockLen,
+            soTAF_SockRep,
+            ssTShToCOn_SockReq,
+            ssCOnToTSh_SockRep,
+            ssTShToTMx_Data,
+            ssTShToTMx_SessId,
+            ssTShToTMx_DatLen);
+
+    pTxMultiplexer(
             piSHL_Mmio_En,
             siTAF_Data,
             siTAF_SessId,
             siTAF_DatLen,
+            ssIPsToTMx_Data,
+            ssIPsToTMx_SessId,
+            ssIPsToTMx_DatLen,
+            ssTShToTMx_Data,
+            ssTShToTMx_SessId,
+            ssTShToTMx_DatLen,
+            ssTMxToWRp_Data,
+            ssTMxToWRp_SessId,
+            ssTMxToWRp_DatLen);
+
+    pWritePath(
+            piSHL_Mmio_En,
+            ssMChToWRp_SegLen,
+            ssMChToWRp_GenCfg,
+            ssTMxToWRp_Data,
+            ssTMxToWRp_SessId,
+            ssTMxToWRp_DatLen,
             ssCOnToWRp_TxBytesReq,
             ssCOnToWRp_TxSessId,
             soSHL_Data,
             soSHL_SndReq,
-            siSHL_SndRep);
-
-  #endif
+            siSHL_SndRep,
+            ssWRpToSLc_TxAct);
 }
 
 /*! \} */
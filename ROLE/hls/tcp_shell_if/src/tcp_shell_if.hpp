@@ -36,45 +36,131 @@
 #include "../../../../cFDK/SRA/LIB/SHELL/LIB/hls/NTS/nts.hpp"
 #include "../../../../cFDK/SRA/LIB/SHELL/LIB/hls/NTS/nts_utils.hpp"
 
+//-------------------------------------------------------------------
+//-- RX SCHEDULING POLICIES
+//--  The policy used by the ReadRequestHandler (RRh) to schedule the
+//--  data requests among the sessions with pending Rx bytes. It is
+//--  selected at compile time with '-DTSIF_RX_POLICY=<policy>'.
+//--   FIFO : The notifications are served in order of arrival by the
+//--          former notification FIFO-based implementation of [RRh].
+//--   RR   : Round-robin among the sessions with pending bytes.
+//--   DRR  : Deficit round-robin with a quantum of 'cRxDefQuantum'
+//--          bytes per session (see also 'CFG_RX_QUANTUM').
+//--   SPF  : Shortest-pending-first. The session with the fewest
+//--          pending bytes is served first.
+//-------------------------------------------------------------------
+#define RX_POLICY_FIFO  0
+#define RX_POLICY_RR    1
+#define RX_POLICY_DRR   2
+#define RX_POLICY_SPF   3
+
+#ifndef TSIF_RX_POLICY
+  #define TSIF_RX_POLICY  RX_POLICY_RR
+#endif
+
 //-------------------------------------------------------------------
 //-- CONSTANTS FOR THE INTERNAL STREAM DEPTHS
 //-------------------------------------------------------------------
-const int cDepth_IRbToRDp_Data       = 256;  // SizeOf input data read buffer (in #chunks)
-const int cDepth_IRbToRDp_Meta       = 256;  // SizeOf input meta read buffer (in #metadata)
+const int cDepth_RRhToRbp_FwdCmd     =   8;  // SizeOf output data request buffer (in #requests)
+
+const int cDepth_IRbToRbp_Data       =   2;
+const int cDepth_IRbToRbp_Meta       =   2;
+const int cDepth_IRbToRRh_Enqueue    =   4;
 
 const int cDepth_RNhToRRh_Notif      =  64;  // SizeOf input notif buffer (in #notifications)
-const int cDepth_RRhToRDp_FwdCmd     =   8;  // SizeOf output data request buffer (in #requests)
-const int cDepth_RRhToRRm_DReq       = cDepth_RRhToRDp_FwdCmd;
+const int cDepth_SLcToRRh_Notif      =   2;
+const int cDepth_SLcToRRh_ClrReq     =   2;
+const int cDepth_SLcToCOn_ClsSig     =   2;
+const int cDepth_RRhToRRm_DReq       = cDepth_RRhToRbp_FwdCmd;
+
+const int cDepth_RbpToRRh_Dequeue    =   4;
+const int cDepth_RbpToRDp_TafCmd     =   2;
+const int cDepth_RbpToRDp_SnkCmd     =   2;
+const int cDepth_RbpToRDp_LaneData   =   2;  // SizeOf the data stream of an Rx lane (in #chunks)
+const int cDepth_RbpToIPs_IpfCmd     =   2;
+
+const int cDepth_IPsToTMx_Data       =   2;
+const int cDepth_IPsToTMx_Meta       =   2;
+
+const int cDepth_TShToTMx_Data       =   2;
+const int cDepth_TShToTMx_Meta       =   2;
+const int cDepth_TShToCOn_SockReq    =   2;
+
+const int cDepth_TMxToWRp_Data       =   2;
+const int cDepth_TMxToWRp_Meta       =   2;
 
-const int cDepth_RDpToRRh_Dequeue    =   4;
 const int cDepth_RDpToCOn_OpnSockReq =   2;
 const int cDepth_RDpToCOn_TxCountReq = cDepth_RDpToCOn_OpnSockReq;
+const int cDepth_RDpToRCo_Data       =   2;
+const int cDepth_RDpToRCo_Meta       =   2;
 
 const int cDepth_COnToWRp_TxBytesReq =   2;
 const int cDepth_COnToWRp_TxSessId   = cDepth_COnToWRp_TxBytesReq;
+const int cDepth_COnToSLc_ClsReq     =   2;
+const int cDepth_COnToTSh_SockRep    =   2;
+
+const int cDepth_WRpToSLc_TxAct      =   4;
+
+const int cDepth_MChToRRh_Quantum    =   2;
+const int cDepth_MChToRRh_PortAct    =   2;
+const int cDepth_MChToLSn_PortCfg    =   2;
+const int cDepth_MChToWRp_SegLen     =   2;
+const int cDepth_MChToWRp_GenCfg     =   2;
+const int cDepth_MChToRDp_StatReq    =   2;
+const int cDepth_MChToSLc_IdleTmo    =   2;
+const int cDepth_MChToRCo_CoaCfg     =   2;
 
 //-------------------------------------------------------------------
 //-- CONSTANTS FOR THE TCP SHELL INTERFACE
 //-------------------------------------------------------------------
 const int cMaxSessions   = TOE_MAX_SESSIONS;
 
-const int cIBuffBytes    = cDepth_IRbToRDp_Data * (ARW/8);
+//-- The input read buffer is accounted in bytes. Its storage holds one extra
+//--  chunk per DReq in flight (+1) for the partial last chunk of a segment, and
+//--  one tail chunk per Rx lane (see 'RxLane').
+const int cIBuffBytes    = 256 * (ARW/8);
 const int cMinDataReqLen = 128;  // The minimum DReq length we want to generate
+const int cMaxRxsQueries = 8;    // Max. #session requests in flight in the Rx scheduler
+const int cMaxRxsDataReqs = cDepth_RRhToRbp_FwdCmd;  // Max. #DReqs in flight
+const int cRxLanes       = 4;    // #Downstream lanes of the input read buffer
+const int cIBuffChunks   = 256 + cMaxRxsDataReqs + 1 + cRxLanes;  // SizeOf input read buffer (in #chunks)
+const int cRbpCmdSlots   = cMaxRxsDataReqs;  // #Forward commands waiting for their segment
+const int cRpnCamEntries = 4;    // #Entries of the notification coalescing CAM
+const int cRxDefQuantum  = 256;  // Default quantum of every session with 'RX_POLICY_DRR' (in bytes)
+const int cConTblEntries = 16;   // #Entries of the connection table of the client mode
+const int cConMaxOpnReqs = 4;    // Max. #open connection requests in flight
+const int cConMaxTries   = 4;    // Max. #attempts to open a connection before giving up
+const int cLsnPortEntries = 8;   // #Entries of the listen port table
+const int cRtySlots      = 4;    // #Messages that can be parked in the send-retry queue
+const int cRtySlotChunks = 256;  // SizeOf a slot of the send-retry queue (in #chunks)
+const int cRtyMaxTries   = 8;    // Max. #attempts to send a parked message before dropping it
+const int cTxSegLen      = 1456; // Default max. length of a Tx segment (in bytes, a multiple of ARW/8)
+const int cGenSessions   = 4;    // #Sessions the Tx traffic generator serves concurrently
+const int cIpfSessions   = 8;    // #Sessions the iperf server accounts for concurrently
+const int cIpfIdleIvals  = 2;    // #Idle report intervals before an iperf session is released
+const int cTMxOrders     = 4;    // #Messages ordered ahead by the Tx multiplexer
+const int cTShLookups    = 4;    // #Sockets looked up ahead by the Tx socket handler
+const int cRcoBufChunks  = 512;  // SizeOf the buffer of the Rx coalescer (in #chunks)
+const int cRcoMsgSlots   = 4;    // #Coalesced messages queued for forwarding
 
 //-------------------------------------------------------------------
 //-- DEFAULT LOCAL-FPGA AND FOREIGN-HOST SOCKETS
 //--  By default, the following sockets and port numbers will be used
-//--  by the TcpShellInterface (unless user specifies new ones via TBD).
+//--  by the TcpShellInterface (unless user specifies new ones via the
+//--  MMIO listen port table, see 'CFG_LSN_PORT').
 //--  Default listen ports:
-//--  --> 5001 : Traffic received on this port is [TODO-TBD].
-//--             It is used to emulate IPERF V2.
-//--  --> 5201 : Traffic received on this port is [TODO-TBD].
-//--             It is used to emulate IPREF V3.
+//--  --> 5001 : Traffic received on this port is sunk and accounted
+//--             per session. It is used to emulate an IPERF V2 server.
+//--  --> 5201 : Traffic received on this port is handled by the
+//--             IPERF V3 server (control channel handshake and
+//--             per-stream accounting of the data streams).
 //--  --> 8800 : Traffic received on this port is systematically
 //--             dumped. It is used to test the Rx part of TOE.
 //--  --> 8801 : A message received on this port triggers the
 //--             transmission of 'nr' bytes from the FPGA to the host.
-//--             It is used to test the Tx part of TOE.
+//--             It is used to test the Tx part of TOE (the payload
+//--             is programmed via 'CFG_TX_GEN', and the extended
+//--             command format is described by 'TxTestReq').
 //--  --> 8802 : Traffic received on this port is forwarded to the TCP
 //--             test application which will loop and echo it back to
 //--             the sender in store-and-forward mode.
@@ -101,11 +187,122 @@ const int cMinDataReqLen = 128;  // The minimum DReq length we want to generate
 #define GEN_CHK0    0x48692066726f6d20  // 'Hi from '
 #define GEN_CHK1    0x464d4b553630210a  // 'FMKU60\n'
 
+//-------------------------------------------------------------------
+//-- DEFAULT SEED OF THE PSEUDO-RANDOM XMIT PATTERN
+//--  The seed of a transfer is this value XOR-ed with its session id.
+//-------------------------------------------------------------------
+#define GEN_PRBS_SEED   0x2545F4914F6CDD1D
+
 enum DropCode {
     NOP=0,  // No Operation
-    GEN     // Generate traffic towards producer
+    GEN,    // Generate traffic towards producer
+    IPF2,   // Account the traffic of an iperf2 session
+    IPF3    // Run the iperf3 protocol on the session
+};
+
+//=========================================================
+//== Connection State
+//==  State of an entry of the connection table which holds
+//==  the sockets opened by the FPGA in client mode.
+//=========================================================
+enum ConnState {
+    CONN_FREE=0,  // Entry is available
+    CONN_WAITING, // Waiting for its (next) open request to be issued
+    CONN_OPENING, // Open request issued, waiting for its reply
+    CONN_OPENED,  // Connection is established
+    CONN_FAILED   // All the attempts failed, the socket is held off for a while
 };
 
+typedef ap_uint<log2Ceil<cConTblEntries>::val> ConnIdx;
+typedef ap_uint<24>                            ConnTime;  // A timestamp (in clock cycles)
+
+//=========================================================
+//== Connection Event
+//==  Reports the outcome of an attempt to open a connection
+//==  in client mode. The session id is only meaningful with
+//==  'CONN_EVT_OPENED'.
+//=========================================================
+enum ConnEvtCode {
+    CONN_EVT_OPENED=0,  // The connection is established
+    CONN_EVT_RETRY,     // An attempt failed or timed out, a new one is scheduled
+    CONN_EVT_FAILED     // All the attempts failed, the connection is given up
+};
+
+class ConnEvent {
+  public:
+    SockAddr        sockAddr;
+    SessionId       sessId;
+    ConnEvtCode     code;
+    ap_uint<8>      nrTries;
+    ConnEvent() {}
+    ConnEvent(SockAddr _sockAddr, SessionId _sessId, ConnEvtCode _code, ap_uint<8> _nrTries) :
+        sockAddr(_sockAddr), sessId(_sessId), code(_code), nrTries(_nrTries) {}
+};
+
+//=========================================================
+//== Socket Send Reply
+//==  Tells [TAF] on which session a socket-addressed message
+//==  was sent, or that no connection could be opened with
+//==  its socket (in which case 'sessId' is meaningless).
+//=========================================================
+class SockSndRep {
+  public:
+    SessionId       sessId;
+    bool            sent;
+    SockSndRep() {}
+    SockSndRep(SessionId _sessId, bool _sent) :
+        sessId(_sessId), sent(_sent) {}
+};
+
+//=========================================================
+//== Socket Lookup Request and Reply
+//==  A socket looked up by [TSh] in the connection table of
+//==  [COn], tagged with the slot of its message in [TSh].
+//==  The replies are returned out of order, as soon as the
+//==  connection of their socket is known.
+//=========================================================
+typedef ap_uint<log2Ceil<cTShLookups>::val> SockLkpTag;
+
+class SockLkpReq {
+  public:
+    SockAddr        sockAddr;
+    SockLkpTag      tag;
+    SockLkpReq() {}
+    SockLkpReq(SockAddr _sockAddr, SockLkpTag _tag) :
+        sockAddr(_sockAddr), tag(_tag) {}
+};
+
+class SockLkpRep {
+  public:
+    SockLkpTag      tag;
+    SessionId       sessId;
+    bool            sent;
+    SockLkpRep() {}
+    SockLkpRep(SockLkpTag _tag, SessionId _sessId, bool _sent) :
+        tag(_tag), sessId(_sessId), sent(_sent) {}
+};
+
+//=========================================================
+//== Tx Message Source
+//==  The source of a message merged by the Tx multiplexer.
+//=========================================================
+enum TxMsgSrc {
+    TX_SRC_TAF=0,  // [TAF], addressed by session id
+    TX_SRC_IPS,    // The iperf server
+    TX_SRC_SCK     // [TAF], addressed by socket
+};
+
+//=========================================================
+//== Send-Retry Queue
+//==  A message which is refused by the TOE for lack of Tx
+//==  buffer space is parked into a slot of this queue and
+//==  is retried later on. The slots of a same session are
+//==  chained in arrival order.
+//=========================================================
+typedef ap_uint<log2Ceil<cRtySlots>::val>                RtySlotIdx;
+typedef ap_uint<log2Ceil<cRtySlotChunks>::val>           RtyChunkIdx;
+typedef ap_uint<log2Ceil<cRtySlots*cRtySlotChunks>::val> RtyBufPtr;
+
 //=========================================================
 //== Forward Command
 //==  Indicates if a received stream must be forwarded or
@@ -140,13 +337,16 @@ class InterruptEntry {
 };
 
 enum QueryCmd {
-    GET=0,  // Retrieve a table entry
-    PUT,    // Modify an entry of the table
-    POST,   // Create a new entry in the table
+    PUT=0,  // Withdraw up to 'byteCnt' bytes from an entry (read-modify-write)
+    POST,   // Add 'byteCnt' bytes to an entry and set its 'dstPort' (read-modify-write)
 };
 
 //=========================================================
 //== Interrupt Table Query
+//==  Both queries are executed by the table as an atomic
+//==  read-modify-write. The 'PUT' query is answered with
+//==  an 'InterruptEntry' that holds the number of bytes
+//==  that were effectively withdrawn from the entry.
 //=========================================================
 class InterruptQuery {
   public:
@@ -154,14 +354,568 @@ class InterruptQuery {
     InterruptEntry  entry;
     QueryCmd        action;
     InterruptQuery () {}
-    InterruptQuery(SessionId _sessId, QueryCmd _action=GET) : // GET Query
-        sessId(_sessId), action(GET) {}
     InterruptQuery(SessionId _sessId, TcpDatLen _byteCnt) : // PUT Query: 'byteCnt'
         sessId(_sessId), entry(_byteCnt, 0), action(PUT) {}
-    InterruptQuery(SessionId _sessId, InterruptEntry _entry, QueryCmd _action=POST) : // POST Query
+    InterruptQuery(SessionId _sessId, InterruptEntry _entry) : // POST Query
         sessId(_sessId), entry(_entry), action(POST) {}
 };
 
+//=========================================================
+//== MMIO Configuration Command
+//==  A write access to one of the run-time programmable
+//==  tables of TSIF. The 'tblId' selects the table and
+//==  the 'index' selects the entry within that table.
+//==  A 'CFG_SINK_STATS' command is a read access which is
+//==  answered on the MMIO statistics interface instead.
+//=========================================================
+enum CfgTblId {
+    CFG_RX_QUANTUM=0,  // DRR quantum of an Rx session (index=SessId, value=#bytes, at most 0xFFFF)
+    CFG_PORT_RANGE,    // Port range of a port action entry (index=Entry, value={HiPort,LoPort})
+    CFG_PORT_ACTION,   // Action of a port action entry (index=Entry, value={PipeId[15:8],Action[7:0]})
+    CFG_LSN_PORT,      // Listen port entry (index=Entry, value={Enable[16],Port[15:0]})
+    CFG_TX_SEG_LEN,    // Max. length of a Tx segment (index=0, value=#bytes, a multiple of ARW/8)
+    CFG_TX_GEN,        // Tx traffic generator (index=GenCfgField, value=see 'GenCfgField')
+    CFG_SINK_STATS,    // Read-out of the sink statistics (index=SessId or 'cSinkStatsAll', value=unused)
+    CFG_IDLE_TIMEOUT,  // Idle timeout of the sessions (index=0, value=#ticks, 0=disabled, see 'SlcTime')
+    CFG_RX_COALESCE,   // Rx coalescing toward [TAF] (index=CoaCfgField, value=see 'CoaCfgField')
+};
+
+class MmioCfgCmd {
+  public:
+    ap_uint<8>      tblId;
+    ap_uint<16>     index;
+    ap_uint<32>     value;
+    MmioCfgCmd() {}
+    MmioCfgCmd(ap_uint<8> _tblId, ap_uint<16> _index, ap_uint<32> _value) :
+        tblId(_tblId), index(_index), value(_value) {}
+};
+
+//=========================================================
+//== Rx Quantum Configuration
+//==  The number of bytes an Rx session is credited with
+//==  by the deficit round-robin scheduler once all of its
+//==  previously requested bytes have been forwarded. A
+//==  quantum of zero disables the deficit accounting for
+//==  that session.
+//=========================================================
+class RxQuantumCfg {
+  public:
+    SessionId       sessId;
+    TcpDatLen       quantum;
+    RxQuantumCfg() {}
+    RxQuantumCfg(SessionId _sessId, TcpDatLen _quantum) :
+        sessId(_sessId), quantum(_quantum) {}
+};
+
+//=========================================================
+//== Rx Coalescing Configuration
+//==  Consecutive segments of a session can be merged into
+//==  a single message to [TAF]. A message is flushed once
+//==  it holds 'COA_CFG_BYTES' bytes, or 'COA_CFG_TIMEOUT'
+//==  cycles after its first segment was received.
+//=========================================================
+const int cRcoMaxBytes   = 2048;  // Max. flush threshold (in bytes)
+const int cRcoDefTimeout =   64;  // Default flush timeout (in cycles)
+
+enum CoaCfgField {
+    COA_CFG_BYTES=0,    // value=Flush threshold (in bytes, 0=disabled)
+    COA_CFG_TIMEOUT     // value=Flush timeout (in cycles)
+};
+
+class RxCoaCfg {
+  public:
+    CoaCfgField     field;
+    ap_uint<16>     value;
+    RxCoaCfg() {}
+    RxCoaCfg(CoaCfgField _field, ap_uint<16> _value) :
+        field(_field), value(_value) {}
+};
+
+//=========================================================
+//== Port Action Table Entry
+//==  Maps the TCP destination ports [loPort:hiPort] onto
+//==  the action to apply to the segments received on these
+//==  ports. The entries are looked up in parallel and the
+//==  entry with the lowest index wins. A port which does
+//==  not match any entry is forwarded to pipeline #0.
+//=========================================================
+enum PortAction {
+    PA_NONE=0,  // Entry is disabled
+    PA_SINK,    // Sink the received segments
+    PA_GEN,     // Trigger the Tx traffic generator (.i.e, XMIT test mode)
+    PA_FWD,     // Forward the received segments to pipeline 'pipeId'
+    PA_IPERF2,  // Serve the received segments as an iperf2 server
+    PA_IPERF3   // Serve the received segments as an iperf3 server
+};
+
+const int cPortActEntries = 8;  // #Entries of the port action table
+const int cNrFwdPipes     = 1;  // #Pipelines the received segments can be forwarded to ([TAF])
+
+class PortActEntry {
+  public:
+    TcpPort         loPort;
+    TcpPort         hiPort;
+    PortAction      action;
+    ap_uint<8>      pipeId;
+    PortActEntry() {}
+    PortActEntry(TcpPort _loPort, TcpPort _hiPort, PortAction _action, ap_uint<8> _pipeId) :
+        loPort(_loPort), hiPort(_hiPort), action(_action), pipeId(_pipeId) {}
+};
+
+//=========================================================
+//== Rx Lane
+//==  The downstream a received segment is delivered to.
+//==  The input read buffer keeps one queue per lane, such
+//==  that a lane which is back-pressured does not block
+//==  the segments of the other lanes.
+//=========================================================
+enum RxLane {
+    LANE_TAF=0, // Forward the segment to [TAF]
+    LANE_SINK,  // Sink the segment
+    LANE_GEN,   // Trigger the Tx traffic generator with the segment
+    LANE_IPERF  // Serve the segment by the iperf server
+};
+
+typedef ap_uint<log2Ceil<cRxLanes>::val>     RxLaneId;
+typedef ap_uint<log2Ceil<cIBuffChunks>::val> ChunkPtr;
+
+//=========================================================
+//== Port Action Configuration
+//==  Sets either the port range or the action of an entry
+//==  of the port action table, as selected by 'setRange'.
+//=========================================================
+class PortActCfg {
+  public:
+    ap_uint<log2Ceil<cPortActEntries>::val> index;
+    bool            setRange;
+    PortActEntry    entry;
+    PortActCfg() {}
+    PortActCfg(ap_uint<log2Ceil<cPortActEntries>::val> _index, bool _setRange, PortActEntry _entry) :
+        index(_index), setRange(_setRange), entry(_entry) {}
+};
+
+//=========================================================
+//== Listen Port Configuration
+//==  Enables or disables an entry of the listen port table.
+//==  An enabled entry is opened in listen mode as soon as
+//==  possible, while traffic is running.
+//=========================================================
+typedef ap_uint<log2Ceil<cLsnPortEntries>::val> LsnPortIdx;
+
+class LsnPortCfg {
+  public:
+    LsnPortIdx      index;
+    bool            enable;
+    TcpPort         port;
+    LsnPortCfg() {}
+    LsnPortCfg(LsnPortIdx _index, bool _enable, TcpPort _port) :
+        index(_index), enable(_enable), port(_port) {}
+};
+
+//=========================================================
+//== Tx Traffic Generator Configuration
+//==  The generator serves up to 'cGenSessions' transfers
+//==  concurrently. The payload of a transfer is produced
+//==  according to 'GenPattern' and, if stamping is enabled,
+//==  the two first chunks of every segment carry the
+//==  sequence number of the segment within its transfer
+//==  and the cycle at which it was generated.
+//=========================================================
+enum GenPattern {
+    GEN_PAT_HELLO=0,  // The alternating 'GEN_CHK0' and 'GEN_CHK1' chunks
+    GEN_PAT_INCR,     // The index of the chunk within the transfer
+    GEN_PAT_PRBS,     // A xorshift64 sequence seeded with 'GEN_PRBS_SEED'
+    GEN_PAT_CONST     // A constant 64-bit word
+};
+
+enum GenCfgField {
+    GEN_CFG_PATTERN=0,  // value={Stamp[8],Pattern[1:0]}
+    GEN_CFG_CONST_LO,   // value=Bits [31:0]  of the constant word
+    GEN_CFG_CONST_HI,   // value=Bits [63:32] of the constant word
+    GEN_CFG_RATE        // value=Rate limit (in 1/256 bytes per cycle, 0=unlimited)
+};
+
+typedef ap_uint<log2Ceil<cGenSessions>::val> GenIdx;
+typedef ap_uint<64>                          GenLen;  // A #bytes of a transfer
+
+class TxGenCfg {
+  public:
+    GenCfgField     field;
+    ap_uint<32>     value;
+    TxGenCfg() {}
+    TxGenCfg(GenCfgField _field, ap_uint<32> _value) :
+        field(_field), value(_value) {}
+};
+
+//=========================================================
+//== Tx Test Request
+//==  A transmit test command received on port 8801 comes
+//==  in two formats (all fields are in network byte order):
+//==   - Legacy   : {IP4[0:3], Port[4:5], Len16[6:7]}
+//==   - Extended : {IP4[0:3], Port[4:5], 0x0000[6:7]}
+//==                {Len48[0:5], Repeat[6:7]}
+//==  The extended format is recognized by a null 16-bit
+//==  length followed by a second chunk. The transfer of
+//==  'length' bytes is sent 'repeat' times in a row, as a
+//==  continuous series of segments. A null 'length' only
+//==  opens the connection.
+//=========================================================
+typedef ap_uint<48> TxTestLen;  // A #bytes of a Tx test request
+
+class TxTestReq {
+  public:
+    TxTestLen       length;
+    ap_uint<16>     repeat;     // #Times the transfer is sent (at least 1)
+    TxTestReq() {}
+    TxTestReq(TxTestLen _length, ap_uint<16> _repeat) :
+        length(_length), repeat(_repeat) {}
+};
+
+//=========================================================
+//== Session Lifecycle
+//==  The last Rx/Tx activity of every session is stamped
+//==  with a coarse time expressed in ticks of
+//==  'cSlcTickCycles' cycles (1 ms at 156.25 MHz). A
+//==  session which remains idle for 'CFG_IDLE_TIMEOUT'
+//==  ticks is closed and its per-session state reclaimed.
+//=========================================================
+typedef ap_uint<32> SlcTime;  // A time in ticks
+
+//=========================================================
+//== Sink Statistics
+//==  The bytes and segments sunk by the ReadPath are
+//==  accounted per session with 64-bit counters, along
+//==  with the number of bytes sunk during the last complete
+//==  interval of 'cSnkInterval' cycles (i.e. the rate of
+//==  the session). The statistics of a session, or the
+//==  aggregate of all sessions, are read out on demand.
+//=========================================================
+const int cSinkStatsAll = 0xFFFF;  // Index of the aggregate of all sessions
+
+typedef ap_uint<16> SnkEpoch;  // Index of a statistics interval
+
+class SinkStats {
+  public:
+    ap_uint<16>     index;      // SessId or 'cSinkStatsAll'
+    ap_uint<64>     bytes;      // #Bytes sunk since reset
+    ap_uint<64>     segs;       // #Segments sunk since reset
+    ap_uint<32>     rate;       // #Bytes sunk during the last complete interval
+    SinkStats() {}
+    SinkStats(ap_uint<16> _index, ap_uint<64> _bytes, ap_uint<64> _segs, ap_uint<32> _rate) :
+        index(_index), bytes(_bytes), segs(_segs), rate(_rate) {}
+};
+
+//=========================================================
+//== Iperf Server
+//==  The iperf server accounts for the bytes received by
+//==  every iperf2 session and every iperf3 data stream. An
+//==  iperf3 test is driven by its control channel, on which
+//==  the server answers with the one-byte state codes below
+//==  and with its own results (in JSON) at the end of the
+//==  test. A report is issued for every session at the end
+//==  of every interval and when the session is released.
+//=========================================================
+enum IperfState {
+    IPF_TEST_START=1,         // Sent once all the data streams are connected
+    IPF_TEST_RUNNING=2,       // Sent right after 'IPF_TEST_START'
+    IPF_TEST_END=4,           // Received when the client is done sending
+    IPF_PARAM_EXCHANGE=9,     // Sent after the cookie of the control channel
+    IPF_CREATE_STREAMS=10,    // Sent after the test parameters
+    IPF_EXCHANGE_RESULTS=13,  // Sent after 'IPF_TEST_END'
+    IPF_DISPLAY_RESULTS=14,   // Sent after the results of the server
+    IPF_IPERF_DONE=16,        // Received when the client is done
+    IPF_CLIENT_TERMINATE=0xFE // Received when the client is interrupted
+};
+
+const int cIpf3CookieLen = 37;   // Length of the cookie of an iperf3 connection (in bytes)
+
+typedef ap_uint<log2Ceil<cIpfSessions>::val> IpfIdx;
+
+class IperfReport {
+  public:
+    SessionId       sessId;
+    ap_uint<8>      version;    // 2 or 3
+    ap_uint<32>     ivalBytes;  // #Bytes received during the interval
+    ap_uint<64>     totalBytes; // #Bytes received since the session started
+    bool            last;       // The session is released
+    IperfReport() {}
+    IperfReport(SessionId _sessId, ap_uint<8> _version, ap_uint<32> _ivalBytes,
+                ap_uint<64> _totalBytes, bool _last) :
+        sessId(_sessId), version(_version), ivalBytes(_ivalBytes),
+        totalBytes(_totalBytes), last(_last) {}
+};
+
+//=========================================================
+//== Rx Grant
+//==  The reply of the interrupt table to a 'PUT' query. It
+//==  indicates the number of bytes granted to the session,
+//==  its TCP destination port and whether the session has
+//==  been drained of its pending bytes.
+//=========================================================
+class RxGrant {
+  public:
+    TcpDatLen       byteCnt;
+    TcpPort         dstPort;
+    bool            drained;
+    RxGrant() {}
+    RxGrant(TcpDatLen _byteCnt, TcpPort _dstPort, bool _drained) :
+        byteCnt(_byteCnt), dstPort(_dstPort), drained(_drained) {}
+};
+
+//=========================================================
+//== Rx Interrupt Signal
+//==  Signals the RxHandler that 'byteCnt' bytes were added
+//==  to (SetInt) or withdrawn from (ClrInt) the pending
+//==  bytes of a session. A 'ClrInt' with 'clear' set also
+//==  clears the interrupt of the session because it has no
+//==  more pending bytes.
+//=========================================================
+class RxIntSig {
+  public:
+    SessionId       sessId;
+    TcpDatLen       byteCnt;
+    bool            clear;
+    RxIntSig() {}
+    RxIntSig(SessionId _sessId, TcpDatLen _byteCnt, bool _clear) :
+        sessId(_sessId), byteCnt(_byteCnt), clear(_clear) {}
+};
+
+//=========================================================
+//== Rx Dequeue Signal
+//==  Signals the dequeue of a chunk from the input read
+//==  buffer, together with the session it belongs to, the
+//==  number of valid bytes it carries (from 'tkeep') and
+//==  whether it is the last chunk of its segment.
+//=========================================================
+typedef ap_uint<log2Ceil<(ARW/8)+1>::val> ChunkBytes;
+
+class RxDequSig {
+  public:
+    SessionId       sessId;
+    ChunkBytes      byteCnt;
+    bool            last;
+    RxDequSig() {}
+    RxDequSig(SessionId _sessId, ChunkBytes _byteCnt, bool _last) :
+        sessId(_sessId), byteCnt(_byteCnt), last(_last) {}
+};
+
+//=========================================================
+//== Rx Scheduler Context
+//==  The state of a session for which the Rx scheduler has
+//==  issued a 'PUT' query and awaits the reply of the
+//==  interrupt table.
+//=========================================================
+class RxSchedCtx {
+  public:
+    SessionId       sessId;
+    TcpDatLen       credit;     // DRR credit of the session
+    TcpDatLen       quantum;    // DRR quantum of the session (0 if not in DRR mode)
+    TcpDatLen       rsrvBytes;  // Running sum of the bytes reserved by the session
+    RxSchedCtx() {}
+    RxSchedCtx(SessionId _sessId, TcpDatLen _credit, TcpDatLen _quantum, TcpDatLen _rsrvBytes) :
+        sessId(_sessId), credit(_credit), quantum(_quantum), rsrvBytes(_rsrvBytes) {}
+};
+
+/*******************************************************************************
+ * @brief Update an entry of the port action table.
+ *
+ * @param[in,out] table  The port action table.
+ * @param[in]     cfg    The configuration of the entry to update.
+ *******************************************************************************/
+inline void updatePortAction(
+        PortActEntry    table[cPortActEntries],
+        PortActCfg      cfg)
+{
+    #pragma HLS INLINE
+
+    if (cfg.setRange) {
+        table[cfg.index].loPort = cfg.entry.loPort;
+        table[cfg.index].hiPort = cfg.entry.hiPort;
+    }
+    else {
+        table[cfg.index].action = cfg.entry.action;
+        table[cfg.index].pipeId = cfg.entry.pipeId;
+    }
+}
+
+/*******************************************************************************
+ * @brief Look up the forward command of a segment in the port action table.
+ *
+ * @param[in]  table    The port action table (must be completely partitioned).
+ * @param[in]  sessId   The session Id of the segment.
+ * @param[in]  datLen   The number of bytes of the segment.
+ * @param[in]  dstPort  The TCP destination port of the segment.
+ *
+ * @return the command telling the ReadPath (RDp) to keep or drop the segment.
+ *
+ * @details
+ *  All the entries are compared in parallel and resolved by a priority
+ *   encoder, such that the lookup does not add any cycle to the data request.
+ *******************************************************************************/
+inline ForwardCmd lookupPortAction(
+        PortActEntry    table[cPortActEntries],
+        SessionId       sessId,
+        TcpDatLen       datLen,
+        TcpPort         dstPort)
+{
+    #pragma HLS INLINE
+
+    PortAction action = PA_FWD;
+    for (int i=cPortActEntries-1; i>=0; i--) {
+        #pragma HLS UNROLL
+        if ((table[i].action != PA_NONE) and
+            (dstPort >= table[i].loPort) and (dstPort <= table[i].hiPort)) {
+            action = table[i].action;
+        }
+    }
+    switch (action) {
+    case PA_SINK:
+        return ForwardCmd(sessId, datLen, CMD_DROP, NOP);
+    case PA_GEN:
+        return ForwardCmd(sessId, datLen, CMD_DROP, GEN);
+    case PA_IPERF2:
+        return ForwardCmd(sessId, datLen, CMD_DROP, IPF2);
+    case PA_IPERF3:
+        return ForwardCmd(sessId, datLen, CMD_DROP, IPF3);
+    default:
+        return ForwardCmd(sessId, datLen, CMD_KEEP, NOP);
+    }
+}
+
+/*******************************************************************************
+ * @brief Round-Robin Arbiter - Returns the index of the first bit set in a
+ *  request vector, starting the search right after the previous grant.
+ *
+ * @param[in]  reqVec    The vector of requests (one bit per requester).
+ * @param[in]  lastGrant The index of the previously granted requester.
+ * @param[out] nextGrant The index of the newly granted requester.
+ *
+ * @return true if a grant was issued (.i.e, 'reqVec' is not null).
+ *
+ * @details
+ *  The arbiter is built out of two priority encoders running in parallel. The
+ *   first one searches the requests located above 'lastGrant' while the second
+ *   one searches the entire vector and only serves when the first one fails
+ *   (.i.e, wrap-around). Each encoder is a binary tree of 2:1 selectors, which
+ *   yields a logic depth of O(log2(N)) instead of the O(N) of a linear scan.
+ *******************************************************************************/
+template<int N>
+bool rrArbiter(
+        ap_uint<N>                     reqVec,
+        ap_uint<log2Ceil<N>::val>      lastGrant,
+        ap_uint<log2Ceil<N>::val>     &nextGrant)
+{
+    #pragma HLS INLINE
+
+    const int L = log2Ceil<N>::val;
+    const int P = 1 << L;  // 'N' rounded up to the next power of 2
+
+    bool         hiVld[P];  // Requests located above 'lastGrant'
+    ap_uint<L>   hiIdx[P];
+    bool         anyVld[P]; // All requests
+    ap_uint<L>   anyIdx[P];
+    #pragma HLS ARRAY_PARTITION variable=hiVld  complete
+    #pragma HLS ARRAY_PARTITION variable=hiIdx  complete
+    #pragma HLS ARRAY_PARTITION variable=anyVld complete
+    #pragma HLS ARRAY_PARTITION variable=anyIdx complete
+
+    for (int i=0; i<P; i++) {
+        #pragma HLS UNROLL
+        anyVld[i] = (i < N) ? (bool)reqVec[i] : false;
+        hiVld[i]  = anyVld[i] and (i > lastGrant);
+        anyIdx[i] = i;
+        hiIdx[i]  = i;
+    }
+    for (int lvl=0; lvl<L; lvl++) {
+        #pragma HLS UNROLL
+        for (int j=0; j<(P>>(lvl+1)); j++) {
+            #pragma HLS UNROLL
+            int lo = j << (lvl+1);
+            int hi = lo + (1 << lvl);
+            if (!hiVld[lo] and hiVld[hi]) {
+                hiVld[lo] = true;
+                hiIdx[lo] = hiIdx[hi];
+            }
+            if (!anyVld[lo] and anyVld[hi]) {
+                anyVld[lo] = true;
+                anyIdx[lo] = anyIdx[hi];
+            }
+        }
+    }
+    nextGrant = (hiVld[0]) ? hiIdx[0] : anyIdx[0];
+    return anyVld[0];
+}
+
+/*******************************************************************************
+ * @brief Shortest-first arbiter.
+ *
+ * @param[in]  reqVec    The vector of requests.
+ * @param[in]  keyVec    The key of every requester (e.g. its #pending bytes).
+ * @param[out] nextGrant The index of the requester with the smallest key.
+ *
+ * @return true if a grant was issued (.i.e, 'reqVec' is not null).
+ *
+ * @details
+ *  The arbiter is a binary tree of 2:1 comparators which yields a logic depth
+ *   of O(log2(N)). Ties are resolved in favor of the lowest index.
+ *******************************************************************************/
+template<int N>
+bool minArbiter(
+        ap_uint<N>                     reqVec,
+        TcpDatLen                      keyVec[N],
+        ap_uint<log2Ceil<N>::val>     &nextGrant)
+{
+    #pragma HLS INLINE
+
+    const int L = log2Ceil<N>::val;
+    const int P = 1 << L;  // 'N' rounded up to the next power of 2
+
+    bool         vld[P];
+    TcpDatLen    key[P];
+    ap_uint<L>   idx[P];
+    #pragma HLS ARRAY_PARTITION variable=vld complete
+    #pragma HLS ARRAY_PARTITION variable=key complete
+    #pragma HLS ARRAY_PARTITION variable=idx complete
+
+    for (int i=0; i<P; i++) {
+        #pragma HLS UNROLL
+        vld[i] = (i < N) ? (bool)reqVec[i] : false;
+        key[i] = (i < N) ? keyVec[i] : (TcpDatLen)0;
+        idx[i] = i;
+    }
+    for (int lvl=0; lvl<L; lvl++) {
+        #pragma HLS UNROLL
+        for (int j=0; j<(P>>(lvl+1)); j++) {
+            #pragma HLS UNROLL
+            int lo = j << (lvl+1);
+            int hi = lo + (1 << lvl);
+            if (vld[hi] and (!vld[lo] or (key[hi] < key[lo]))) {
+                vld[lo] = true;
+                key[lo] = key[hi];
+                idx[lo] = idx[hi];
+            }
+        }
+    }
+    nextGrant = idx[0];
+    return vld[0];
+}
+
+/*******************************************************************************
+ * @brief Return the next state of a xorshift64 pseudo-random generator.
+ *
+ * @param[in]  state  The current state (must not be null).
+ *******************************************************************************/
+inline ap_uint<64> prbsNext(
+        ap_uint<64>     state)
+{
+    #pragma HLS INLINE
+
+    state ^= (state << 13);
+    state ^= (state >>  7);
+    state ^= (state << 17);
+    return state;
+}
+
 /*************************************************************************
  *
  * ENTITY - TCP SHELL INTERFACE (TSIF)
@@ -173,6 +927,8 @@ void tcp_shell_if(
         //-- SHELL / Mmio Interface
         //------------------------------------------------------
         CmdBit                *piSHL_Mmio_En,
+        stream<MmioCfgCmd>    &siSHL_Mmio_CfgCmd,
+        stream<SinkStats>     &soSHL_Mmio_SinkStats,
 
         //------------------------------------------------------
         //-- TAF / Rx Data Interface
@@ -181,6 +937,14 @@ void tcp_shell_if(
         stream<TcpSessId>     &siTAF_SessId,
         stream<TcpDatLen>     &siTAF_DatLen,
 
+        //------------------------------------------------------
+        //-- TAF / Rx Socket Interface
+        //------------------------------------------------------
+        stream<TcpAppData>    &siTAF_SockData,
+        stream<SockAddr>      &siTAF_SockAddr,
+        stream<TcpDatLen>     &siTAF_SockLen,
+        stream<SockSndRep>    &soTAF_SockRep,
+
         //------------------------------------------------------
         //-- TAF / Tx Data Interface
         //------------------------------------------------------
@@ -225,7 +989,9 @@ void tcp_shell_if(
         //-- DEBUG Probes
         //------------------------------------------------------
         stream<ap_uint<32> >  &soDBG_SinkCnt,
-        stream<ap_uint<16> >  &soDBG_InpBufSpace
+        stream<ap_uint<16> >  &soDBG_InpBufSpace,
+        stream<ConnEvent>     &soDBG_OpnEvent,
+        stream<IperfReport>   &soDBG_IpfReport
 
 );
 
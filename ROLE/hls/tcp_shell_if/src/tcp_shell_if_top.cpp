@@ -44,10 +44,18 @@ using namespace std;
  * @brief Top of TCP Shell Interface (TSIF)
  *
  * @param[in]  piSHL_Mmio_En Enable signal from [SHELL/MMIO].
+ * @param[in]  siSHL_Mmio_CfgCmd Configuration command from [SHELL/MMIO].
+ * @param[out] soSHL_Mmio_SinkStats The sink statistics read out by [SHELL/MMIO].
  * @param[in]  siTAF_Data    TCP data stream from TcpAppFlash (TAF).
  * @param[in]  siTAF_SessId  TCP session Id  from [TAF].
+ * @param[in]  siTAF_DatLen  TCP data length from [TAF].
+ * @param[in]  siTAF_SockData TCP data stream of a socket-addressed message from [TAF].
+ * @param[in]  siTAF_SockAddr The remote socket of that message from [TAF].
+ * @param[in]  siTAF_SockLen  The length of that message from [TAF].
+ * @param[out] soTAF_SockRep  The session that message was sent on, to [TAF].
  * @param[out] soTAF_Data    TCP data stream to   [TAF].
  * @param[out] soTAF_SessId  TCP session Id  to   [TAF].
+ * @param[out] soTAF_DatLen  TCP data length to   [TAF].
  * @param[in]  siSHL_Notif   TCP data notification from [SHELL].
  * @param[out] soSHL_DReq    TCP data request to [SHELL].
  * @param[in]  siSHL_Data    TCP data stream from [SHELL].
@@ -61,6 +69,9 @@ using namespace std;
  * @param[in]  siSHL_OpnRep  TCP open connection reply from [SHELL].
  * @param[out] soSHL_ClsReq  TCP close connection request to [SHELL].
  * @param[out] soDBG_SinkCnt Counts the number of sinked bytes (for debug).
+ * @param[out] soDBG_InpBufSpace The available space in the input buffer (for debug).
+ * @param[out] soDBG_OpnEvent The outcome of the open connection attempts (for debug).
+ * @param[out] soDBG_IpfReport The per-session reports of the iperf server (for debug).
  *******************************************************************************/
 #if HLS_VERSION == 2016
     void tcp_shell_if_top(
@@ -68,6 +79,8 @@ using namespace std;
         //-- SHELL / Mmio Interface
         //------------------------------------------------------
         CmdBit                *piSHL_Mmio_En,
+        stream<MmioCfgCmd>    &siSHL_Mmio_CfgCmd,
+        stream<SinkStats>     &soSHL_Mmio_SinkStats,
         //------------------------------------------------------
         //-- TAF / TxP Data Interface
         //------------------------------------------------------
@@ -75,6 +88,13 @@ using namespace std;
         stream<TcpSessId>     &siTAF_SessId,
         stream<TcpDatLen>     &siTAF_DatLen,
         //------------------------------------------------------
+        //-- TAF / TxP Socket Interface
+        //------------------------------------------------------
+        stream<TcpAppData>    &siTAF_SockData,
+        stream<SockAddr>      &siTAF_SockAddr,
+        stream<TcpDatLen>     &siTAF_SockLen,
+        stream<SockSndRep>    &soTAF_SockRep,
+        //------------------------------------------------------
         //-- TAF / RxP Data Interface
         //------------------------------------------------------
         stream<TcpAppData>    &soTAF_Data,
@@ -106,7 +126,14 @@ using namespace std;
         //------------------------------------------------------
         //-- SHELL / Close Interfaces
         //------------------------------------------------------
-        stream<TcpAppClsReq>  &soSHL_ClsReq)
+        stream<TcpAppClsReq>  &soSHL_ClsReq,
+        //------------------------------------------------------
+        //-- DEBUG Probes
+        //------------------------------------------------------
+        stream<ap_uint<32> >  &soDBG_SinkCnt,
+        stream<ap_uint<16> >  &soDBG_InpBufSpace,
+        stream<ConnEvent>     &soDBG_OpnEvent,
+        stream<IperfReport>   &soDBG_IpfReport)
 {
 
     //-- DIRECTIVES FOR THE INTERFACES -----------------------------------------
@@ -117,11 +144,22 @@ using namespace std;
     /*** directives because the new PRAGMAs do not work for us.        ***/
     /*********************************************************************/
     #pragma HLS INTERFACE ap_stable register port=piSHL_Mmio_En    name=piSHL_Mmio_En
+    #pragma HLS resource core=AXI4Stream variable=siSHL_Mmio_CfgCmd metadata="-bus_bundle siSHL_Mmio_CfgCmd"
+    #pragma HLS DATA_PACK                variable=siSHL_Mmio_CfgCmd
+    #pragma HLS resource core=AXI4Stream variable=soSHL_Mmio_SinkStats metadata="-bus_bundle soSHL_Mmio_SinkStats"
+    #pragma HLS DATA_PACK                variable=soSHL_Mmio_SinkStats
 
     #pragma HLS resource core=AXI4Stream variable=siTAF_Data   metadata="-bus_bundle siTAF_Data"
     #pragma HLS resource core=AXI4Stream variable=siTAF_SessId metadata="-bus_bundle siTAF_SessId"
     #pragma HLS resource core=AXI4Stream variable=siTAF_DatLen metadata="-bus_bundle siTAF_DatLen"
 
+    #pragma HLS resource core=AXI4Stream variable=siTAF_SockData metadata="-bus_bundle siTAF_SockData"
+    #pragma HLS resource core=AXI4Stream variable=siTAF_SockAddr metadata="-bus_bundle siTAF_SockAddr"
+    #pragma HLS DATA_PACK                variable=siTAF_SockAddr
+    #pragma HLS resource core=AXI4Stream variable=siTAF_SockLen  metadata="-bus_bundle siTAF_SockLen"
+    #pragma HLS resource core=AXI4Stream variable=soTAF_SockRep  metadata="-bus_bundle soTAF_SockRep"
+    #pragma HLS DATA_PACK                variable=soTAF_SockRep
+
     #pragma HLS resource core=AXI4Stream variable=soTAF_Data   metadata="-bus_bundle soTAF_Data"
     #pragma HLS resource core=AXI4Stream variable=soTAF_SessId metadata="-bus_bundle soTAF_SessId"
     #pragma HLS resource core=AXI4Stream variable=soTAF_DatLen metadata="-bus_bundle soTAF_DatLen"
@@ -149,6 +187,13 @@ using namespace std;
 
     #pragma HLS resource core=AXI4Stream variable=soSHL_ClsReq metadata="-bus_bundle soSHL_ClsReq"
 
+    #pragma HLS resource core=AXI4Stream variable=soDBG_SinkCnt     metadata="-bus_bundle soDBG_SinkCnt"
+    #pragma HLS resource core=AXI4Stream variable=soDBG_InpBufSpace metadata="-bus_bundle soDBG_InpBufSpace"
+    #pragma HLS resource core=AXI4Stream variable=soDBG_OpnEvent    metadata="-bus_bundle soDBG_OpnEvent"
+    #pragma HLS DATA_PACK                variable=soDBG_OpnEvent
+    #pragma HLS resource core=AXI4Stream variable=soDBG_IpfReport   metadata="-bus_bundle soDBG_IpfReport"
+    #pragma HLS DATA_PACK                variable=soDBG_IpfReport
+
     //-- DIRECTIVES FOR THIS PROCESS -------------------------------------------
     #pragma HLS DATAFLOW
 
@@ -156,10 +201,16 @@ using namespace std;
     tcp_shell_if(
         //-- SHELL / Mmio Interface
         piSHL_Mmio_En,
+        siSHL_Mmio_CfgCmd,
+        soSHL_Mmio_SinkStats,
         //-- TAF / Rx & Tx Data Interfaces
         siTAF_Data,
         siTAF_SessId,
         siTAF_DatLen,
+        siTAF_SockData,
+        siTAF_SockAddr,
+        siTAF_SockLen,
+        soTAF_SockRep,
         soTAF_Data,
         soTAF_SessId,
         soTAF_DatLen,
@@ -179,7 +230,12 @@ using namespace std;
         soSHL_OpnReq,
         siSHL_OpnRep,
         //-- TOE / Close Interfaces
-        soSHL_ClsReq);
+        soSHL_ClsReq,
+        //-- DEBUG Interfaces
+        soDBG_SinkCnt,
+        soDBG_InpBufSpace,
+        soDBG_OpnEvent,
+        soDBG_IpfReport);
 
 }
 #else
@@ -188,6 +244,8 @@ using namespace std;
         //-- SHELL / Mmio Interface
         //------------------------------------------------------
         CmdBit                *piSHL_Mmio_En,
+        stream<MmioCfgCmd>    &siSHL_Mmio_CfgCmd,
+        stream<SinkStats>     &soSHL_Mmio_SinkStats,
         //------------------------------------------------------
         //-- TAF / TxP Data Interface
         //------------------------------------------------------
@@ -195,6 +253,13 @@ using namespace std;
         stream<TcpSessId>     &siTAF_SessId,
         stream<TcpDatLen>     &siTAF_DatLen,
         //------------------------------------------------------
+        //-- TAF / TxP Socket Interface
+        //------------------------------------------------------
+        stream<TcpAppData>    &siTAF_SockData,
+        stream<SockAddr>      &siTAF_SockAddr,
+        stream<TcpDatLen>     &siTAF_SockLen,
+        stream<SockSndRep>    &soTAF_SockRep,
+        //------------------------------------------------------
         //-- TAF / RxP Data Interface
         //------------------------------------------------------
         stream<TcpAppData>    &soTAF_Data,
@@ -231,17 +296,30 @@ using namespace std;
         //-- DEBUG Probes
         //------------------------------------------------------
         stream<ap_uint<32> >  &soDBG_SinkCnt,
-        stream<ap_uint<16> >  &soDBG_InpBufSpace)
+        stream<ap_uint<16> >  &soDBG_InpBufSpace,
+        stream<ConnEvent>     &soDBG_OpnEvent,
+        stream<IperfReport>   &soDBG_IpfReport)
 {
     //-- DIRECTIVES FOR THE INTERFACES -----------------------------------------
     #pragma HLS INTERFACE ap_ctrl_none port=return
 
     #pragma HLS INTERFACE ap_stable register    port=piSHL_Mmio_En  name=piSHL_Mmio_En
+    #pragma HLS INTERFACE axis off              port=siSHL_Mmio_CfgCmd name=siSHL_Mmio_CfgCmd
+    #pragma HLS DATA_PACK                   variable=siSHL_Mmio_CfgCmd
+    #pragma HLS INTERFACE axis off              port=soSHL_Mmio_SinkStats name=soSHL_Mmio_SinkStats
+    #pragma HLS DATA_PACK                   variable=soSHL_Mmio_SinkStats
 
     #pragma HLS INTERFACE axis off              port=siTAF_Data     name=siTAF_Data
     #pragma HLS INTERFACE axis off              port=siTAF_SessId   name=siTAF_SessId
     #pragma HLS INTERFACE axis off              port=siTAF_DatLen   name=siTAF_DatLen
 
+    #pragma HLS INTERFACE axis off              port=siTAF_SockData name=siTAF_SockData
+    #pragma HLS INTERFACE axis off              port=siTAF_SockAddr name=siTAF_SockAddr
+    #pragma HLS DATA_PACK                   variable=siTAF_SockAddr
+    #pragma HLS INTERFACE axis off              port=siTAF_SockLen  name=siTAF_SockLen
+    #pragma HLS INTERFACE axis off              port=soTAF_SockRep  name=soTAF_SockRep
+    #pragma HLS DATA_PACK                   variable=soTAF_SockRep
+
     #pragma HLS INTERFACE axis off              port=soTAF_Data     name=soTAF_Data
     #pragma HLS INTERFACE axis off              port=soTAF_SessId   name=soTAF_SessId
     #pragma HLS INTERFACE axis off              port=soTAF_DatLen   name=soTAF_DatLen
@@ -271,6 +349,10 @@ using namespace std;
 
     #pragma HLS INTERFACE axis register both    port=soDBG_SinkCnt     name=soDBG_SinkCnt
     #pragma HLS INTERFACE axis register both    port=soDBG_InpBufSpace name=soDBG_InpBufSpace
+    #pragma HLS INTERFACE axis register both    port=soDBG_OpnEvent    name=soDBG_OpnEvent
+    #pragma HLS DATA_PACK                   variable=soDBG_OpnEvent
+    #pragma HLS INTERFACE axis register both    port=soDBG_IpfReport   name=soDBG_IpfReport
+    #pragma HLS DATA_PACK                   variable=soDBG_IpfReport
 
     //-- DIRECTIVES FOR THIS PROCESS -------------------------------------------
   #if HLS_VERSION == 2017
@@ -283,10 +365,16 @@ using namespace std;
     tcp_shell_if(
         //-- SHELL / Mmio Interface
         piSHL_Mmio_En,
+        siSHL_Mmio_CfgCmd,
+        soSHL_Mmio_SinkStats,
         //-- TAF / Rx & Tx Data Interfaces
         siTAF_Data,
         siTAF_SessId,
         siTAF_DatLen,
+        siTAF_SockData,
+        siTAF_SockAddr,
+        siTAF_SockLen,
+        soTAF_SockRep,
         soTAF_Data,
         soTAF_SessId,
         soTAF_DatLen,
@@ -309,7 +397,9 @@ using namespace std;
         soSHL_ClsReq,
         //-- DEBUG Interfaces
         soDBG_SinkCnt,
-        soDBG_InpBufSpace);
+        soDBG_InpBufSpace,
+        soDBG_OpnEvent,
+        soDBG_IpfReport);
 }
 
 #endif  //  HLS_VERSION
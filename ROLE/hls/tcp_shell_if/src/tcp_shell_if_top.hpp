@@ -47,6 +47,8 @@ void tcp_shell_if_top(
         //-- SHELL / Mmio Interface
         //------------------------------------------------------
         CmdBit                *piSHL_Mmio_En,
+        stream<MmioCfgCmd>    &siSHL_Mmio_CfgCmd,
+        stream<SinkStats>     &soSHL_Mmio_SinkStats,
 
         //------------------------------------------------------
         //-- TAF / Rx Data Interface
@@ -55,6 +57,14 @@ void tcp_shell_if_top(
         stream<TcpSessId>     &siTAF_SessId,
         stream<TcpDatLen>     &siTAF_DatLen,
 
+        //------------------------------------------------------
+        //-- TAF / Rx Socket Interface
+        //------------------------------------------------------
+        stream<TcpAppData>    &siTAF_SockData,
+        stream<SockAddr>      &siTAF_SockAddr,
+        stream<TcpDatLen>     &siTAF_SockLen,
+        stream<SockSndRep>    &soTAF_SockRep,
+
         //------------------------------------------------------
         //-- TAF / Tx Data Interface
         //------------------------------------------------------
@@ -99,7 +109,9 @@ void tcp_shell_if_top(
         //-- DEBUG Probes
         //------------------------------------------------------
         stream<ap_uint<32> >  &soDBG_SinkCnt,
-        stream<ap_uint<16> >  &soDBG_InpBufSpace
+        stream<ap_uint<16> >  &soDBG_InpBufSpace,
+        stream<ConnEvent>     &soDBG_OpnEvent,
+        stream<IperfReport>   &soDBG_IpfReport
 );
 
 #endif
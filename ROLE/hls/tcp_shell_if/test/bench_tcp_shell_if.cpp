@@ -0,0 +1,2651 @@
+/*
+ * Copyright 2016 -- 2021 IBM Corporation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*****************************************************************************
+ * @file       : bench_tcp_shell_if.cpp
+ * @brief      : Performance benchmark for the TCP Shell Interface (TSIF).
+ *
+ * System:     : cloudFPGA
+ * Component   : cFp_HelloKale/ROLE/TcpShellInterface (TSIF)
+ * Language    : Vivado HLS
+ *
+ *               +-----------------------+
+ *               |  TcpApplicationFlash  |
+ *               |        (TAF)          |
+ *               +-----/|\------+--------+
+ *                      |       |
+ *                      |      \|/
+ *               +------+----------------+
+ *               |   TcpShellInterface   |
+ *               |       (TSIF)          |
+ *               +-----/|\------+--------+
+ *                      |       |
+ *                      |      \|/
+ *               +------+----------------+
+ *               |  TOE (DReq-driven)    |
+ *               +-----------------------+
+ *
+ * @details
+ *  Contrary to the functional testbench, the TOE model of this benchmark only
+ *   delivers data upon reception of a data request (DReq), after a configurable
+ *   latency and at a rate of one chunk per clock cycle. This allows to measure
+ *   the rate at which [TSIF] absorbs the notifications as well as the Rx
+ *   throughput achieved for a given traffic pattern.
+ *
+ * \ingroup tcp_shell_if
+ * \addtogroup tcp_shell_if
+ * \{
+ *****************************************************************************/
+
+#include <algorithm>
+#include <deque>
+#include <vector>
+
+#include "bench_tcp_shell_if.hpp"
+
+using namespace hls;
+using namespace std;
+
+//---------------------------------------------------------
+// HELPERS FOR THE DEBUGGING TRACES
+//  .e.g: DEBUG_LEVEL = (MDL_TRACE | IPS_TRACE)
+//---------------------------------------------------------
+#ifndef __SYNTHESIS__
+  extern unsigned int gSimCycCnt;
+  extern unsigned int gMaxSimCycles;
+#endif
+
+#define THIS_NAME "BENCH_TSIF"
+#define TRACE_OFF      0x0000
+#define TRACE_TOE     1 <<  1
+#define TRACE_TAF     1 <<  2
+#define TRACE_ALL      0xFFFF
+#define DEBUG_LEVEL (TRACE_OFF)
+
+//---------------------------------------------------------
+//-- NOTIFICATION STATISTICS
+//---------------------------------------------------------
+unsigned int    gNotifSent      = 0;  // #Notifications injected so far
+unsigned int    gNotifStalls    = 0;  // #Cycles a notification could not be injected
+unsigned int    gNotifFirstCyc  = 0;  // Cycle of the first injected notification
+unsigned int    gNotifLastCyc   = 0;  // Cycle of the last injected notification
+unsigned int    gRxLastCyc      = 0;  // Cycle of the last byte forwarded to TAF (or sunk)
+unsigned long   gSinkCnt        = 0;  // #Bytes sunk by TSIF
+unsigned long   gCoaBytes       = 0;  // #Bytes the Rx coalescer of TSIF may hold on top of its input read buffer
+unsigned long   gMaxInFlight    = 0;  // Max. #bytes requested by TSIF but not yet forwarded to TAF
+unsigned long   gChunksAtMax    = 0;  // #Chunk bytes holding those 'gMaxInFlight' bytes
+unsigned long   gMaxChunkBytes  = 0;  // Max. #chunk bytes requested by TSIF but not yet forwarded to TAF
+unsigned int    gDReqCnt        = 0;  // #Data requests issued by TSIF
+unsigned int    gDReqPeak       = 0;  // Max. #data requests issued within 'cBenchDReqWindow' cycles
+unsigned int    gDReqReorders   = 0;  // #Data requests served ahead of an older one by the TOE
+unsigned int    gTafMsgs        = 0;  // #Messages forwarded by TSIF to TAF
+unsigned int    gTafLenErrs     = 0;  // #Messages to TAF whose length differs from their data-length
+unsigned int    gGenFirstCyc    = 0;  // Cycle of the first chunk sent by the Tx generator
+unsigned int    gGenLastCyc     = 0;  // Cycle of the last chunk sent by the Tx generator
+unsigned int    gIpfFirstCyc    = 0;  // Cycle of the first byte served on an iperf data session
+unsigned int    gIpfLastCyc     = 0;  // Cycle of the last byte served on an iperf data session
+deque<IperfReport> gIpfReports;      // Reports issued by the iperf server of TSIF
+unsigned int    gCliSent        = 0;  // #Socket-addressed messages reported as sent by TSIF
+unsigned int    gCliDropped     = 0;  // #Socket-addressed messages reported as dropped by TSIF
+unsigned int    gCliOpenCyc     = 0;  // Cycle of the last connection opened by the TOE
+unsigned int    gCliFirstCyc    = 0;  // Cycle of the first chunk of a socket-addressed message
+unsigned int    gCliLastCyc     = 0;  // Cycle of the last chunk of a socket-addressed message
+unsigned long   gCliRcvdBytes   = 0;  // #Bytes of the socket-addressed messages received by the TOE
+unsigned long   gCliOpenBytes   = 0;  // #Bytes received when the last connection was opened
+unsigned int    gCliFailCyc     = 0;  // Cycle of the first socket-addressed message reported as dropped
+unsigned long   gCliFailBytes   = 0;  // #Bytes received when that message was reported
+unsigned int    gTxbGranted     = 0;  // #Requests to send granted by the TOE
+unsigned int    gTxbAhead       = 0;  // #Requests to send received before the data of the previous grant
+unsigned int    gTxbAheadRefused = 0; // #Requests to send issued ahead and refused by the TOE
+unsigned int    gTxbStallFirstCyc  = 0;  // Cycle of the first refusal of a blocked session
+unsigned int    gTxbStallLastCyc   = 0;  // Cycle of the last request of a blocked session
+unsigned long   gTxbStallBytes     = 0;  // #Bytes of the unblocked sessions received since 'gTxbStallFirstCyc'
+unsigned long   gTxbStallLastBytes = 0;  // Value of 'gTxbStallBytes' at 'gTxbStallLastCyc'
+
+/*******************************************************************************
+ * @brief Emulate the data request server of the TOE.
+ *
+ * @param[in/out] nrErr       A ref to the error counter of the main testbench.
+ * @param[in]     dreqLat     The latency of the TOE upon a data request (in cycles).
+ * @param[in]     reorder     Serve the data requests out of order.
+ * @param[in/out] sessStats   The per-session statistics.
+ * @param[in]  siTSIF_DReq    Data read request from TcpShellInterface (TSIF).
+ * @param[out] soTSIF_Data    Data to [TSIF].
+ * @param[out] soTSIF_Meta    Session Id to [TSIF].
+ * @param[in]  siTSIF_LsnReq  Listen port request from [TSIF].
+ * @param[out] soTSIF_LsnRep  Listen port reply to [TSIF].
+ *
+ * @details
+ *  A data request is served 'dreqLat' cycles after its reception by streaming
+ *   its data at a rate of one chunk per cycle. With 'reorder', the shortest of
+ *   the requests which are due is served first (the youngest one upon a tie),
+ *   but the requests of a same session are always served in order.
+ *  Upon reception of a data request, the number of bytes requested by [TSIF]
+ *   but not yet forwarded to [TAF] is checked against the size of the input
+ *   read buffer of [TSIF], and the peak rate of the data requests is measured
+ *   over a sliding window of 'cBenchDReqWindow' cycles.
+ *  The number of chunks which hold these bytes is tracked as well. It gives the
+ *   physical occupancy of the buffer, and the budget a chunk-granular accounting
+ *   of that buffer would have consumed.
+ *******************************************************************************/
+void pBenchToeServer(
+        int                      &nrErr,
+        int                       dreqLat,
+        bool                      reorder,
+        vector<BenchSessStats>   &sessStats,
+        stream<TcpAppRdReq>      &siTSIF_DReq,
+        stream<TcpAppData>       &soTSIF_Data,
+        stream<TcpAppMeta>       &soTSIF_Meta,
+        stream<TcpAppLsnReq>     &siTSIF_LsnReq,
+        stream<TcpAppLsnRep>     &soTSIF_LsnRep)
+{
+    const char *myName = concat3(THIS_NAME, "/", "TOE");
+
+    //-- STATIC VARIABLES ------------------------------------------------------
+    static deque<pair<unsigned int, TcpAppRdReq> > toe_dReqQueue;
+    static deque<unsigned int>                     toe_dReqCycles;
+    static bool         toe_isStreaming = false;
+    static SessionId    toe_currSess;
+    static unsigned int toe_bytesLeft;
+    static ap_uint<8>   toe_byteVal = 0;
+
+    //------------------------------------------------------
+    //-- LISTEN REQUESTS ARE ALWAYS GRANTED
+    //------------------------------------------------------
+    if (!siTSIF_LsnReq.empty()) {
+        siTSIF_LsnReq.read();
+        soTSIF_LsnRep.write(TcpAppLsnRep(NTS_OK));
+    }
+
+    //------------------------------------------------------
+    //-- ACCEPT A NEW DATA REQUEST
+    //------------------------------------------------------
+    if (!siTSIF_DReq.empty()) {
+        TcpAppRdReq dReq = siTSIF_DReq.read();
+        BenchSessStats &stats = sessStats[dReq.sessionID];
+        if ((dReq.length == 0) or
+            ((stats.reqBytes + dReq.length) > stats.notifBytes)) {
+            printError(myName, "DReq(SessId=%d, Len=%d) exceeds the #bytes notified for this session (%ld).\n",
+                       dReq.sessionID.to_uint(), dReq.length.to_uint(),
+                       (stats.notifBytes - stats.reqBytes));
+            nrErr++;
+        }
+        stats.reqBytes  += dReq.length;
+        stats.reqChunks += (dReq.length + (ARW/8) - 1) / (ARW/8);
+        unsigned long inFlight   = 0;
+        unsigned long chunkBytes = 0;
+        for (size_t s=0; s<sessStats.size(); s++) {
+            inFlight   += sessStats[s].reqBytes - sessStats[s].rcvdBytes;
+            chunkBytes += (sessStats[s].reqChunks - sessStats[s].rcvdChunks) * (ARW/8);
+        }
+        inFlight -= gSinkCnt;
+        if (inFlight > gMaxInFlight) {
+            gMaxInFlight = inFlight;
+            gChunksAtMax = chunkBytes;
+        }
+        if ((gSinkCnt != 0) or (gCoaBytes != 0)) {
+            //-- The chunks sunk or coalesced by TSIF are not observed. Do not track them.
+            chunkBytes = 0;
+        }
+        if (chunkBytes > gMaxChunkBytes) {
+            gMaxChunkBytes = chunkBytes;
+        }
+        if (inFlight > (unsigned)cIBuffBytes + gCoaBytes) {
+            printError(myName, "DReq(SessId=%d, Len=%d) overruns the input read buffer of TSIF (%ld bytes in flight).\n",
+                       dReq.sessionID.to_uint(), dReq.length.to_uint(), inFlight);
+            nrErr++;
+        }
+        if (chunkBytes > (unsigned)(cIBuffChunks * (ARW/8))) {
+            printError(myName, "DReq(SessId=%d, Len=%d) overflows the storage of the input read buffer of TSIF (%ld chunks in flight).\n",
+                       dReq.sessionID.to_uint(), dReq.length.to_uint(), chunkBytes / (ARW/8));
+            nrErr++;
+        }
+        toe_dReqQueue.push_back(make_pair(gSimCycCnt + dreqLat, dReq));
+        gDReqCnt++;
+        toe_dReqCycles.push_back(gSimCycCnt);
+        while (toe_dReqCycles.front() + cBenchDReqWindow <= gSimCycCnt) {
+            toe_dReqCycles.pop_front();
+        }
+        if (toe_dReqCycles.size() > gDReqPeak) {
+            gDReqPeak = toe_dReqCycles.size();
+        }
+        if (DEBUG_LEVEL & TRACE_TOE) {
+            printInfo(myName, "Received DReq(SessId=%d, Len=%d).\n",
+                      dReq.sessionID.to_uint(), dReq.length.to_uint());
+        }
+    }
+
+    //------------------------------------------------------
+    //-- SERVE THE DATA REQUESTS (one chunk per cycle)
+    //------------------------------------------------------
+    if (!toe_isStreaming and !toe_dReqQueue.empty() and
+        (toe_dReqQueue.front().first <= gSimCycCnt)) {
+        size_t pick = 0;
+        if (reorder) {
+            vector<bool> seen(sessStats.size(), false);
+            for (size_t i=0; i<toe_dReqQueue.size(); i++) {
+                TcpAppRdReq &dReq = toe_dReqQueue[i].second;
+                if ((toe_dReqQueue[i].first <= gSimCycCnt) and !seen[dReq.sessionID] and
+                    (dReq.length <= toe_dReqQueue[pick].second.length)) {
+                    pick = i;
+                }
+                seen[dReq.sessionID] = true;
+            }
+            if (pick != 0) {
+                gDReqReorders++;
+            }
+        }
+        toe_currSess  = toe_dReqQueue[pick].second.sessionID;
+        toe_bytesLeft = toe_dReqQueue[pick].second.length;
+        toe_dReqQueue.erase(toe_dReqQueue.begin() + pick);
+        soTSIF_Meta.write(toe_currSess);
+        toe_isStreaming = true;
+    }
+    if (toe_isStreaming) {
+        TcpAppData chunk(0, 0, 0);
+        int chunkLen = (toe_bytesLeft > (ARW/8)) ? (ARW/8) : toe_bytesLeft;
+        for (int i=0; i<chunkLen; i++) {
+            chunk.setLE_TData(toe_byteVal++, (i*8)+7, (i*8)+0);
+        }
+        chunk.setLE_TKeep(lenToLE_tKeep(chunkLen));
+        sessStats[toe_currSess].srvdBytes += chunkLen;
+        toe_bytesLeft -= chunkLen;
+        chunk.setLE_TLast((toe_bytesLeft == 0) ? TLAST : 0);
+        soTSIF_Data.write(chunk);
+        if (toe_bytesLeft == 0) {
+            toe_isStreaming = false;
+        }
+    }
+}
+
+/*******************************************************************************
+ * @brief Return the length of a notification.
+ *
+ * @param[in] cfg      The configuration of the benchmark.
+ * @param[in] notifNr  The sequence number of the notification.
+ *
+ * @return 'cfg.segLen', or an entry of 'cBenchMixedSegLens' when 'cfg.segLen'
+ *   is 0. The number of entries is prime, such that the sessions do not
+ *   always get the same length.
+ *******************************************************************************/
+int benchSegLen(const BenchCfg &cfg, unsigned int notifNr) {
+    return (cfg.segLen != 0) ? cfg.segLen : cBenchMixedSegLens[notifNr % cBenchNrMixedSegLens];
+}
+
+/*******************************************************************************
+ * @brief Emulate the Rx path of the TOE in a data-request driven fashion.
+ *
+ * @param[in/out] nrErr       A ref to the error counter of the main testbench.
+ * @param[in]     cfg         The configuration of the benchmark.
+ * @param[in/out] sessStats   The per-session statistics.
+ * @param[out] soTSIF_Notif   Notification to TcpShellInterface (TSIF).
+ * @param[in]  siTSIF_DReq    Data read request from [TSIF].
+ * @param[out] soTSIF_Data    Data to [TSIF].
+ * @param[out] soTSIF_Meta    Session Id to [TSIF].
+ * @param[in]  siTSIF_LsnReq  Listen port request from [TSIF].
+ * @param[out] soTSIF_LsnRep  Listen port reply to [TSIF].
+ *
+ * @details
+ *  Notifications are spread in round-robin fashion over 'cfg.nrSess' sessions
+ *   and are injected at a rate of up to one per cycle, i.e. every time [TSIF]
+ *   has drained the previous one. A cycle during which the previous
+ *   notification is still pending is accounted as a stall.
+ *  Similarly to the TOE, a session does not get notified more bytes than its
+ *   Rx buffer can hold (.i.e, 'cBenchToeRxBufBytes').
+ *  Every notified segment is also recorded as a message in flight, such that
+ *   [TAF] can measure its notification-to-last-byte latency.
+ *  The data requests are served by 'pBenchToeServer()'.
+ *******************************************************************************/
+void pBenchTOE(
+        int                      &nrErr,
+        const BenchCfg           &cfg,
+        vector<BenchSessStats>   &sessStats,
+        stream<TcpAppNotif>      &soTSIF_Notif,
+        stream<TcpAppRdReq>      &siTSIF_DReq,
+        stream<TcpAppData>       &soTSIF_Data,
+        stream<TcpAppMeta>       &soTSIF_Meta,
+        stream<TcpAppLsnReq>     &siTSIF_LsnReq,
+        stream<TcpAppLsnRep>     &soTSIF_LsnRep)
+{
+    pBenchToeServer(nrErr, cfg.dreqLat, cfg.reorder, sessStats,
+                    siTSIF_DReq, soTSIF_Data, soTSIF_Meta, siTSIF_LsnReq, soTSIF_LsnRep);
+
+    if (gSimCycCnt < cSimToeStartupDelay) {
+        return;
+    }
+
+    //------------------------------------------------------
+    //-- INJECT A NEW NOTIFICATION
+    //------------------------------------------------------
+    if (gNotifSent < (unsigned)cfg.nrNotifs) {
+        SessionId       sessId = gNotifSent % cfg.nrSess;
+        BenchSessStats &stats  = sessStats[sessId];
+        int             segLen = benchSegLen(cfg, gNotifSent);
+        if ((stats.notifBytes - stats.reqBytes + segLen) > cBenchToeRxBufBytes) {
+            //-- The Rx buffer of this session is full. Wait for TSIF to read it.
+        }
+        else if (soTSIF_Notif.empty()) {
+            soTSIF_Notif.write(TcpAppNotif(sessId, segLen, DEFAULT_HOST_IP4_ADDR,
+                                           DEFAULT_HOST_TCP_SRC_PORT, cfg.dstPort));
+            stats.notifBytes += segLen;
+            stats.msgs.push_back(BenchMsg(stats.notifBytes, gSimCycCnt));
+            if (gNotifSent == 0) {
+                gNotifFirstCyc = gSimCycCnt;
+            }
+            gNotifLastCyc = gSimCycCnt;
+            gNotifSent++;
+        }
+        else {
+            gNotifStalls++;
+        }
+    }
+}
+
+/*******************************************************************************
+ * @brief Emulate the Rx path of the TOE with a mix of bulk and short-message
+ *  sessions.
+ *
+ * @param[in/out] nrErr       A ref to the error counter of the main testbench.
+ * @param[in]     cfg         The configuration of the mixed benchmark.
+ * @param[in]     startCyc    The cycle at which the traffic starts.
+ * @param[in/out] sessStats   The per-session statistics.
+ * @param[out] soTSIF_Notif   Notification to TcpShellInterface (TSIF).
+ * @param[in]  siTSIF_DReq    Data read request from [TSIF].
+ * @param[out] soTSIF_Data    Data to [TSIF].
+ * @param[out] soTSIF_Meta    Session Id to [TSIF].
+ * @param[in]  siTSIF_LsnReq  Listen port request from [TSIF].
+ * @param[out] soTSIF_LsnRep  Listen port reply to [TSIF].
+ *
+ * @details
+ *  Every short-message session notifies a message of 'cfg.msgLen' bytes every
+ *   'cBenchMixMsgPeriod' cycles, with the sessions evenly staggered over that
+ *   period. These notifications take precedence over the ones of the bulk
+ *   sessions which are otherwise kept 'cBenchMixBulkWindow' bytes ahead of
+ *   the bytes delivered to [TSIF] (.i.e, the Rx window of the TOE). The bulk
+ *   traffic stops once all the short messages were notified.
+ *******************************************************************************/
+void pBenchMixTOE(
+        int                      &nrErr,
+        const BenchMixCfg        &cfg,
+        unsigned int              startCyc,
+        vector<BenchSessStats>   &sessStats,
+        stream<TcpAppNotif>      &soTSIF_Notif,
+        stream<TcpAppRdReq>      &siTSIF_DReq,
+        stream<TcpAppData>       &soTSIF_Data,
+        stream<TcpAppMeta>       &soTSIF_Meta,
+        stream<TcpAppLsnReq>     &siTSIF_LsnReq,
+        stream<TcpAppLsnRep>     &soTSIF_LsnRep)
+{
+    static int  mix_bulkSess = 0;
+
+    pBenchToeServer(nrErr, cfg.dreqLat, false, sessStats,
+                    siTSIF_DReq, soTSIF_Data, soTSIF_Meta, siTSIF_LsnReq, soTSIF_LsnRep);
+
+    if ((gSimCycCnt < startCyc) or !soTSIF_Notif.empty()) {
+        return;
+    }
+
+    //------------------------------------------------------
+    //-- SHORT MESSAGES FIRST
+    //------------------------------------------------------
+    bool shortPending = false;
+    for (int i=0; i<cfg.nrShort; i++) {
+        SessionId       sessId = cfg.nrBulk + i;
+        BenchSessStats &stats  = sessStats[sessId];
+        if (stats.nrMsgs < cBenchMixNrMsgs) {
+            shortPending = true;
+            unsigned int dueCyc = startCyc + (i * cBenchMixMsgPeriod) / cfg.nrShort +
+                                  stats.nrMsgs * cBenchMixMsgPeriod;
+            if (dueCyc <= gSimCycCnt) {
+                soTSIF_Notif.write(TcpAppNotif(sessId, cfg.msgLen, DEFAULT_HOST_IP4_ADDR,
+                                               DEFAULT_HOST_TCP_SRC_PORT, ECHO_MODE_LSN_PORT));
+                stats.notifBytes += cfg.msgLen;
+                stats.msgs.push_back(BenchMsg(stats.notifBytes, gSimCycCnt));
+                stats.nrMsgs++;
+                return;
+            }
+        }
+    }
+
+    //------------------------------------------------------
+    //-- KEEP THE BULK SESSIONS BACKLOGGED
+    //------------------------------------------------------
+    if (shortPending and (cfg.nrBulk > 0)) {
+        mix_bulkSess = (mix_bulkSess + 1) % cfg.nrBulk;
+        BenchSessStats &stats = sessStats[mix_bulkSess];
+        if ((stats.notifBytes - stats.srvdBytes + cBenchMixBulkSegLen) <= cBenchMixBulkWindow) {
+            soTSIF_Notif.write(TcpAppNotif(mix_bulkSess, cBenchMixBulkSegLen, DEFAULT_HOST_IP4_ADDR,
+                                           DEFAULT_HOST_TCP_SRC_PORT, ECHO_MODE_LSN_PORT));
+            stats.notifBytes += cBenchMixBulkSegLen;
+        }
+    }
+}
+
+/*******************************************************************************
+ * @brief Emulate the Rx part of the TcpApplicationFlash (TAF).
+ *
+ * @param[in/out] sessStats    The per-session statistics.
+ * @param[in]  siTSIF_Data     Data stream from TcpShellInterface (TSIF).
+ * @param[in]  siTSIF_SessId   Session-id from [TSIF].
+ * @param[in]  siTSIF_DatLen   Data-length from [TSIF].
+ *
+ * @details
+ *  Always drains the incoming streams and accounts the received bytes on a
+ *   per-session basis. A message in flight is retired, and its latency is
+ *   recorded, when the byte counter of its session reaches its end. Every
+ *   message forwarded by [TSIF] must carry as many bytes as its data-length.
+ *******************************************************************************/
+void pBenchTAF(
+        vector<BenchSessStats>   &sessStats,
+        stream<TcpAppData>       &siTSIF_Data,
+        stream<TcpSessId>        &siTSIF_SessId,
+        stream<TcpDatLen>        &siTSIF_DatLen)
+{
+    const char *myName = concat3(THIS_NAME, "/", "TAF");
+
+    static deque<TcpSessId>  taf_sessIds;
+    static deque<TcpDatLen>  taf_datLens;
+    static unsigned int      taf_msgBytes = 0;
+
+    if (!siTSIF_SessId.empty()) {
+        taf_sessIds.push_back(siTSIF_SessId.read());
+    }
+    if (!siTSIF_DatLen.empty()) {
+        taf_datLens.push_back(siTSIF_DatLen.read());
+    }
+    if (!siTSIF_Data.empty() and !taf_sessIds.empty() and !taf_datLens.empty()) {
+        TcpAppData chunk = siTSIF_Data.read();
+        BenchSessStats &stats = sessStats[taf_sessIds.front()];
+        taf_msgBytes     += chunk.getLen();
+        stats.rcvdBytes  += chunk.getLen();
+        stats.rcvdChunks += 1;
+        while (!stats.msgs.empty() and (stats.msgs.front().endByte <= stats.rcvdBytes)) {
+            stats.latencies.push_back(gSimCycCnt - stats.msgs.front().injCyc);
+            stats.msgs.pop_front();
+        }
+        gRxLastCyc = gSimCycCnt;
+        if (chunk.getTLast()) {
+            if (taf_msgBytes != taf_datLens.front()) {
+                printError(myName, "Received a message of %d bytes with a data-length of %d bytes.\n",
+                           taf_msgBytes, taf_datLens.front().to_uint());
+                gTafLenErrs++;
+            }
+            gTafMsgs++;
+            taf_msgBytes = 0;
+            taf_sessIds.pop_front();
+            taf_datLens.pop_front();
+        }
+        if (DEBUG_LEVEL & TRACE_TAF) {
+            printAxisRaw(myName, "Received data chunk: ", chunk);
+        }
+    }
+}
+
+/*******************************************************************************
+ * @brief Compute the Jain's fairness index of a set of allocations.
+ *
+ * @param[in] alloc  The allocations (e.g. #bytes received per session).
+ *
+ * @return (sum(x))^2 / (n * sum(x^2)), which is 1.0 for a perfectly fair share.
+ *******************************************************************************/
+double jainIndex(const vector<double> &alloc) {
+    double sum=0, sumSq=0;
+    for (size_t i=0; i<alloc.size(); i++) {
+        sum   += alloc[i];
+        sumSq += alloc[i] * alloc[i];
+    }
+    return (sumSq == 0) ? 1.0 : (sum * sum) / (alloc.size() * sumSq);
+}
+
+/*******************************************************************************
+ * @brief Run one clock cycle of the design-under-test (DUT).
+ *
+ * @param[in/out] dut  The signal and stream interfaces of the DUT.
+ *******************************************************************************/
+void stepDut(BenchDutItf &dut) {
+    tcp_shell_if(
+            &dut.sMMIO_TSIF_Enable, dut.ssMMIO_TSIF_CfgCmd, dut.ssTSIF_MMIO_SinkStats,
+            dut.ssTAF_TSIF_Data, dut.ssTAF_TSIF_SessId, dut.ssTAF_TSIF_DatLen,
+            dut.ssTAF_TSIF_SockData, dut.ssTAF_TSIF_SockAddr, dut.ssTAF_TSIF_SockLen,
+            dut.ssTSIF_TAF_SockRep,
+            dut.ssTSIF_TAF_Data, dut.ssTSIF_TAF_SessId, dut.ssTSIF_TAF_DatLen,
+            dut.ssTOE_TSIF_Notif, dut.ssTSIF_TOE_DReq, dut.ssTOE_TSIF_Data, dut.ssTOE_TSIF_Meta,
+            dut.ssTSIF_TOE_LsnReq, dut.ssTOE_TSIF_LsnRep,
+            dut.ssTSIF_TOE_Data, dut.ssTSIF_TOE_SndReq, dut.ssTOE_TSIF_SndRep,
+            dut.ssTSIF_TOE_OpnReq, dut.ssTOE_TSIF_OpnRep,
+            dut.ssTSIF_TOE_ClsReq,
+            dut.ssTSIF_DBG_SinkCnt, dut.ssTSIF_DBG_InpBufSpace, dut.ssTSIF_DBG_OpnEvent,
+            dut.ssTSIF_DBG_IpfReport);
+
+    //-- Poll the aggregated sink statistics whenever the MMIO command queue is idle
+    if (dut.ssMMIO_TSIF_CfgCmd.empty()) {
+        dut.ssMMIO_TSIF_CfgCmd.write(MmioCfgCmd(CFG_SINK_STATS, cSinkStatsAll, 0));
+    }
+    while (!dut.ssTSIF_MMIO_SinkStats.empty()) {
+        SinkStats stats = dut.ssTSIF_MMIO_SinkStats.read();
+        if (stats.bytes != gSinkCnt) {
+            gSinkCnt   = stats.bytes.to_uint64();
+            gRxLastCyc = gSimCycCnt;
+        }
+    }
+
+    //-- Drain the debug probes
+    while (!dut.ssTSIF_DBG_SinkCnt.empty())     { dut.ssTSIF_DBG_SinkCnt.read(); }
+    while (!dut.ssTSIF_DBG_InpBufSpace.empty()) { dut.ssTSIF_DBG_InpBufSpace.read(); }
+    while (!dut.ssTSIF_DBG_OpnEvent.empty())    { dut.ssTSIF_DBG_OpnEvent.read(); }
+    while (!dut.ssTSIF_DBG_IpfReport.empty())   { gIpfReports.push_back(dut.ssTSIF_DBG_IpfReport.read()); }
+}
+
+/*******************************************************************************
+ * @brief Return the name of the Rx scheduling policy [TSIF] was compiled with.
+ *******************************************************************************/
+const char *benchPolicyName() {
+    switch (TSIF_RX_POLICY) {
+    case RX_POLICY_FIFO: return "FIFO";
+    case RX_POLICY_RR:   return "RR";
+    case RX_POLICY_DRR:  return "DRR";
+    case RX_POLICY_SPF:  return "SPF";
+    default:             return "???";
+    }
+}
+
+/*******************************************************************************
+ * @brief Compute the latency statistics of the messages received by a range of
+ *  sessions.
+ *
+ * @param[in]  sessStats  The per-session statistics.
+ * @param[in]  firstSess  The first session of the range.
+ * @param[in]  endSess    The session following the last one of the range.
+ * @param[out] res        The 'nrMsgs', 'avgLat', 'p99Lat' and 'maxLat' results.
+ *******************************************************************************/
+void benchSegLatency(
+        const vector<BenchSessStats> &sessStats,
+        int                           firstSess,
+        int                           endSess,
+        BenchMixResult               &res)
+{
+    vector<unsigned int> lat;
+    for (int s=firstSess; s<endSess; s++) {
+        lat.insert(lat.end(), sessStats[s].latencies.begin(), sessStats[s].latencies.end());
+    }
+    sort(lat.begin(), lat.end());
+    res.nrMsgs = lat.size();
+    if (res.nrMsgs) {
+        double sum = 0;
+        for (size_t i=0; i<lat.size(); i++) {
+            sum += lat[i];
+        }
+        res.avgLat = sum / lat.size();
+        res.p99Lat = lat[(lat.size() * 99 + 99) / 100 - 1];
+        res.maxLat = lat.back();
+    }
+}
+
+/*******************************************************************************
+ * @brief Run the mixed bulk and short-message traffic through the DUT with a
+ *  given Rx quantum.
+ *
+ * @param[in/out] nrErr    A ref to the error counter of the main testbench.
+ * @param[in/out] dut      The signal and stream interfaces of the DUT.
+ * @param[in]     cfg      The configuration of the mixed benchmark.
+ * @param[in]     quantum  The Rx quantum to program into every session (0=off).
+ * @param[out]    res      The latency and throughput results.
+ *
+ * @details
+ *  The quantum is programmed via the MMIO configuration interface of [TSIF]
+ *   before the traffic starts. The latency of a short message is measured from
+ *   the cycle of its notification to the cycle its last byte reaches [TAF].
+ *******************************************************************************/
+void benchMixPhase(
+        int                &nrErr,
+        BenchDutItf        &dut,
+        const BenchMixCfg  &cfg,
+        int                 quantum,
+        BenchMixResult     &res)
+{
+    const int nrSess = cfg.nrBulk + cfg.nrShort;
+    vector<BenchSessStats> sessStats(cMaxSessions);
+
+    //-- Program the quantum of every session
+    for (int s=0; s<nrSess; s++) {
+        dut.ssMMIO_TSIF_CfgCmd.write(MmioCfgCmd(CFG_RX_QUANTUM, s, quantum));
+    }
+
+    unsigned int startCyc = gSimCycCnt + nrSess + cGraceTime;
+    if (startCyc < (unsigned)cSimToeStartupDelay) {
+        startCyc = cSimToeStartupDelay;
+    }
+    unsigned int maxCyc = startCyc + (cBenchMixNrMsgs + 16) * cBenchMixMsgPeriod + cGraceTime;
+    unsigned long notified, received;
+    do {
+        pBenchMixTOE(nrErr, cfg, startCyc, sessStats,
+                dut.ssTOE_TSIF_Notif, dut.ssTSIF_TOE_DReq, dut.ssTOE_TSIF_Data, dut.ssTOE_TSIF_Meta,
+                dut.ssTSIF_TOE_LsnReq, dut.ssTOE_TSIF_LsnRep);
+        stepDut(dut);
+        pBenchTAF(sessStats, dut.ssTSIF_TAF_Data, dut.ssTSIF_TAF_SessId, dut.ssTSIF_TAF_DatLen);
+        stepSim();
+        notified = received = 0;
+        for (int s=0; s<nrSess; s++) {
+            notified += sessStats[s].notifBytes;
+            received += sessStats[s].rcvdBytes;
+        }
+    } while (((gSimCycCnt <= startCyc) or (received < notified) or
+              (sessStats[nrSess-1].nrMsgs < cBenchMixNrMsgs)) and
+             (gSimCycCnt < maxCyc) and (!gFatalError) and (nrErr < 10));
+
+    if (received != notified) {
+        printError(THIS_NAME, "Only %ld out of %ld notified bytes were forwarded to [TAF] (quantum=%d).\n",
+                   received, notified, quantum);
+        nrErr++;
+    }
+
+    //-- Latency of the short messages
+    benchSegLatency(sessStats, cfg.nrBulk, nrSess, res);
+    //-- Goodput of the bulk sessions
+    unsigned long bulkBytes = 0;
+    for (int s=0; s<cfg.nrBulk; s++) {
+        bulkBytes += sessStats[s].rcvdBytes;
+    }
+    res.bulkRate = (double)bulkBytes / (gRxLastCyc - startCyc + 1);
+}
+
+/*******************************************************************************
+ * @brief Benchmark the round-robin arbiter of the RxHandler for a given number
+ *  of sessions against a linear-scan reference model.
+ *
+ * @param[in/out] nrErr  A ref to the error counter of the main testbench.
+ *
+ * @details
+ *  The arbiter is exercised with random request vectors of increasing density
+ *   and every grant is compared with the one of the reference model. The
+ *   fairness is assessed by keeping all the requests of a random subset of
+ *   sessions asserted and by checking that each of them gets exactly one
+ *   grant per round.
+ *******************************************************************************/
+template<int N>
+void benchArbiter(int &nrErr) {
+    const char *myName = concat3(THIS_NAME, "/", "ARB");
+    const int   cNrGrants = 16 * N;
+
+    ap_uint<log2Ceil<N>::val> lastGrant = N-1;
+    ap_uint<log2Ceil<N>::val> nextGrant;
+    int mismatches = 0;
+    int unfairRounds = 0;
+
+    for (int density=1; density<=4; density++) {
+        ap_uint<N>  reqVec;
+        vector<int> nrGrants(N, 0);
+        int         nrReq = 0;
+        for (int i=0; i<N; i++) {
+            reqVec[i] = ((random() % 4) < density) ? 1 : 0;
+            nrReq += reqVec[i] ? 1 : 0;
+        }
+        for (int g=0; g<cNrGrants; g++) {
+            //-- Reference model: linear scan starting right after the last grant
+            int refGrant = -1;
+            for (int i=1; i<=N; i++) {
+                if (reqVec[(lastGrant.to_uint() + i) % N]) {
+                    refGrant = (lastGrant.to_uint() + i) % N;
+                    break;
+                }
+            }
+            bool granted = rrArbiter<N>(reqVec, lastGrant, nextGrant);
+            if ((granted != (refGrant >= 0)) or (granted and (nextGrant != refGrant))) {
+                mismatches++;
+            }
+            if (granted) {
+                lastGrant = nextGrant;
+                nrGrants[nextGrant.to_uint()]++;
+            }
+        }
+        //-- Every requester must have received the same number of grants (+/-1)
+        int minG = cNrGrants, maxG = 0;
+        for (int i=0; i<N; i++) {
+            if (reqVec[i]) {
+                minG = (nrGrants[i] < minG) ? nrGrants[i] : minG;
+                maxG = (nrGrants[i] > maxG) ? nrGrants[i] : maxG;
+            }
+        }
+        if (nrReq and ((maxG - minG) > 1)) {
+            unfairRounds++;
+        }
+    }
+    //-- Sparse and toggling requests
+    for (int g=0; g<cNrGrants; g++) {
+        ap_uint<N> reqVec;
+        for (int k=0; k<3; k++) {
+            reqVec[random() % N] = 1;
+        }
+        int refGrant = -1;
+        for (int i=1; i<=N; i++) {
+            if (reqVec[(lastGrant.to_uint() + i) % N]) {
+                refGrant = (lastGrant.to_uint() + i) % N;
+                break;
+            }
+        }
+        if (!rrArbiter<N>(reqVec, lastGrant, nextGrant) or (nextGrant != refGrant)) {
+            mismatches++;
+        }
+        lastGrant = nextGrant;
+    }
+
+    printInfo(myName, "N=%4d : %d grant mismatch(es) - %d unfair round(s) - logic depth = %d levels.\n",
+              N, mismatches, unfairRounds, log2Ceil<N>::val);
+    if (mismatches or unfairRounds) {
+        nrErr++;
+    }
+}
+
+/*******************************************************************************
+ * @brief Benchmark the latency of short messages mixed with bulk traffic, with
+ *  and without a deficit round-robin quantum.
+ *
+ * @param[in/out] nrErr  A ref to the error counter of the main testbench.
+ * @param[in]     cfg    The configuration of the mixed benchmark.
+ *
+ * @details
+ *  The same traffic is run twice through the same DUT; first with the quantum
+ *   of every session set to zero (.i.e, DRR disabled), and then with the
+ *   quantum set to 'cfg.quantum'. The benchmark fails if a short message gets
+ *   lost or if the DRR mode does not reduce the 99th percentile latency of the
+ *   short messages.
+ *******************************************************************************/
+void benchMix(int &nrErr, const BenchMixCfg &cfg) {
+    BenchDutItf    dut;
+    BenchMixResult resOff, resDrr;
+
+    printInfo(THIS_NAME, "\tnrShort=%d - nrBulk=%d - quantum=%d - msgLen=%d - dreqLat=%d\n",
+              cfg.nrShort, cfg.nrBulk, cfg.quantum, cfg.msgLen, cfg.dreqLat);
+
+    benchMixPhase(nrErr, dut, cfg, 0,           resOff);
+    benchMixPhase(nrErr, dut, cfg, cfg.quantum, resDrr);
+
+    printInfo(THIS_NAME, "--------------------------------------------------------------\n");
+    printInfo(THIS_NAME, "Short-message latency (in cycles) and bulk goodput (in bytes/cycle):\n");
+    printInfo(THIS_NAME, "\t%-12s : nrMsgs=%4d - avg=%7.1f - p99=%5d - max=%5d - bulk=%.3f\n",
+              "quantum=off", resOff.nrMsgs, resOff.avgLat, resOff.p99Lat, resOff.maxLat, resOff.bulkRate);
+    printInfo(THIS_NAME, "\tquantum=%-4d : nrMsgs=%4d - avg=%7.1f - p99=%5d - max=%5d - bulk=%.3f\n",
+              cfg.quantum, resDrr.nrMsgs, resDrr.avgLat, resDrr.p99Lat, resDrr.maxLat, resDrr.bulkRate);
+    printInfo(THIS_NAME, "--------------------------------------------------------------\n");
+
+    unsigned int expMsgs = cfg.nrShort * cBenchMixNrMsgs;
+    if ((resOff.nrMsgs != expMsgs) or (resDrr.nrMsgs != expMsgs)) {
+        printError(THIS_NAME, "Some short messages were not received (expected %d).\n", expMsgs);
+        nrErr++;
+    }
+    if ((cfg.nrBulk > 0) and (resDrr.p99Lat >= resOff.p99Lat)) {
+        printError(THIS_NAME, "The DRR mode did not reduce the p99 latency of the short messages.\n");
+        nrErr++;
+    }
+}
+
+/*******************************************************************************
+ * @brief Emulate the TOE for the Tx traffic generator of [TSIF].
+ *
+ * @param[in/out] nrErr       A ref to the error counter of the main testbench.
+ * @param[in]     cfg         The configuration of the generator benchmark.
+ * @param[in]     genConst    The constant word programmed into the generator.
+ * @param[in/out] genStats    The per-transfer statistics.
+ * @param[out] soTSIF_Notif   Notification to TcpShellInterface (TSIF).
+ * @param[in]  siTSIF_DReq    Data read request from [TSIF].
+ * @param[out] soTSIF_Data    Data to [TSIF].
+ * @param[out] soTSIF_Meta    Session Id to [TSIF].
+ * @param[in]  siTSIF_LsnReq  Listen port request from [TSIF].
+ * @param[out] soTSIF_LsnRep  Listen port reply to [TSIF].
+ * @param[in]  siTSIF_OpnReq  Open connection request from [TSIF].
+ * @param[out] soTSIF_OpnRep  Open connection reply to [TSIF].
+ * @param[in]  siTSIF_SndReq  Request to send from [TSIF].
+ * @param[out] soTSIF_SndRep  Send reply to [TSIF].
+ * @param[in]  siTSIF_TxData  Tx data from [TSIF].
+ *
+ * @details
+ *  Every Rx session notifies one 8801 command which requests 'cfg.nrBytes' to
+ *   be sent to the remote socket {DEFAULT_HOST_IP4_ADDR, cBenchGenPortBase+s}
+ *   (in the extended format of 'TxTestReq' if required by 'cfg').
+ *   Every open request is granted with session id 'cBenchGenSessBase+s' and
+ *   every request to send is granted right away, as if the TOE was draining its
+ *   Tx buffers at line rate. The Tx data are consumed at one chunk per cycle.
+ *   Every segment must match the length of its request to send, and every
+ *   chunk must match the pattern programmed into the generator.
+ *******************************************************************************/
+void pBenchGenTOE(
+        int                      &nrErr,
+        const BenchGenCfg        &cfg,
+        ap_uint<64>               genConst,
+        vector<BenchGenStats>    &genStats,
+        stream<TcpAppNotif>      &soTSIF_Notif,
+        stream<TcpAppRdReq>      &siTSIF_DReq,
+        stream<TcpAppData>       &soTSIF_Data,
+        stream<TcpAppMeta>       &soTSIF_Meta,
+        stream<TcpAppLsnReq>     &siTSIF_LsnReq,
+        stream<TcpAppLsnRep>     &soTSIF_LsnRep,
+        stream<TcpAppOpnReq>     &siTSIF_OpnReq,
+        stream<TcpAppOpnRep>     &soTSIF_OpnRep,
+        stream<TcpAppSndReq>     &siTSIF_SndReq,
+        stream<TcpAppSndRep>     &soTSIF_SndRep,
+        stream<TcpAppData>       &siTSIF_TxData)
+{
+    const char *myName = concat3(THIS_NAME, "/", "TOE");
+
+    //-- STATIC VARIABLES ------------------------------------------------------
+    static deque<TcpAppRdReq>  toe_dReqQueue;
+    static deque<TcpAppSndReq> toe_sndReqQueue;
+
+    //------------------------------------------------------
+    //-- LISTEN AND OPEN REQUESTS ARE ALWAYS GRANTED
+    //------------------------------------------------------
+    if (!siTSIF_LsnReq.empty()) {
+        siTSIF_LsnReq.read();
+        soTSIF_LsnRep.write(TcpAppLsnRep(NTS_OK));
+    }
+    if (!siTSIF_OpnReq.empty()) {
+        TcpAppOpnReq opnReq = siTSIF_OpnReq.read();
+        int s = opnReq.port.to_int() - cBenchGenPortBase;
+        if ((s < 0) or (s >= cfg.nrSess)) {
+            printError(myName, "Received an open request for an unexpected port (%d).\n", opnReq.port.to_int());
+            nrErr++;
+        }
+        soTSIF_OpnRep.write(TcpAppOpnRep(cBenchGenSessBase + s, ESTABLISHED));
+    }
+
+    //------------------------------------------------------
+    //-- INJECT THE 8801 COMMANDS AND SERVE THEIR DATA REQUESTS
+    //------------------------------------------------------
+    if ((gSimCycCnt >= (unsigned)cSimToeStartupDelay) and
+        (gNotifSent < (unsigned)cfg.nrSess) and soTSIF_Notif.empty()) {
+        soTSIF_Notif.write(TcpAppNotif(gNotifSent, (cfg.isExtended()) ? 16 : 8, DEFAULT_HOST_IP4_ADDR,
+                                       DEFAULT_HOST_TCP_SRC_PORT, XMIT_MODE_LSN_PORT));
+        gNotifSent++;
+    }
+    if (!siTSIF_DReq.empty()) {
+        toe_dReqQueue.push_back(siTSIF_DReq.read());
+    }
+    if (!toe_dReqQueue.empty()) {
+        SessionId  sessId = toe_dReqQueue.front().sessionID;
+        TcpAppData cmd(0, 0, 0);
+        toe_dReqQueue.pop_front();
+        cmd.setLE_TData(byteSwap32(DEFAULT_HOST_IP4_ADDR), 31, 0);
+        cmd.setLE_TData(byteSwap16(cBenchGenPortBase + sessId), 47, 32);
+        cmd.setLE_TData(byteSwap16((cfg.isExtended()) ? 0 : cfg.nrBytes), 63, 48);
+        cmd.setLE_TKeep(0xFF);
+        cmd.setLE_TLast((cfg.isExtended()) ? 0 : TLAST);
+        soTSIF_Meta.write(sessId);
+        soTSIF_Data.write(cmd);
+        if (cfg.isExtended()) {
+            TcpAppData ext(0, 0, 0);
+            ext.setLE_TData(byteSwap32(cfg.nrBytes >> 16),    31, 0);
+            ext.setLE_TData(byteSwap16(cfg.nrBytes & 0xFFFF), 47, 32);
+            ext.setLE_TData(byteSwap16(cfg.repeat), 63, 48);
+            ext.setLE_TKeep(0xFF);
+            ext.setLE_TLast(TLAST);
+            soTSIF_Data.write(ext);
+        }
+    }
+
+    //------------------------------------------------------
+    //-- GRANT THE REQUESTS TO SEND
+    //------------------------------------------------------
+    if (!siTSIF_SndReq.empty()) {
+        TcpAppSndReq sndReq = siTSIF_SndReq.read();
+        toe_sndReqQueue.push_back(sndReq);
+        soTSIF_SndRep.write(TcpAppSndRep(sndReq.sessId, sndReq.length, 0xFFFF, NO_ERROR));
+    }
+
+    //------------------------------------------------------
+    //-- CONSUME AND CHECK THE TX DATA
+    //------------------------------------------------------
+    if (!siTSIF_TxData.empty()) {
+        TcpAppData chunk = siTSIF_TxData.read();
+        if (toe_sndReqQueue.empty()) {
+            printError(myName, "Received Tx data without a request to send.\n");
+            nrErr++;
+            return;
+        }
+        TcpAppSndReq   &sndReq = toe_sndReqQueue.front();
+        int             s      = sndReq.sessId.to_int() - cBenchGenSessBase;
+        BenchGenStats  &stats  = genStats[s];
+        if (stats.chunkIdx == 0) {
+            stats.prbs = ap_uint<64>(GEN_PRBS_SEED) ^ sndReq.sessId;
+            if (gGenFirstCyc == 0) {
+                gGenFirstCyc = gSimCycCnt;
+            }
+        }
+        ap_uint<64> word;
+        switch (cfg.pattern) {
+        case GEN_PAT_INCR:  word = stats.chunkIdx; break;
+        case GEN_PAT_PRBS:  word = stats.prbs;     break;
+        case GEN_PAT_CONST: word = genConst;       break;
+        default:            word = (stats.chunkIdx & 1) ? GEN_CHK1 : GEN_CHK0; break;
+        }
+        if (cfg.stamp and (stats.segBytes == 0)) {
+            word = stats.segIdx;
+        }
+        bool isStamp = cfg.stamp and (stats.segBytes == (ARW/8));
+        TcpAppData expChunk(0, chunk.getLE_TKeep(), 0);
+        expChunk.setTData(word);
+        expChunk.clearUnusedBytes();
+        if (isStamp) {
+            //-- The timestamp must be the cycle at which the chunk was generated (unless truncated)
+            if ((chunk.getLen() == (ARW/8)) and
+                ((chunk.getTData() > gSimCycCnt) or (chunk.getTData() + 16 < gSimCycCnt))) {
+                printError(myName, "Transfer #%d: Segment #%ld carries an unexpected timestamp (%ld).\n",
+                           s, stats.segIdx, (unsigned long)chunk.getTData());
+                nrErr++;
+            }
+        }
+        else if (chunk.getLE_TData() != expChunk.getLE_TData()) {
+            printError(myName, "Transfer #%d: Chunk #%ld does not match the generator pattern.\n",
+                       s, stats.chunkIdx);
+            printAxisRaw(myName, "\tReceived: ", chunk);
+            printAxisRaw(myName, "\tExpected: ", expChunk);
+            nrErr++;
+        }
+        stats.prbs       = prbsNext(stats.prbs);
+        stats.chunkIdx  += 1;
+        stats.segBytes  += chunk.getLen();
+        stats.rcvdBytes += chunk.getLen();
+        gGenLastCyc = gSimCycCnt;
+        if (chunk.getTLast()) {
+            if (stats.segBytes != sndReq.length) {
+                printError(myName, "Transfer #%d: Segment #%ld is %ld bytes long instead of %d.\n",
+                           s, stats.segIdx, stats.segBytes, sndReq.length.to_int());
+                nrErr++;
+            }
+            stats.segIdx  += 1;
+            stats.segBytes = 0;
+            toe_sndReqQueue.pop_front();
+        }
+        if (DEBUG_LEVEL & TRACE_TOE) {
+            printAxisRaw(myName, "Received Tx data chunk: ", chunk);
+        }
+    }
+}
+
+/*******************************************************************************
+ * @brief Benchmark the Tx traffic generator of [TSIF].
+ *
+ * @param[in/out] nrErr  A ref to the error counter of the main testbench.
+ * @param[in]     cfg    The configuration of the generator benchmark.
+ *
+ * @details
+ *  The generator is programmed via the MMIO configuration interface of [TSIF]
+ *   before the 8801 commands are injected. The benchmark fails if a transfer
+ *   is not completed, if the payload does not match the programmed pattern,
+ *   or if the aggregated Tx rate is below 'cBenchGenMinRate' of the line rate
+ *   (unlimited generator) or deviates by more than 'cBenchGenRateTol' from the
+ *   programmed rate (rate-limited generator).
+ *******************************************************************************/
+void benchGen(int &nrErr, const BenchGenCfg &cfg) {
+    const ap_uint<64> genConst = 0x0123456789ABCDEF;
+
+    BenchDutItf           dut;
+    vector<BenchGenStats> genStats(cfg.nrSess);
+
+    dut.ssMMIO_TSIF_CfgCmd.write(MmioCfgCmd(CFG_TX_GEN, GEN_CFG_PATTERN,
+                                 (cfg.stamp ? 0x100 : 0) | cfg.pattern));
+    dut.ssMMIO_TSIF_CfgCmd.write(MmioCfgCmd(CFG_TX_GEN, GEN_CFG_CONST_LO, genConst(31, 0)));
+    dut.ssMMIO_TSIF_CfgCmd.write(MmioCfgCmd(CFG_TX_GEN, GEN_CFG_CONST_HI, genConst(63,32)));
+    dut.ssMMIO_TSIF_CfgCmd.write(MmioCfgCmd(CFG_TX_GEN, GEN_CFG_RATE, cfg.rate));
+    if (cfg.segLen) {
+        dut.ssMMIO_TSIF_CfgCmd.write(MmioCfgCmd(CFG_TX_SEG_LEN, 0, cfg.segLen));
+    }
+
+    unsigned long totalBytes = (unsigned long)cfg.nrSess * cfg.nrBytes * ((cfg.repeat) ? cfg.repeat : 1);
+    double        expRate    = (cfg.rate) ? (cfg.rate / 256.0) : (double)(ARW/8);
+    gMaxSimCycles += (unsigned int)(totalBytes / expRate) * 2;
+
+    unsigned long totalRcvd;
+    do {
+        pBenchGenTOE(nrErr, cfg, genConst, genStats,
+                dut.ssTOE_TSIF_Notif, dut.ssTSIF_TOE_DReq, dut.ssTOE_TSIF_Data, dut.ssTOE_TSIF_Meta,
+                dut.ssTSIF_TOE_LsnReq, dut.ssTOE_TSIF_LsnRep,
+                dut.ssTSIF_TOE_OpnReq, dut.ssTOE_TSIF_OpnRep,
+                dut.ssTSIF_TOE_SndReq, dut.ssTOE_TSIF_SndRep, dut.ssTSIF_TOE_Data);
+        stepDut(dut);
+        stepSim();
+        totalRcvd = 0;
+        for (int s=0; s<cfg.nrSess; s++) {
+            totalRcvd += genStats[s].rcvdBytes;
+        }
+    } while ((totalRcvd < totalBytes) and (gSimCycCnt < gMaxSimCycles) and
+             (!gFatalError) and (nrErr < 10));
+
+    //---------------------------------------------------------------
+    //-- REPORT AND ASSESS THE RESULTS
+    //---------------------------------------------------------------
+    unsigned int txCycles = gGenLastCyc - gGenFirstCyc + 1;
+    double       txRate   = (double)totalRcvd / txCycles;
+    printInfo(THIS_NAME, "--------------------------------------------------------------\n");
+    printInfo(THIS_NAME, "Tx throughput : %ld bytes in %d cycles (%.3f bytes/cycle = %5.1f%% of line rate).\n",
+              totalRcvd, txCycles, txRate, 100.0 * txRate / (ARW/8));
+    for (int s=0; s<cfg.nrSess; s++) {
+        printInfo(THIS_NAME, "\tTransfer #%2d : received=%8ld bytes in %ld segments.\n",
+                  s, genStats[s].rcvdBytes, genStats[s].segIdx);
+    }
+    printInfo(THIS_NAME, "--------------------------------------------------------------\n");
+    if (totalRcvd != totalBytes) {
+        printError(THIS_NAME, "Only %ld out of %ld requested bytes were transmitted.\n",
+                   totalRcvd, totalBytes);
+        nrErr++;
+    }
+    if ((cfg.rate == 0) and (txRate < cBenchGenMinRate * (ARW/8))) {
+        printError(THIS_NAME, "The Tx generator did not run at line rate (%.3f bytes/cycle).\n", txRate);
+        nrErr++;
+    }
+    if ((cfg.rate != 0) and ((txRate < expRate * (1 - cBenchGenRateTol)) or
+                             (txRate > expRate * (1 + cBenchGenRateTol)))) {
+        printError(THIS_NAME, "The Tx generator did not run at its programmed rate (%.3f instead of %.3f bytes/cycle).\n",
+                   txRate, expRate);
+        nrErr++;
+    }
+}
+
+/*******************************************************************************
+ * @brief Emulate the TOE for the iperf server of [TSIF].
+ *
+ * @param[in/out] nrErr       A ref to the error counter of the main testbench.
+ * @param[in/out] ipfSess     The sessions of the iperf clients.
+ * @param[out] soTSIF_Notif   Notification to TcpShellInterface (TSIF).
+ * @param[in]  siTSIF_DReq    Data read request from [TSIF].
+ * @param[out] soTSIF_Data    Data to [TSIF].
+ * @param[out] soTSIF_Meta    Session Id to [TSIF].
+ * @param[in]  siTSIF_LsnReq  Listen port request from [TSIF].
+ * @param[out] soTSIF_LsnRep  Listen port reply to [TSIF].
+ * @param[in]  siTSIF_SndReq  Request to send from [TSIF].
+ * @param[out] soTSIF_SndRep  Send reply to [TSIF].
+ * @param[in]  siTSIF_TxData  Tx data from [TSIF].
+ *
+ * @details
+ *  The bytes queued by the iperf clients are notified in a round-robin fashion
+ *   with up to 'cBenchIpfNotifLen' bytes per notification, and are served upon
+ *   the data requests of [TSIF] at a rate of one chunk per cycle. Every request
+ *   to send is granted right away and the Tx data are appended to the received
+ *   bytes of their session.
+ *******************************************************************************/
+void pBenchIperfTOE(
+        int                      &nrErr,
+        vector<BenchIpfSess>     &ipfSess,
+        stream<TcpAppNotif>      &soTSIF_Notif,
+        stream<TcpAppRdReq>      &siTSIF_DReq,
+        stream<TcpAppData>       &soTSIF_Data,
+        stream<TcpAppMeta>       &soTSIF_Meta,
+        stream<TcpAppLsnReq>     &siTSIF_LsnReq,
+        stream<TcpAppLsnRep>     &soTSIF_LsnRep,
+        stream<TcpAppSndReq>     &siTSIF_SndReq,
+        stream<TcpAppSndRep>     &soTSIF_SndRep,
+        stream<TcpAppData>       &siTSIF_TxData)
+{
+    const char *myName = concat3(THIS_NAME, "/", "TOE");
+
+    //-- STATIC VARIABLES ------------------------------------------------------
+    static deque<TcpAppRdReq>  toe_dReqQueue;
+    static deque<TcpAppSndReq> toe_sndReqQueue;
+    static bool                toe_isStreaming = false;
+    static SessionId           toe_currSess;
+    static unsigned int        toe_bytesLeft;
+    static unsigned int        toe_nextSess = 0;
+
+    //------------------------------------------------------
+    //-- LISTEN REQUESTS ARE ALWAYS GRANTED
+    //------------------------------------------------------
+    if (!siTSIF_LsnReq.empty()) {
+        siTSIF_LsnReq.read();
+        soTSIF_LsnRep.write(TcpAppLsnRep(NTS_OK));
+    }
+
+    //------------------------------------------------------
+    //-- NOTIFY THE QUEUED BYTES (round-robin over the sessions)
+    //------------------------------------------------------
+    if ((gSimCycCnt >= (unsigned)cSimToeStartupDelay) and soTSIF_Notif.empty()) {
+        for (size_t n=0; n<ipfSess.size(); n++) {
+            unsigned int  s    = (toe_nextSess + n) % ipfSess.size();
+            BenchIpfSess &sess = ipfSess[s];
+            unsigned long room = cBenchToeRxBufBytes - sess.notified.size();
+            unsigned long len  = min(min((unsigned long)sess.toNotify.size(), room),
+                                     (unsigned long)cBenchIpfNotifLen);
+            if (len) {
+                for (unsigned long i=0; i<len; i++) {
+                    sess.notified.push_back(sess.toNotify.front());
+                    sess.toNotify.pop_front();
+                }
+                soTSIF_Notif.write(TcpAppNotif(s, len, DEFAULT_HOST_IP4_ADDR,
+                                               DEFAULT_HOST_TCP_SRC_PORT + s, sess.dstPort));
+                toe_nextSess = s + 1;
+                break;
+            }
+        }
+    }
+
+    //------------------------------------------------------
+    //-- SERVE THE DATA REQUESTS (one chunk per cycle)
+    //------------------------------------------------------
+    if (!siTSIF_DReq.empty()) {
+        TcpAppRdReq   dReq = siTSIF_DReq.read();
+        BenchIpfSess &sess = ipfSess[dReq.sessionID];
+        if ((dReq.length == 0) or
+            ((sess.reqBytes + dReq.length) > sess.notified.size())) {
+            printError(myName, "DReq(SessId=%d, Len=%d) exceeds the #bytes notified for this session (%ld).\n",
+                       dReq.sessionID.to_uint(), dReq.length.to_uint(),
+                       (unsigned long)sess.notified.size() - sess.reqBytes);
+            nrErr++;
+            return;
+        }
+        sess.reqBytes += dReq.length;
+        toe_dReqQueue.push_back(dReq);
+    }
+    if (!toe_isStreaming and !toe_dReqQueue.empty()) {
+        toe_currSess  = toe_dReqQueue.front().sessionID;
+        toe_bytesLeft = toe_dReqQueue.front().length;
+        toe_dReqQueue.pop_front();
+        soTSIF_Meta.write(toe_currSess);
+        toe_isStreaming = true;
+    }
+    if (toe_isStreaming) {
+        BenchIpfSess &sess = ipfSess[toe_currSess];
+        TcpAppData chunk(0, 0, 0);
+        int chunkLen = (toe_bytesLeft > (ARW/8)) ? (ARW/8) : toe_bytesLeft;
+        for (int i=0; i<chunkLen; i++) {
+            chunk.setLE_TData(sess.notified.front(), (i*8)+7, (i*8)+0);
+            sess.notified.pop_front();
+        }
+        chunk.setLE_TKeep(lenToLE_tKeep(chunkLen));
+        sess.reqBytes -= chunkLen;
+        toe_bytesLeft -= chunkLen;
+        chunk.setLE_TLast((toe_bytesLeft == 0) ? TLAST : 0);
+        soTSIF_Data.write(chunk);
+        if (toe_currSess != cBenchIpfCtrlSess) {
+            if (gIpfFirstCyc == 0) {
+                gIpfFirstCyc = gSimCycCnt;
+            }
+            gIpfLastCyc = gSimCycCnt;
+        }
+        if (toe_bytesLeft == 0) {
+            toe_isStreaming = false;
+        }
+    }
+
+    //------------------------------------------------------
+    //-- GRANT THE REQUESTS TO SEND AND COLLECT THE TX DATA
+    //------------------------------------------------------
+    if (!siTSIF_SndReq.empty()) {
+        TcpAppSndReq sndReq = siTSIF_SndReq.read();
+        toe_sndReqQueue.push_back(sndReq);
+        soTSIF_SndRep.write(TcpAppSndRep(sndReq.sessId, sndReq.length, 0xFFFF, NO_ERROR));
+    }
+    if (!siTSIF_TxData.empty()) {
+        TcpAppData chunk = siTSIF_TxData.read();
+        if (toe_sndReqQueue.empty()) {
+            printError(myName, "Received Tx data without a request to send.\n");
+            nrErr++;
+            return;
+        }
+        SessionId sessId = toe_sndReqQueue.front().sessId;
+        for (int i=0; i<chunk.getLen(); i++) {
+            ipfSess[sessId].rcvd += (char)chunk.getLE_TData((i*8)+7, (i*8)+0).to_uint();
+        }
+        if (chunk.getTLast()) {
+            toe_sndReqQueue.pop_front();
+        }
+        if (DEBUG_LEVEL & TRACE_TOE) {
+            printAxisRaw(myName, "Received Tx data chunk: ", chunk);
+        }
+    }
+}
+
+/*******************************************************************************
+ * @brief Queue a string of bytes on the session of an iperf client.
+ *
+ * @param[in/out] sess  The session of the iperf client.
+ * @param[in]     str   The bytes to queue.
+ *******************************************************************************/
+void benchIpfSend(BenchIpfSess &sess, const string &str) {
+    sess.toNotify.insert(sess.toNotify.end(), str.begin(), str.end());
+}
+
+/*******************************************************************************
+ * @brief Benchmark the iperf server of [TSIF].
+ *
+ * @param[in/out] nrErr  A ref to the error counter of the main testbench.
+ * @param[in]     cfg    The configuration of the iperf benchmark.
+ *
+ * @details
+ *  Session #0 is the control channel of an iperf3 client, sessions [1:nrStreams]
+ *   are its data streams and the last session is an iperf2 client. The iperf3
+ *   client walks through the states of the protocol and checks the answers of
+ *   the server, while the iperf2 client sends its bytes concurrently with the
+ *   test. The benchmark fails if the results of the server do not list every
+ *   stream with its number of bytes, if the reports of a session do not add up
+ *   to its number of bytes, if a session is not released, or if the aggregated
+ *   goodput is below 'cBenchIpfMinRate' of the line rate.
+ *******************************************************************************/
+void benchIperf(int &nrErr, const BenchIpfCfg &cfg) {
+    const string cookie = string("tsifbenchtsifbenchtsifbenchtsifbench") + '\0';
+
+    BenchDutItf          dut;
+    vector<BenchIpfSess> ipfSess;
+    int                  nrSess  = cfg.nrStreams + 2;
+    int                  ipf2    = nrSess - 1;
+
+    for (int s=0; s<nrSess; s++) {
+        ipfSess.push_back(BenchIpfSess((s == ipf2) ? IPERF_LSN_PORT : IPREF3_LSN_PORT));
+    }
+
+    unsigned long totalBytes = (unsigned long)(cfg.nrStreams + 1) * cfg.nrBytes;
+    gMaxSimCycles += (unsigned int)(totalBytes / (ARW/8)) * 2 + 8 * 4096;
+
+    //-- The script of the iperf3 client
+    enum { CLT_COOKIE=0, CLT_PARAMS, CLT_STREAMS, CLT_RUNNING, CLT_END,
+           CLT_RESULTS, CLT_DONE, CLT_RELEASED } step = CLT_COOKIE;
+    BenchIpfSess &ctrl = ipfSess[cBenchIpfCtrlSess];
+    size_t        rcvdPos = 0;
+    string        json;
+    benchIpfSend(ctrl, cookie);
+
+    do {
+        pBenchIperfTOE(nrErr, ipfSess,
+                dut.ssTOE_TSIF_Notif, dut.ssTSIF_TOE_DReq, dut.ssTOE_TSIF_Data, dut.ssTOE_TSIF_Meta,
+                dut.ssTSIF_TOE_LsnReq, dut.ssTOE_TSIF_LsnRep,
+                dut.ssTSIF_TOE_SndReq, dut.ssTOE_TSIF_SndRep, dut.ssTSIF_TOE_Data);
+        stepDut(dut);
+        stepSim();
+
+        //-- Nothing is expected to be forwarded to TAF
+        if (!dut.ssTSIF_TAF_Data.empty()) {
+            printError(THIS_NAME, "Received unexpected data on the TAF interface.\n");
+            dut.ssTSIF_TAF_Data.read();
+            nrErr++;
+        }
+        if (!dut.ssTSIF_TAF_SessId.empty()) { dut.ssTSIF_TAF_SessId.read(); }
+        if (!dut.ssTSIF_TAF_DatLen.empty()) { dut.ssTSIF_TAF_DatLen.read(); }
+
+        //-- Account the reports
+        while (!gIpfReports.empty()) {
+            IperfReport   rpt = gIpfReports.front();
+            BenchIpfSess &sess = ipfSess[rpt.sessId];
+            gIpfReports.pop_front();
+            if (sess.released or (rpt.sessId == cBenchIpfCtrlSess) or
+                (rpt.version != ((sess.dstPort == IPERF_LSN_PORT) ? 2 : 3))) {
+                printError(THIS_NAME, "Received an unexpected report for session #%d.\n",
+                           rpt.sessId.to_uint());
+                nrErr++;
+            }
+            sess.ivalSum  += rpt.ivalBytes;
+            sess.rptTotal  = rpt.totalBytes;
+            sess.released  = rpt.last;
+            sess.nrRpts   += 1;
+        }
+
+        //-- Walk through the states of the iperf3 client
+        unsigned long avail = ctrl.rcvd.size() - rcvdPos;
+        switch (step) {
+        case CLT_COOKIE:
+        case CLT_PARAMS:
+        case CLT_END:
+            if (avail >= 1) {
+                unsigned char code = ctrl.rcvd[rcvdPos++];
+                unsigned char exp  = (step == CLT_COOKIE) ? IPF_PARAM_EXCHANGE :
+                                     (step == CLT_PARAMS) ? IPF_CREATE_STREAMS : IPF_EXCHANGE_RESULTS;
+                if (code != exp) {
+                    printError(THIS_NAME, "Received state %d instead of %d on the control channel.\n", code, exp);
+                    nrErr++;
+                }
+                if (step == CLT_COOKIE) {
+                    char params[128];
+                    int  len = snprintf(params, sizeof(params),
+                               "{\"tcp\":true,\"omit\":0,\"time\":10,\"parallel\":%d,\"len\":131072,\"client_version\":\"3.9\"}",
+                               cfg.nrStreams);
+                    benchIpfSend(ctrl, string(1, len >> 24) + (char)(len >> 16) + (char)(len >> 8) + (char)len);
+                    benchIpfSend(ctrl, string(params, len));
+                    step = CLT_PARAMS;
+                }
+                else if (step == CLT_PARAMS) {
+                    for (int s=1; s<=cfg.nrStreams; s++) {
+                        benchIpfSend(ipfSess[s], cookie);
+                    }
+                    benchIpfSend(ipfSess[ipf2], string(cfg.nrBytes, '2'));
+                    step = CLT_STREAMS;
+                }
+                else {
+                    string res = "{\"cpu_util_total\":1.5,\"sender_has_retransmits\":0,\"streams\":[]}";
+                    int    len = res.size();
+                    benchIpfSend(ctrl, string(1, len >> 24) + (char)(len >> 16) + (char)(len >> 8) + (char)len);
+                    benchIpfSend(ctrl, res);
+                    step = CLT_RESULTS;
+                }
+            }
+            break;
+        case CLT_STREAMS:
+            if (avail >= 2) {
+                if ((ctrl.rcvd[rcvdPos] != IPF_TEST_START) or (ctrl.rcvd[rcvdPos+1] != IPF_TEST_RUNNING)) {
+                    printError(THIS_NAME, "Did not receive TEST_START and TEST_RUNNING on the control channel.\n");
+                    nrErr++;
+                }
+                rcvdPos += 2;
+                for (int s=1; s<=cfg.nrStreams; s++) {
+                    string data(cfg.nrBytes, 0);
+                    for (int i=0; i<cfg.nrBytes; i++) {
+                        data[i] = (char)(s * 7 + i);
+                    }
+                    benchIpfSend(ipfSess[s], data);
+                }
+                step = CLT_RUNNING;
+            }
+            break;
+        case CLT_RUNNING:
+            {
+                bool allSent = true;
+                for (int s=1; s<=cfg.nrStreams; s++) {
+                    allSent &= ipfSess[s].toNotify.empty() and ipfSess[s].notified.empty();
+                }
+                if (allSent) {
+                    benchIpfSend(ctrl, string(1, (char)IPF_TEST_END));
+                    step = CLT_END;
+                }
+            }
+            break;
+        case CLT_RESULTS:
+            if (avail >= 4) {
+                unsigned long len = ((unsigned char)ctrl.rcvd[rcvdPos+0] << 24) |
+                                    ((unsigned char)ctrl.rcvd[rcvdPos+1] << 16) |
+                                    ((unsigned char)ctrl.rcvd[rcvdPos+2] <<  8) |
+                                    ((unsigned char)ctrl.rcvd[rcvdPos+3] <<  0);
+                if (avail >= 4 + len + 1) {
+                    json = ctrl.rcvd.substr(rcvdPos+4, len);
+                    if ((unsigned char)ctrl.rcvd[rcvdPos+4+len] != IPF_DISPLAY_RESULTS) {
+                        printError(THIS_NAME, "The results of the server are not followed by DISPLAY_RESULTS.\n");
+                        nrErr++;
+                    }
+                    rcvdPos += 4 + len + 1;
+                    benchIpfSend(ctrl, string(1, (char)IPF_IPERF_DONE));
+                    step = CLT_DONE;
+                }
+            }
+            break;
+        case CLT_DONE:
+            {
+                bool allReleased = true;
+                for (int s=1; s<nrSess; s++) {
+                    allReleased &= ipfSess[s].released;
+                }
+                if (allReleased) {
+                    step = CLT_RELEASED;
+                }
+            }
+            break;
+        default:
+            break;
+        }
+    } while ((step != CLT_RELEASED) and (gSimCycCnt < gMaxSimCycles) and
+             (!gFatalError) and (nrErr < 10));
+
+    //---------------------------------------------------------------
+    //-- REPORT AND ASSESS THE RESULTS
+    //---------------------------------------------------------------
+    //-- The cookies of the streams are served along with the payload
+    unsigned long rxBytes  = totalBytes + cfg.nrStreams * cookie.size();
+    unsigned int  rxCycles = gIpfLastCyc - gIpfFirstCyc + 1;
+    double        rxRate   = (double)rxBytes / rxCycles;
+    printInfo(THIS_NAME, "--------------------------------------------------------------\n");
+    printInfo(THIS_NAME, "Rx goodput : %ld bytes in %d cycles (%.3f bytes/cycle = %5.1f%% of line rate).\n",
+              rxBytes, rxCycles, rxRate, 100.0 * rxRate / (ARW/8));
+    printInfo(THIS_NAME, "Results of the server : %s\n", json.c_str());
+    for (int s=1; s<nrSess; s++) {
+        printInfo(THIS_NAME, "\tSession #%2d (iperf%d) : reports=%2d - total=%8ld bytes - released=%d.\n",
+                  s, (s == ipf2) ? 2 : 3, ipfSess[s].nrRpts, ipfSess[s].rptTotal, ipfSess[s].released);
+    }
+    printInfo(THIS_NAME, "--------------------------------------------------------------\n");
+    if (step != CLT_RELEASED) {
+        printError(THIS_NAME, "The iperf test did not complete (client step=%d).\n", step);
+        nrErr++;
+    }
+    for (int s=1; s<nrSess; s++) {
+        if ((ipfSess[s].rptTotal != (unsigned long)cfg.nrBytes) or
+            (ipfSess[s].ivalSum  != (unsigned long)cfg.nrBytes)) {
+            printError(THIS_NAME, "Session #%d: the reports account %ld (total) and %ld (intervals) bytes instead of %d.\n",
+                       s, ipfSess[s].rptTotal, ipfSess[s].ivalSum, cfg.nrBytes);
+            nrErr++;
+        }
+    }
+    //-- The streams are numbered 1, 3, 4, ... and the cookies are not accounted
+    for (int n=0; n<cfg.nrStreams; n++) {
+        int    expId = (n == 0) ? 1 : n + 2;
+        char   key[16];
+        snprintf(key, sizeof(key), "\"id\":%3d", expId);
+        size_t pos = json.find(key);
+        if (pos == string::npos) {
+            printError(THIS_NAME, "Stream #%d is not listed in the results of the server.\n", expId);
+            nrErr++;
+            continue;
+        }
+        pos = json.find("\"bytes\":", pos);
+        unsigned long bytes = (pos == string::npos) ? 0 : strtoul(json.c_str() + pos + 8, NULL, 10);
+        if (bytes != (unsigned long)cfg.nrBytes) {
+            printError(THIS_NAME, "Stream #%d: the server reports %ld bytes instead of %d.\n",
+                       expId, bytes, cfg.nrBytes);
+            nrErr++;
+        }
+    }
+    if ((json.size() < 2) or (json[0] != '{') or (json[json.size()-1] != '}')) {
+        printError(THIS_NAME, "The results of the server are not a JSON object.\n");
+        nrErr++;
+    }
+    if (rxRate < cBenchIpfMinRate * (ARW/8)) {
+        printError(THIS_NAME, "The iperf server did not sink at line rate (%.3f bytes/cycle).\n", rxRate);
+        nrErr++;
+    }
+}
+
+/*******************************************************************************
+ * @brief Emulate the TOE for the socket-addressed Tx interface of [TSIF].
+ *
+ * @param[in/out] nrErr       A ref to the error counter of the main testbench.
+ * @param[in]     cfg         The configuration of the client benchmark.
+ * @param[in/out] socks       The per-socket statistics.
+ * @param[in]  siTSIF_LsnReq  Listen port request from [TSIF].
+ * @param[out] soTSIF_LsnRep  Listen port reply to [TSIF].
+ * @param[in]  siTSIF_OpnReq  Open connection request from [TSIF].
+ * @param[out] soTSIF_OpnRep  Open connection reply to [TSIF].
+ * @param[in]  siTSIF_SndReq  Request to send from [TSIF].
+ * @param[out] soTSIF_SndRep  Send reply to [TSIF].
+ * @param[in]  siTSIF_TxData  Tx data from [TSIF].
+ *
+ * @details
+ *  An open request for the remote socket {DEFAULT_HOST_IP4_ADDR,
+ *   cBenchCliPortBase+s} is answered after 'cfg.opnLat' cycles with session id
+ *   'cBenchCliSessBase+s', or is refused if 's' is below 'cfg.nrFail'. The
+ *   1st open request of every socket is never answered if 'cfg.lossy'. Every
+ *   request to send is granted right away and the Tx data are consumed at one
+ *   chunk per cycle. Every segment must match the length of its request to
+ *   send, and every chunk must carry the index of the message it belongs to
+ *   and its own index within that message.
+ *******************************************************************************/
+void pBenchCliTOE(
+        int                      &nrErr,
+        const BenchCliCfg        &cfg,
+        vector<BenchCliSock>     &socks,
+        stream<TcpAppLsnReq>     &siTSIF_LsnReq,
+        stream<TcpAppLsnRep>     &soTSIF_LsnRep,
+        stream<TcpAppOpnReq>     &siTSIF_OpnReq,
+        stream<TcpAppOpnRep>     &soTSIF_OpnRep,
+        stream<TcpAppSndReq>     &siTSIF_SndReq,
+        stream<TcpAppSndRep>     &soTSIF_SndRep,
+        stream<TcpAppData>       &siTSIF_TxData)
+{
+    const char *myName = concat3(THIS_NAME, "/", "TOE");
+
+    //-- STATIC VARIABLES ------------------------------------------------------
+    static deque<pair<unsigned int, TcpAppOpnReq> > toe_opnReqQueue;
+    static deque<TcpAppSndReq> toe_sndReqQueue;
+    static unsigned long       toe_segBytes = 0;
+
+    //------------------------------------------------------
+    //-- LISTEN REQUESTS ARE ALWAYS GRANTED
+    //------------------------------------------------------
+    if (!siTSIF_LsnReq.empty()) {
+        siTSIF_LsnReq.read();
+        soTSIF_LsnRep.write(TcpAppLsnRep(NTS_OK));
+    }
+
+    //------------------------------------------------------
+    //-- ANSWER THE OPEN REQUESTS AFTER 'opnLat' CYCLES
+    //------------------------------------------------------
+    if (!siTSIF_OpnReq.empty()) {
+        toe_opnReqQueue.push_back(make_pair(gSimCycCnt + cfg.opnLat, siTSIF_OpnReq.read()));
+    }
+    if (!toe_opnReqQueue.empty() and (toe_opnReqQueue.front().first <= gSimCycCnt)) {
+        TcpAppOpnReq opnReq = toe_opnReqQueue.front().second;
+        int s = opnReq.port.to_int() - cBenchCliPortBase;
+        toe_opnReqQueue.pop_front();
+        if ((s < 0) or (s >= cfg.nrSocks) or (opnReq.addr != DEFAULT_HOST_IP4_ADDR)) {
+            printError(myName, "Received an open request for an unexpected socket.\n");
+            printSockAddr(myName, opnReq);
+            nrErr++;
+            soTSIF_OpnRep.write(TcpAppOpnRep(0, CLOSED));
+        }
+        else {
+            socks[s].nrOpens++;
+            if (cfg.lossy and (socks[s].nrOpens == 1)) {
+                //-- Lose this request
+            }
+            else if (s < cfg.nrFail) {
+                soTSIF_OpnRep.write(TcpAppOpnRep(0, CLOSED));
+            }
+            else {
+                soTSIF_OpnRep.write(TcpAppOpnRep(cBenchCliSessBase + s, ESTABLISHED));
+                gCliOpenCyc   = gSimCycCnt;
+                gCliOpenBytes = gCliRcvdBytes;
+            }
+        }
+    }
+
+    //------------------------------------------------------
+    //-- GRANT THE REQUESTS TO SEND
+    //------------------------------------------------------
+    if (!siTSIF_SndReq.empty()) {
+        TcpAppSndReq sndReq = siTSIF_SndReq.read();
+        toe_sndReqQueue.push_back(sndReq);
+        soTSIF_SndRep.write(TcpAppSndRep(sndReq.sessId, sndReq.length, 0xFFFF, NO_ERROR));
+    }
+
+    //------------------------------------------------------
+    //-- CONSUME AND CHECK THE TX DATA
+    //------------------------------------------------------
+    if (!siTSIF_TxData.empty()) {
+        TcpAppData chunk = siTSIF_TxData.read();
+        if (toe_sndReqQueue.empty()) {
+            printError(myName, "Received Tx data without a request to send.\n");
+            nrErr++;
+            return;
+        }
+        TcpAppSndReq &sndReq = toe_sndReqQueue.front();
+        int           s      = sndReq.sessId.to_int() - cBenchCliSessBase;
+        if ((s < cfg.nrFail) or (s >= cfg.nrSocks) or socks[s].expMsgs.empty()) {
+            printError(myName, "Received unexpected Tx data on session #%d.\n", sndReq.sessId.to_int());
+            nrErr++;
+            toe_sndReqQueue.pop_front();
+            return;
+        }
+        BenchCliSock &sock = socks[s];
+        TcpAppData expChunk(0, chunk.getLE_TKeep(), 0);
+        expChunk.setTData(((ap_uint<64>)sock.expMsgs.front() << 32) | (sock.msgBytes / (ARW/8)));
+        expChunk.clearUnusedBytes();
+        if (chunk.getLE_TData() != expChunk.getLE_TData()) {
+            printError(myName, "Socket #%d: Chunk #%ld of message #%d does not match.\n",
+                       s, sock.msgBytes / (ARW/8), sock.expMsgs.front());
+            printAxisRaw(myName, "\tReceived: ", chunk);
+            printAxisRaw(myName, "\tExpected: ", expChunk);
+            nrErr++;
+        }
+        if (gCliFirstCyc == 0) {
+            gCliFirstCyc = gSimCycCnt;
+        }
+        gCliRcvdBytes  += chunk.getLen();
+        gCliLastCyc     = gSimCycCnt;
+        toe_segBytes   += chunk.getLen();
+        sock.msgBytes  += chunk.getLen();
+        sock.rcvdBytes += chunk.getLen();
+        if (sock.msgBytes == (unsigned)cfg.msgLen) {
+            sock.expMsgs.pop_front();
+            sock.msgBytes = 0;
+        }
+        if (chunk.getTLast()) {
+            if (toe_segBytes != sndReq.length) {
+                printError(myName, "Socket #%d: Received a segment of %ld bytes instead of %d.\n",
+                           s, toe_segBytes, sndReq.length.to_int());
+                nrErr++;
+            }
+            toe_segBytes = 0;
+            toe_sndReqQueue.pop_front();
+        }
+        if (DEBUG_LEVEL & TRACE_TOE) {
+            printAxisRaw(myName, "Received Tx data chunk: ", chunk);
+        }
+    }
+}
+
+/*******************************************************************************
+ * @brief Emulate the socket-addressed Tx part of the TcpApplicationFlash (TAF).
+ *
+ * @param[in/out] nrErr       A ref to the error counter of the main testbench.
+ * @param[in]     cfg         The configuration of the client benchmark.
+ * @param[in/out] socks       The per-socket statistics.
+ * @param[out] soTSIF_SockData Tx data stream to [TSIF].
+ * @param[out] soTSIF_SockAddr The remote socket of the message to [TSIF].
+ * @param[out] soTSIF_SockLen  The length of the message to [TSIF].
+ * @param[in]  siTSIF_SockRep  The session the message was sent on, from [TSIF].
+ *
+ * @details
+ *  The messages are sent back-to-back, at one chunk per cycle, to the remote
+ *   sockets in turn. Every reply must report the session of the socket of its
+ *   message, or that the message was not sent if that socket refuses its
+ *   connection.
+ *******************************************************************************/
+void pBenchCliTAF(
+        int                      &nrErr,
+        const BenchCliCfg        &cfg,
+        vector<BenchCliSock>     &socks,
+        stream<TcpAppData>       &soTSIF_SockData,
+        stream<SockAddr>         &soTSIF_SockAddr,
+        stream<TcpDatLen>        &soTSIF_SockLen,
+        stream<SockSndRep>       &siTSIF_SockRep)
+{
+    const char *myName = concat3(THIS_NAME, "/", "TAF");
+
+    //-- STATIC VARIABLES ------------------------------------------------------
+    static int  taf_msgIdx   = 0;
+    static int  taf_chunkIdx = 0;
+    static int  taf_repIdx   = 0;
+
+    //------------------------------------------------------
+    //-- SEND THE MESSAGES BACK-TO-BACK
+    //------------------------------------------------------
+    if ((gSimCycCnt >= (unsigned)cSimToeStartupDelay) and (taf_msgIdx < cfg.nrMsgs)) {
+        int s = taf_msgIdx % cfg.nrSocks;
+        if (taf_chunkIdx == 0) {
+            soTSIF_SockAddr.write(SockAddr(DEFAULT_HOST_IP4_ADDR, cBenchCliPortBase + s));
+            soTSIF_SockLen.write(cfg.msgLen);
+            if (s >= cfg.nrFail) {
+                socks[s].expMsgs.push_back(taf_msgIdx);
+            }
+        }
+        int left = cfg.msgLen - taf_chunkIdx * (ARW/8);
+        TcpAppData chunk(0, 0, 0);
+        chunk.setTData(((ap_uint<64>)taf_msgIdx << 32) | taf_chunkIdx);
+        chunk.setLE_TKeep(lenToLE_tKeep((left < (ARW/8)) ? left : (ARW/8)));
+        chunk.setLE_TLast((left <= (ARW/8)) ? TLAST : 0);
+        chunk.clearUnusedBytes();
+        soTSIF_SockData.write(chunk);
+        if (left <= (ARW/8)) {
+            taf_msgIdx  += 1;
+            taf_chunkIdx = 0;
+        }
+        else {
+            taf_chunkIdx += 1;
+        }
+    }
+
+    //------------------------------------------------------
+    //-- CHECK THE REPLIES
+    //------------------------------------------------------
+    if (!siTSIF_SockRep.empty()) {
+        SockSndRep sockRep = siTSIF_SockRep.read();
+        int  s       = taf_repIdx % cfg.nrSocks;
+        bool expSent = (s >= cfg.nrFail);
+        if ((sockRep.sent != expSent) or (expSent and (sockRep.sessId != cBenchCliSessBase + s))) {
+            printError(myName, "Message #%d: Received an unexpected reply (sent=%d, sessId=%d).\n",
+                       taf_repIdx, sockRep.sent, sockRep.sessId.to_int());
+            nrErr++;
+        }
+        if (sockRep.sent) {
+            gCliSent++;
+        }
+        else {
+            if (gCliDropped == 0) {
+                gCliFailCyc   = gSimCycCnt;
+                gCliFailBytes = gCliRcvdBytes;
+            }
+            gCliDropped++;
+        }
+        taf_repIdx++;
+    }
+}
+
+/*******************************************************************************
+ * @brief Benchmark the socket-addressed Tx interface of [TSIF].
+ *
+ * @param[in/out] nrErr  A ref to the error counter of the main testbench.
+ * @param[in]     cfg    The configuration of the client benchmark.
+ *
+ * @details
+ *  The benchmark fails if a message is not replied to, or not received by its
+ *   remote socket, if a connection is opened more than once, or if the Tx rate
+ *   is below 'cBenchCliMinRate' of the line rate once all the connections are
+ *   opened (for messages of at least 'cBenchCliMinRateLen' bytes).
+ *  With refusing sockets, that rate is assessed once the first message has
+ *   been dropped, against the share of the messages which go to the other
+ *   sockets. A refusing socket must also be held off after its attempts fail,
+ *   i.e. get at most 'cConMaxTries' open requests per 'cBenchCliFailHoldOff'
+ *   cycles instead of one series of attempts per message.
+ *******************************************************************************/
+void benchCli(int &nrErr, const BenchCliCfg &cfg) {
+    BenchDutItf          dut;
+    vector<BenchCliSock> socks(cfg.nrSocks);
+
+    int nrChunks = (cfg.msgLen + (ARW/8) - 1) / (ARW/8);
+    gMaxSimCycles += cfg.nrMsgs * (nrChunks + 4) * 2 + cfg.nrSocks * cfg.opnLat * 2;
+    if (cfg.nrFail) {
+        //-- Every message to a refusing socket waits for all the attempts to open it
+        gMaxSimCycles += (cfg.nrMsgs / cfg.nrSocks + 1) * cfg.nrFail * (cConMaxTries * (cfg.opnLat + 500));
+    }
+    if (cfg.lossy) {
+        //-- The 1st messages wait for the slots of the lost requests to be freed
+        gMaxSimCycles += cfg.nrSocks * 2 * cBenchCliOpnExpiry;
+    }
+
+    do {
+        pBenchCliTAF(nrErr, cfg, socks,
+                dut.ssTAF_TSIF_SockData, dut.ssTAF_TSIF_SockAddr, dut.ssTAF_TSIF_SockLen,
+                dut.ssTSIF_TAF_SockRep);
+        pBenchCliTOE(nrErr, cfg, socks,
+                dut.ssTSIF_TOE_LsnReq, dut.ssTOE_TSIF_LsnRep,
+                dut.ssTSIF_TOE_OpnReq, dut.ssTOE_TSIF_OpnRep,
+                dut.ssTSIF_TOE_SndReq, dut.ssTOE_TSIF_SndRep, dut.ssTSIF_TOE_Data);
+        stepDut(dut);
+        stepSim();
+        bool done = (gCliSent + gCliDropped == (unsigned)cfg.nrMsgs);
+        for (int s=0; s<cfg.nrSocks; s++) {
+            done = done and socks[s].expMsgs.empty();
+        }
+        if (done) {
+            break;
+        }
+    } while ((gSimCycCnt < gMaxSimCycles) and (!gFatalError) and (nrErr < 10));
+
+    //---------------------------------------------------------------
+    //-- REPORT AND ASSESS THE RESULTS
+    //---------------------------------------------------------------
+    unsigned long totalRcvd = 0;
+    int           nrOpens   = 0;
+    for (int s=0; s<cfg.nrSocks; s++) {
+        totalRcvd += socks[s].rcvdBytes;
+        nrOpens   += socks[s].nrOpens;
+    }
+    unsigned int  warmCyc    = max(gCliOpenCyc, gCliFailCyc);
+    unsigned int  warmCycles = (gCliLastCyc > warmCyc) ? (gCliLastCyc - warmCyc) : 1;
+    unsigned long warmBytes  = gCliRcvdBytes - max(gCliOpenBytes, gCliFailBytes);
+    double        warmRate   = (double)warmBytes / warmCycles;
+    double        minRate    = cBenchCliMinRate * (ARW/8) * (cfg.nrSocks - cfg.nrFail) / cfg.nrSocks;
+    printInfo(THIS_NAME, "--------------------------------------------------------------\n");
+    printInfo(THIS_NAME, "Messages      : %d sent and %d dropped out of %d (%d open requests for %d sockets).\n",
+              gCliSent, gCliDropped, cfg.nrMsgs, nrOpens, cfg.nrSocks);
+    printInfo(THIS_NAME, "Tx throughput : %ld bytes in %d cycles, of which %ld bytes in %d cycles once the connections are opened (%5.1f%% of line rate).\n",
+              totalRcvd, gCliLastCyc - gCliFirstCyc + 1, warmBytes, warmCycles,
+              100.0 * warmRate / (ARW/8));
+    for (int s=0; s<cfg.nrSocks; s++) {
+        printInfo(THIS_NAME, "\tSocket #%2d : received=%8ld bytes after %d open request(s).\n",
+                  s, socks[s].rcvdBytes, socks[s].nrOpens);
+    }
+    printInfo(THIS_NAME, "--------------------------------------------------------------\n");
+    int nrSent = 0;
+    for (int m=0; m<cfg.nrMsgs; m++) {
+        nrSent += ((m % cfg.nrSocks) >= cfg.nrFail) ? 1 : 0;
+    }
+    if ((gCliSent != (unsigned)nrSent) or (totalRcvd != (unsigned long)nrSent * cfg.msgLen)) {
+        printError(THIS_NAME, "Only %d out of %d messages were sent (%ld bytes received).\n",
+                   gCliSent, nrSent, totalRcvd);
+        nrErr++;
+    }
+    int expOpens = cfg.lossy ? 2 : 1;
+    for (int s=cfg.nrFail; s<cfg.nrSocks; s++) {
+        if (socks[s].nrOpens != expOpens) {
+            printError(THIS_NAME, "The connection to socket #%d was requested %d times instead of %d.\n",
+                       s, socks[s].nrOpens, expOpens);
+            nrErr++;
+        }
+    }
+    int maxFailOpens = cConMaxTries * (1 + gSimCycCnt / cBenchCliFailHoldOff);
+    for (int s=0; s<cfg.nrFail; s++) {
+        if (socks[s].nrOpens > maxFailOpens) {
+            printError(THIS_NAME, "The refusing socket #%d was requested %d times (max. %d).\n",
+                       s, socks[s].nrOpens, maxFailOpens);
+            nrErr++;
+        }
+    }
+    if ((cfg.nrFail < cfg.nrSocks) and (cfg.msgLen >= cBenchCliMinRateLen) and
+        (cfg.nrMsgs > 4 * cfg.nrSocks) and (warmRate < minRate)) {
+        printError(THIS_NAME, "The socket-addressed messages were not sent at line rate (%.3f bytes/cycle, min. %.3f).\n",
+                   warmRate, minRate);
+        nrErr++;
+    }
+}
+
+/*******************************************************************************
+ * @brief Emulate the Tx part of the TcpApplicationFlash (TAF) for the Tx buffer
+ *        back-pressure benchmark.
+ *
+ * @param[in]     cfg         The configuration of the Tx buffer benchmark.
+ * @param[in/out] sess        The per-session statistics.
+ * @param[out] soTSIF_Data    Tx data stream to [TSIF].
+ * @param[out] soTSIF_SessId  The session Id of the message to [TSIF].
+ * @param[out] soTSIF_DatLen  The length of the message to [TSIF].
+ *
+ * @details
+ *  The messages are sent back-to-back, at one chunk per cycle. The first
+ *   'cfg.nrSess' messages go to every session in turn, and the next messages
+ *   go to the unblocked sessions in turn. Every chunk carries the index of its
+ *   message and its own index within that message.
+ *******************************************************************************/
+void pBenchTxbTAF(
+        const BenchTxbCfg        &cfg,
+        vector<BenchTxbSess>     &sess,
+        stream<TcpAppData>       &soTSIF_Data,
+        stream<TcpSessId>        &soTSIF_SessId,
+        stream<TcpDatLen>        &soTSIF_DatLen)
+{
+    //-- STATIC VARIABLES ------------------------------------------------------
+    static int  taf_msgIdx   = 0;
+    static int  taf_chunkIdx = 0;
+    static int  taf_sess     = 0;
+
+    if ((gSimCycCnt >= (unsigned)cSimToeStartupDelay) and (taf_msgIdx < cfg.nrMsgs)) {
+        if (taf_chunkIdx == 0) {
+            int nrUnblocked = cfg.nrSess - cfg.nrBlocked();
+            taf_sess = (taf_msgIdx < cfg.nrSess) ? taf_msgIdx :
+                       cfg.nrBlocked() + (taf_msgIdx - cfg.nrSess) % nrUnblocked;
+            soTSIF_SessId.write(taf_sess);
+            soTSIF_DatLen.write(cfg.msgLen);
+            sess[taf_sess].expMsgs.push_back(taf_msgIdx);
+        }
+        int left = cfg.msgLen - taf_chunkIdx * (ARW/8);
+        TcpAppData chunk(0, 0, 0);
+        chunk.setTData(((ap_uint<64>)taf_msgIdx << 32) | taf_chunkIdx);
+        chunk.setLE_TKeep(lenToLE_tKeep((left < (ARW/8)) ? left : (ARW/8)));
+        chunk.setLE_TLast((left <= (ARW/8)) ? TLAST : 0);
+        chunk.clearUnusedBytes();
+        soTSIF_Data.write(chunk);
+        if (left <= (ARW/8)) {
+            taf_msgIdx  += 1;
+            taf_chunkIdx = 0;
+        }
+        else {
+            taf_chunkIdx += 1;
+        }
+    }
+}
+
+/*******************************************************************************
+ * @brief Emulate the TOE with a finite Tx buffer per session.
+ *
+ * @param[in/out] nrErr       A ref to the error counter of the main testbench.
+ * @param[in]     cfg         The configuration of the Tx buffer benchmark.
+ * @param[in/out] sess        The per-session statistics.
+ * @param[in]  siTSIF_LsnReq  Listen port request from [TSIF].
+ * @param[out] soTSIF_LsnRep  Listen port reply to [TSIF].
+ * @param[in]  siTSIF_SndReq  Request to send from [TSIF].
+ * @param[out] soTSIF_SndRep  Send reply to [TSIF].
+ * @param[in]  siTSIF_TxData  Tx data from [TSIF].
+ *
+ * @details
+ *  A request to send is granted if the Tx buffer of its session has enough
+ *   free space, and is refused with 'NO_SPACE' otherwise. The 'spaceLeft' of a
+ *   reply is the free space before the request. A lost session answers every
+ *   request with 'NO_CONNECTION' once it has refused one. The Tx buffer of an
+ *   unblocked session frees one chunk every 'cfg.drain' cycles, and so does
+ *   the Tx buffer of a stalled session once 'cBenchTxbStallCyc' cycles have
+ *   elapsed since the first refusal of a blocked session. By then, [TSIF] must
+ *   have given up the message of the stalled session, and none of its parked
+ *   segments may get through anymore.
+ *  Every segment must match the length of its request to send, and the chunks
+ *   of a session must follow each other within a message. A message may only
+ *   end early if its next chunks never show up.
+ *  The Tx data are consumed before the requests to send. A request received
+ *   while a granted segment is not complete was therefore issued ahead, on the
+ *   basis of the Tx space cache of [TSIF], and must never be refused.
+ *******************************************************************************/
+void pBenchTxbTOE(
+        int                      &nrErr,
+        const BenchTxbCfg        &cfg,
+        vector<BenchTxbSess>     &sess,
+        stream<TcpAppLsnReq>     &siTSIF_LsnReq,
+        stream<TcpAppLsnRep>     &soTSIF_LsnRep,
+        stream<TcpAppSndReq>     &siTSIF_SndReq,
+        stream<TcpAppSndRep>     &soTSIF_SndRep,
+        stream<TcpAppData>       &siTSIF_TxData)
+{
+    const char *myName = concat3(THIS_NAME, "/", "TOE");
+
+    //-- STATIC VARIABLES ------------------------------------------------------
+    static deque<TcpAppSndReq> toe_sndReqQueue;
+    static unsigned long       toe_segBytes = 0;
+
+    //------------------------------------------------------
+    //-- LISTEN REQUESTS ARE ALWAYS GRANTED
+    //------------------------------------------------------
+    if (!siTSIF_LsnReq.empty()) {
+        siTSIF_LsnReq.read();
+        soTSIF_LsnRep.write(TcpAppLsnRep(NTS_OK));
+    }
+
+    //------------------------------------------------------
+    //-- DRAIN THE TX BUFFERS (THE STALLED ONES ONLY ONCE GIVEN UP)
+    //------------------------------------------------------
+    bool resumed = (gTxbStallFirstCyc != 0) and (gSimCycCnt >= gTxbStallFirstCyc + cBenchTxbStallCyc);
+    if ((gSimCycCnt % cfg.drain) == 0) {
+        for (int s=0; s<cfg.nrSess; s++) {
+            if (!cfg.isBlocked(s) or ((s < cfg.nrStall) and resumed)) {
+                sess[s].space = min(sess[s].space + (ARW/8), cfg.bufLen);
+            }
+        }
+    }
+
+    //------------------------------------------------------
+    //-- CONSUME AND CHECK ALL THE TX DATA RECEIVED SO FAR
+    //------------------------------------------------------
+    while (!siTSIF_TxData.empty()) {
+        TcpAppData chunk = siTSIF_TxData.read();
+        if (toe_sndReqQueue.empty()) {
+            printError(myName, "Received Tx data without a request to send.\n");
+            nrErr++;
+            return;
+        }
+        TcpAppSndReq &sndReq = toe_sndReqQueue.front();
+        int           s      = sndReq.sessId.to_int();
+        BenchTxbSess &ses    = sess[s];
+        int           msgIdx = chunk.getTData()(63,32).to_int();
+        int           chkIdx = chunk.getTData()(31, 0).to_int();
+        if (chunk.getLen() < (ARW/8)) {
+            //-- The indexes of a partial chunk are cleared, but such a chunk ends its message
+            msgIdx = (ses.expMsgs.empty()) ? -1 : ses.expMsgs.front();
+            chkIdx = ses.msgBytes / (ARW/8);
+        }
+        //-- Skip the messages (or the remainder of the message) dropped by [TSIF]
+        while (!ses.expMsgs.empty() and (ses.expMsgs.front() != msgIdx)) {
+            if (ses.msgBytes) {
+                ses.nrTrunc++;
+            }
+            else {
+                ses.nrDropped++;
+            }
+            ses.expMsgs.pop_front();
+            ses.msgBytes = 0;
+        }
+        if (ses.expMsgs.empty()) {
+            printError(myName, "Session #%d: Received a chunk of message #%d out of order.\n", s, msgIdx);
+            nrErr++;
+        }
+        else if ((unsigned long)chkIdx * (ARW/8) != ses.msgBytes) {
+            printError(myName, "Session #%d: Received chunk #%d of message #%d after %ld bytes of that message.\n",
+                       s, chkIdx, msgIdx, ses.msgBytes);
+            nrErr++;
+        }
+        else {
+            int left = cfg.msgLen - chkIdx * (ARW/8);
+            if (chunk.getLen() != ((left < (ARW/8)) ? left : (ARW/8))) {
+                printError(myName, "Session #%d: Chunk #%d of message #%d has an unexpected length (%d).\n",
+                           s, chkIdx, msgIdx, chunk.getLen());
+                nrErr++;
+            }
+        }
+        toe_segBytes  += chunk.getLen();
+        ses.msgBytes  += chunk.getLen();
+        ses.rcvdBytes += chunk.getLen();
+        if (!cfg.isBlocked(s) and gTxbStallFirstCyc) {
+            gTxbStallBytes += chunk.getLen();
+        }
+        if (!ses.expMsgs.empty() and (ses.msgBytes == (unsigned)cfg.msgLen)) {
+            ses.expMsgs.pop_front();
+            ses.msgBytes = 0;
+        }
+        if (chunk.getTLast()) {
+            if (toe_segBytes != sndReq.length) {
+                printError(myName, "Session #%d: Received a segment of %ld bytes instead of %d.\n",
+                           s, toe_segBytes, sndReq.length.to_int());
+                nrErr++;
+            }
+            toe_segBytes = 0;
+            toe_sndReqQueue.pop_front();
+        }
+        if (DEBUG_LEVEL & TRACE_TOE) {
+            printAxisRaw(myName, "Received Tx data chunk: ", chunk);
+        }
+    }
+
+    //------------------------------------------------------
+    //-- GRANT OR REFUSE THE REQUESTS TO SEND
+    //------------------------------------------------------
+    if (!siTSIF_SndReq.empty()) {
+        TcpAppSndReq sndReq = siTSIF_SndReq.read();
+        int           s     = sndReq.sessId.to_int();
+        if (s >= cfg.nrSess) {
+            printError(myName, "Received a request to send for an unexpected session (%d).\n", s);
+            nrErr++;
+            soTSIF_SndRep.write(TcpAppSndRep(sndReq.sessId, sndReq.length, 0, NO_CONNECTION));
+            return;
+        }
+        BenchTxbSess &ses   = sess[s];
+        bool          ahead = !toe_sndReqQueue.empty();
+        if (ahead) {
+            gTxbAhead++;
+        }
+        if (cfg.isBlocked(s)) {
+            if (gTxbStallFirstCyc) {
+                gTxbStallLastCyc   = gSimCycCnt;
+                gTxbStallLastBytes = gTxbStallBytes;
+            }
+        }
+        if (ses.lost) {
+            soTSIF_SndRep.write(TcpAppSndRep(sndReq.sessId, sndReq.length, 0, NO_CONNECTION));
+        }
+        else if (sndReq.length <= ses.space) {
+            soTSIF_SndRep.write(TcpAppSndRep(sndReq.sessId, sndReq.length, ses.space, NO_ERROR));
+            ses.space -= sndReq.length;
+            toe_sndReqQueue.push_back(sndReq);
+            gTxbGranted++;
+        }
+        else {
+            soTSIF_SndRep.write(TcpAppSndRep(sndReq.sessId, sndReq.length, ses.space, NO_SPACE));
+            ses.nrRefused++;
+            if (ahead) {
+                printError(myName, "Session #%d: A request to send of %d bytes issued ahead was refused (space=%d).\n",
+                           s, sndReq.length.to_int(), ses.space);
+                gTxbAheadRefused++;
+                nrErr++;
+            }
+            ses.lost = (s >= cfg.nrStall) and cfg.isBlocked(s);
+            if (cfg.isBlocked(s) and (gTxbStallFirstCyc == 0)) {
+                gTxbStallFirstCyc = gSimCycCnt;
+                gTxbStallLastCyc  = gSimCycCnt;
+            }
+        }
+    }
+}
+
+/*******************************************************************************
+ * @brief Benchmark the send-retry queue of [TSIF] against a TOE whose Tx buffers
+ *        fill up.
+ *
+ * @param[in/out] nrErr  A ref to the error counter of the main testbench.
+ * @param[in]     cfg    The configuration of the Tx buffer benchmark.
+ *
+ * @details
+ *  The benchmark fails if the chunks of a session are not received in order,
+ *   if a message is received with a hole, if a message of an unblocked session
+ *   is not entirely received, if a blocked session does not receive exactly
+ *   the segments which fit into its Tx buffer, or if the unblocked sessions do
+ *   not make any progress while the messages of the blocked sessions are parked.
+ *   The latter is only assessed if these messages fit into the send-retry queue
+ *   of [TSIF].
+ *  It also fails if a request to send issued ahead is refused, or if none was
+ *   issued ahead although the Tx buffer holds two segments.
+ *******************************************************************************/
+void benchTxb(int &nrErr, const BenchTxbCfg &cfg) {
+    BenchDutItf          dut;
+    vector<BenchTxbSess> sess(cfg.nrSess);
+
+    for (int s=0; s<cfg.nrSess; s++) {
+        sess[s].space = cfg.bufLen;
+    }
+    dut.ssMMIO_TSIF_CfgCmd.write(MmioCfgCmd(CFG_TX_SEG_LEN, 0, cfg.segLen));
+
+    int nrChunks = (cfg.msgLen + (ARW/8) - 1) / (ARW/8);
+    int nrUnblocked = cfg.nrSess - cfg.nrBlocked();
+    gMaxSimCycles += cfg.nrMsgs * nrChunks * max(2, cfg.drain * 2 / nrUnblocked) +
+                     cfg.nrBlocked() * nrChunks * 2 * cBenchTxbQuiet;
+
+    do {
+        pBenchTxbTAF(cfg, sess, dut.ssTAF_TSIF_Data, dut.ssTAF_TSIF_SessId, dut.ssTAF_TSIF_DatLen);
+        stepDut(dut);
+        pBenchTxbTOE(nrErr, cfg, sess,
+                dut.ssTSIF_TOE_LsnReq, dut.ssTOE_TSIF_LsnRep,
+                dut.ssTSIF_TOE_SndReq, dut.ssTOE_TSIF_SndRep, dut.ssTSIF_TOE_Data);
+        stepSim();
+        bool done = (gSimCycCnt > (unsigned)cSimToeStartupDelay) and dut.ssTAF_TSIF_Data.empty();
+        for (int s=cfg.nrBlocked(); s<cfg.nrSess; s++) {
+            done = done and sess[s].expMsgs.empty();
+        }
+        if (cfg.nrBlocked()) {
+            done = done and (gTxbStallFirstCyc != 0) and (gSimCycCnt > gTxbStallLastCyc + cBenchTxbQuiet);
+        }
+        if (done) {
+            break;
+        }
+    } while ((gSimCycCnt < gMaxSimCycles) and (!gFatalError) and (nrErr < 10));
+
+    //---------------------------------------------------------------
+    //-- REPORT AND ASSESS THE RESULTS
+    //---------------------------------------------------------------
+    int nrRefused = 0;
+    for (int s=0; s<cfg.nrSess; s++) {
+        //-- A message which is still expected was dropped entirely or in part
+        if (!sess[s].expMsgs.empty()) {
+            if (sess[s].msgBytes) {
+                sess[s].nrTrunc++;
+                sess[s].expMsgs.pop_front();
+            }
+            sess[s].nrDropped += sess[s].expMsgs.size();
+        }
+        nrRefused += sess[s].nrRefused;
+    }
+    unsigned int  stallCycles = gTxbStallLastCyc - gTxbStallFirstCyc;
+    unsigned long stallBytes  = gTxbStallLastBytes;
+    printInfo(THIS_NAME, "--------------------------------------------------------------\n");
+    printInfo(THIS_NAME, "Send requests : %d granted and %d refused with 'NO_SPACE'.\n", gTxbGranted, nrRefused);
+    printInfo(THIS_NAME, "Look-ahead    : %d requests issued ahead and %d of them refused.\n", gTxbAhead, gTxbAheadRefused);
+    if (cfg.nrBlocked()) {
+        printInfo(THIS_NAME, "Progress      : %ld bytes of the unblocked sessions in %d cycles while the blocked sessions were retried (%.3f bytes/cycle).\n",
+                  stallBytes, stallCycles, (stallCycles) ? ((double)stallBytes / stallCycles) : 0.0);
+    }
+    for (int s=0; s<cfg.nrSess; s++) {
+        printInfo(THIS_NAME, "\tSession #%2d : received=%8ld bytes - refused=%4d - truncated=%d - dropped=%d%s\n",
+                  s, sess[s].rcvdBytes, sess[s].nrRefused, sess[s].nrTrunc, sess[s].nrDropped,
+                  (s < cfg.nrStall) ? " (stalled)" : (cfg.isBlocked(s)) ? " (lost)" : "");
+    }
+    printInfo(THIS_NAME, "--------------------------------------------------------------\n");
+    for (int s=0; s<cfg.nrSess; s++) {
+        if (!cfg.isBlocked(s) and (sess[s].nrTrunc or sess[s].nrDropped)) {
+            printError(THIS_NAME, "Session #%d: %d message(s) truncated and %d dropped, although its Tx buffer drains.\n",
+                       s, sess[s].nrTrunc, sess[s].nrDropped);
+            nrErr++;
+        }
+        if (cfg.isBlocked(s)) {
+            //-- The segments which fit into the Tx buffer are sent, the remainder of the message is dropped
+            unsigned long expBytes = (cfg.msgLen <= cfg.bufLen) ? cfg.msgLen :
+                                     (unsigned long)(cfg.bufLen / cfg.segLen) * cfg.segLen;
+            if (sess[s].rcvdBytes != expBytes) {
+                printError(THIS_NAME, "Session #%d: Received %ld bytes of its message instead of %ld.\n",
+                           s, sess[s].rcvdBytes, expBytes);
+                nrErr++;
+            }
+        }
+    }
+    //-- A Tx buffer which holds two segments lets the next segment be requested ahead
+    if ((cfg.bufLen >= 2 * cfg.segLen) and (gTxbAhead == 0)) {
+        printError(THIS_NAME, "No request to send was issued ahead, the Tx space cache of [TSIF] was not exercised.\n");
+        nrErr++;
+    }
+    //-- The segments of the blocked messages which are parked (one slot per segment)
+    int nrSegs    = (cfg.msgLen + cfg.segLen - 1) / cfg.segLen;
+    int nrParked  = cfg.nrBlocked() * (nrSegs - min(nrSegs, cfg.bufLen / cfg.segLen));
+    if ((nrParked != 0) and (nrParked < cRtySlots) and (stallBytes == 0)) {
+        printError(THIS_NAME, "The unblocked sessions did not make any progress while the blocked sessions were retried.\n");
+        nrErr++;
+    }
+}
+
+/*******************************************************************************
+ * @brief Main function of the performance benchmark of the TCP Shell Interface.
+ *
+ * This benchmark takes 0 to 5 parameters in the following order:
+ * @param[in] The number of sessions [1:cMaxSessions], or 'arb' to sweep the
+ *            round-robin arbiter of the RxHandler over 32 to 1024 sessions.
+ * @param[in] The number of notifications to inject [1:...].
+ * @param[in] The number of bytes per notification [1:cIBuffBytes], or 0 for a
+ *            mix of segment lengths (see 'cBenchMixedSegLens').
+ * @param[in] The TCP destination port of the notifications.
+ * @param[in] The latency of the TOE upon a data request (in cycles).
+ *
+ * Alternatively, the mixed traffic benchmark is invoked with:
+ *   drr <nrShort> <nrBulk> <quantum> [msgLen] [dreqLat]
+ *
+ * And the port action table is exercised with:
+ *   pat <nrSess> <nrNotifs> <segLen> <dstPort>
+ *  which programs 'dstPort' as a sink port via MMIO before running the same
+ *  traffic as above. All the notified bytes must then be sunk by [TSIF].
+ *
+ * And the coalescing of the segments forwarded to [TAF] is exercised with:
+ *   coa <bytes> <timeout> <nrSess> <nrNotifs> <segLen> [dstPort] [dReqLatency]
+ *  which programs the flush threshold and timeout of the Rx coalescing before
+ *  running the same traffic as above. Fewer messages than data requests must
+ *  then be forwarded to [TAF].
+ *
+ * And the out-of-order service of the data requests is exercised with:
+ *   ooo <nrSess> <nrNotifs> <segLen> [dstPort] [dReqLatency]
+ *  which runs the same traffic as above while the TOE serves the shortest data
+ *  request first. All the notified bytes must still be forwarded to [TAF].
+ *
+ * And the Tx traffic generator is exercised with:
+ *   gen <nrSess> <nrBytes> [pattern] [rate] [stamp] [repeat] [segLen]
+ *  which requests 'nrSess' concurrent transfers of 'nrBytes' bytes each, sent
+ *  'repeat' times in a row (with the extended 8801 command if 'repeat' != 0)
+ *  and cut into segments of at most 'segLen' bytes (if 'segLen' != 0).
+ *
+ * And the iperf server is exercised with:
+ *   iperf <nrStreams> <nrBytes>
+ *  which runs an iperf3 test of 'nrStreams' parallel streams of 'nrBytes' bytes
+ *  each, next to an iperf2 client which sends 'nrBytes' bytes.
+ *
+ * And the socket-addressed Tx interface is exercised with:
+ *   cli <nrSocks> <nrMsgs> [msgLen] [opnLat] [nrFail] [lossy]
+ *  which sends 'nrMsgs' messages of 'msgLen' bytes to 'nrSocks' remote sockets
+ *  in turn, the first 'nrFail' of which refuse their connection. Every other
+ *  connection must be opened once and reused by all the messages to its socket.
+ *  If 'lossy' != 0, the TOE never answers the 1st open request of every socket.
+ *
+ * And the send-retry queue is exercised with:
+ *   txb <nrSess> <nrMsgs> [msgLen] [bufLen] [drain] [nrStall] [nrLost] [segLen]
+ *  which sends 'nrMsgs' messages of 'msgLen' bytes to a TOE whose per-session
+ *  Tx buffer of 'bufLen' bytes drains one chunk every 'drain' cycles. The first
+ *  'nrStall' sessions stall until their message is given up, and the next
+ *  'nrLost' sessions lose their connection. Their message must be cut at a
+ *  segment boundary, while all the messages of the other sessions must be
+ *  received in order.
+ *******************************************************************************/
+int main(int argc, char *argv[]) {
+
+    gSimCycCnt = 0;
+
+    //------------------------------------------------------
+    //-- TESTBENCH VARIABLES
+    //------------------------------------------------------
+    int      nrErr = 0;
+    BenchCfg cfg;
+
+    //------------------------------------------------------
+    //-- PARSING THE TESBENCH ARGUMENTS
+    //------------------------------------------------------
+    if ((argc >= 2) and (string(argv[1]) == "arb")) {
+        benchArbiter<  32>(nrErr);
+        benchArbiter<  64>(nrErr);
+        benchArbiter< 256>(nrErr);
+        benchArbiter< 512>(nrErr);
+        benchArbiter<1024>(nrErr);
+        if (nrErr) {
+            printError(THIS_NAME, "#### BENCHMARK FAILED : TOTAL NUMBER OF ERROR(S) = %2d  ####\n", nrErr);
+        } else {
+            printInfo(THIS_NAME, "####               SUCCESSFUL END OF TEST                ####\n");
+        }
+        return (nrErr);
+    }
+    if ((argc >= 2) and (string(argv[1]) == "drr")) {
+        BenchMixCfg mixCfg;
+        if (argc >= 3) { mixCfg.nrShort = atoi(argv[2]); }
+        if (argc >= 4) { mixCfg.nrBulk  = atoi(argv[3]); }
+        if (argc >= 5) { mixCfg.quantum = atoi(argv[4]); }
+        if (argc >= 6) { mixCfg.msgLen  = atoi(argv[5]); }
+        if (argc >= 7) { mixCfg.dreqLat = atoi(argv[6]); }
+        if ((mixCfg.nrShort < 1) or (mixCfg.nrBulk < 0) or
+            ((mixCfg.nrShort + mixCfg.nrBulk) > cMaxSessions)) {
+            printFatal(THIS_NAME, "Arguments 'nrShort' and 'nrBulk' must satisfy 1 <= nrShort+nrBulk <= %d.\n",
+                       cMaxSessions);
+            return NTS_KO;
+        }
+        if ((mixCfg.quantum < 1) or (mixCfg.quantum > 0xFFFF)) {
+            printFatal(THIS_NAME, "Argument 'quantum' is out of range [1:65535].\n");
+            return NTS_KO;
+        }
+        if ((mixCfg.msgLen < 1) or (mixCfg.msgLen > cIBuffBytes)) {
+            printFatal(THIS_NAME, "Argument 'msgLen' is out of range [1:%d].\n", cIBuffBytes);
+            return NTS_KO;
+        }
+        printInfo(THIS_NAME, "############################################################################\n");
+        printInfo(THIS_NAME, "## BENCHMARK 'bench_tcp_shell_if' (DRR MIXED TRAFFIC) STARTS HERE         ##\n");
+        printInfo(THIS_NAME, "############################################################################\n");
+        benchMix(nrErr, mixCfg);
+        if (nrErr) {
+            printError(THIS_NAME, "#### BENCHMARK FAILED : TOTAL NUMBER OF ERROR(S) = %2d  ####\n", nrErr);
+        } else {
+            printInfo(THIS_NAME, "####               SUCCESSFUL END OF TEST                ####\n");
+        }
+        return (nrErr);
+    }
+    if ((argc >= 2) and (string(argv[1]) == "gen")) {
+        BenchGenCfg genCfg;
+        if (argc >= 3) { genCfg.nrSess  = atoi(argv[2]); }
+        if (argc >= 4) { genCfg.nrBytes = atol(argv[3]); }
+        if (argc >= 5) { genCfg.pattern = atoi(argv[4]); }
+        if (argc >= 6) { genCfg.rate    = atoi(argv[5]); }
+        if (argc >= 7) { genCfg.stamp   = (atoi(argv[6]) != 0); }
+        if (argc >= 8) { genCfg.repeat  = atoi(argv[7]); }
+        if (argc >= 9) { genCfg.segLen  = atoi(argv[8]); }
+        if ((genCfg.nrSess < 1) or (genCfg.nrSess > cGenSessions)) {
+            printFatal(THIS_NAME, "Argument 'nrSess' is out of range [1:%d].\n", cGenSessions);
+            return NTS_KO;
+        }
+        if ((genCfg.nrBytes < 1) or (genCfg.nrBytes > 0xFFFFFFFFFFFFL)) {
+            printFatal(THIS_NAME, "Argument 'nrBytes' is out of range [1:2^48-1].\n");
+            return NTS_KO;
+        }
+        if ((genCfg.repeat < 0) or (genCfg.repeat > 0xFFFF)) {
+            printFatal(THIS_NAME, "Argument 'repeat' is out of range [0:65535].\n");
+            return NTS_KO;
+        }
+        if ((genCfg.segLen < 0) or (genCfg.segLen > cRtySlotChunks*(ARW/8)) or
+            (genCfg.segLen % (ARW/8) != 0)) {
+            printFatal(THIS_NAME, "Argument 'segLen' must be a multiple of %d in range [0:%d].\n",
+                       (ARW/8), cRtySlotChunks*(ARW/8));
+            return NTS_KO;
+        }
+        if ((genCfg.pattern < GEN_PAT_HELLO) or (genCfg.pattern > GEN_PAT_CONST)) {
+            printFatal(THIS_NAME, "Argument 'pattern' is out of range [0:3].\n");
+            return NTS_KO;
+        }
+        if ((genCfg.rate < 0) or (genCfg.rate > ((ARW/8) << 8))) {
+            printFatal(THIS_NAME, "Argument 'rate' is out of range [0:%d].\n", (ARW/8) << 8);
+            return NTS_KO;
+        }
+        printInfo(THIS_NAME, "############################################################################\n");
+        printInfo(THIS_NAME, "## BENCHMARK 'bench_tcp_shell_if' (TX TRAFFIC GENERATOR) STARTS HERE      ##\n");
+        printInfo(THIS_NAME, "############################################################################\n");
+        printInfo(THIS_NAME, "\tnrSess=%d - nrBytes=%ld - pattern=%d - rate=%d - stamp=%d - repeat=%d - segLen=%d\n",
+                  genCfg.nrSess, genCfg.nrBytes, genCfg.pattern, genCfg.rate, genCfg.stamp, genCfg.repeat,
+                  genCfg.segLen);
+        benchGen(nrErr, genCfg);
+        if (nrErr) {
+            printError(THIS_NAME, "#### BENCHMARK FAILED : TOTAL NUMBER OF ERROR(S) = %2d  ####\n", nrErr);
+        } else {
+            printInfo(THIS_NAME, "####               SUCCESSFUL END OF TEST                ####\n");
+        }
+        return (nrErr);
+    }
+    if ((argc >= 2) and (string(argv[1]) == "iperf")) {
+        BenchIpfCfg ipfCfg;
+        if (argc >= 3) { ipfCfg.nrStreams = atoi(argv[2]); }
+        if (argc >= 4) { ipfCfg.nrBytes   = atoi(argv[3]); }
+        if ((ipfCfg.nrStreams < 1) or (ipfCfg.nrStreams > cIpfSessions-2)) {
+            printFatal(THIS_NAME, "Argument 'nrStreams' is out of range [1:%d].\n", cIpfSessions-2);
+            return NTS_KO;
+        }
+        if (ipfCfg.nrBytes < 1) {
+            printFatal(THIS_NAME, "Argument 'nrBytes' must be a positive number.\n");
+            return NTS_KO;
+        }
+        printInfo(THIS_NAME, "############################################################################\n");
+        printInfo(THIS_NAME, "## BENCHMARK 'bench_tcp_shell_if' (IPERF SERVER) STARTS HERE              ##\n");
+        printInfo(THIS_NAME, "############################################################################\n");
+        printInfo(THIS_NAME, "\tnrStreams=%d - nrBytes=%d\n", ipfCfg.nrStreams, ipfCfg.nrBytes);
+        benchIperf(nrErr, ipfCfg);
+        if (nrErr) {
+            printError(THIS_NAME, "#### BENCHMARK FAILED : TOTAL NUMBER OF ERROR(S) = %2d  ####\n", nrErr);
+        } else {
+            printInfo(THIS_NAME, "####               SUCCESSFUL END OF TEST                ####\n");
+        }
+        return (nrErr);
+    }
+    if ((argc >= 2) and (string(argv[1]) == "cli")) {
+        BenchCliCfg cliCfg;
+        if (argc >= 3) { cliCfg.nrSocks = atoi(argv[2]); }
+        if (argc >= 4) { cliCfg.nrMsgs  = atoi(argv[3]); }
+        if (argc >= 5) { cliCfg.msgLen  = atoi(argv[4]); }
+        if (argc >= 6) { cliCfg.opnLat  = atoi(argv[5]); }
+        if (argc >= 7) { cliCfg.nrFail  = atoi(argv[6]); }
+        if (argc >= 8) { cliCfg.lossy   = (atoi(argv[7]) != 0); }
+        if ((cliCfg.nrSocks < 1) or (cliCfg.nrSocks > cConTblEntries) or
+            (cliCfg.nrSocks > cMaxSessions - cBenchCliSessBase)) {
+            printFatal(THIS_NAME, "Argument 'nrSocks' is out of range [1:%d].\n",
+                       min(cConTblEntries, cMaxSessions - cBenchCliSessBase));
+            return NTS_KO;
+        }
+        if ((cliCfg.nrMsgs < 1) or (cliCfg.msgLen < 1) or (cliCfg.msgLen > 0xFFFF)) {
+            printFatal(THIS_NAME, "Arguments 'nrMsgs' and 'msgLen' must be in range [1:...] and [1:65535].\n");
+            return NTS_KO;
+        }
+        if ((cliCfg.opnLat < 0) or (cliCfg.opnLat > cBenchCliMaxOpnLat) or
+            (cliCfg.nrFail < 0) or (cliCfg.nrFail > cliCfg.nrSocks)) {
+            printFatal(THIS_NAME, "Arguments 'opnLat' and 'nrFail' must be in range [0:%d] and [0:nrSocks].\n",
+                       cBenchCliMaxOpnLat);
+            return NTS_KO;
+        }
+        if (cliCfg.lossy and (cliCfg.nrSocks > cConMaxOpnReqs)) {
+            //-- The open replies are matched in order, so every lost request must be in the 1st batch
+            printFatal(THIS_NAME, "Argument 'nrSocks' must be in range [1:%d] for a lossy TOE.\n", cConMaxOpnReqs);
+            return NTS_KO;
+        }
+        printInfo(THIS_NAME, "############################################################################\n");
+        printInfo(THIS_NAME, "## BENCHMARK 'bench_tcp_shell_if' (SOCKET-ADDRESSED TX) STARTS HERE       ##\n");
+        printInfo(THIS_NAME, "############################################################################\n");
+        printInfo(THIS_NAME, "\tnrSocks=%d - nrMsgs=%d - msgLen=%d - opnLat=%d - nrFail=%d - lossy=%d\n",
+                  cliCfg.nrSocks, cliCfg.nrMsgs, cliCfg.msgLen, cliCfg.opnLat, cliCfg.nrFail, cliCfg.lossy);
+        benchCli(nrErr, cliCfg);
+        if (nrErr) {
+            printError(THIS_NAME, "#### BENCHMARK FAILED : TOTAL NUMBER OF ERROR(S) = %2d  ####\n", nrErr);
+        } else {
+            printInfo(THIS_NAME, "####               SUCCESSFUL END OF TEST                ####\n");
+        }
+        return (nrErr);
+    }
+    if ((argc >= 2) and (string(argv[1]) == "txb")) {
+        BenchTxbCfg txbCfg;
+        if (argc >= 3) { txbCfg.nrSess  = atoi(argv[2]); }
+        if (argc >= 4) { txbCfg.nrMsgs  = atoi(argv[3]); }
+        if (argc >= 5) { txbCfg.msgLen  = atoi(argv[4]); }
+        if (argc >= 6) { txbCfg.bufLen  = atoi(argv[5]); }
+        if (argc >= 7) { txbCfg.drain   = atoi(argv[6]); }
+        if (argc >= 8) { txbCfg.nrStall = atoi(argv[7]); }
+        if (argc >= 9) { txbCfg.nrLost  = atoi(argv[8]); }
+        if (argc >= 10){ txbCfg.segLen  = atoi(argv[9]); }
+        if ((txbCfg.nrSess < 1) or (txbCfg.nrSess > cMaxSessions) or
+            (txbCfg.nrStall < 0) or (txbCfg.nrLost < 0) or (txbCfg.nrBlocked() >= txbCfg.nrSess)) {
+            printFatal(THIS_NAME, "Arguments 'nrSess', 'nrStall' and 'nrLost' must satisfy nrStall+nrLost < nrSess <= %d.\n",
+                       cMaxSessions);
+            return NTS_KO;
+        }
+        if ((txbCfg.nrMsgs < txbCfg.nrSess) or (txbCfg.msgLen < 1) or (txbCfg.msgLen > 0xFFFF)) {
+            printFatal(THIS_NAME, "Arguments 'nrMsgs' and 'msgLen' must be in range [nrSess:...] and [1:65535].\n");
+            return NTS_KO;
+        }
+        if ((txbCfg.segLen < (ARW/8)) or (txbCfg.segLen > cRtySlotChunks*(ARW/8)) or
+            (txbCfg.segLen % (ARW/8) != 0)) {
+            printFatal(THIS_NAME, "Argument 'segLen' must be a multiple of %d in range [%d:%d].\n",
+                       (ARW/8), (ARW/8), cRtySlotChunks*(ARW/8));
+            return NTS_KO;
+        }
+        if ((txbCfg.bufLen < txbCfg.segLen) or (txbCfg.bufLen > 0xFFFF) or (txbCfg.drain < 1)) {
+            printFatal(THIS_NAME, "Arguments 'bufLen' and 'drain' must be in range [segLen:65535] and [1:...].\n");
+            return NTS_KO;
+        }
+        if (txbCfg.nrBlocked() and (txbCfg.msgLen <= txbCfg.bufLen)) {
+            printFatal(THIS_NAME, "Argument 'msgLen' must exceed 'bufLen' for the blocked sessions to be refused.\n");
+            return NTS_KO;
+        }
+        printInfo(THIS_NAME, "############################################################################\n");
+        printInfo(THIS_NAME, "## BENCHMARK 'bench_tcp_shell_if' (TX BUFFER BACK-PRESSURE) STARTS HERE   ##\n");
+        printInfo(THIS_NAME, "############################################################################\n");
+        printInfo(THIS_NAME, "\tnrSess=%d - nrMsgs=%d - msgLen=%d - bufLen=%d - drain=%d - nrStall=%d - nrLost=%d - segLen=%d\n",
+                  txbCfg.nrSess, txbCfg.nrMsgs, txbCfg.msgLen, txbCfg.bufLen, txbCfg.drain,
+                  txbCfg.nrStall, txbCfg.nrLost, txbCfg.segLen);
+        benchTxb(nrErr, txbCfg);
+        if (nrErr) {
+            printError(THIS_NAME, "#### BENCHMARK FAILED : TOTAL NUMBER OF ERROR(S) = %2d  ####\n", nrErr);
+        } else {
+            printInfo(THIS_NAME, "####               SUCCESSFUL END OF TEST                ####\n");
+        }
+        return (nrErr);
+    }
+    if ((argc >= 2) and (string(argv[1]) == "pat")) {
+        if (argc < 6) {
+            printFatal(THIS_NAME, "Usage: pat <nrSess> <nrNotifs> <segLen> <dstPort>\n");
+            return NTS_KO;
+        }
+        cfg.sink = true;
+        argv++;
+        argc--;
+    }
+    else if ((argc >= 2) and (string(argv[1]) == "ooo")) {
+        if (argc < 5) {
+            printFatal(THIS_NAME, "Usage: ooo <nrSess> <nrNotifs> <segLen> [dstPort] [dReqLatency]\n");
+            return NTS_KO;
+        }
+        cfg.reorder = true;
+        argv++;
+        argc--;
+    }
+    else if ((argc >= 2) and (string(argv[1]) == "coa")) {
+        if (argc < 7) {
+            printFatal(THIS_NAME, "Usage: coa <bytes> <timeout> <nrSess> <nrNotifs> <segLen> [dstPort] [dReqLatency]\n");
+            return NTS_KO;
+        }
+        cfg.coaBytes = atoi(argv[2]);
+        cfg.coaTmo   = atoi(argv[3]);
+        if ((cfg.coaBytes < 1) or (cfg.coaBytes > cRcoMaxBytes) or (cfg.coaTmo < 0) or (cfg.coaTmo > 0xFFFF)) {
+            printFatal(THIS_NAME, "Argument 'bytes' or 'timeout' is out of range ([1:%d] and [0:65535]).\n",
+                       cRcoMaxBytes);
+            return NTS_KO;
+        }
+        argv += 3;
+        argc -= 3;
+    }
+    if (argc >= 2) {
+        cfg.nrSess = atoi(argv[1]);
+        if ((cfg.nrSess < 1) or (cfg.nrSess > cMaxSessions)) {
+            printFatal(THIS_NAME, "Argument 'nrSess' is out of range [1:%d].\n", cMaxSessions);
+            return NTS_KO;
+        }
+    }
+    if (argc >= 3) {
+        cfg.nrNotifs = atoi(argv[2]);
+        if (cfg.nrNotifs < 1) {
+            printFatal(THIS_NAME, "Argument 'nrNotifs' must be greater than 0.\n");
+            return NTS_KO;
+        }
+    }
+    if (argc >= 4) {
+        cfg.segLen = atoi(argv[3]);
+        if ((cfg.segLen < 0) or (cfg.segLen > cIBuffBytes)) {
+            printFatal(THIS_NAME, "Argument 'segLen' is out of range [0:%d].\n", cIBuffBytes);
+            return NTS_KO;
+        }
+    }
+    if (argc >= 5) {
+        cfg.dstPort = atoi(argv[4]);
+        if (!cfg.sink and
+            ((cfg.dstPort == RECV_MODE_LSN_PORT) or (cfg.dstPort == XMIT_MODE_LSN_PORT))) {
+            printFatal(THIS_NAME, "Argument 'dstPort' cannot be a port which does not forward its data to [TAF].\n");
+            return NTS_KO;
+        }
+    }
+    if (argc >= 6) {
+        cfg.dreqLat = atoi(argv[5]);
+    }
+
+    BenchDutItf            dut;
+    vector<BenchSessStats> sessStats(cMaxSessions);
+    unsigned long totalNotif = 0;
+    for (int n=0; n<cfg.nrNotifs; n++) {
+        totalNotif    += benchSegLen(cfg, n);
+        gMaxSimCycles += (1 + (benchSegLen(cfg, n) + (ARW/8) - 1) / (ARW/8)) * 2;
+    }
+    gMaxSimCycles += cfg.dreqLat;
+
+    printInfo(THIS_NAME, "############################################################################\n");
+    printInfo(THIS_NAME, "## BENCHMARK 'bench_tcp_shell_if' STARTS HERE                             ##\n");
+    printInfo(THIS_NAME, "############################################################################\n");
+    printInfo(THIS_NAME, "\tnrSess=%d - nrNotifs=%d - segLen=%d - dstPort=%d - dreqLat=%d - policy=%s%s%s\n",
+              cfg.nrSess, cfg.nrNotifs, cfg.segLen, cfg.dstPort.to_uint(), cfg.dreqLat,
+              benchPolicyName(), (cfg.sink ? " - sink" : ""), (cfg.reorder ? " - reorder" : ""));
+
+    if (cfg.coaBytes) {
+        dut.ssMMIO_TSIF_CfgCmd.write(MmioCfgCmd(CFG_RX_COALESCE, COA_CFG_BYTES,   cfg.coaBytes));
+        dut.ssMMIO_TSIF_CfgCmd.write(MmioCfgCmd(CFG_RX_COALESCE, COA_CFG_TIMEOUT, cfg.coaTmo));
+        gCoaBytes = (cRcoBufChunks + cRcoMsgSlots + 1) * (ARW/8);
+    }
+    if (cfg.sink) {
+        //-- Program the destination port as a sink port (entry #2 is free by default)
+        dut.ssMMIO_TSIF_CfgCmd.write(MmioCfgCmd(CFG_PORT_RANGE,  2,
+                                     (cfg.dstPort.to_uint() << 16) | cfg.dstPort.to_uint()));
+        dut.ssMMIO_TSIF_CfgCmd.write(MmioCfgCmd(CFG_PORT_ACTION, 2, PA_SINK));
+    }
+
+    //-----------------------------------------------------
+    //-- MAIN LOOP
+    //-----------------------------------------------------
+    unsigned long totalRcvd  = 0;
+    vector<double> halfShare;
+    do {
+        pBenchTOE(nrErr, cfg, sessStats,
+                dut.ssTOE_TSIF_Notif, dut.ssTSIF_TOE_DReq, dut.ssTOE_TSIF_Data, dut.ssTOE_TSIF_Meta,
+                dut.ssTSIF_TOE_LsnReq, dut.ssTOE_TSIF_LsnRep);
+
+        stepDut(dut);
+
+        pBenchTAF(sessStats, dut.ssTSIF_TAF_Data, dut.ssTSIF_TAF_SessId, dut.ssTSIF_TAF_DatLen);
+
+        totalRcvd = (cfg.sink) ? gSinkCnt : 0;
+        for (int s=0; s<cfg.nrSess; s++) {
+            totalRcvd += sessStats[s].rcvdBytes;
+        }
+        //-- Take a snapshot of the fairness while all sessions are still backlogged
+        if ((halfShare.size() == 0) and (totalRcvd >= totalNotif/2)) {
+            for (int s=0; s<cfg.nrSess; s++) {
+                halfShare.push_back((double)sessStats[s].rcvdBytes);
+            }
+        }
+        stepSim();
+    } while ((totalRcvd < totalNotif) and (gSimCycCnt < gMaxSimCycles) and
+             (!gFatalError) and (nrErr < 10));
+
+    //---------------------------------------------------------------
+    //-- REPORT
+    //---------------------------------------------------------------
+    unsigned int notifCycles = gNotifLastCyc - gNotifFirstCyc + 1;
+    unsigned int rxCycles    = gRxLastCyc    - gNotifFirstCyc + 1;
+    printInfo(THIS_NAME, "--------------------------------------------------------------\n");
+    printInfo(THIS_NAME, "Notifications : %d injected in %d cycles (%.3f notif/cycle, %d stall cycles).\n",
+              gNotifSent, notifCycles, (double)gNotifSent / notifCycles, gNotifStalls);
+    printInfo(THIS_NAME, "Rx throughput : %ld bytes in %d cycles (%.3f bytes/cycle = %5.1f%% of line rate).\n",
+              totalRcvd, rxCycles, (double)totalRcvd / rxCycles,
+              100.0 * totalRcvd / rxCycles / (ARW/8));
+    printInfo(THIS_NAME, "Fairness      : Jain index = %.4f (when half of the bytes were received).\n",
+              jainIndex(halfShare));
+    printInfo(THIS_NAME, "Input buffer  : up to %ld out of %d bytes requested and not yet forwarded.\n",
+              gMaxInFlight, cIBuffBytes);
+    printInfo(THIS_NAME, "Buffer usage  : %ld bytes held in %ld chunk bytes (%5.1f%% of the buffer vs. %5.1f%% with chunk-granular accounting).\n",
+              gMaxInFlight, gChunksAtMax, 100.0 * gMaxInFlight / cIBuffBytes,
+              (gChunksAtMax) ? (100.0 * gMaxInFlight / gChunksAtMax) : 0.0);
+    printInfo(THIS_NAME, "Buffer storage: up to %ld out of %d chunks requested and not yet forwarded.\n",
+              gMaxChunkBytes / (ARW/8), cIBuffChunks);
+    printInfo(THIS_NAME, "Data requests : %d issued (%.1f bytes/DReq, peak of %d DReqs in %d cycles).\n",
+              gDReqCnt, (double)totalRcvd / gDReqCnt, gDReqPeak, cBenchDReqWindow);
+    if (cfg.reorder) {
+        printInfo(THIS_NAME, "Reordering    : %d data requests served ahead of an older one.\n",
+                  gDReqReorders);
+    }
+    if (!cfg.sink) {
+        printInfo(THIS_NAME, "TAF messages  : %d forwarded (%.1f bytes/msg).\n",
+                  gTafMsgs, (gTafMsgs) ? ((double)totalRcvd / gTafMsgs) : 0.0);
+    }
+    if (!cfg.sink) {
+        BenchMixResult res;
+        benchSegLatency(sessStats, 0, cfg.nrSess, res);
+        printInfo(THIS_NAME, "Seg. latency  : avg=%.1f - p99=%d - max=%d cycles (over %d segments).\n",
+                  res.avgLat, res.p99Lat, res.maxLat, res.nrMsgs);
+    }
+    for (int s=0; s<cfg.nrSess; s++) {
+        printInfo(THIS_NAME, "\tSession #%2d : notified=%8ld - requested=%8ld - received=%8ld bytes.\n",
+                  s, sessStats[s].notifBytes, sessStats[s].reqBytes, sessStats[s].rcvdBytes);
+    }
+    printInfo(THIS_NAME, "--------------------------------------------------------------\n");
+
+    //---------------------------------------------------------------
+    //-- ASSESS THE RESULTS
+    //---------------------------------------------------------------
+    if (totalRcvd != totalNotif) {
+        printError(THIS_NAME, "Only %ld out of %ld notified bytes were %s.\n",
+                   totalRcvd, totalNotif, (cfg.sink ? "sunk" : "forwarded to [TAF]"));
+        nrErr++;
+    }
+    if (cfg.reorder and (gDReqReorders == 0)) {
+        printError(THIS_NAME, "The TOE did not serve any data request out of order.\n");
+        nrErr++;
+    }
+    if (gTafLenErrs != 0) {
+        printError(THIS_NAME, "%d messages were forwarded to [TAF] with a wrong data-length.\n", gTafLenErrs);
+        nrErr++;
+    }
+    if (cfg.coaBytes and (gTafMsgs >= gDReqCnt)) {
+        printError(THIS_NAME, "[TSIF] did not coalesce any segment (%d messages for %d data requests).\n",
+                   gTafMsgs, gDReqCnt);
+        nrErr++;
+    }
+    if (cfg.sink and (totalRcvd != gSinkCnt)) {
+        printError(THIS_NAME, "%ld bytes were forwarded to [TAF] instead of being sunk.\n",
+                   totalRcvd - gSinkCnt);
+        nrErr++;
+    }
+    //-- [NOTE] The SPF policy is unfair by design and the FIFO policy is served by
+    //--   the legacy handler which does not issue one data request per cycle.
+    if (!cfg.sink and (TSIF_RX_POLICY != RX_POLICY_SPF) and
+        (jainIndex(halfShare) < cBenchMinJainIndex)) {
+        printError(THIS_NAME, "The Rx bandwidth was not fairly shared among the sessions (Jain index < %.2f).\n",
+                   cBenchMinJainIndex);
+        nrErr++;
+    }
+    if ((TSIF_RX_POLICY != RX_POLICY_FIFO) and
+        (cfg.segLen != 0) and (cfg.segLen * cBenchDReqWindow <= cIBuffBytes) and
+        (cfg.nrSess >= cBenchDReqWindow) and (gDReqPeak < cBenchDReqWindow)) {
+        printError(THIS_NAME, "[TSIF] failed to issue one data request per cycle (peak of %d DReqs in %d cycles).\n",
+                   gDReqPeak, cBenchDReqWindow);
+        nrErr++;
+    }
+    if (gNotifStalls != 0) {
+        printError(THIS_NAME, "[TSIF] failed to absorb one notification per cycle (%d stall cycles).\n",
+                   gNotifStalls);
+        nrErr++;
+    }
+
+    if (nrErr) {
+        printError(THIS_NAME, "###########################################################\n");
+        printError(THIS_NAME, "#### BENCHMARK FAILED : TOTAL NUMBER OF ERROR(S) = %2d  ####\n", nrErr);
+        printError(THIS_NAME, "###########################################################\n");
+    } else {
+        printInfo(THIS_NAME, "#############################################################\n");
+        printInfo(THIS_NAME, "####               SUCCESSFUL END OF TEST                ####\n");
+        printInfo(THIS_NAME, "#############################################################\n");
+    }
+
+    return (nrErr);
+}
+
+/*! \} */
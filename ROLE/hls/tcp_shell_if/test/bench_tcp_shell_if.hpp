@@ -0,0 +1,404 @@
+/*
+ * Copyright 2016 -- 2021 IBM Corporation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*****************************************************************************
+ * @file       : bench_tcp_shell_if.hpp
+ * @brief      : Performance benchmark for the TCP Shell Interface (TSIF).
+ *
+ * System:     : cloudFPGA
+ * Component   : cFp_HelloKale/ROLE/TcpShellInterface (TSIF)
+ * Language    : Vivado HLS
+ *
+ * \ingroup tcp_shell_if
+ * \addtogroup tcp_shell_if
+ * \{
+ *****************************************************************************/
+
+#ifndef _BENCH_TSIF_H_
+#define _BENCH_TSIF_H_
+
+#include <deque>
+#include <string>
+#include <vector>
+
+#include "../src/tcp_shell_if.hpp"
+#include "./simu_tcp_shell_if_env.hpp"
+
+//---------------------------------------------------------
+//-- TESTBENCH GLOBAL VARIABLES
+//---------------------------------------------------------
+unsigned int    gSimCycCnt    = 0;
+bool            gTraceEvent   = false;
+bool            gFatalError   = false;
+unsigned int    gMaxSimCycles = cSimToeStartupDelay + cGraceTime;
+
+//---------------------------------------------------------
+//-- BENCHMARK DEFINES
+//---------------------------------------------------------
+const int cBenchDefNrSess     =    8;  // Default number of sessions
+const int cBenchDefNrNotifs   = 1024;  // Default number of notifications
+const int cBenchDefSegLen     =   64;  // Default segment length (in bytes)
+const int cBenchDefDReqLat    =   16;  // Default latency of the TOE upon a DReq (in cycles)
+
+const int cBenchNrMixedSegLens = 7;     // #Segment lengths of a mixed-size traffic (segLen=0)
+const int cBenchMixedSegLens[cBenchNrMixedSegLens] = { 1, 13, 65, 139, 257, 611, 1460 };
+
+const int cBenchToeRxBufBytes = 0xFFFF;  // Size of the per-session Rx buffer of the TOE
+
+const int cBenchDReqWindow    =    8;  // #Cycles over which the peak DReq rate is measured
+
+const double cBenchMinJainIndex = 0.95;   // Minimum fairness among equally loaded sessions
+
+const int cBenchMixDefMsgLen  =   64;  // Default length of a short message (in bytes)
+const int cBenchMixNrMsgs     =   64;  // #Messages sent by every short-message session
+const int cBenchMixMsgPeriod  = 1024;  // #Cycles between two messages of a short-message session
+const int cBenchMixBulkSegLen = 1460;  // #Bytes per notification of a bulk session
+const int cBenchMixBulkWindow = 8 * cBenchMixBulkSegLen;  // #Bytes a bulk session keeps notified ahead
+
+const int cBenchGenDefBytes   = 60000;  // Default #bytes of a Tx test transfer
+const int cBenchGenPortBase   = 5000;   // TCP port of the remote socket of the 1st transfer
+const int cBenchGenSessBase   =   16;   // Session id of the 1st transfer (above the Rx sessions, below cMaxSessions)
+const double cBenchGenMinRate = 0.95;   // Min. Tx rate of an unlimited generator (in fraction of line rate)
+const double cBenchGenRateTol = 0.05;   // Max. deviation of a rate-limited generator from its rate
+
+const int cBenchIpfDefBytes   = 60000;  // Default #bytes sent by every iperf stream
+const int cBenchIpfNotifLen   =  1460;  // Max. #bytes per notification of an iperf session
+const int cBenchIpfCtrlSess   =     0;  // Session id of the iperf3 control channel
+const double cBenchIpfMinRate = 0.90;   // Min. iperf goodput (in fraction of line rate)
+
+const int cBenchCliDefMsgs    =  1024;  // Default #messages sent to the remote sockets
+const int cBenchCliDefMsgLen  =    64;  // Default length of a message (in bytes)
+const int cBenchCliDefOpnLat  =   100;  // Default latency of the TOE upon an open request (in cycles)
+const int cBenchCliMaxOpnLat  =   200;  // Max. latency of the TOE upon an open request (below the csim open timeout of [COn])
+const int cBenchCliFailHoldOff =  5000;  // #Cycles [COn] holds off a socket which failed to open (csim hold-off)
+const int cBenchCliOpnExpiry  =  1250;  // #Cycles before [COn] frees the slot of a lost open request (csim timeout + expiry)
+const int cBenchCliPortBase   =  6000;  // TCP port of the 1st remote socket
+const int cBenchCliSessBase   =    16;  // Session id of the 1st remote socket (above the Rx sessions, below cMaxSessions)
+const int cBenchCliMinRateLen =    64;  // Min. message length for which the Tx rate is assessed (in bytes)
+const double cBenchCliMinRate = 0.90;   // Min. Tx rate once the connections are opened (in fraction of line rate)
+
+const int cBenchTxbDefMsgs    =   256;  // Default #messages sent by [TAF]
+const int cBenchTxbDefMsgLen  =  1000;  // Default length of a message (in bytes)
+const int cBenchTxbDefBufLen  =  1024;  // Default size of the per-session Tx buffer of the TOE (in bytes)
+const int cBenchTxbDefDrain   =     8;  // Default #cycles for the TOE to drain a chunk from a Tx buffer
+const int cBenchTxbDefSegLen  =   256;  // Default max. length of a Tx segment (in bytes)
+const int cBenchTxbStallCyc   =  6000;  // #Cycles a stalled Tx buffer does not drain after its first refusal
+                                         //  (longer than the attempts of [WRp] to send a parked segment in csim)
+const int cBenchTxbQuiet      =  4096;  // #Cycles without a request of a blocked session before it is considered given up
+                                         //  (above the longest backoff of [WRp] in csim)
+
+//---------------------------------------------------------
+//-- BENCHMARK CONFIGURATION
+//---------------------------------------------------------
+class BenchCfg {
+  public:
+    int         nrSess;    // #Sessions to spread the notifications over
+    int         nrNotifs;  // #Notifications to inject
+    int         segLen;    // #Bytes per notification (0 = cycle through 'cBenchMixedSegLens')
+    TcpPort     dstPort;   // TCP destination port of the notifications
+    int         dreqLat;   // #Cycles between a DReq and its first data chunk
+    bool        sink;      // 'dstPort' is programmed as a sink port
+    bool        reorder;   // The TOE serves the data requests of different sessions out of order
+    int         coaBytes;  // Flush threshold of the Rx coalescing (in bytes, 0=disabled)
+    int         coaTmo;    // Flush timeout of the Rx coalescing (in cycles)
+    BenchCfg() : nrSess(cBenchDefNrSess), nrNotifs(cBenchDefNrNotifs), segLen(cBenchDefSegLen),
+                 dstPort(ECHO_MODE_LSN_PORT), dreqLat(cBenchDefDReqLat), sink(false), reorder(false),
+                 coaBytes(0), coaTmo(cRcoDefTimeout) {}
+};
+
+//---------------------------------------------------------
+//-- BENCHMARK CONFIGURATION FOR MIXED TRAFFIC
+//--  Sessions [0:nrBulk-1] are bulk sessions which are kept
+//--  backlogged, while sessions [nrBulk:nrBulk+nrShort-1]
+//--  periodically send a short message.
+//---------------------------------------------------------
+class BenchMixCfg {
+  public:
+    int         nrShort;   // #Short-message sessions
+    int         nrBulk;    // #Bulk sessions
+    int         quantum;   // DRR quantum programmed into TSIF (in bytes)
+    int         msgLen;    // #Bytes per short message
+    int         dreqLat;   // #Cycles between a DReq and its first data chunk
+    BenchMixCfg() : nrShort(4), nrBulk(2), quantum(256), msgLen(cBenchMixDefMsgLen),
+                    dreqLat(cBenchDefDReqLat) {}
+};
+
+//---------------------------------------------------------
+//-- BENCHMARK CONFIGURATION FOR THE TX TRAFFIC GENERATOR
+//--  Every session sends one 8801 command which requests
+//--  'nrBytes' bytes on its own remote socket. The extended
+//--  command format is used if 'nrBytes' does not fit into
+//--  16 bits or if the transfer is repeated.
+//---------------------------------------------------------
+class BenchGenCfg {
+  public:
+    int         nrSess;    // #Concurrent transfers
+    long        nrBytes;   // #Bytes per transfer
+    int         pattern;   // Payload pattern (see 'GenPattern')
+    int         rate;      // Rate limit (in 1/256 bytes per cycle, 0=unlimited)
+    bool        stamp;     // Segments carry a sequence number and a timestamp
+    int         repeat;    // #Times the transfer is sent (0=legacy command)
+    int         segLen;    // Max. length of a Tx segment (0=default of [TSIF])
+    BenchGenCfg() : nrSess(1), nrBytes(cBenchGenDefBytes), pattern(GEN_PAT_INCR),
+                    rate(0), stamp(false), repeat(0), segLen(0) {}
+    bool isExtended() const { return (nrBytes > 0xFFFF) or (repeat != 0); }
+};
+
+//---------------------------------------------------------
+//-- BENCHMARK CONFIGURATION FOR THE IPERF SERVER
+//--  An iperf3 client runs a test of 'nrStreams' parallel
+//--  streams of 'nrBytes' bytes each, while an iperf2
+//--  client sends 'nrBytes' bytes to port 5001.
+//---------------------------------------------------------
+class BenchIpfCfg {
+  public:
+    int         nrStreams;  // #Parallel streams of the iperf3 test
+    int         nrBytes;    // #Bytes per stream
+    BenchIpfCfg() : nrStreams(1), nrBytes(cBenchIpfDefBytes) {}
+};
+
+//---------------------------------------------------------
+//-- BENCHMARK CONFIGURATION FOR THE SOCKET-ADDRESSED TX
+//--  [TAF] sends 'nrMsgs' back-to-back messages of 'msgLen'
+//--  bytes to 'nrSocks' remote sockets in turn. The TOE
+//--  answers an open request after 'opnLat' cycles, and
+//--  refuses the connections of the first 'nrFail' sockets.
+//--  A 'lossy' TOE never answers the 1st open request of
+//--  every socket.
+//---------------------------------------------------------
+class BenchCliCfg {
+  public:
+    int         nrSocks;   // #Remote sockets
+    int         nrMsgs;    // #Messages sent by [TAF]
+    int         msgLen;    // #Bytes per message
+    int         opnLat;    // #Cycles between an open request and its reply
+    int         nrFail;    // #Remote sockets which refuse their connection
+    bool        lossy;     // The TOE loses the 1st open request of every socket
+    BenchCliCfg() : nrSocks(4), nrMsgs(cBenchCliDefMsgs), msgLen(cBenchCliDefMsgLen),
+                    opnLat(cBenchCliDefOpnLat), nrFail(0), lossy(false) {}
+};
+
+//---------------------------------------------------------
+//-- BENCHMARK CONFIGURATION FOR THE TX BUFFER BACK-PRESSURE
+//--  [TAF] sends 'nrMsgs' back-to-back messages of 'msgLen'
+//--  bytes. Every session gets one message in turn, and the
+//--  next messages go to the unblocked sessions only. The
+//--  TOE has a Tx buffer of 'bufLen' bytes per session which
+//--  drains one chunk every 'drain' cycles, except for the
+//--  first 'nrStall' sessions which stall for a while once
+//--  they refused a request, and for the next 'nrLost'
+//--  sessions which lose their connection upon their first
+//--  'NO_SPACE' reply. The message of a blocked session is
+//--  longer than 'bufLen', such that it is given up.
+//---------------------------------------------------------
+class BenchTxbCfg {
+  public:
+    int         nrSess;    // #Sessions
+    int         nrMsgs;    // #Messages sent by [TAF]
+    int         msgLen;    // #Bytes per message
+    int         bufLen;    // #Bytes of the Tx buffer of a session
+    int         drain;     // #Cycles to drain a chunk from a Tx buffer
+    int         nrStall;   // #Sessions whose Tx buffer stalls
+    int         nrLost;    // #Sessions which lose their connection
+    int         segLen;    // Max. length of a Tx segment
+    BenchTxbCfg() : nrSess(8), nrMsgs(cBenchTxbDefMsgs), msgLen(cBenchTxbDefMsgLen),
+                    bufLen(cBenchTxbDefBufLen), drain(cBenchTxbDefDrain), nrStall(0), nrLost(0),
+                    segLen(cBenchTxbDefSegLen) {}
+    int  nrBlocked()          const { return nrStall + nrLost; }
+    bool isBlocked(int sess)  const { return sess < nrBlocked(); }
+};
+
+//---------------------------------------------------------
+//-- BENCHMARK STATISTICS OF A TX SESSION
+//--  The messages of a session must be received in order.
+//--  The remainder of a message may be dropped, but never
+//--  a part in the middle of it.
+//---------------------------------------------------------
+class BenchTxbSess {
+  public:
+    std::deque<int> expMsgs;    // Index of the messages expected by the session
+    unsigned long   msgBytes;   // #Bytes received in the current message
+    unsigned long   rcvdBytes;  // #Bytes received by the session
+    int             space;      // #Bytes free in the Tx buffer of the session
+    bool            lost;       // The connection of the session is lost
+    int             nrRefused;  // #Requests to send refused with 'NO_SPACE'
+    int             nrTrunc;    // #Messages whose remainder was dropped
+    int             nrDropped;  // #Messages entirely dropped
+    BenchTxbSess() : msgBytes(0), rcvdBytes(0), space(0), lost(false), nrRefused(0),
+                     nrTrunc(0), nrDropped(0) {}
+};
+
+//---------------------------------------------------------
+//-- BENCHMARK STATISTICS OF A REMOTE SOCKET
+//--  The messages sent to a socket are expected in order.
+//--  A message is identified by its index, which is also
+//--  carried by every chunk of its payload.
+//---------------------------------------------------------
+class BenchCliSock {
+  public:
+    std::deque<int> expMsgs;    // Index of the messages expected by the socket
+    unsigned long   msgBytes;   // #Bytes received in the current message
+    unsigned long   rcvdBytes;  // #Bytes received by the socket
+    int             nrOpens;    // #Open requests received for the socket
+    BenchCliSock() : msgBytes(0), rcvdBytes(0), nrOpens(0) {}
+};
+
+//---------------------------------------------------------
+//-- BENCHMARK SESSION OF AN IPERF CLIENT
+//--  The bytes of a session are first queued for notifi-
+//--  cation, and then served upon the data requests.
+//---------------------------------------------------------
+class BenchIpfSess {
+  public:
+    TcpPort       dstPort;    // Iperf port of the server
+    std::deque<unsigned char> toNotify;  // Bytes not notified yet
+    std::deque<unsigned char> notified;  // Bytes notified but not served yet
+    unsigned long reqBytes;   // #Bytes requested by TSIF but not served yet
+    std::string   rcvd;       // Bytes sent by TSIF on this session
+    unsigned long ivalSum;    // Sum of the interval bytes of the reports
+    unsigned long rptTotal;   // Total bytes of the last report
+    int           nrRpts;     // #Reports of this session
+    bool          released;   // The last report of the session was received
+    BenchIpfSess(TcpPort _dstPort) : dstPort(_dstPort), reqBytes(0), ivalSum(0),
+                                     rptTotal(0), nrRpts(0), released(false) {}
+};
+
+//---------------------------------------------------------
+//-- BENCHMARK STATISTICS OF A TX TEST TRANSFER
+//---------------------------------------------------------
+class BenchGenStats {
+  public:
+    unsigned long rcvdBytes;  // #Bytes received by the TOE
+    unsigned long chunkIdx;   // Index of the next chunk of the transfer
+    unsigned long segIdx;     // Index of the next segment of the transfer
+    unsigned long segBytes;   // #Bytes received in the current segment
+    ap_uint<64>   prbs;       // Expected state of the pseudo-random sequence
+    BenchGenStats() : rcvdBytes(0), chunkIdx(0), segIdx(0), segBytes(0), prbs(0) {}
+};
+
+//---------------------------------------------------------
+//-- BENCHMARK MESSAGE
+//--  A message is considered received when the byte counter
+//--  of its session reaches 'endByte'.
+//---------------------------------------------------------
+class BenchMsg {
+  public:
+    unsigned long endByte;   // Session byte count at the end of the message
+    unsigned int  injCyc;    // Cycle at which the message was notified
+    BenchMsg(unsigned long _endByte, unsigned int _injCyc) :
+        endByte(_endByte), injCyc(_injCyc) {}
+};
+
+//---------------------------------------------------------
+//-- BENCHMARK SESSION STATISTICS
+//---------------------------------------------------------
+class BenchSessStats {
+  public:
+    unsigned long notifBytes;  // #Bytes notified to TSIF
+    unsigned long reqBytes;    // #Bytes requested by TSIF
+    unsigned long srvdBytes;   // #Bytes delivered by TOE to TSIF
+    unsigned long rcvdBytes;   // #Bytes forwarded by TSIF to TAF
+    unsigned long reqChunks;   // #Chunks requested by TSIF
+    unsigned long rcvdChunks;  // #Chunks forwarded by TSIF to TAF
+    int           nrMsgs;      // #Messages notified to TSIF
+    std::deque<BenchMsg>      msgs;       // Messages in flight
+    std::vector<unsigned int> latencies;  // Notification-to-last-byte latency of the received messages
+    BenchSessStats() : notifBytes(0), reqBytes(0), srvdBytes(0), rcvdBytes(0),
+                       reqChunks(0), rcvdChunks(0), nrMsgs(0) {}
+};
+
+//---------------------------------------------------------
+//-- BENCHMARK RESULTS FOR MIXED TRAFFIC
+//---------------------------------------------------------
+class BenchMixResult {
+  public:
+    unsigned int  nrMsgs;      // #Short messages received
+    double        avgLat;      // Average latency of the short messages (in cycles)
+    unsigned int  p99Lat;      // 99th percentile latency of the short messages (in cycles)
+    unsigned int  maxLat;      // Maximum latency of the short messages (in cycles)
+    double        bulkRate;    // Bulk goodput (in bytes/cycle)
+    BenchMixResult() : nrMsgs(0), avgLat(0), p99Lat(0), maxLat(0), bulkRate(0) {}
+};
+
+//---------------------------------------------------------
+//-- DUT SIGNAL AND STREAM INTERFACES
+//---------------------------------------------------------
+class BenchDutItf {
+  public:
+    CmdBit               sMMIO_TSIF_Enable;
+    stream<MmioCfgCmd>   ssMMIO_TSIF_CfgCmd;
+    stream<SinkStats>    ssTSIF_MMIO_SinkStats;
+    stream<TcpAppData>   ssTAF_TSIF_Data;
+    stream<TcpSessId>    ssTAF_TSIF_SessId;
+    stream<TcpDatLen>    ssTAF_TSIF_DatLen;
+    stream<TcpAppData>   ssTAF_TSIF_SockData;
+    stream<SockAddr>     ssTAF_TSIF_SockAddr;
+    stream<TcpDatLen>    ssTAF_TSIF_SockLen;
+    stream<SockSndRep>   ssTSIF_TAF_SockRep;
+    stream<TcpAppData>   ssTSIF_TAF_Data;
+    stream<TcpSessId>    ssTSIF_TAF_SessId;
+    stream<TcpDatLen>    ssTSIF_TAF_DatLen;
+    stream<TcpAppNotif>  ssTOE_TSIF_Notif;
+    stream<TcpAppData>   ssTOE_TSIF_Data;
+    stream<TcpAppMeta>   ssTOE_TSIF_Meta;
+    stream<TcpAppRdReq>  ssTSIF_TOE_DReq;
+    stream<TcpAppLsnRep> ssTOE_TSIF_LsnRep;
+    stream<TcpAppLsnReq> ssTSIF_TOE_LsnReq;
+    stream<TcpAppSndRep> ssTOE_TSIF_SndRep;
+    stream<TcpAppData>   ssTSIF_TOE_Data;
+    stream<TcpAppSndReq> ssTSIF_TOE_SndReq;
+    stream<TcpAppOpnRep> ssTOE_TSIF_OpnRep;
+    stream<TcpAppOpnReq> ssTSIF_TOE_OpnReq;
+    stream<TcpAppClsReq> ssTSIF_TOE_ClsReq;
+    stream<ap_uint<32> > ssTSIF_DBG_SinkCnt;
+    stream<ap_uint<16> > ssTSIF_DBG_InpBufSpace;
+    stream<ConnEvent>    ssTSIF_DBG_OpnEvent;
+    stream<IperfReport>  ssTSIF_DBG_IpfReport;
+    BenchDutItf() :
+        sMMIO_TSIF_Enable(1),
+        ssMMIO_TSIF_CfgCmd("ssMMIO_TSIF_CfgCmd"),
+        ssTSIF_MMIO_SinkStats("ssTSIF_MMIO_SinkStats"),
+        ssTAF_TSIF_Data  ("ssTAF_TSIF_Data"),
+        ssTAF_TSIF_SessId("ssTAF_TSIF_SessId"),
+        ssTAF_TSIF_DatLen("ssTAF_TSIF_DatLen"),
+        ssTAF_TSIF_SockData("ssTAF_TSIF_SockData"),
+        ssTAF_TSIF_SockAddr("ssTAF_TSIF_SockAddr"),
+        ssTAF_TSIF_SockLen ("ssTAF_TSIF_SockLen"),
+        ssTSIF_TAF_SockRep ("ssTSIF_TAF_SockRep"),
+        ssTSIF_TAF_Data  ("ssTSIF_TAF_Data"),
+        ssTSIF_TAF_SessId("ssTSIF_TAF_SessId"),
+        ssTSIF_TAF_DatLen("ssTSIF_TAF_DatLen"),
+        ssTOE_TSIF_Notif ("ssTOE_TSIF_Notif"),
+        ssTOE_TSIF_Data  ("ssTOE_TSIF_Data"),
+        ssTOE_TSIF_Meta  ("ssTOE_TSIF_Meta"),
+        ssTSIF_TOE_DReq  ("ssTSIF_TOE_DReq"),
+        ssTOE_TSIF_LsnRep("ssTOE_TSIF_LsnRep"),
+        ssTSIF_TOE_LsnReq("ssTSIF_TOE_LsnReq"),
+        ssTOE_TSIF_SndRep("ssTOE_TSIF_SndRep"),
+        ssTSIF_TOE_Data  ("ssTSIF_TOE_Data"),
+        ssTSIF_TOE_SndReq("ssTSIF_TOE_SndReq"),
+        ssTOE_TSIF_OpnRep("ssTOE_TSIF_OpnRep"),
+        ssTSIF_TOE_OpnReq("ssTSIF_TOE_OpnReq"),
+        ssTSIF_TOE_ClsReq("ssTSIF_TOE_ClsReq"),
+        ssTSIF_DBG_SinkCnt("ssTSIF_DBG_SinkCnt"),
+        ssTSIF_DBG_InpBufSpace("ssTSIF_DBG_InpBufSpace"),
+        ssTSIF_DBG_OpnEvent("ssTSIF_DBG_OpnEvent"),
+        ssTSIF_DBG_IpfReport("ssTSIF_DBG_IpfReport") {}
+};
+
+#endif
+
+/*! \} */
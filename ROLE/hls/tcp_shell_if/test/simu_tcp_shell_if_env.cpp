@@ -53,6 +53,9 @@ extern bool         gTraceEvent;
 extern bool         gFatalError;
 extern unsigned int gMaxSimCycles; //  = cSimToeStartupDelay + cGraceTime;
 
+unsigned long gSimSinkBytes = 0;  // #Bytes notified to the sink port (see 'RECV_MODE_LSN_PORT')
+map<unsigned int, int> gSimLsnReqCnt;  // #Listen requests received by the TOE per port
+
 //---------------------------------------------------------
 // HELPERS FOR THE DEBUGGING TRACES
 //  .e.g: DEBUG_LEVEL = (MDL_TRACE | IPS_TRACE)
@@ -97,7 +100,43 @@ void increaseSimTime(unsigned int cycles) {
 }
 
 /*****************************************************************************
- * @brief Empty the DebugSinkCounter stream and throw it away.
+ * @brief Empty the SinkStats stream and check its last read-out against the
+ *  number of bytes notified to the sink port.
+ *
+ * @param[in/out] ss        A ref to the stream to drain.
+ * @param[in]     ssName    The name of the stream to drain.
+ *
+ * @return NTS_OK if successful,  otherwise NTS_KO.
+ ******************************************************************************/
+bool drainSinkStats(stream<SinkStats> &ss, string ssName) {
+    int          nr=0;
+    const char  *myName  = concat3(THIS_NAME, "/", "DSS");
+    SinkStats    stats;
+    bool         rc=NTS_OK;
+
+    //-- READ FROM STREAM
+    while (!(ss.empty())) {
+        ss.read(stats);
+        nr++;
+    }
+    if (nr == 0) {
+        printWarn(myName, "No sink statistics were read out from stream '%s'.\n", ssName.c_str());
+        return(NTS_KO);
+    }
+    printInfo(myName, "Sink statistics : %ld bytes in %ld segments (%d bytes in the last interval).\n",
+              (unsigned long)stats.bytes.to_uint64(), (unsigned long)stats.segs.to_uint64(),
+              stats.rate.to_uint());
+    if ((stats.bytes != gSimSinkBytes) or (stats.segs > stats.bytes)) {
+        printWarn(myName, "Houston, we have a problem !\n\tsunkBytes=%ld|notifiedBytes=%ld\n",
+                  (unsigned long)stats.bytes.to_uint64(), gSimSinkBytes);
+        rc=NTS_KO;
+    }
+    return(rc);
+}
+
+/*****************************************************************************
+ * @brief Empty the DebugSinkCounter stream and check its last value against
+ *  the number of bytes notified to the sink port.
  *
  * @param[in/out] ss        A ref to the stream to drain.
  * @param[in]     ssName    The name of the stream to drain.
@@ -107,7 +146,7 @@ void increaseSimTime(unsigned int cycles) {
 bool drainDebugSinkCounter(stream<ap_uint<32> > &ss, string ssName) {
     int          nr=0;
     const char  *myName  = concat3(THIS_NAME, "/", "DUMTF");
-    ap_uint<32>  currCount;
+    ap_uint<32>  currCount=0;
     ap_uint<32>  prevCount=0xFFFFFFFF;
     bool         rc=NTS_OK;
 
@@ -119,6 +158,13 @@ bool drainDebugSinkCounter(stream<ap_uint<32> > &ss, string ssName) {
             rc=NTS_KO;
         }
         prevCount = currCount;
+        nr++;
+    }
+    //-- ASSESS THE LAST COUNTER VALUE
+    if (currCount != (ap_uint<32>)gSimSinkBytes) {
+        printWarn(myName, "The last value of stream '%s' (%d) differs from the bytes notified to the sink port (%ld).\n",
+                  ssName.c_str(), currCount.to_uint(), gSimSinkBytes);
+        rc=NTS_KO;
     }
     return(rc);
 }
@@ -201,19 +247,54 @@ void pTAF(ofstream &ofTAF_Data,
     }
 }
 
+/*******************************************************************************
+ * @brief Check the listen requests received by the TOE for the ports of the
+ *   listen port reconfiguration (see 'pMMIO').
+ *
+ * @return NTS_OK if each port was requested exactly once, otherwise NTS_KO.
+ *******************************************************************************/
+bool checkToeLsnPorts() {
+    const char        *myName  = concat3(THIS_NAME, "/", "CTLP");
+    const unsigned int ports[2] = { RECFG_LSN_PORT_P, RECFG_LSN_PORT_Q };
+    bool               rc = NTS_OK;
+
+    for (int i=0; i<2; i++) {
+        if (gSimLsnReqCnt[ports[i]] != 1) {
+            printWarn(myName, "The TOE received %d listen request(s) for port %d instead of 1.\n",
+                      gSimLsnReqCnt[ports[i]], ports[i]);
+            rc = NTS_KO;
+        }
+    }
+    return(rc);
+}
+
 /*******************************************************************************
  * @brief Emulate the behavior of the SHELL & MMIO.
  *
  * @param[in]  piSHL_Ready    Ready signal from [SHELL].
  * @param[out] poTSIF_Enable  Enable signal to [TSIF] (.i.e, Enable Layer-7).
+ * @param[out] soTSIF_CfgCmd  Configuration command to [TSIF].
  *
+ * @details
+ *  Once [TSIF] is enabled, the spare entries #6 and #7 of the listen port table
+ *   are reprogrammed as follows:
+ *   - entry #6 is enabled on port 'P' and entry #7 shares that port,
+ *   - entry #6 is moved to port 'Q' and entry #7 follows,
+ *   - entry #6 is disabled and re-enabled right away.
+ *  A port which is already listening via another entry must not be requested
+ *   again, such that the TOE receives a single request per port (see
+ *   'checkToeLsnPorts').
  *******************************************************************************/
 void pMMIO(
         StsBit *piSHL_Ready,
-        CmdBit *poTSIF_Enable) {
+        CmdBit *poTSIF_Enable,
+        stream<MmioCfgCmd> &soTSIF_CfgCmd) {
     const char *myName = concat3(THIS_NAME, "/", "MMIO");
 
     static bool mmio_printOnce = true;
+    static int  mmio_cfgCycCnt = 0;
+
+    const ap_uint<32> cEnable = 0x10000;  // Enable bit of a listen port entry
 
     if (*piSHL_Ready) {
         *poTSIF_Enable = 1;
@@ -222,6 +303,25 @@ void pMMIO(
                     "[SHELL/NTS/TOE] is ready -> Enabling operation of the TCP Shell Interface [TSIF].\n");
             mmio_printOnce = false;
         }
+        switch (mmio_cfgCycCnt) {
+        case 40:
+            soTSIF_CfgCmd.write(MmioCfgCmd(CFG_LSN_PORT, 6, cEnable | RECFG_LSN_PORT_P));
+            break;
+        case 80:
+            soTSIF_CfgCmd.write(MmioCfgCmd(CFG_LSN_PORT, 7, cEnable | RECFG_LSN_PORT_P));
+            break;
+        case 120:
+            soTSIF_CfgCmd.write(MmioCfgCmd(CFG_LSN_PORT, 6, cEnable | RECFG_LSN_PORT_Q));
+            break;
+        case 160:
+            soTSIF_CfgCmd.write(MmioCfgCmd(CFG_LSN_PORT, 7, cEnable | RECFG_LSN_PORT_Q));
+            break;
+        case 200:
+            soTSIF_CfgCmd.write(MmioCfgCmd(CFG_LSN_PORT, 6,           RECFG_LSN_PORT_Q));
+            soTSIF_CfgCmd.write(MmioCfgCmd(CFG_LSN_PORT, 6, cEnable | RECFG_LSN_PORT_Q));
+            break;
+        }
+        mmio_cfgCycCnt++;
     } else {
         *poTSIF_Enable = 0;
     }
@@ -323,6 +423,7 @@ void pTOE(
                 printInfo(myLsnName, "Received a listen port request #%d from [TSIF].\n",
                           appLsnPortReq.to_int());
             }
+            gSimLsnReqCnt[appLsnPortReq.to_uint()]++;
             // SEND REPLY BACK TO [TSIF]
             if (!soTSIF_LsnRep.full()) {
                 soTSIF_LsnRep.write(TcpAppLsnRep(NTS_OK));
@@ -427,6 +528,9 @@ void pTOE(
                 }
                 soTSIF_Notif.write(TcpAppNotif(toe_sessId, toe_notifByteCnt, toe_hostIp4Addr,
                                     toe_hostTcpSrcPort, toe_hostTcpDstPort));
+                if (toe_hostTcpDstPort == RECV_MODE_LSN_PORT) {
+                    gSimSinkBytes += toe_notifByteCnt;
+                }
                 if (DEBUG_LEVEL & TRACE_TOE_RXP) {
                     printInfo(myRxpName, "Sending Notif to [TSIF] (sessId=%2d, datLen=%4d, dstPort=%4d).\n",
                             toe_sessId.to_int(), toe_notifByteCnt.to_int(), toe_hostTcpDstPort.to_uint());
@@ -620,7 +724,7 @@ void pTOE(
             else { //-- Session is ESTABLISHED and data-length <= maxWriteLength
                 // Notify APP about acceptance of the transmission
                 soTSIF_SndRep.write(TcpAppSndRep(toe_appSndReq.sessId,
-                                    toe_appSndReq.length, 0x10000, NO_ERROR));
+                                    toe_appSndReq.length, 0xFFFF, NO_ERROR));
             }
         }
         if (!siTSIF_Data.empty()) {
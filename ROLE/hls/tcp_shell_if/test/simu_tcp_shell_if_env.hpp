@@ -66,14 +66,25 @@ const int cMinWAIT = cMaxSessions;  // To avoid that TSIF accumulates the byte c
 #define DEFAULT_SESSION_ID       0
 #define DEFAULT_SESSION_LEN     32
 
+//---------------------------------------------------------
+//-- LISTEN PORT RECONFIGURATION
+//--  The MMIO emulator reprograms the spare entries #6 and
+//--  #7 of the listen port table with the following ports
+//--  while traffic is running.
+//---------------------------------------------------------
+#define RECFG_LSN_PORT_P        7000
+#define RECFG_LSN_PORT_Q        7001
+
 
 /*******************************************************************************
  * SIMULATION UTILITY HELPERS
  ********************************************************************************/
 void stepSim();
 void increaseSimTime(unsigned int cycles);
+bool drainSinkStats(stream<SinkStats> &ss, string ssName);
 bool drainDebugSinkCounter(stream<ap_uint<32> > &ss, string ssName);
 bool drainDebugSpaceCounter(stream<ap_uint<16> > &ss, string ssName);
+bool checkToeLsnPorts();
 
 
 /******************************************************************************
@@ -90,7 +101,8 @@ void pTAF(
 
 void pMMIO(
         StsBit *piSHL_Ready,
-        CmdBit *poTSIF_Enable);
+        CmdBit *poTSIF_Enable,
+        stream<MmioCfgCmd> &soTSIF_CfgCmd);
 
 void pTOE(
         int                  &nrErr,
@@ -120,10 +120,18 @@ int main(int argc, char *argv[]) {
     //------------------------------------------------------
     //-- DUT STREAM INTERFACES
     //------------------------------------------------------
+    //-- SHL / Mmio Interface
+    stream<MmioCfgCmd>   ssMMIO_TSIF_CfgCmd("ssMMIO_TSIF_CfgCmd");
+    stream<SinkStats>    ssTSIF_MMIO_SinkStats("ssTSIF_MMIO_SinkStats");
     //-- TAF / Rx Data Interface
     stream<TcpAppData>   ssTAF_TSIF_Data  ("ssTAF_TSIF_Data");
     stream<TcpSessId>    ssTAF_TSIF_SessId("ssTAF_TSIF_SessId");
     stream<TcpDatLen>    ssTAF_TSIF_DatLen("ssTAF_TSIF_DatLen");
+    //-- TAF / Rx Socket Interface
+    stream<TcpAppData>   ssTAF_TSIF_SockData("ssTAF_TSIF_SockData");
+    stream<SockAddr>     ssTAF_TSIF_SockAddr("ssTAF_TSIF_SockAddr");
+    stream<TcpDatLen>    ssTAF_TSIF_SockLen ("ssTAF_TSIF_SockLen");
+    stream<SockSndRep>   ssTSIF_TAF_SockRep ("ssTSIF_TAF_SockRep");
     //-- TSIF / Tx Data Interface
     stream<TcpAppData>   ssTSIF_TAF_Data  ("ssTSIF_TAF_Data");
     stream<TcpSessId>    ssTSIF_TAF_SessId("ssTSIF_TAF_SessId");
@@ -151,6 +159,8 @@ int main(int argc, char *argv[]) {
     //-- DEBUG Interface
     stream<ap_uint<32> > ssTSIF_DBG_SinkCnt("ssTSIF_DBG_SinkCnt");
     stream<ap_uint<16> > ssTSIF_DBG_InpBufSpace("ssTSIF_DBG_InpBufSpace");
+    stream<ConnEvent>    ssTSIF_DBG_OpnEvent("ssTSIF_DBG_OpnEvent");
+    stream<IperfReport>  ssTSIF_DBG_IpfReport("ssTSIF_DBG_IpfReport");
 
     //------------------------------------------------------
     //-- TESTBENCH VARIABLES
@@ -313,11 +323,16 @@ int main(int argc, char *argv[]) {
         //-------------------------------------------------
         //-- EMULATE SHELL/MMIO
         //-------------------------------------------------
+        if (gSimCycCnt + 8 == gMaxSimCycles) {
+            //-- Read-out the aggregated sink statistics before the end of the run
+            ssMMIO_TSIF_CfgCmd.write(MmioCfgCmd(CFG_SINK_STATS, cSinkStatsAll, 0));
+        }
         pMMIO(
             //-- TOE / Ready Signal
             &sTOE_MMIO_Ready,
             //-- MMIO / Enable Layer-7 (.i.e APP alias ROLE)
-            &sMMIO_TSIF_Enable);
+            &sMMIO_TSIF_Enable,
+            ssMMIO_TSIF_CfgCmd);
 
         //-------------------------------------------------
         //-- RUN DUT
@@ -325,8 +340,11 @@ int main(int argc, char *argv[]) {
         tcp_shell_if_top(
             //-- SHELL / Mmio Interface
             &sMMIO_TSIF_Enable,
+            ssMMIO_TSIF_CfgCmd,
+            ssTSIF_MMIO_SinkStats,
             //-- TAF / Rx & Tx Data Interfaces
             ssTAF_TSIF_Data, ssTAF_TSIF_SessId, ssTAF_TSIF_DatLen,
+            ssTAF_TSIF_SockData, ssTAF_TSIF_SockAddr, ssTAF_TSIF_SockLen, ssTSIF_TAF_SockRep,
             ssTSIF_TAF_Data, ssTSIF_TAF_SessId, ssTSIF_TAF_DatLen,
             //-- TOE / Rx Data Interfaces
             ssTOE_TSIF_Notif, ssTSIF_TOE_DReq, ssTOE_TSIF_Data,
@@ -341,7 +359,9 @@ int main(int argc, char *argv[]) {
             ssTSIF_TOE_ClsReq,
             //-- DEBUG Interfaces
             ssTSIF_DBG_SinkCnt,
-            ssTSIF_DBG_InpBufSpace);
+            ssTSIF_DBG_InpBufSpace,
+            ssTSIF_DBG_OpnEvent,
+            ssTSIF_DBG_IpfReport);
 
         //-------------------------------------------------
         //-- EMULATE ROLE/TcpApplicationFlash
@@ -374,11 +394,42 @@ int main(int argc, char *argv[]) {
             printError(THIS_NAME, "Failed to drain debug sink counter from DUT. \n");
         nrErr++;
     }
+    if (not drainSinkStats(ssTSIF_MMIO_SinkStats, "ssTSIF_MMIO_SinkStats")) {
+            printError(THIS_NAME, "Failed to read out the sink statistics from DUT. \n");
+        nrErr++;
+    }
     if (not drainDebugSpaceCounter(ssTSIF_DBG_InpBufSpace, "ssTSIF_DBG_InpBufSpace")) {
             printError(THIS_NAME, "Failed to drain debug space counter from DUT. \n");
         nrErr++;
     }
 
+    //---------------------------------------------------------------
+    //-- CHECK THE LISTEN REQUESTS RECEIVED BY THE TOE
+    //---------------------------------------------------------------
+    if (not checkToeLsnPorts()) {
+        printError(THIS_NAME, "The TOE did not receive the expected listen requests. \n");
+        nrErr++;
+    }
+
+    //---------------------------------------------------------------
+    //-- DRAIN THE TSIF OPEN CONNECTION EVENTS
+    //---------------------------------------------------------------
+    int nrOpened = 0;
+    while (!ssTSIF_DBG_OpnEvent.empty()) {
+        ConnEvent opnEvent = ssTSIF_DBG_OpnEvent.read();
+        if (opnEvent.code == CONN_EVT_OPENED) {
+            nrOpened++;
+        }
+        else if (opnEvent.code == CONN_EVT_FAILED) {
+            printError(THIS_NAME, "Failed to open a connection after %d attempts.\n", opnEvent.nrTries.to_uint());
+            nrErr++;
+        }
+    }
+    if (nrOpened == 0) {
+        printError(THIS_NAME, "No connection was reported as opened by the DUT. \n");
+        nrErr++;
+    }
+
     //---------------------------------------------------------------
     //-- COMPARE RESULT DATA FILE WITH GOLDEN FILE
     //---------------------------------------------------------------
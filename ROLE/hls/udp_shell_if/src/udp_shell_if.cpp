@@ -38,7 +38,7 @@
  *          |       |  |  +------+     +-------------+  |
  *          +-------+  +--------------------------------+
  *
- * [TODO] - The DEFAULT_FPGA_LSN_PORT (0x2263=8803) and the DEFAULT_HOST_IP4_ADDR must be made programmable.
+ * [TODO] - The DEFAULT_HOST_IP4_ADDR must be made programmable.
  *
  * \ingroup udp_shell_if 
  * \addtogroup udp_shell_if 
@@ -66,45 +66,52 @@ using namespace std;
 #define TRACE_SAM 1 <<  3
 #define TRACE_LSN 1 <<  4
 #define TRACE_CLS 1 <<  5
+#define TRACE_MCH 1 <<  6
 #define TRACE_ALL  0xFFFF
 #define DEBUG_LEVEL (TRACE_OFF)
 
 enum DropCmd {KEEP_CMD=false, DROP_CMD};
 
-//---------------------------------------------------------
-//-- DEFAULT LOCAL FPGA AND FOREIGN HOST SOCKETS
-//--  By default, the following sockets will be used by the
-//--  UDP Role Interface, unless the user specifies new ones
-//--  via TBD.
-//--  FYI --> 8803 is the ZIP code of Ruschlikon ;-)
-//---------------------------------------------------------
-#define DEFAULT_FPGA_LSN_PORT   0x2263      // ROLE   listens on port = 8803
-
 
 /*******************************************************************************
  * @brief Listen(LSn)
  *
  * @param[in]  piSHL_Enable  Enable signal from [SHELL].
+ * @param[in]  siMCh_PortCfg An entry of the listen port table from MmioConfigHandler (MCh).
  * @param[out] soSHL_LsnReq  Listen port request to [SHELL].
  * @param[in]  siSHL_LsnRep  Listen reply from [SHELL].
+ * @param[out] soCLs_ClsReq  Close port request to Close (CLs).
+ * @param[in]  siCLs_ClsAck  Close port acknowledgment from [CLs].
  *
  * @details
- *  This process requests the SHELL/NTS/UOE to open a specific port in receive
- *   mode. Although the notion of 'listening' does not exist for unconnected UDP
- *   mode, we keep that name for this process because it puts an FPGA receive
- *   port on hold and ready accept incoming traffic (.i.e, it opens a connection
- *   in server mode).
- *  By default, the port numbers 5001, 5201, 8800, 8801 and 8803 will always be
- *   opened in listen mode at startup. Later on, we should be able to open more
- *   ports if we provide some configuration register for the user to specify new
- *   ones.
+ *  This process requests the SHELL/NTS/UOE to open the ports of a run-time
+ *   programmable listen port table in receive mode. Although the notion of
+ *   'listening' does not exist for unconnected UDP mode, we keep that name for
+ *   this process because it puts an FPGA receive port on hold and ready accept
+ *   incoming traffic (.i.e, it opens a connection in server mode).
+ *  By default, the entries [0:5] of the table hold the port numbers 8800 to
+ *   8803, 5001 and 5201, and will be opened at startup. The table can be
+ *   updated via MMIO (see 'CFG_LSN_PORT') while traffic is running. Every
+ *   enabled entry which is not yet opened is opened, one request at a time and
+ *   in round-robin order. When an opened entry is disabled or reprogrammed,
+ *   its former port is forwarded to the process Close (CLs), unless another
+ *   entry of the table still holds that port.
+ *  The close requests which are forwarded to [CLs] are kept in a table of
+ *   pending closes until [CLs] acknowledges them. A port is not requested
+ *   again while a close of that port is pending. Otherwise, the UOE could
+ *   receive the close request after the new listen request and end up closing
+ *   a port which is supposed to be opened.
  *  As opposed to the TCP Offload engine (TOE), the UOE supports a total of
- *   65,535 (0xFFFF) connections in listening mode.
+ *   65,535 (0xFFFF) connections in listening mode. The table is nevertheless
+ *   restricted to the static ports [1:32767] (see 'pMmioConfigHandler').
  *******************************************************************************/
 void pListen(
         CmdBit              *piSHL_Enable,
+        stream<LsnPortCfg>   &siMCh_PortCfg,
         stream<UdpPort>      &soSHL_LsnReq,
-        stream<StsBool>      &siSHL_LsnRep)
+        stream<StsBool>      &siSHL_LsnRep,
+        stream<UdpPort>      &soCLs_ClsReq,
+        stream<UdpPort>      &siCLs_ClsAck)
 {
     //-- DIRECTIVES FOR THIS PROCESS ------------------------------------------
     #pragma HLS INLINE off
@@ -112,62 +119,103 @@ void pListen(
 
     const char *myName = concat3(THIS_NAME, "/", "LSn");
 
+    //-- STATIC ARRAYS (Listen port table) ------------------------------------
+    static UdpPort             LSN_PORT[cLsnPortEntries] = {
+        RECV_MODE_LSN_PORT, XMIT_MODE_LSN_PORT, ECHO_MOD2_LSN_PORT,
+        ECHO_MODE_LSN_PORT, IPERF_LSN_PORT,     IPREF3_LSN_PORT };
+    #pragma HLS ARRAY_PARTITION variable=LSN_PORT complete dim=1
+    #pragma HLS reset           variable=LSN_PORT
+    static bool                LSN_ENA[cLsnPortEntries] = {
+        true, true, true, true, true, true };
+    #pragma HLS ARRAY_PARTITION variable=LSN_ENA  complete dim=1
+    #pragma HLS reset           variable=LSN_ENA
+    static bool                LSN_OPEN[cLsnPortEntries];  // The UOE listens on this entry
+    #pragma HLS ARRAY_PARTITION variable=LSN_OPEN complete dim=1
+    #pragma HLS reset           variable=LSN_OPEN
+
+    //-- STATIC ARRAYS (Pending close table) ----------------------------------
+    static UdpPort             CLS_PORT[cLsnPortEntries];
+    #pragma HLS ARRAY_PARTITION variable=CLS_PORT complete dim=1
+    static bool                CLS_PEND[cLsnPortEntries];  // A close of this port is pending
+    #pragma HLS ARRAY_PARTITION variable=CLS_PEND complete dim=1
+    #pragma HLS reset           variable=CLS_PEND
+
     //-- STATIC CONTROL VARIABLES (with RESET) --------------------------------
-    static enum FsmStates { LSN_IDLE, LSN_SEND_REQ, LSN_WAIT_REP, LSN_DONE } \
+    static enum FsmStates { LSN_IDLE, LSN_SEND_REQ, LSN_WAIT_REP } \
                                lsn_fsmState=LSN_IDLE;
     #pragma HLS reset variable=lsn_fsmState
-    static ap_uint<3>          lsn_i = 0;
+    static LsnPortIdx          lsn_i = cLsnPortEntries-1;  // The last entry served
     #pragma HLS reset variable=lsn_i
-
-    //-- STATIC ARRAYS --------------------------------------------------------
-    static const UdpPort LSN_PORT_TABLE[6] = { RECV_MODE_LSN_PORT, XMIT_MODE_LSN_PORT,
-                                               ECHO_MOD2_LSN_PORT, ECHO_MODE_LSN_PORT,
-                                               IPERF_LSN_PORT,     IPREF3_LSN_PORT };
-    #pragma HLS RESOURCE variable=LSN_PORT_TABLE core=ROM_1P
+    static LsnPortIdx          lsn_clsWr = 0;  // The next entry of the pending close table to fill
+    #pragma HLS reset variable=lsn_clsWr
+    static LsnPortIdx          lsn_clsRd = 0;  // The oldest entry of the pending close table
+    #pragma HLS reset variable=lsn_clsRd
 
     //-- STATIC DATAFLOW VARIABLES --------------------------------------------
+    static UdpPort     lsn_port;  // The port of the pending listen request
     static ap_uint<8>  lsn_watchDogTimer;
 
+    //-- DYNAMIC VARIABLES ----------------------------------------------------
+    bool        found = false;
+    bool        isListening = false;
+    bool        isShared = false;
+    bool        isClosing = false;
+    bool        clsReqSent = false;
+    LsnPortIdx  nextIdx = 0;
+
+    //-- Release the pending close which was acknowledged by [CLs]
+    //--  (The closes are acknowledged in the order they were requested)
+    if (!siCLs_ClsAck.empty()) {
+        siCLs_ClsAck.read();
+        CLS_PEND[lsn_clsRd] = false;
+        lsn_clsRd++;
+    }
+    bool clsTblFull = CLS_PEND[lsn_clsWr];
+
     switch (lsn_fsmState) {
     case LSN_IDLE:
-        if (*piSHL_Enable != 1) {
-            return;
-        }
-        else {
-            if (lsn_i == 0) {
-                lsn_fsmState = LSN_SEND_REQ;
+        if (*piSHL_Enable == 1) {
+            //-- Search the next enabled entry which is not opened yet
+            for (int k=1; k<=cLsnPortEntries; ++k) {
+                #pragma HLS UNROLL
+                LsnPortIdx idx = lsn_i + k;
+                if (!found and LSN_ENA[idx] and !LSN_OPEN[idx]) {
+                    found   = true;
+                    nextIdx = idx;
+                }
             }
-            else {
-                //-- Port are already opened
-                lsn_fsmState = LSN_DONE;
+            if (found) {
+                lsn_i    = nextIdx;
+                lsn_port = LSN_PORT[nextIdx];
+                lsn_fsmState = LSN_SEND_REQ;
             }
         }
         break;
     case LSN_SEND_REQ:
-        if (!soSHL_LsnReq.full()) {
-            switch (lsn_i) {
-            case 0:
-                soSHL_LsnReq.write(RECV_MODE_LSN_PORT);
-                break;
-            case 1:
-                soSHL_LsnReq.write(XMIT_MODE_LSN_PORT);
-                break;
-            case 2:
-                soSHL_LsnReq.write(ECHO_MOD2_LSN_PORT);
-                break;
-            case 3:
-                soSHL_LsnReq.write(ECHO_MODE_LSN_PORT);
-                break;
-            case 4:
-                soSHL_LsnReq.write(IPERF_LSN_PORT);
-                break;
-            case 5:
-                soSHL_LsnReq.write(IPREF3_LSN_PORT);
-                break;
+        //-- Do not request a port which is already opened via another entry
+        //--  nor a port which is still being closed
+        for (int k=0; k<cLsnPortEntries; ++k) {
+            #pragma HLS UNROLL
+            if (LSN_OPEN[k] and (LSN_PORT[k] == lsn_port)) {
+                isListening = true;
+            }
+            if (CLS_PEND[k] and (CLS_PORT[k] == lsn_port)) {
+                isClosing = true;
             }
+        }
+        if (isClosing) {
+            //-- Retry once the close was acknowledged
+            lsn_fsmState = LSN_IDLE;
+        }
+        else if (isListening) {
+            LSN_OPEN[lsn_i] = true;
+            lsn_fsmState = LSN_IDLE;
+        }
+        else if (!soSHL_LsnReq.full()) {
+            soSHL_LsnReq.write(lsn_port);
             if (DEBUG_LEVEL & TRACE_LSN) {
                 printInfo(myName, "Server is requested to listen on port #%d (0x%4.4X).\n",
-                          LSN_PORT_TABLE[lsn_i].to_uint(), LSN_PORT_TABLE[lsn_i].to_uint());
+                          lsn_port.to_uint(), lsn_port.to_uint());
             }
             #ifndef __SYNTHESIS__
                 lsn_watchDogTimer = 10;
@@ -182,52 +230,99 @@ void pListen(
         break;
     case LSN_WAIT_REP:
         lsn_watchDogTimer--;
-        if (!siSHL_LsnRep.empty()) {
+        if (!siSHL_LsnRep.empty() and !soCLs_ClsReq.full() and !clsTblFull) {
             UdpAppLsnRep listenDone;
             siSHL_LsnRep.read(listenDone);
             if (listenDone) {
-                printInfo(myName, "Received OK listen reply from [UOE] for port %d.\n", LSN_PORT_TABLE[lsn_i].to_uint());
-                if (lsn_i == sizeof(LSN_PORT_TABLE)/sizeof(LSN_PORT_TABLE[0])-1) {
-                    lsn_fsmState = LSN_DONE;
+                printInfo(myName, "Received OK listen reply from [UOE] for port %d.\n", lsn_port.to_uint());
+                if (LSN_ENA[lsn_i] and (LSN_PORT[lsn_i] == lsn_port)) {
+                    LSN_OPEN[lsn_i] = true;
                 }
                 else {
-                    //-- Set next listen port number
-                    lsn_i += 1;
-                    lsn_fsmState = LSN_SEND_REQ;
+                    //-- The entry was reprogrammed in the mean time
+                    for (int k=0; k<cLsnPortEntries; ++k) {
+                        #pragma HLS UNROLL
+                        if (LSN_OPEN[k] and (LSN_PORT[k] == lsn_port)) {
+                            isShared = true;
+                        }
+                    }
+                    if (!isShared) {
+                        soCLs_ClsReq.write(lsn_port);
+                        CLS_PORT[lsn_clsWr] = lsn_port;
+                        CLS_PEND[lsn_clsWr] = true;
+                        lsn_clsWr++;
+                        clsReqSent = true;
+                    }
                 }
             }
             else {
                 printWarn(myName, "UOE denied listening on port %d (0x%4.4X).\n",
-                          LSN_PORT_TABLE[lsn_i].to_uint(), LSN_PORT_TABLE[lsn_i].to_uint());
-                lsn_fsmState = LSN_SEND_REQ;
+                          lsn_port.to_uint(), lsn_port.to_uint());
             }
+            lsn_fsmState = LSN_IDLE;
         }
         else {
             if (lsn_watchDogTimer == 0) {
-                printError(myName, "Timeout: Server failed to listen on port %d %d (0x%4.4X).\n",
-                           LSN_PORT_TABLE[lsn_i].to_uint(), LSN_PORT_TABLE[lsn_i].to_uint());
-                //-- Try next listen port number
-                lsn_i += 1;
-                lsn_fsmState = LSN_SEND_REQ;
+                printError(myName, "Timeout: Server failed to listen on port %d (0x%4.4X).\n",
+                           lsn_port.to_uint(), lsn_port.to_uint());
+                lsn_fsmState = LSN_IDLE;
             }
         }
         break;
-    case LSN_DONE:
-        break;
     }  // End-of: switch()
+
+    //-- Update the listen port table (takes precedence over the FSM)
+    if (!siMCh_PortCfg.empty() and !soCLs_ClsReq.full() and !clsTblFull and !clsReqSent) {
+        LsnPortCfg portCfg = siMCh_PortCfg.read();
+        if ((portCfg.enable != LSN_ENA[portCfg.index]) or (portCfg.port != LSN_PORT[portCfg.index])) {
+            if (LSN_OPEN[portCfg.index]) {
+                //-- Close the former port unless another entry still holds it
+                isShared = false;
+                for (int k=0; k<cLsnPortEntries; ++k) {
+                    #pragma HLS UNROLL
+                    if ((k != portCfg.index) and LSN_OPEN[k] and (LSN_PORT[k] == LSN_PORT[portCfg.index])) {
+                        isShared = true;
+                    }
+                }
+                if (!isShared) {
+                    soCLs_ClsReq.write(LSN_PORT[portCfg.index]);
+                    CLS_PORT[lsn_clsWr] = LSN_PORT[portCfg.index];
+                    CLS_PEND[lsn_clsWr] = true;
+                    lsn_clsWr++;
+                }
+            }
+            LSN_OPEN[portCfg.index] = false;
+        }
+        LSN_ENA[portCfg.index]  = portCfg.enable;
+        LSN_PORT[portCfg.index] = portCfg.port;
+        if (DEBUG_LEVEL & TRACE_LSN) {
+            printInfo(myName, "%s listen port entry #%d (Port=%d).\n",
+                      (portCfg.enable ? "Enabling" : "Disabling"),
+                      portCfg.index.to_uint(), portCfg.port.to_uint());
+        }
+    }
 }  // End-of: pListen()
 
 /*******************************************************************************
  * @brief Request the SHELL/NTS/UOE to close a previously opened port.
  *
  * @param[in]  piSHL_Enable  Enable signal from [SHELL].
+ * @param[in]  siLSn_ClsReq  Close port request from Listen (LSn).
  * @param[out] soSHL_ClsReq  Close port request to [SHELL].
  * @param[in]  siSHL_ClsRep  Close port reply from [SHELL].
+ * @param[out] soLSn_ClsAck  Close port acknowledgment to [LSn].
+ *
+ * @details
+ *  The close requests of [LSn] are served one at a time and in order. Every
+ *   close which is acknowledged by [SHELL] is acknowledged to [LSn] in turn,
+ *   such that [LSn] can request that port again.
  *******************************************************************************/
 void pClose(
         CmdBit              *piSHL_Enable,
+        stream<UdpPort>      &siLSn_ClsReq,
         stream<UdpPort>      &soSHL_ClsReq,
-        stream<StsBool>      &siSHL_ClsRep)
+        stream<StsBool>      &siSHL_ClsRep,
+        stream<UdpPort>      &soLSn_ClsAck)
 {
     //-- DIRECTIVES FOR THIS PROCESS ------------------------------------------
     #pragma HLS INLINE off
@@ -236,11 +331,12 @@ void pClose(
     const char *myName = concat3(THIS_NAME, "/", "CLs");
 
     //-- STATIC CONTROL VARIABLES (with RESET) --------------------------------
-    static enum FsmStates { CLS_IDLE, CLS_SEND_REQ, CLS_WAIT_REP, CLS_DONE } \
+    static enum FsmStates { CLS_IDLE, CLS_SEND_REQ, CLS_WAIT_REP } \
                                cls_fsmState=CLS_IDLE;
     #pragma HLS reset variable=cls_fsmState
 
     //-- STATIC DATAFLOW VARIABLES --------------------------------------------
+    static UdpPort  cls_port;  // The port to close
 
     switch (cls_fsmState) {
     case CLS_IDLE:
@@ -252,51 +348,142 @@ void pClose(
             }
             return;
         }
-        else {
+        else if (!siLSn_ClsReq.empty()) {
+            siLSn_ClsReq.read(cls_port);
             cls_fsmState = CLS_SEND_REQ;
         }
         break;
     case CLS_SEND_REQ:
         if (!soSHL_ClsReq.full()) {
-            // [FIXME-Must take the port # from a CfgReg] - DEFAULT_FPGA_LSN_PORT;
-            // In the mean time, close a fake port to avoid the logic to be synthesized away.
-            UdpPort  udpClosePort = 0xDEAD;
-            soSHL_ClsReq.write(udpClosePort);
+            soSHL_ClsReq.write(cls_port);
             if (DEBUG_LEVEL & TRACE_CLS) {
                 printInfo(myName, "SHELL/NTS/USIF is requesting to close port #%d (0x%4.4X).\n",
-                          udpClosePort.to_int(), udpClosePort.to_int());
+                          cls_port.to_int(), cls_port.to_int());
             }
             cls_fsmState = CLS_WAIT_REP;
         }
         else {
-            printWarn(myName, "Cannot send a listen port request to [UOE] because stream is full!\n");
+            printWarn(myName, "Cannot send a close port request to [UOE] because stream is full!\n");
         }
         break;
     case CLS_WAIT_REP:
-        if (!siSHL_ClsRep.empty()) {
+        if (!siSHL_ClsRep.empty() and !soLSn_ClsAck.full()) {
             StsBool isOpened;
             siSHL_ClsRep.read(isOpened);
             if (not isOpened) {
-                printInfo(myName, "Received close acknowledgment from [UOE].\n");
-                cls_fsmState = CLS_DONE;
+                printInfo(myName, "Received close acknowledgment from [UOE] for port %d.\n",
+                          cls_port.to_int());
+                soLSn_ClsAck.write(cls_port);
+                cls_fsmState = CLS_IDLE;
             }
             else {
                 printWarn(myName, "UOE denied closing the port %d (0x%4.4X) which is still opened.\n",
-                          DEFAULT_FPGA_LSN_PORT, DEFAULT_FPGA_LSN_PORT);
+                          cls_port.to_int(), cls_port.to_int());
                 cls_fsmState = CLS_SEND_REQ;
             }
         }
         break;
-    case CLS_DONE:
-        break;
     }
 }  // End-of: pClose()
 
 
+/*******************************************************************************
+ * @brief MMIO Configuration Handler (MCh)
+ *
+ * @param[in]  siSHL_CfgCmd  A configuration command from [SHELL/MMIO].
+ * @param[out] soRDp_PortAct An entry of the port action table to ReadPath (RDp).
+ * @param[out] soLSn_PortCfg An entry of the listen port table to Listen (LSn).
+ *
+ * @details
+ *  This process decodes the configuration commands written by the MMIO
+ *   register path and dispatches them to the process which owns the targeted
+ *   table. Commands with an unknown table-id, an out-of-range index or an
+ *   invalid value are dropped.
+ *  An entry of the port action table is programmed in two steps, by setting
+ *   its port range first ('CFG_PORT_RANGE') and its action next
+ *   ('CFG_PORT_ACTION'). The action of an entry must be set to 'PA_NONE'
+ *   before its port range is modified.
+ *  An enabled entry of the listen port table must hold a static port in the
+ *   range [1:32767], like the listen port table of [TSIF].
+ *******************************************************************************/
+void pMmioConfigHandler(
+        stream<MmioCfgCmd>    &siSHL_CfgCmd,
+        stream<PortActCfg>    &soRDp_PortAct,
+        stream<LsnPortCfg>    &soLSn_PortCfg)
+{
+    //-- DIRECTIVES FOR THIS PROCESS -------------------------------------------
+    #pragma HLS INLINE off
+    #pragma HLS PIPELINE II=1 enable_flush
+
+    const char *myName = concat3(THIS_NAME, "/", "MCh");
+
+    if (!siSHL_CfgCmd.empty() and !soRDp_PortAct.full() and !soLSn_PortCfg.full()) {
+        MmioCfgCmd cfgCmd = siSHL_CfgCmd.read();
+        PortAction action = (PortAction)cfgCmd.value(7,0).to_uint();
+        ap_uint<8> pipeId = cfgCmd.value(15,8);
+        switch (cfgCmd.tblId) {
+        case CFG_PORT_RANGE:
+            if (cfgCmd.index < cPortActEntries) {
+                soRDp_PortAct.write(PortActCfg(cfgCmd.index, true,
+                                    PortActEntry(cfgCmd.value(15,0), cfgCmd.value(31,16), PA_NONE, 0)));
+                if (DEBUG_LEVEL & TRACE_MCH) {
+                    printInfo(myName, "Setting the port range of action entry #%d to [%d:%d].\n",
+                              cfgCmd.index.to_uint(), cfgCmd.value(15,0).to_uint(), cfgCmd.value(31,16).to_uint());
+                }
+            }
+            else {
+                printWarn(myName, "Port action entry #%d is out of range. Port range is ignored.\n",
+                          cfgCmd.index.to_uint());
+            }
+            break;
+        case CFG_PORT_ACTION:
+            if (cfgCmd.index >= cPortActEntries) {
+                printWarn(myName, "Port action entry #%d is out of range. Action is ignored.\n",
+                          cfgCmd.index.to_uint());
+            }
+            else if ((cfgCmd.value(7,0) > PA_FWD) or ((action == PA_FWD) and (pipeId >= cNrFwdPipes))) {
+                printWarn(myName, "Invalid action (Action=%d, PipeId=%d) for port action entry #%d. Action is ignored.\n",
+                          cfgCmd.value(7,0).to_uint(), pipeId.to_uint(), cfgCmd.index.to_uint());
+            }
+            else {
+                soRDp_PortAct.write(PortActCfg(cfgCmd.index, false,
+                                    PortActEntry(0, 0, action, pipeId)));
+                if (DEBUG_LEVEL & TRACE_MCH) {
+                    printInfo(myName, "Setting the action of port action entry #%d to %d (PipeId=%d).\n",
+                              cfgCmd.index.to_uint(), action, pipeId.to_uint());
+                }
+            }
+            break;
+        case CFG_LSN_PORT:
+            if (cfgCmd.index >= cLsnPortEntries) {
+                printWarn(myName, "Listen port entry #%d is out of range. Listen port is ignored.\n",
+                          cfgCmd.index.to_uint());
+            }
+            else if (cfgCmd.value[16] and ((cfgCmd.value(15,0) == 0) or cfgCmd.value[15])) {
+                printWarn(myName, "Listen port %d is not a valid static port. Listen port entry #%d is ignored.\n",
+                          cfgCmd.value(15,0).to_uint(), cfgCmd.index.to_uint());
+            }
+            else {
+                soLSn_PortCfg.write(LsnPortCfg(cfgCmd.index, cfgCmd.value[16], cfgCmd.value(15,0)));
+                if (DEBUG_LEVEL & TRACE_MCH) {
+                    printInfo(myName, "Setting listen port entry #%d to port %d (Enable=%d).\n",
+                              cfgCmd.index.to_uint(), cfgCmd.value(15,0).to_uint(), cfgCmd.value(16,16).to_uint());
+                }
+            }
+            break;
+        default:
+            printWarn(myName, "Unknown configuration table #%d. Command is ignored.\n",
+                      cfgCmd.tblId.to_uint());
+            break;
+        }
+    }
+}
+
 /*******************************************************************************
  * @brief Read Path (RDp) - From SHELL/UOE to ROLE/UAF.
  *
  * @param[in]  piSHL_Enable Enable signal from [SHELL].
+ * @param[in]  siMCh_PortAct An entry of the port action table from MmioConfigHandler (MCh).
  * @param[in]  siSHL_Data   Datagram from [SHELL].
  * @param[in]  siSHL_Meta   Metadata from [SHELL].
  * @param[in]  siSHL_DLen   data len from [SHELL].
@@ -308,7 +495,10 @@ void pClose(
  *
  * @details
  *  This process waits for a new metadata to read and performs 3 possibles tasks
- *  depending on the value of the UDP destination port.
+ *  depending on the action that the UDP destination port maps onto in the port
+ *  action table. This table is programmed at run time via the MMIO configuration
+ *  path (see 'CFG_PORT_RANGE' and 'CFG_PORT_ACTION'), and it is looked up in the
+ *  same cycle as the metadata is read. By default, the table specifies:
  *  1) If DstPort==8800, the incoming datagram is dumped. This mode is used to
  *     the UOE in receive mode.
  *  2) If DstPort==8801, it extract the address of the remote socket to connect
@@ -320,6 +510,7 @@ void pClose(
  *******************************************************************************/
 void pReadPath(
         CmdBit              *piSHL_Enable,
+        stream<PortActCfg>  &siMCh_PortAct,
         stream<UdpAppData>  &siSHL_Data,
         stream<UdpAppMeta>  &siSHL_Meta,
         stream<UdpAppDLen>  &siSHL_DLen,
@@ -339,6 +530,11 @@ void pReadPath(
     static enum FsmStates { RDP_IDLE=0, RDP_FWD_META, RDP_FWD_STREAM, RDP_SINK_STREAM, RDP_8801 } \
 	                           rdp_fsmState = RDP_IDLE;
     #pragma HLS reset variable=rdp_fsmState
+    static PortActEntry        PORT_ACTION[cPortActEntries] = {
+        PortActEntry(RECV_MODE_LSN_PORT, RECV_MODE_LSN_PORT, PA_SINK, 0),
+        PortActEntry(XMIT_MODE_LSN_PORT, XMIT_MODE_LSN_PORT, PA_GEN,  0) };
+    #pragma HLS ARRAY_PARTITION variable=PORT_ACTION complete dim=1
+    #pragma HLS reset variable=PORT_ACTION
 
     //-- STATIC DATAFLOW VARIABLES ---------------------------------------------
     static UdpAppMeta  rdp_appMeta;
@@ -351,18 +547,22 @@ void pReadPath(
         return;
     }
 
+    if (!siMCh_PortAct.empty()) {
+        updatePortAction(PORT_ACTION, siMCh_PortAct.read());
+    }
+
     switch (rdp_fsmState ) {
     case RDP_IDLE:
         if (!siSHL_Meta.empty() and !siSHL_DLen.empty()) {
             siSHL_Meta.read(rdp_appMeta);
             siSHL_DLen.read(rdp_appDLen);
-            switch (rdp_appMeta.udpDstPort) {
-            case RECV_MODE_LSN_PORT:
+            switch (lookupPortAction(PORT_ACTION, rdp_appMeta.udpDstPort)) {
+            case PA_SINK:
                 // (DstPort == 8800) Sink this traffic stream
                 if (DEBUG_LEVEL & TRACE_RDP) { printInfo(myName, "Entering Rx test mode (DstPort=%4.4d)\n", rdp_appMeta.udpDstPort.to_uint()); }
                 rdp_fsmState  = RDP_SINK_STREAM;
                 break;
-            case XMIT_MODE_LSN_PORT:
+            case PA_GEN:
                 // (DstPort == 8801) Enter the Tx test mode
                 if (DEBUG_LEVEL & TRACE_RDP) { printInfo(myName, "Entering Tx test mode (DstPort=%4.4d)\n", rdp_appMeta.udpDstPort.to_uint()); }
                 rdp_fsmState  = RDP_8801;
@@ -566,6 +766,7 @@ void pWritePath(
  * @brief   Main process of the UDP Shell Interface (USIF).
  *
  * @param[in]  piSHL_Mmio_En Enable signal from [SHELL/MMIO].
+ * @param[in]  siSHL_Mmio_CfgCmd Configuration command from [SHELL/MMIO].
  * @param[out] soSHL_LsnReq  Listen port request to [SHELL].
  * @param[in]  siSHL_LsnRep  Listen port reply from [SHELL].
  * @param[out] soSHL_ClsReq  Close port request to [SHELL].
@@ -597,6 +798,7 @@ void udp_shell_if(
         //-- SHELL / Mmio Interface
         //------------------------------------------------------
         CmdBit              *piSHL_Mmio_En,
+        stream<MmioCfgCmd>  &siSHL_Mmio_CfgCmd,
 
         //------------------------------------------------------
         //-- SHELL / Control Port Interfaces
@@ -643,6 +845,22 @@ void udp_shell_if(
     //-- LOCAL STREAMS (Sorted by the name of the modules which generate them)
     //-------------------------------------------------------------------------
 
+    //-- Mmio Configuration Handler (MCh)
+    static stream<PortActCfg>      ssMChToRDp_PortAct  ("ssMChToRDp_PortAct");
+    #pragma HLS STREAM    variable=ssMChToRDp_PortAct  depth=cDepth_MChToRDp_PortAct
+    #pragma HLS DATA_PACK variable=ssMChToRDp_PortAct
+    static stream<LsnPortCfg>      ssMChToLSn_PortCfg  ("ssMChToLSn_PortCfg");
+    #pragma HLS STREAM    variable=ssMChToLSn_PortCfg  depth=cDepth_MChToLSn_PortCfg
+    #pragma HLS DATA_PACK variable=ssMChToLSn_PortCfg
+
+    //-- Listen (LSn)
+    static stream<UdpPort>         ssLSnToCLs_ClsReq   ("ssLSnToCLs_ClsReq");
+    #pragma HLS STREAM    variable=ssLSnToCLs_ClsReq   depth=cDepth_LSnToCLs_ClsReq
+
+    //-- Close (CLs)
+    static stream<UdpPort>         ssCLsToLSn_ClsAck   ("ssCLsToLSn_ClsAck");
+    #pragma HLS STREAM    variable=ssCLsToLSn_ClsAck   depth=cDepth_CLsToLSn_ClsAck
+
     //-- Read Path (RDp)
     static stream<SocketPair>      ssRDpToWRp_SockPair ("ssRDpToWRp_SockPair");
     #pragma HLS STREAM    variable=ssRDpToWRp_SockPair depth=2
@@ -650,18 +868,29 @@ void udp_shell_if(
     #pragma HLS STREAM    variable=ssRDpToWRp_DReq     depth=2
 
     //-- PROCESS FUNCTIONS ----------------------------------------------------
+    pMmioConfigHandler(
+            siSHL_Mmio_CfgCmd,
+            ssMChToRDp_PortAct,
+            ssMChToLSn_PortCfg);
+
     pListen(
             piSHL_Mmio_En,
+            ssMChToLSn_PortCfg,
             soSHL_LsnReq,
-            siSHL_LsnRep);
+            siSHL_LsnRep,
+            ssLSnToCLs_ClsReq,
+            ssCLsToLSn_ClsAck);
 
     pClose(
             piSHL_Mmio_En,
+            ssLSnToCLs_ClsReq,
             soSHL_ClsReq,
-            siSHL_ClsRep);
+            siSHL_ClsRep,
+            ssCLsToLSn_ClsAck);
 
     pReadPath(
             piSHL_Mmio_En,
+            ssMChToRDp_PortAct,
             siSHL_Data,
             siSHL_Meta,
             siSHL_DLen,
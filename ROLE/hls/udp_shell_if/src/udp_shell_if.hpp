@@ -39,7 +39,8 @@
 //-------------------------------------------------------------------
 //-- DEFAULT LISTENING PORTS
 //--  By default, the following port numbers will be used by the
-//--  UdpShellInterface (unless user specifies new ones via TBD).
+//--  UdpShellInterface (unless user specifies new ones via the MMIO
+//--  listen port table, see 'CFG_LSN_PORT').
 //--  Default listen ports:
 //--  --> 5001 : Traffic received on this port is [TODO-TBD].
 //--             It is used to emulate IPERF V2.
@@ -73,6 +74,151 @@
 #define GEN_CHK0    0x48692066726f6d20  // 'Hi from '
 #define GEN_CHK1    0x464d4b553630210a  // 'FMKU60\n'
 
+//-------------------------------------------------------------------
+//-- DEFAULT STREAM DEPTHS
+//-------------------------------------------------------------------
+const int cDepth_MChToRDp_PortAct    =   2;
+const int cDepth_MChToLSn_PortCfg    =   2;
+const int cDepth_LSnToCLs_ClsReq     =   2;
+const int cDepth_CLsToLSn_ClsAck     =   2;
+
+//=========================================================
+//== MMIO Configuration Command
+//==  A write access to one of the run-time programmable
+//==  tables of USIF. The 'tblId' selects the table and
+//==  the 'index' selects the entry within that table.
+//==  The table-ids are the same as the ones of TSIF.
+//=========================================================
+enum CfgTblId {
+    CFG_PORT_RANGE=1,  // Port range of a port action entry (index=Entry, value={HiPort,LoPort})
+    CFG_PORT_ACTION,   // Action of a port action entry (index=Entry, value={PipeId[15:8],Action[7:0]})
+    CFG_LSN_PORT,      // Listen port entry (index=Entry, value={Enable[16],Port[15:0]})
+};
+
+class MmioCfgCmd {
+  public:
+    ap_uint<8>      tblId;
+    ap_uint<16>     index;
+    ap_uint<32>     value;
+    MmioCfgCmd() {}
+    MmioCfgCmd(ap_uint<8> _tblId, ap_uint<16> _index, ap_uint<32> _value) :
+        tblId(_tblId), index(_index), value(_value) {}
+};
+
+//=========================================================
+//== Port Action Table Entry
+//==  Maps the UDP destination ports [loPort:hiPort] onto
+//==  the action to apply to the datagrams received on these
+//==  ports. The entries are looked up in parallel and the
+//==  entry with the lowest index wins. A port which does
+//==  not match any entry is forwarded to pipeline #0.
+//=========================================================
+enum PortAction {
+    PA_NONE=0,  // Entry is disabled
+    PA_SINK,    // Sink the received datagrams
+    PA_GEN,     // Trigger the Tx traffic generator (.i.e, XMIT test mode)
+    PA_FWD      // Forward the received datagrams to pipeline 'pipeId'
+};
+
+const int cPortActEntries = 8;  // #Entries of the port action table
+const int cNrFwdPipes     = 1;  // #Pipelines the received datagrams can be forwarded to ([UAF])
+const int cLsnPortEntries = 8;  // #Entries of the listen port table
+
+class PortActEntry {
+  public:
+    UdpPort         loPort;
+    UdpPort         hiPort;
+    PortAction      action;
+    ap_uint<8>      pipeId;
+    PortActEntry() {}
+    PortActEntry(UdpPort _loPort, UdpPort _hiPort, PortAction _action, ap_uint<8> _pipeId) :
+        loPort(_loPort), hiPort(_hiPort), action(_action), pipeId(_pipeId) {}
+};
+
+//=========================================================
+//== Port Action Configuration
+//==  Sets either the port range or the action of an entry
+//==  of the port action table, as selected by 'setRange'.
+//=========================================================
+class PortActCfg {
+  public:
+    ap_uint<log2Ceil<cPortActEntries>::val> index;
+    bool            setRange;
+    PortActEntry    entry;
+    PortActCfg() {}
+    PortActCfg(ap_uint<log2Ceil<cPortActEntries>::val> _index, bool _setRange, PortActEntry _entry) :
+        index(_index), setRange(_setRange), entry(_entry) {}
+};
+
+//=========================================================
+//== Listen Port Configuration
+//==  Enables or disables an entry of the listen port table.
+//==  An enabled entry is opened as soon as possible, while
+//==  a disabled entry is closed, while traffic is running.
+//=========================================================
+typedef ap_uint<log2Ceil<cLsnPortEntries>::val> LsnPortIdx;
+
+class LsnPortCfg {
+  public:
+    LsnPortIdx      index;
+    bool            enable;
+    UdpPort         port;
+    LsnPortCfg() {}
+    LsnPortCfg(LsnPortIdx _index, bool _enable, UdpPort _port) :
+        index(_index), enable(_enable), port(_port) {}
+};
+
+/*******************************************************************************
+ * @brief Update an entry of the port action table.
+ *
+ * @param[in,out] table  The port action table.
+ * @param[in]     cfg    The configuration of the entry to update.
+ *******************************************************************************/
+inline void updatePortAction(
+        PortActEntry    table[cPortActEntries],
+        PortActCfg      cfg)
+{
+    #pragma HLS INLINE
+
+    if (cfg.setRange) {
+        table[cfg.index].loPort = cfg.entry.loPort;
+        table[cfg.index].hiPort = cfg.entry.hiPort;
+    }
+    else {
+        table[cfg.index].action = cfg.entry.action;
+        table[cfg.index].pipeId = cfg.entry.pipeId;
+    }
+}
+
+/*******************************************************************************
+ * @brief Look up the action of a UDP destination port in the port action table.
+ *
+ * @param[in]  table    The port action table (must be completely partitioned).
+ * @param[in]  dstPort  The UDP destination port of the datagram.
+ *
+ * @return the action to apply to the datagram ('PA_FWD' if no entry matches).
+ *
+ * @details
+ *  All the entries are compared in parallel and resolved by a priority
+ *   encoder, such that the lookup fits in the cycle which reads the metadata.
+ *******************************************************************************/
+inline PortAction lookupPortAction(
+        PortActEntry    table[cPortActEntries],
+        UdpPort         dstPort)
+{
+    #pragma HLS INLINE
+
+    PortAction action = PA_FWD;
+    for (int i=cPortActEntries-1; i>=0; i--) {
+        #pragma HLS UNROLL
+        if ((table[i].action != PA_NONE) and
+            (dstPort >= table[i].loPort) and (dstPort <= table[i].hiPort)) {
+            action = table[i].action;
+        }
+    }
+    return action;
+}
+
 
 /*******************************************************************************
  *
@@ -85,6 +231,7 @@ void udp_shell_if(
         //-- SHELL / Mmio Interface
         //------------------------------------------------------
         CmdBit                  *piSHL_Mmio_En,
+        stream<MmioCfgCmd>      &siSHL_Mmio_CfgCmd,
 
         //------------------------------------------------------
         //-- SHELL / Control Port Interfaces
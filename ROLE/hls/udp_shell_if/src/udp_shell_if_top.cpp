@@ -48,6 +48,7 @@ using namespace std;
  * @brief   Top of UDP Shell Interface (USIF)
  *
  * @param[in]  piSHL_Mmio_En Enable signal from [SHELL/MMIO].
+ * @param[in]  siSHL_Mmio_CfgCmd Configuration command from [SHELL/MMIO].
  * @param[out] soSHL_LsnReq  Listen port request to [SHELL].
  * @param[in]  siSHL_LsnRep  Listen port reply from [SHELL].
  * @param[out] soSHL_ClsReq  Close port request to [SHELL].
@@ -77,6 +78,7 @@ using namespace std;
         //-- SHELL / Mmio Interface
         //------------------------------------------------------
         CmdBit              *piSHL_Mmio_En,
+        stream<MmioCfgCmd>  &siSHL_Mmio_CfgCmd,
        //------------------------------------------------------
         //-- SHELL / Control Port Interfaces
         //------------------------------------------------------
@@ -117,6 +119,8 @@ using namespace std;
     /*** directives because the new PRAGMAs do not work for us.        ***/
     /*********************************************************************/
     #pragma HLS INTERFACE ap_stable register port=piSHL_Mmio_En name=piSHL_Mmio_En
+    #pragma HLS resource core=AXI4Stream variable=siSHL_Mmio_CfgCmd metadata="-bus_bundle siSHL_Mmio_CfgCmd"
+    #pragma HLS DATA_PACK                variable=siSHL_Mmio_CfgCmd
 
     //-- [SHL] INTERFACES ------------------------------------------------------
     #pragma HLS resource core=AXI4Stream variable=soSHL_LsnReq  metadata="-bus_bundle soSHL_LsnReq"
@@ -151,6 +155,7 @@ using namespace std;
     udp_shell_if(
         //-- SHELL / Mmio Interface
         piSHL_Mmio_En,
+        siSHL_Mmio_CfgCmd,
         //-- SHELL / Control Port Interfaces
         soSHL_LsnReq,
         siSHL_LsnRep,
@@ -178,6 +183,7 @@ using namespace std;
         //-- SHELL / Mmio Interface
         //------------------------------------------------------
         CmdBit              *piSHL_Mmio_En,
+        stream<MmioCfgCmd>  &siSHL_Mmio_CfgCmd,
        //------------------------------------------------------
         //-- SHELL / Control Port Interfaces
         //------------------------------------------------------
@@ -216,6 +222,8 @@ using namespace std;
   #if defined (USE_AP_FIFO)
     //-- Make use of FIFOs on the UAF interfaces -------------------------------
     #pragma HLS INTERFACE ap_stable register    port=piSHL_Mmio_En  name=piSHL_Mmio_En
+    #pragma HLS INTERFACE axis off              port=siSHL_Mmio_CfgCmd name=siSHL_Mmio_CfgCmd
+    #pragma HLS DATA_PACK                   variable=siSHL_Mmio_CfgCmd
 
     //-- [SHL] INTERFACES ------------------------------------------------------
     #pragma HLS INTERFACE axis off              port=soSHL_LsnReq   name=soSHL_LsnReq
@@ -248,6 +256,8 @@ using namespace std;
   #else
     //-- Make use of AXIS on the UAF interfaces --------------------------------
     #pragma HLS INTERFACE ap_stable register    port=piSHL_Mmio_En  name=piSHL_Mmio_En
+    #pragma HLS INTERFACE axis off              port=siSHL_Mmio_CfgCmd name=siSHL_Mmio_CfgCmd
+    #pragma HLS DATA_PACK                   variable=siSHL_Mmio_CfgCmd
 
     //-- [SHL] INTERFACES ------------------------------------------------------
     #pragma HLS INTERFACE axis off              port=soSHL_LsnReq   name=soSHL_LsnReq
@@ -288,6 +298,7 @@ using namespace std;
     udp_shell_if(
         //-- SHELL / Mmio Interface
         piSHL_Mmio_En,
+        siSHL_Mmio_CfgCmd,
         //-- SHELL / Control Port Interfaces
         soSHL_LsnReq,
         siSHL_LsnRep,
@@ -48,6 +48,7 @@ void udp_shell_if_top(
         //-- SHELL / Mmio Interface
         //------------------------------------------------------
         CmdBit                  *piSHL_Mmio_En,
+        stream<MmioCfgCmd>      &siSHL_Mmio_CfgCmd,
 
         //------------------------------------------------------
         //-- SHELL / Control Port Interfaces
@@ -57,6 +57,11 @@ extern bool         gTraceEvent;
 extern bool         gFatalError;
 extern unsigned int gMaxSimCycles;
 
+//-- The listen/close events seen by the UOE ('L' or 'C' per port)
+map<unsigned int, string>  gUoeLsnPortLog;
+//-- The ports the UOE is currently listening on
+set<unsigned int>          gUoeLsnPortSet;
+
 //---------------------------------------------------------
 // HELPERS FOR THE DEBUGGING TRACES
 //  .e.g: DEBUG_LEVEL = (MDL_TRACE | IPS_TRACE)
@@ -94,6 +99,49 @@ void increaseSimTime(unsigned int cycles) {
     gMaxSimCycles += cycles;
 }
 
+/*******************************************************************************
+ * @brief Check the listen and close requests seen by the UOE for the ports of
+ *   the listen port reconfiguration (see 'pMMIO').
+ *
+ * @return the number of errors.
+ *
+ * @details
+ *  Both ports are first opened, then closed when their entry is reprogrammed
+ *   or disabled, and finally re-opened via another entry or after being
+ *   re-enabled. The close of a port must therefore reach the UOE before the
+ *   port is requested again, and both ports must be opened at the end.
+ *  The invalid ports 0 and 'X' must never reach the UOE.
+ *******************************************************************************/
+int checkUoeLsnPorts() {
+    const char        *myName  = concat3(THIS_NAME, "/", "CHK");
+    const unsigned int ports[2] = { RECFG_LSN_PORT_P, RECFG_LSN_PORT_Q };
+    const unsigned int badPorts[2] = { 0, RECFG_LSN_PORT_X };
+    const string       expLog  = "LCL";
+    int                nrErr   = 0;
+
+    for (int i=0; i<2; i++) {
+        string log = gUoeLsnPortLog[ports[i]];
+        if (log != expLog) {
+            printError(myName, "Port %d - The UOE received the listen/close sequence '%s' instead of '%s'.\n",
+                       ports[i], log.c_str(), expLog.c_str());
+            nrErr++;
+        }
+        if (gUoeLsnPortSet.count(ports[i]) == 0) {
+            printError(myName, "Port %d - The UOE does not listen on this port at the end of the run.\n",
+                       ports[i]);
+            nrErr++;
+        }
+    }
+    for (int i=0; i<2; i++) {
+        if (!gUoeLsnPortLog[badPorts[i]].empty()) {
+            printError(myName, "Port %d - The UOE received a listen/close request for this invalid port.\n",
+                       badPorts[i]);
+            nrErr++;
+        }
+    }
+    return nrErr;
+}
+
 /*******************************************************************************
  * @brief Emulate the behavior of the ROLE/UdpAppFlash (UAF).
  *
@@ -158,17 +206,33 @@ void pUAF(
  *
  * @param[in]  piSHL_Ready    Ready Signal from [SHELL].
  * @param[out] poUSIF_Enable  Enable signal to [USIF] (.i.e, Enable Layer-7).
+ * @param[out] soUSIF_CfgCmd  Configuration command to [USIF].
  *
+ * @details
+ *  Once [USIF] is enabled, the spare entries #6 and #7 of the listen port table
+ *   are reprogrammed as follows:
+ *   - entry #6 is enabled on port 'P',
+ *   - entry #6 is moved to port 'Q' while entry #7 is enabled on port 'P',
+ *   - entry #6 is disabled and re-enabled right away,
+ *   - entries #7 and #6 are moved to the invalid ports 0 and 'X', which must
+ *     be ignored.
+ *  The second and the third step request [USIF] to listen on a port which is
+ *   still being closed (see 'checkUoeLsnPorts').
  *******************************************************************************/
 void pMMIO(
         //-- SHELL / Ready Signal
         StsBit      *piSHL_Ready,
         //-- MMIO / Enable Layer-7 (.i.e APP alias ROLE)
-        CmdBit      *poUSIF_Enable)
+        CmdBit      *poUSIF_Enable,
+        //-- MMIO / Configuration Command
+        stream<MmioCfgCmd> &soUSIF_CfgCmd)
 {
     const char *myName  = concat3(THIS_NAME, "/", "MMIO");
 
     static bool mmio_printOnce = true;
+    static int  mmio_cfgCycCnt = 0;
+
+    const ap_uint<32> cEnable = 0x10000;  // Enable bit of a listen port entry
 
     if (*piSHL_Ready) {
         *poUSIF_Enable = 1;
@@ -176,6 +240,30 @@ void pMMIO(
             printInfo(myName, "[SHELL/NTS/UOE] is ready -> Enabling operation of the UDP Shell Interface (USIF).\n");
             mmio_printOnce = false;
         }
+        switch (mmio_cfgCycCnt) {
+        case 40:
+            printInfo(myName, "Enabling listen port entry #6 on port %d.\n", RECFG_LSN_PORT_P);
+            soUSIF_CfgCmd.write(MmioCfgCmd(CFG_LSN_PORT, 6, cEnable | RECFG_LSN_PORT_P));
+            break;
+        case 80:
+            printInfo(myName, "Moving listen port entry #6 to port %d and enabling entry #7 on port %d.\n",
+                      RECFG_LSN_PORT_Q, RECFG_LSN_PORT_P);
+            soUSIF_CfgCmd.write(MmioCfgCmd(CFG_LSN_PORT, 6, cEnable | RECFG_LSN_PORT_Q));
+            soUSIF_CfgCmd.write(MmioCfgCmd(CFG_LSN_PORT, 7, cEnable | RECFG_LSN_PORT_P));
+            break;
+        case 160:
+            printInfo(myName, "Disabling and re-enabling listen port entry #6 (port %d).\n", RECFG_LSN_PORT_Q);
+            soUSIF_CfgCmd.write(MmioCfgCmd(CFG_LSN_PORT, 6,           RECFG_LSN_PORT_Q));
+            soUSIF_CfgCmd.write(MmioCfgCmd(CFG_LSN_PORT, 6, cEnable | RECFG_LSN_PORT_Q));
+            break;
+        case 240:
+            printInfo(myName, "Moving listen port entries #7 and #6 to the invalid ports 0 and %d.\n",
+                      RECFG_LSN_PORT_X);
+            soUSIF_CfgCmd.write(MmioCfgCmd(CFG_LSN_PORT, 7, cEnable | 0));
+            soUSIF_CfgCmd.write(MmioCfgCmd(CFG_LSN_PORT, 6, cEnable | RECFG_LSN_PORT_X));
+            break;
+        }
+        mmio_cfgCycCnt++;
     }
     else {
         *poUSIF_Enable = 0;
@@ -201,6 +289,7 @@ void pMMIO(
  * @param[in]  siUSIF_LsnReq  The listen port request from [USIF].
  * @param[out] soUSIF_LsnRep  The listen port reply to [USIF].
  * @param[in]  siUSIF_ClsReq  The close port request from [USIF].
+ * @param[out] soUSIF_ClsRep  The close port reply to [USIF].
  *
  ******************************************************************************/
 void pUOE(
@@ -226,10 +315,12 @@ void pUOE(
         stream<UdpPort>       &siUSIF_LsnReq,
         stream<StsBool>       &soUSIF_LsnRep,
         //-- USIF<->UOE / Close Interfaces
-        stream<UdpPort>       &siUSIF_ClsReq)
+        stream<UdpPort>       &siUSIF_ClsReq,
+        stream<StsBool>       &soUSIF_ClsRep)
 {
 
     static enum LsnStates { LSN_WAIT_REQ,  LSN_SEND_REP }  uoe_lsnState = LSN_WAIT_REQ;
+    static enum ClsStates { CLS_WAIT_REQ,  CLS_SEND_REP }  uoe_clsState = CLS_WAIT_REQ;
     static enum RxpStates { RXP_SEND_META, RXP_SEND_DATA, \
                             RXP_SEND_8801, RXP_DONE }      uoe_rxpState = RXP_SEND_META;
     static enum TxpStates { TXP_WAIT_META, TXP_RECV_DATA } uoe_txpState = TXP_WAIT_META;
@@ -242,6 +333,7 @@ void pUOE(
     static bool uoe_txpIsReady = false;
 
     const char  *myLsnName = concat3(THIS_NAME, "/", "UOE/Listen");
+    const char  *myClsName = concat3(THIS_NAME, "/", "UOE/Close");
     const char  *myRxpName = concat3(THIS_NAME, "/", "UOE/RxPath");
     const char  *myTxpName = concat3(THIS_NAME, "/", "UOE/TxPath");
 
@@ -274,6 +366,8 @@ void pUOE(
             siUSIF_LsnReq.read(uoe_lsnPortReq);
             printInfo(myLsnName, "Received a listen port request #%d from [USIF].\n",
                       uoe_lsnPortReq.to_int());
+            gUoeLsnPortLog[uoe_lsnPortReq.to_uint()] += 'L';
+            gUoeLsnPortSet.insert(uoe_lsnPortReq.to_uint());
             uoe_lsnState = LSN_SEND_REP;
         }
         break;
@@ -289,7 +383,40 @@ void pUOE(
     }  // End-of: switch (uoe_lsnState) {
 
     //------------------------------------------------------
-    //-- FSM #2 - RX DATA PATH
+    //-- FSM #2 - CLOSING
+    //--    (The port is closed 'cUoeClsLatency' cycles
+    //--     after the request was received)
+    //------------------------------------------------------
+    static UdpPort  uoe_clsPortReq;
+    static int      uoe_clsDelay;
+    switch (uoe_clsState) {
+    case CLS_WAIT_REQ: // CHECK IF A CLOSING REQUEST IS PENDING
+        if (!siUSIF_ClsReq.empty()) {
+            siUSIF_ClsReq.read(uoe_clsPortReq);
+            printInfo(myClsName, "Received a close port request #%d from [USIF].\n",
+                      uoe_clsPortReq.to_int());
+            uoe_clsDelay = cUoeClsLatency;
+            uoe_clsState = CLS_SEND_REP;
+        }
+        break;
+    case CLS_SEND_REP: // CLOSE THE PORT AND SEND REPLY BACK TO [USIF]
+        if (uoe_clsDelay) {
+            uoe_clsDelay--;
+        }
+        else if (!soUSIF_ClsRep.full()) {
+            gUoeLsnPortLog[uoe_clsPortReq.to_uint()] += 'C';
+            gUoeLsnPortSet.erase(uoe_clsPortReq.to_uint());
+            soUSIF_ClsRep.write(false);  // The port is not opened anymore
+            uoe_clsState = CLS_WAIT_REQ;
+        }
+        else {
+            printWarn(myClsName, "Cannot send close reply back to [USIF] because stream is full.\n");
+        }
+        break;
+    }  // End-of: switch (uoe_clsState) {
+
+    //------------------------------------------------------
+    //-- FSM #3 - RX DATA PATH
     //------------------------------------------------------
     UdpAppData         appData;
     static UdpAppMeta  uoe_rxMeta;
@@ -439,7 +566,7 @@ void pUOE(
     }
 
     //------------------------------------------------------
-    //-- FSM #3 - TX DATA PATH
+    //-- FSM #4 - TX DATA PATH
     //--    (Always drain the data coming from [USIF])
     //------------------------------------------------------
     static UdpAppDLen uoe_appDLen;
@@ -33,6 +33,9 @@
 #include <cstdlib>
 #include <hls_stream.h>
 #include <iostream>
+#include <map>
+#include <set>
+#include <string>
 
 #include "../src/udp_shell_if.hpp"
 #include "../../../../cFDK/SRA/LIB/SHELL/LIB/hls/NTS/SimNtsUtils.hpp"
@@ -58,12 +61,27 @@ const int cGraceTime     = 500;  // Give the TB some time to finish
 
 #define DEFAULT_DATAGRAM_LEN    32
 
+//---------------------------------------------------------
+//-- LISTEN PORT RECONFIGURATION
+//--  The MMIO emulator reprograms the spare entries #6 and
+//--  #7 of the listen port table with the following ports
+//--  while traffic is running, and the UOE emulator serves
+//--  the close requests with some latency. The port 'X' is
+//--  not a static port and must be rejected by [USIF].
+//---------------------------------------------------------
+#define RECFG_LSN_PORT_P        7000
+#define RECFG_LSN_PORT_Q        7001
+#define RECFG_LSN_PORT_X       36864
+
+const int cUoeClsLatency = 16;  // The UOE closes a port 16 cycles after the request
+
 
 /*******************************************************************************
  * SIMULATION UTILITY HELPERS
  ********************************************************************************/
 void stepSim();
 void increaseSimTime(unsigned int cycles);
+int  checkUoeLsnPorts();
 
 /******************************************************************************
  * SIMULATION ENVIRONMENT FUNCTIONS
@@ -81,7 +99,9 @@ void pMMIO(
         //-- SHELL / Ready Signal
         StsBit      *piSHL_Ready,
         //-- MMIO / Enable Layer-7 (.i.e APP alias ROLE)
-        CmdBit      *poUSIF_Enable);
+        CmdBit      *poUSIF_Enable,
+        //-- MMIO / Configuration Command
+        stream<MmioCfgCmd> &soUSIF_CfgCmd);
 
 void pUOE(
         int                   &nrErr,
@@ -106,7 +126,8 @@ void pUOE(
         stream<UdpPort>       &siUSIF_LsnReq,
         stream<StsBool>       &soUSIF_LsnRep,
         //-- USIF<->UOE / Close Interfaces
-        stream<UdpPort>       &siUSIF_ClsReq);
+        stream<UdpPort>       &siUSIF_ClsReq,
+        stream<StsBool>       &soUSIF_ClsRep);
 
 #endif
 
@@ -88,6 +88,8 @@ int main(int argc, char *argv[]) {
     //------------------------------------------------------
     //-- DUT STREAM INTERFACES
     //------------------------------------------------------
+    //-- SHL / Mmio Interface
+    stream<MmioCfgCmd>    ssMMIO_USIF_CfgCmd  ("ssMMIO_USIF_CfgCmd");
     //-- UAF->USIF / UDP Tx Data Interface
     stream<UdpAppData>    ssUAF_USIF_Data     ("ssUAF_USIF_Data");
     stream<UdpAppMeta>    ssUAF_USIF_Meta     ("ssUAF_USIF_Meta");
@@ -252,7 +254,8 @@ int main(int argc, char *argv[]) {
             ssUSIF_UOE_LsnReq,
             ssUOE_USIF_LsnRep,
             //-- USIF<->UOE / Close Interfaces
-            ssUSIF_UOE_ClsReq);
+            ssUSIF_UOE_ClsReq,
+            ssUOE_USIF_ClsRep);
 
         //-------------------------------------------------
         //-- EMULATE SHELL/MMIO
@@ -261,7 +264,9 @@ int main(int argc, char *argv[]) {
             //-- UOE / Ready Signal
             &sUOE_MMIO_Ready,
             //-- MMIO / Enable Layer-7 (.i.e APP alias ROLE)
-            &sMMIO_USIF_Enable);
+            &sMMIO_USIF_Enable,
+            //-- MMIO / Configuration Command
+            ssMMIO_USIF_CfgCmd);
 
         //-------------------------------------------------
         //-- RUN DUT
@@ -269,6 +274,7 @@ int main(int argc, char *argv[]) {
         udp_shell_if(
             //-- SHELL / Mmio Interface
             &sMMIO_USIF_Enable,
+            ssMMIO_USIF_CfgCmd,
             //-- SHELL / Control Port Interfaces
             ssUSIF_UOE_LsnReq,
             ssUOE_USIF_LsnRep,
@@ -351,6 +357,11 @@ int main(int argc, char *argv[]) {
         nrErr += 1;
     }
 
+    //---------------------------------------------------------------
+    //-- CHECK THE LISTEN AND CLOSE REQUESTS SEEN BY THE UOE
+    //---------------------------------------------------------------
+    nrErr += checkUoeLsnPorts();
+
     if (nrErr) {
          printError(THIS_NAME, "###############################################################################\n");
          printError(THIS_NAME, "#### TESTBENCH 'test_udp_shell_if' FAILED : TOTAL NUMBER OF ERROR(S) = %2d ####\n", nrErr);